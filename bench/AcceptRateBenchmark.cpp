@@ -0,0 +1,123 @@
+#include "AcceptRateBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace {
+
+enum class Mode {
+  PLAIN,
+  CONDITION,
+  LIFECYCLE
+};
+
+const char* modeName(Mode mode) {
+  switch(mode) {
+    case Mode::PLAIN: return "server.run()";
+    case Mode::CONDITION: return "server.run(condition)";
+    case Mode::LIFECYCLE: return "ServerLifecycle";
+  }
+  return "";
+}
+
+void runMode(Mode mode, v_int32 clientThreads, const std::chrono::milliseconds& duration) {
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+
+  auto port = connectionProvider->getPort();
+
+  std::atomic<bool> serverShouldContinue(true);
+  std::shared_ptr<oatpp::network::Server> server;
+  std::shared_ptr<ServerLifecycle> lifecycle;
+  std::thread serverThread;
+
+  switch(mode) {
+
+    case Mode::PLAIN:
+      server = oatpp::network::Server::createShared(connectionProvider, connectionHandler);
+      serverThread = std::thread([server] { server->run(); });
+      break;
+
+    case Mode::CONDITION:
+      server = oatpp::network::Server::createShared(connectionProvider, connectionHandler);
+      serverThread = std::thread([server, &serverShouldContinue] {
+        server->run([&serverShouldContinue] { return serverShouldContinue.load(); });
+      });
+      break;
+
+    case Mode::LIFECYCLE:
+      lifecycle = std::make_shared<ServerLifecycle>(connectionProvider, connectionHandler);
+      lifecycle->start();
+      break;
+
+  }
+
+  std::atomic<v_int64> served(0);
+  std::atomic<v_int64> failed(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, &served, &failed, &clientsShouldContinue] {
+      while(clientsShouldContinue) {
+        if(LoopbackClient::requestOnce(port)) {
+          served ++;
+        } else {
+          failed ++;
+        }
+      }
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  auto stopStart = std::chrono::steady_clock::now();
+
+  if(lifecycle) {
+    lifecycle->stop();
+  } else {
+    serverShouldContinue = false;
+    server->stop();
+    connectionProvider->stop();
+    serverThread.join();
+    connectionHandler->stop();
+  }
+
+  auto stopMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - stopStart).count();
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+
+  OATPP_LOGI("AcceptRateBenchmark", "%-22s accepts/s=%.1f served=%lld failed=%lld stop=%lldus",
+             modeName(mode), served / seconds, (long long) served.load(), (long long) failed.load(), (long long) stopMicros);
+
+}
+
+}
+
+void AcceptRateBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "client threads=%d, duration=%lldms", m_clientThreads, (long long) m_duration.count());
+
+  runMode(Mode::PLAIN, m_clientThreads, m_duration);
+  runMode(Mode::CONDITION, m_clientThreads, m_duration);
+  runMode(Mode::LIFECYCLE, m_clientThreads, m_duration);
+
+}
@@ -0,0 +1,27 @@
+#ifndef AcceptRateBenchmark_hpp
+#define AcceptRateBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Measures connections accepted and served per second with one short-lived connection per request.
+ * Compares the plain `server.run()` loop used by NoStop, the legacy `server.run(condition)` loop
+ * and &l:ServerLifecycle;.
+ */
+class AcceptRateBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_clientThreads;
+  std::chrono::milliseconds m_duration;
+public:
+
+  AcceptRateBenchmark(v_int32 clientThreads = 8, const std::chrono::milliseconds& duration = std::chrono::seconds(5))
+    : UnitTest("BENCH[AcceptRateBenchmark]")
+    , m_clientThreads(clientThreads)
+    , m_duration(duration)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // AcceptRateBenchmark_hpp
@@ -0,0 +1,241 @@
+#include "ArenaBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "dto/DTOs.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "memory/RequestArena.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+
+std::atomic<bool> countAllocations(false);
+std::atomic<v_int64> allocations(0);
+
+}
+
+/* Counts heap allocations of the whole bench binary while countAllocations is set */
+
+void* operator new(std::size_t size) {
+  if(countAllocations.load(std::memory_order_relaxed)) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if(ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+/**
+ * Per-request DTO and response on the heap.
+ */
+class HeapController : public oatpp::web::server::api::ApiController {
+public:
+
+  HeapController(const std::shared_ptr<ObjectMapper>& objectMapper)
+    : oatpp::web::server::api::ApiController(objectMapper)
+  {}
+
+  ENDPOINT("GET", "/", root) {
+    auto dto = MyDto::createShared();
+    dto->statusCode = 200;
+    dto->message = "Hello World!";
+    return createDtoResponse(Status::CODE_200, dto);
+  }
+
+};
+
+/**
+ * Same response with everything of the request in a RequestArena.
+ */
+class ArenaController : public oatpp::web::server::api::ApiController {
+public:
+
+  ArenaController(const std::shared_ptr<ObjectMapper>& objectMapper)
+    : oatpp::web::server::api::ApiController(objectMapper)
+  {}
+
+  ENDPOINT("GET", "/", root) {
+    auto arena = RequestArena::create();
+    auto dto = arena->create<oatpp::Object<MyDto>>();
+    dto->statusCode = arena->create<oatpp::Int32>(200);
+    dto->message = arena->create<oatpp::String>("Hello World!");
+    return arena->createDtoResponse(Status::CODE_200, dto, getDefaultObjectMapper());
+  }
+
+};
+
+#include OATPP_CODEGEN_END(ApiController)
+
+namespace {
+
+typedef oatpp::web::protocol::http::Status Status;
+typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+
+std::shared_ptr<OutgoingResponse> buildOnHeap(const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper) {
+  auto dto = MyDto::createShared();
+  dto->statusCode = 200;
+  dto->message = "Hello World!";
+  return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(Status::CODE_200, dto, objectMapper);
+}
+
+std::shared_ptr<OutgoingResponse> buildInArena(const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper) {
+  auto arena = RequestArena::create();
+  auto dto = arena->create<oatpp::Object<MyDto>>();
+  dto->statusCode = arena->create<oatpp::Int32>(200);
+  dto->message = arena->create<oatpp::String>("Hello World!");
+  return arena->createDtoResponse(Status::CODE_200, dto, objectMapper);
+}
+
+typedef std::shared_ptr<OutgoingResponse> (*Builder)(const std::shared_ptr<oatpp::data::mapping::ObjectMapper>&);
+
+/* The response is dropped only after its body is read, the way a connection thread does it */
+v_int64 buildAndDrop(Builder builder, const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper) {
+  auto response = builder(objectMapper);
+  return response->getBody()->getKnownSize();
+}
+
+double allocationsPerRequest(Builder builder, const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper, v_int64 iterations) {
+
+  /* Warm up thread caches first */
+  for(v_int64 i = 0; i < 1000; i ++) {
+    buildAndDrop(builder, objectMapper);
+  }
+
+  allocations = 0;
+  countAllocations = true;
+  for(v_int64 i = 0; i < iterations; i ++) {
+    buildAndDrop(builder, objectMapper);
+  }
+  countAllocations = false;
+
+  return (double) allocations / iterations;
+
+}
+
+double runInProcess(Builder builder, const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper, v_int32 threads, v_int64 iterations) {
+
+  std::atomic<v_int64> bytes(0);
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> workers;
+  for(v_int32 i = 0; i < threads; i ++) {
+    workers.push_back(std::thread([builder, &objectMapper, iterations, &bytes] {
+      v_int64 threadBytes = 0;
+      for(v_int64 j = 0; j < iterations; j ++) {
+        threadBytes += buildAndDrop(builder, objectMapper);
+      }
+      bytes += threadBytes;
+    }));
+  }
+
+  for(auto& worker : workers) {
+    worker.join();
+  }
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+  return threads * iterations / seconds;
+
+}
+
+void runHttp(const char* name,
+             const std::shared_ptr<oatpp::web::server::api::ApiController>& controller,
+             v_int32 clientThreads,
+             const std::chrono::milliseconds& duration)
+{
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(controller);
+
+  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  /* Allocations of the whole server per request - parsing, routing and writing included */
+  double perRequest = 0;
+  {
+    const v_int64 requests = 10000;
+    LoopbackClient client(port);
+    for(v_int64 i = 0; i < 1000; i ++) {
+      client.request("/");
+    }
+    allocations = 0;
+    countAllocations = true;
+    for(v_int64 i = 0; i < requests; i ++) {
+      client.request("/");
+    }
+    countAllocations = false;
+    perRequest = (double) allocations / requests;
+  }
+
+  std::atomic<v_int64> served(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, &served, &clientsShouldContinue] {
+      LoopbackClient client(port);
+      while(clientsShouldContinue && client.request("/") == 200) {
+        served ++;
+      }
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  lifecycle.stop();
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+
+  OATPP_LOGI("ArenaBenchmark", "http %-6s req/s=%.1f allocations/request=%.2f (client included)", name, served / seconds, perRequest);
+
+}
+
+}
+
+void ArenaBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "threads=%d, duration=%lldms, iterations=%lld",
+             m_threads, (long long) m_duration.count(), (long long) m_iterations);
+
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  auto heapAllocations = allocationsPerRequest(&buildOnHeap, objectMapper, 100000);
+  auto arenaAllocations = allocationsPerRequest(&buildInArena, objectMapper, 100000);
+  OATPP_LOGI(TAG, "in-process allocations/request heap=%.2f arena=%.2f", heapAllocations, arenaAllocations);
+
+  auto iterationsPerThread = m_iterations / m_threads;
+  auto heapRate = runInProcess(&buildOnHeap, objectMapper, m_threads, iterationsPerThread);
+  auto arenaRate = runInProcess(&buildInArena, objectMapper, m_threads, iterationsPerThread);
+  OATPP_LOGI(TAG, "in-process responses/s heap=%.1f arena=%.1f", heapRate, arenaRate);
+
+  runHttp("heap", std::make_shared<HeapController>(objectMapper), m_threads, m_duration);
+  runHttp("arena", std::make_shared<ArenaController>(objectMapper), m_threads, m_duration);
+
+}
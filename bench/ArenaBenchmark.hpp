@@ -0,0 +1,31 @@
+#ifndef ArenaBenchmark_hpp
+#define ArenaBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Per-request DTO and response built on the heap (`MyDto::createShared()`, `createDtoResponse()`) against the same
+ * objects built in a &l:RequestArena; - heap allocations per request and throughput, in-process on several threads
+ * and as req/s over keep-alive loopback connections.
+ */
+class ArenaBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_threads;
+  std::chrono::milliseconds m_duration;
+  v_int64 m_iterations;
+public:
+
+  ArenaBenchmark(v_int32 threads = 8,
+                 const std::chrono::milliseconds& duration = std::chrono::seconds(5),
+                 v_int64 iterations = 1000000)
+    : UnitTest("BENCH[ArenaBenchmark]")
+    , m_threads(threads)
+    , m_duration(duration)
+    , m_iterations(iterations)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // ArenaBenchmark_hpp
@@ -0,0 +1,148 @@
+#include "CachedResponseBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+/**
+ * `GET /` as it was before the response cache - new DTO and serialization per request.
+ */
+class UncachedController : public oatpp::web::server::api::ApiController {
+public:
+
+  UncachedController(const std::shared_ptr<ObjectMapper>& objectMapper)
+    : oatpp::web::server::api::ApiController(objectMapper)
+  {}
+
+  ENDPOINT("GET", "/", root) {
+    auto dto = MyDto::createShared();
+    dto->statusCode = 200;
+    dto->message = "Hello World!";
+    return createDtoResponse(Status::CODE_200, dto);
+  }
+
+};
+
+#include OATPP_CODEGEN_END(ApiController)
+
+namespace {
+
+typedef oatpp::web::protocol::http::Status Status;
+
+void runInProcess(v_int64 iterations) {
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  auto start = std::chrono::steady_clock::now();
+  for(v_int64 i = 0; i < iterations; i ++) {
+    auto dto = MyDto::createShared();
+    dto->statusCode = 200;
+    dto->message = "Hello World!";
+    auto response = oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(Status::CODE_200, dto, objectMapper);
+  }
+  auto uncached = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+
+  auto dto = MyDto::createShared();
+  dto->statusCode = 200;
+  dto->message = "Hello World!";
+  auto cachedResponse = CachedResponse::createDtoResponse(Status::CODE_200, dto, objectMapper);
+
+  start = std::chrono::steady_clock::now();
+  for(v_int64 i = 0; i < iterations; i ++) {
+    auto response = cachedResponse->respond(nullptr);
+  }
+  auto cached = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+
+  OATPP_LOGI("CachedResponseBenchmark", "in-process  uncached responses/s=%.1f cached responses/s=%.1f",
+             iterations / uncached, iterations / cached);
+
+}
+
+void runHttp(const char* name,
+             const std::shared_ptr<oatpp::web::server::api::ApiController>& controller,
+             const std::string& extraHeaders,
+             v_int32 expectedStatus,
+             v_int32 clientThreads,
+             const std::chrono::milliseconds& duration)
+{
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(controller);
+
+  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  std::atomic<v_int64> served(0);
+  std::atomic<v_int64> failed(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, &extraHeaders, expectedStatus, &served, &failed, &clientsShouldContinue] {
+      std::unique_ptr<LoopbackClient> client(new LoopbackClient(port));
+      while(clientsShouldContinue) {
+        if(client->request("/", extraHeaders) == expectedStatus) {
+          served ++;
+        } else {
+          failed ++;
+        }
+        if(!client->isConnected()) {
+          client.reset(new LoopbackClient(port));
+        }
+      }
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  lifecycle.stop();
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+
+  OATPP_LOGI("CachedResponseBenchmark", "%-22s req/s=%.1f served=%lld failed=%lld",
+             name, served / seconds, (long long) served.load(), (long long) failed.load());
+
+}
+
+}
+
+void CachedResponseBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "client threads=%d, duration=%lldms, iterations=%lld",
+             m_clientThreads, (long long) m_duration.count(), (long long) m_iterations);
+
+  runInProcess(m_iterations);
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  auto controller = std::make_shared<MyController>(objectMapper);
+
+  /* ETag of the cached root, same as the controller computes */
+  auto dto = MyDto::createShared();
+  dto->statusCode = 200;
+  dto->message = "Hello World!";
+  auto etag = CachedResponse::createDtoResponse(Status::CODE_200, dto, objectMapper)->getETag();
+
+  runHttp("uncached", std::make_shared<UncachedController>(objectMapper), "", 200, m_clientThreads, m_duration);
+  runHttp("cached", controller, "", 200, m_clientThreads, m_duration);
+  runHttp("cached If-None-Match", controller, "If-None-Match: " + *etag + "\r\n", 304, m_clientThreads, m_duration);
+
+}
@@ -0,0 +1,31 @@
+#ifndef CachedResponseBenchmark_hpp
+#define CachedResponseBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Compares `GET /` served by serializing `MyDto` on every request (the way MyController used to do it)
+ * with the pre-serialized &l:CachedResponse; - in-process and as req/s over keep-alive loopback connections,
+ * including conditional requests answered with 304.
+ */
+class CachedResponseBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_clientThreads;
+  std::chrono::milliseconds m_duration;
+  v_int64 m_iterations;
+public:
+
+  CachedResponseBenchmark(v_int32 clientThreads = 8,
+                          const std::chrono::milliseconds& duration = std::chrono::seconds(5),
+                          v_int64 iterations = 1000000)
+    : UnitTest("BENCH[CachedResponseBenchmark]")
+    , m_clientThreads(clientThreads)
+    , m_duration(duration)
+    , m_iterations(iterations)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // CachedResponseBenchmark_hpp
@@ -0,0 +1,130 @@
+#include "CompressionBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "compression/ResponseCompression.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "app/PayloadController.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+
+/**
+ * User + system CPU time of the process so far.
+ */
+double cpuSeconds() {
+  rusage usage;
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+void run(const char* name,
+         const std::shared_ptr<oatpp::web::server::HttpRouter>& router,
+         const std::shared_ptr<ResponseCompression>& compression,
+         const char* path,
+         const std::string& acceptEncoding,
+         v_int32 clientThreads,
+         const std::chrono::milliseconds& duration)
+{
+
+  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  if(compression) {
+    connectionHandler->addResponseInterceptor(std::make_shared<ResponseCompression::ResponseInterceptor>(compression));
+  }
+
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  std::atomic<v_int64> served(0);
+  std::atomic<v_int64> failed(0);
+  std::atomic<v_int64> receivedBytes(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  auto extraHeaders = acceptEncoding.empty() ? std::string() : "Accept-Encoding: " + acceptEncoding + "\r\n";
+
+  auto cpuBefore = cpuSeconds();
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, path, &extraHeaders, &served, &failed, &receivedBytes, &clientsShouldContinue] {
+      std::unique_ptr<LoopbackClient> client(new LoopbackClient(port));
+      while(clientsShouldContinue) {
+        if(client->request(path, extraHeaders) == 200) {
+          served ++;
+        } else {
+          failed ++;
+        }
+        if(!client->isConnected()) {
+          receivedBytes += client->getReceivedBytes();
+          client.reset(new LoopbackClient(port));
+        }
+      }
+      receivedBytes += client->getReceivedBytes();
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  auto cpu = cpuSeconds() - cpuBefore;
+
+  lifecycle.stop();
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+  auto requests = std::max<v_int64>(served.load() + failed.load(), 1);
+
+  OATPP_LOGI("CompressionBenchmark", "%-16s %-18s req/s=%.1f bytes/response=%.0f cpu us/request=%.1f failed=%lld",
+             path, name, served / seconds, (double) receivedBytes.load() / requests, cpu * 1e6 / requests,
+             (long long) failed.load());
+
+}
+
+}
+
+void CompressionBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "client threads=%d, duration=%lldms", m_clientThreads, (long long) m_duration.count());
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+  router->addController(std::make_shared<PayloadController>(objectMapper, 1000));
+
+  ResponseCompression::Config config;
+  ResponseCompression::Config noCacheConfig;
+  noCacheConfig.cacheMaxBytes = 0;
+
+  for(const char* path : {"/payload/cached", "/payload/dto", "/items/1000"}) {
+
+    run("uncompressed", router, nullptr, path, "", m_clientThreads, m_duration);
+    run("gzip", router, ResponseCompression::createShared(config), path, "gzip", m_clientThreads, m_duration);
+    run("deflate", router, ResponseCompression::createShared(config), path, "deflate", m_clientThreads, m_duration);
+    if(Compressor::isSupported(Compressor::Encoding::BROTLI)) {
+      run("br", router, ResponseCompression::createShared(config), path, "br", m_clientThreads, m_duration);
+    }
+
+    /* What the cache of compressed variants saves */
+    if(std::string(path) == "/payload/cached") {
+      run("gzip, no cache", router, ResponseCompression::createShared(noCacheConfig), path, "gzip", m_clientThreads, m_duration);
+    }
+
+  }
+
+}
@@ -0,0 +1,30 @@
+#ifndef CompressionBenchmark_hpp
+#define CompressionBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Serves JSON bodies of &l:PayloadController; and `GET /items/{count}` of &l:MyController; without compression and
+ * through &l:ResponseCompression; with gzip, deflate and brotli (if built with it), over keep-alive loopback
+ * connections. The cached body is also served with the cache of compressed variants turned off.
+ * Reports req/s, bytes on the wire per response (head included) and CPU time of the process per request - the loopback
+ * clients are included, they are the same for every run.
+ */
+class CompressionBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_clientThreads;
+  std::chrono::milliseconds m_duration;
+public:
+
+  CompressionBenchmark(v_int32 clientThreads = 4,
+                       const std::chrono::milliseconds& duration = std::chrono::seconds(3))
+    : UnitTest("BENCH[CompressionBenchmark]")
+    , m_clientThreads(clientThreads)
+    , m_duration(duration)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // CompressionBenchmark_hpp
@@ -0,0 +1,158 @@
+#include "DtoSerializerBenchmark.hpp"
+
+#include "dto/DTOs.hpp"
+#include "mapping/StaticJsonObjectMapper.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+#include <chrono>
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * DTO with 20 fields of the usual types.
+ */
+class WideDto : public oatpp::DTO {
+
+  DTO_INIT(WideDto, DTO)
+
+  DTO_FIELD(Int64, id);
+  DTO_FIELD(Int32, version);
+  DTO_FIELD(String, name);
+  DTO_FIELD(String, email);
+  DTO_FIELD(Int32, age);
+  DTO_FIELD(Float64, balance);
+  DTO_FIELD(String, country);
+  DTO_FIELD(String, city);
+  DTO_FIELD(String, street);
+  DTO_FIELD(Int32, zip);
+  DTO_FIELD(Float64, latitude);
+  DTO_FIELD(Float64, longitude);
+  DTO_FIELD(Int64, createdAt);
+  DTO_FIELD(Int64, updatedAt);
+  DTO_FIELD(String, status);
+  DTO_FIELD(Int32, loginCount);
+  DTO_FIELD(Float64, score);
+  DTO_FIELD(String, note, "comment");
+  DTO_FIELD(Int32, flags);
+  DTO_FIELD(Object<MyDto>, last);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+STATIC_DTO(WideDto,
+  STATIC_DTO_FIELD(id)
+  STATIC_DTO_FIELD(version)
+  STATIC_DTO_FIELD(name)
+  STATIC_DTO_FIELD(email)
+  STATIC_DTO_FIELD(age)
+  STATIC_DTO_FIELD(balance)
+  STATIC_DTO_FIELD(country)
+  STATIC_DTO_FIELD(city)
+  STATIC_DTO_FIELD(street)
+  STATIC_DTO_FIELD(zip)
+  STATIC_DTO_FIELD(latitude)
+  STATIC_DTO_FIELD(longitude)
+  STATIC_DTO_FIELD(createdAt)
+  STATIC_DTO_FIELD(updatedAt)
+  STATIC_DTO_FIELD(status)
+  STATIC_DTO_FIELD(loginCount)
+  STATIC_DTO_FIELD(score)
+  STATIC_DTO_FIELD_AS(note, "comment")
+  STATIC_DTO_FIELD(flags)
+  STATIC_DTO_FIELD(last)
+)
+
+namespace {
+
+oatpp::Object<MyDto> createMyDto() {
+  auto dto = MyDto::createShared();
+  dto->statusCode = 200;
+  dto->message = "Hello World!";
+  return dto;
+}
+
+oatpp::Object<WideDto> createWideDto() {
+  auto dto = WideDto::createShared();
+  dto->id = 1234567890123;
+  dto->version = 7;
+  dto->name = "John Smith";
+  dto->email = "john.smith at example.com";
+  dto->age = 42;
+  dto->balance = 1024.5;
+  dto->country = "Netherlands";
+  dto->city = "Amsterdam";
+  dto->street = "Damrak 1";
+  dto->zip = 1012;
+  dto->latitude = 52.3738;
+  dto->longitude = 4.8910;
+  dto->createdAt = 1700000000000;
+  dto->updatedAt = 1700000360000;
+  dto->status = "active";
+  dto->loginCount = 318;
+  dto->score = 0.97;
+  dto->note = nullptr;
+  dto->flags = 5;
+  dto->last = createMyDto();
+  return dto;
+}
+
+template<class Wrapper>
+void measure(const char* name,
+             const Wrapper& dto,
+             const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& runtime,
+             const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& generated,
+             v_int64 iterations)
+{
+
+  auto json = runtime->writeToString(dto);
+  OATPP_ASSERT(generated->writeToString(dto) == json);
+
+  oatpp::data::stream::BufferOutputStream stream;
+
+  auto serialize = [&stream, &dto, iterations](const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& mapper) {
+    auto start = std::chrono::steady_clock::now();
+    for(v_int64 i = 0; i < iterations; i ++) {
+      stream.setCurrentPosition(0);
+      mapper->write(&stream, dto);
+    }
+    return std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(std::chrono::steady_clock::now() - start).count() / iterations;
+  };
+
+  auto deserialize = [&json, iterations](const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& mapper) {
+    auto start = std::chrono::steady_clock::now();
+    for(v_int64 i = 0; i < iterations; i ++) {
+      auto result = mapper->readFromString<Wrapper>(json);
+      OATPP_ASSERT(result);
+    }
+    return std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(std::chrono::steady_clock::now() - start).count() / iterations;
+  };
+
+  auto runtimeWrite = serialize(runtime);
+  auto generatedWrite = serialize(generated);
+  auto runtimeRead = deserialize(runtime);
+  auto generatedRead = deserialize(generated);
+
+  OATPP_LOGI("DtoSerializerBenchmark", "%-8s write ns/object runtime=%.1f static=%.1f | read ns/object runtime=%.1f static=%.1f",
+             name, runtimeWrite, generatedWrite, runtimeRead, generatedRead);
+
+}
+
+}
+
+void DtoSerializerBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "iterations=%lld", (long long) m_iterations);
+
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> runtime = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  auto staticMapper = StaticJsonObjectMapper::createShared();
+  staticMapper->registerDto<MyDto>();
+  staticMapper->registerDto<WideDto>();
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> generated = staticMapper;
+
+  measure("MyDto", createMyDto(), runtime, generated, m_iterations);
+  measure("WideDto", createWideDto(), runtime, generated, m_iterations / 4);
+
+}
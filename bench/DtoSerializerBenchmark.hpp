@@ -0,0 +1,24 @@
+#ifndef DtoSerializerBenchmark_hpp
+#define DtoSerializerBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * ns/object of serializing and deserializing `MyDto` and a 20-field DTO with the runtime (reflection) JSON mapper
+ * and with &l:StaticJsonObjectMapper;.
+ */
+class DtoSerializerBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int64 m_iterations;
+public:
+
+  DtoSerializerBenchmark(v_int64 iterations = 1000000)
+    : UnitTest("BENCH[DtoSerializerBenchmark]")
+    , m_iterations(iterations)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // DtoSerializerBenchmark_hpp
@@ -0,0 +1,153 @@
+#include "FileServingBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "controller/MyController.hpp"
+#include "handler/ParkingConnectionHandler.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr v_int64 RANGE_SIZE = 1024 * 1024;
+
+/**
+ * User + system CPU time of the process so far.
+ */
+double cpuSeconds() {
+  rusage usage;
+  ::getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+void createAsset(const std::string& path, v_int64 size) {
+  std::string block(64 * 1024, 'x');
+  auto file = std::fopen(path.c_str(), "wb");
+  OATPP_ASSERT(file != nullptr);
+  for(v_int64 written = 0; written < size; written += (v_int64) block.size()) {
+    std::fwrite(block.data(), 1, (size_t) std::min<v_int64>(size - written, (v_int64) block.size()), file);
+  }
+  std::fclose(file);
+}
+
+void run(const char* name,
+         const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler,
+         const std::string& path,
+         const std::string& range,
+         v_int64 responseSize,
+         v_int32 clientThreads,
+         const std::chrono::milliseconds& duration)
+{
+
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  std::atomic<v_int64> served(0);
+  std::atomic<v_int64> failed(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  auto extraHeaders = range.empty() ? std::string() : "Range: " + range + "\r\n";
+  auto expectedStatus = range.empty() ? 200 : 206;
+
+  auto cpuBefore = cpuSeconds();
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, &path, &extraHeaders, expectedStatus, &served, &failed, &clientsShouldContinue] {
+      std::unique_ptr<LoopbackClient> client(new LoopbackClient(port));
+      while(clientsShouldContinue) {
+        if(client->request(path.c_str(), extraHeaders) == expectedStatus) {
+          served ++;
+        } else {
+          failed ++;
+        }
+        if(!client->isConnected()) {
+          client.reset(new LoopbackClient(port));
+        }
+      }
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  auto cpu = cpuSeconds() - cpuBefore;
+
+  lifecycle.stop();
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+  auto gib = (double) served.load() * responseSize / (1024.0 * 1024.0 * 1024.0);
+
+  OATPP_LOGI("FileServingBenchmark", "%-24s %-14s req/s=%.1f MiB/s=%.1f failed=%lld cpu s/GiB=%.3f",
+             name, range.empty() ? "whole file" : range.c_str(), served / seconds, gib * 1024.0 / seconds,
+             (long long) failed.load(), gib > 0 ? cpu / gib : -1.0);
+
+}
+
+}
+
+void FileServingBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "client threads=%d, duration=%lldms", m_clientThreads, (long long) m_duration.count());
+
+  char directoryTemplate[] = "/tmp/file-serving-bench-XXXXXX";
+  OATPP_ASSERT(::mkdtemp(directoryTemplate) != nullptr);
+  std::string directory = directoryTemplate;
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper, directory));
+
+  ParkingConnectionHandler::Config config;
+  config.workersCount = m_clientThreads;
+  config.idleTimeout = std::chrono::seconds(60);
+
+  struct Asset {
+    const char* name;
+    v_int64 size;
+  };
+
+  for(const Asset& asset : {Asset{"64k.bin", 64 * 1024}, Asset{"16m.bin", 16 * 1024 * 1024}}) {
+
+    createAsset(directory + "/" + asset.name, asset.size);
+    auto path = std::string("/assets/") + asset.name;
+
+    /* Whole file, then a range from the middle of it */
+    std::vector<std::pair<std::string, v_int64>> requests = {{"", asset.size}};
+    if(asset.size > RANGE_SIZE) {
+      auto first = asset.size / 2;
+      requests.push_back({"bytes=" + std::to_string(first) + "-" + std::to_string(first + RANGE_SIZE - 1), RANGE_SIZE});
+    }
+
+    for(auto& request : requests) {
+      run("HttpConnectionHandler", oatpp::web::server::HttpConnectionHandler::createShared(router),
+          path, request.first, request.second, m_clientThreads, m_duration);
+      run("ParkingConnectionHandler", ParkingConnectionHandler::createShared(router, config),
+          path, request.first, request.second, m_clientThreads, m_duration);
+    }
+
+    std::remove((directory + "/" + asset.name).c_str());
+
+  }
+
+  ::rmdir(directory.c_str());
+
+}
@@ -0,0 +1,29 @@
+#ifndef FileServingBenchmark_hpp
+#define FileServingBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Serves `GET /assets/{name}` of &l:MyController; with `HttpConnectionHandler` - the body is read into user space and
+ * written through the buffer - and with &l:ParkingConnectionHandler;, which sends the &l:FileBody; with `sendfile`.
+ * Reports throughput and CPU time of the process per GiB served (the loopback clients included - they are the same
+ * for both handlers), for whole files and for 1 MiB ranges.
+ */
+class FileServingBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_clientThreads;
+  std::chrono::milliseconds m_duration;
+public:
+
+  FileServingBenchmark(v_int32 clientThreads = 4,
+                       const std::chrono::milliseconds& duration = std::chrono::seconds(3))
+    : UnitTest("BENCH[FileServingBenchmark]")
+    , m_clientThreads(clientThreads)
+    , m_duration(duration)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // FileServingBenchmark_hpp
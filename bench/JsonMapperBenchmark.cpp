@@ -0,0 +1,82 @@
+#include "JsonMapperBenchmark.hpp"
+
+#include "dto/DTOs.hpp"
+#include "mapping/SimdObjectMapper.hpp"
+
+namespace {
+
+oatpp::String createPayload(v_int32 dtosCount, v_int32 messageLength, bool escapes) {
+
+  auto list = oatpp::List<oatpp::Object<MyDto>>::createShared();
+  for(v_int32 i = 0; i < dtosCount; i ++) {
+    std::string message;
+    for(v_int32 j = 0; j < messageLength; j ++) {
+      /* every 64th character needs an escape */
+      message += (escapes && j % 64 == 63) ? '"' : (char) ('a' + (i + j) % 26);
+    }
+    auto dto = MyDto::createShared();
+    dto->statusCode = i;
+    dto->message = message;
+    list->push_back(dto);
+  }
+
+  return oatpp::parser::json::mapping::ObjectMapper::createShared()->writeToString(list);
+
+}
+
+/* MB/s of parsing the payload over and over for the duration */
+double measure(const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& mapper,
+               const oatpp::String& payload,
+               const std::chrono::milliseconds& duration)
+{
+
+  v_int64 parsed = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::steady_clock::duration::zero();
+
+  while(elapsed < duration) {
+    for(v_int32 i = 0; i < 10; i ++) {
+      auto list = mapper->readFromString<oatpp::List<oatpp::Object<MyDto>>>(payload);
+      OATPP_ASSERT(list);
+      parsed ++;
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+  }
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+  return parsed * payload->size() / seconds / (1024 * 1024);
+
+}
+
+}
+
+void JsonMapperBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "dtos=%d, duration=%lldms, level=%s", m_dtosCount, (long long) m_duration.count(),
+             SimdObjectMapper::getLevelName(SimdObjectMapper::getLevel()));
+
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> stock = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> simd = SimdObjectMapper::createShared();
+
+  struct Case {
+    const char* name;
+    v_int32 messageLength;
+    bool escapes;
+  };
+
+  const Case cases[] = {
+    {"message=16", 16, false},
+    {"message=128", 128, false},
+    {"message=1024", 1024, false},
+    {"message=1024 escaped", 1024, true}
+  };
+
+  for(auto& c : cases) {
+    auto payload = createPayload(m_dtosCount, c.messageLength, c.escapes);
+    auto stockRate = measure(stock, payload, m_duration);
+    auto simdRate = measure(simd, payload, m_duration);
+    OATPP_LOGI(TAG, "%-22s payload=%lldB stock MB/s=%.1f simd MB/s=%.1f speedup=%.2fx",
+               c.name, (long long) payload->size(), stockRate, simdRate, simdRate / stockRate);
+  }
+
+}
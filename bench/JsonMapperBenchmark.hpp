@@ -0,0 +1,27 @@
+#ifndef JsonMapperBenchmark_hpp
+#define JsonMapperBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Deserialization throughput of the stock JSON ObjectMapper against &l:SimdObjectMapper; on lists of `MyDto`
+ * with short, medium and long messages, with and without escapes.
+ */
+class JsonMapperBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_dtosCount;
+  std::chrono::milliseconds m_duration;
+public:
+
+  JsonMapperBenchmark(v_int32 dtosCount = 1000,
+                      const std::chrono::milliseconds& duration = std::chrono::seconds(2))
+    : UnitTest("BENCH[JsonMapperBenchmark]")
+    , m_dtosCount(dtosCount)
+    , m_duration(duration)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // JsonMapperBenchmark_hpp
@@ -0,0 +1,130 @@
+#include "LoadBenchmark.hpp"
+#include "LoadGenerator.hpp"
+
+#include "app/TestComponent.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+oatpp::Object<LoadRunDto> runTransport(const char* transport,
+                                       const std::shared_ptr<oatpp::network::ServerConnectionProvider>& serverConnectionProvider,
+                                       const std::shared_ptr<oatpp::network::ClientConnectionProvider>& clientConnectionProvider,
+                                       const std::shared_ptr<oatpp::web::server::HttpRouter>& router,
+                                       const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper,
+                                       const LoadGenerator::Config& config)
+{
+
+  ServerLifecycle lifecycle(serverConnectionProvider, oatpp::web::server::HttpConnectionHandler::createShared(router));
+  lifecycle.start();
+
+  LoadGenerator generator(clientConnectionProvider, objectMapper);
+  auto result = generator.run(config);
+  result->transport = transport;
+
+  lifecycle.stop();
+
+  OATPP_LOGI("LoadBenchmark", "%-7s concurrency=%-3d keep-alive=%d req/s=%.1f p50=%lldus p99=%lldus p999=%lldus failures=%lld rss=%lldkB",
+             transport, *result->concurrency, (int) *result->keepAlive, *result->throughput,
+             (long long) *result->p50, (long long) *result->p99, (long long) *result->p999,
+             (long long) *result->failures, (long long) *result->rssKb);
+
+  return result;
+
+}
+
+}
+
+void LoadBenchmark::applyEnvironment() {
+
+  if(const char* value = std::getenv("LOAD_BENCH_CONCURRENCY")) {
+    m_concurrency.clear();
+    std::stringstream stream(value);
+    std::string item;
+    while(std::getline(stream, item, ',')) {
+      auto concurrency = std::atoi(item.c_str());
+      if(concurrency > 0) {
+        m_concurrency.push_back(concurrency);
+      }
+    }
+  }
+
+  if(const char* value = std::getenv("LOAD_BENCH_REQUESTS")) {
+    m_requestsPerClient = std::atoll(value);
+  }
+
+  if(const char* value = std::getenv("LOAD_BENCH_KEEP_ALIVE")) {
+    std::string keepAlive(value);
+    if(keepAlive == "on") {
+      m_keepAlive = {true};
+    } else if(keepAlive == "off") {
+      m_keepAlive = {false};
+    } else {
+      m_keepAlive = {true, false};
+    }
+  }
+
+  if(const char* value = std::getenv("LOAD_BENCH_OUTPUT")) {
+    m_outputPath = value;
+  }
+
+}
+
+void LoadBenchmark::onRun() {
+
+  applyEnvironment();
+
+  /* Virtual interface and ObjectMapper of the tests */
+  TestComponent component;
+
+  OATPP_COMPONENT(std::shared_ptr<oatpp::network::virtual_::Interface>, virtualInterface);
+  OATPP_COMPONENT(std::shared_ptr<oatpp::data::mapping::ObjectMapper>, objectMapper);
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  auto report = LoadReportDto::createShared();
+  report->benchmark = "LoadBenchmark";
+
+  for(auto keepAlive : m_keepAlive) {
+    for(auto concurrency : m_concurrency) {
+
+      LoadGenerator::Config config = {concurrency, m_requestsPerClient, keepAlive};
+
+      report->runs->push_back(runTransport("virtual",
+                                           oatpp::network::virtual_::server::ConnectionProvider::createShared(virtualInterface),
+                                           oatpp::network::virtual_::client::ConnectionProvider::createShared(virtualInterface),
+                                           router, objectMapper, config));
+
+      auto tcpProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+      auto port = tcpProvider->getPort();
+      report->runs->push_back(runTransport("tcp",
+                                           tcpProvider,
+                                           oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port}),
+                                           router, objectMapper, config));
+
+    }
+  }
+
+  auto jsonMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  jsonMapper->getSerializer()->getConfig()->useBeautifier = true;
+  auto json = jsonMapper->writeToString(report);
+
+  std::ofstream output(m_outputPath);
+  output << *json << "\n";
+
+  if(output) {
+    OATPP_LOGI(TAG, "Report written to '%s'", m_outputPath.c_str());
+  } else {
+    OATPP_LOGE(TAG, "Can't write report to '%s'", m_outputPath.c_str());
+  }
+
+}
@@ -0,0 +1,44 @@
+#ifndef LoadBenchmark_hpp
+#define LoadBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+#include <vector>
+
+/**
+ * Load test of the server used by all stop examples (`HttpConnectionHandler` + MyController run by &l:ServerLifecycle;).
+ * Runs &l:LoadGenerator; over the virtual interface of `TestComponent` and over loopback TCP for every
+ * concurrency and keep-alive setting, and writes throughput, p50/p99/p999 latency and RSS as JSON.
+ *
+ * Settings can be overridden with environment variables:
+ * - `LOAD_BENCH_CONCURRENCY` - comma separated list of client thread counts, e.g. `1,8,32`.
+ * - `LOAD_BENCH_REQUESTS` - requests per client thread.
+ * - `LOAD_BENCH_KEEP_ALIVE` - `on`, `off` or `both`.
+ * - `LOAD_BENCH_OUTPUT` - path of the JSON report.
+ */
+class LoadBenchmark : public oatpp::test::UnitTest {
+private:
+  std::vector<v_int32> m_concurrency;
+  v_int64 m_requestsPerClient;
+  std::vector<bool> m_keepAlive;
+  std::string m_outputPath;
+private:
+  void applyEnvironment();
+public:
+
+  LoadBenchmark(const std::vector<v_int32>& concurrency = {1, 8, 32},
+                v_int64 requestsPerClient = 2000,
+                const std::vector<bool>& keepAlive = {true, false},
+                const std::string& outputPath = "load-bench.json")
+    : UnitTest("BENCH[LoadBenchmark]")
+    , m_concurrency(concurrency)
+    , m_requestsPerClient(requestsPerClient)
+    , m_keepAlive(keepAlive)
+    , m_outputPath(outputPath)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // LoadBenchmark_hpp
@@ -0,0 +1,141 @@
+#include "LoadGenerator.hpp"
+
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+
+v_int64 percentile(const std::vector<v_int64>& sorted, double p) {
+  if(sorted.empty()) {
+    return 0;
+  }
+  auto rank = (size_t) std::ceil(p * sorted.size());
+  return sorted[std::min(sorted.size(), std::max<size_t>(rank, 1)) - 1];
+}
+
+}
+
+LoadGenerator::LoadGenerator(const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider,
+                             const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper)
+  : m_connectionProvider(connectionProvider)
+  , m_objectMapper(objectMapper)
+{}
+
+oatpp::Object<LoadRunDto> LoadGenerator::run(const Config& config) {
+
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(m_connectionProvider);
+  auto client = MyApiTestClient::createShared(requestExecutor, m_objectMapper);
+
+  std::vector<std::vector<v_int64>> latencies(config.concurrency);
+  std::vector<v_int64> failures(config.concurrency, 0);
+
+  auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for(v_int32 i = 0; i < config.concurrency; i ++) {
+
+    threads.push_back(std::thread([&config, &client, &latencies, &failures, i] {
+
+      auto& threadLatencies = latencies[i];
+      threadLatencies.reserve(config.requestsPerClient);
+
+      std::shared_ptr<oatpp::web::client::RequestExecutor::ConnectionHandle> connection;
+
+      for(v_int64 r = 0; r < config.requestsPerClient; r ++) {
+
+        auto requestStart = std::chrono::steady_clock::now();
+
+        try {
+
+          if(config.keepAlive && !connection) {
+            connection = client->getConnection();
+          }
+
+          auto response = client->getRoot(connection);
+          auto body = response->readBodyToString();
+
+          if(response->getStatusCode() != 200 || !body) {
+            failures[i] ++;
+            connection = nullptr;
+            continue;
+          }
+
+        } catch (const std::exception&) {
+          failures[i] ++;
+          connection = nullptr;
+          continue;
+        }
+
+        threadLatencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - requestStart).count());
+
+      }
+
+    }));
+
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+
+  std::vector<v_int64> all;
+  v_int64 failed = 0;
+  for(v_int32 i = 0; i < config.concurrency; i ++) {
+    all.insert(all.end(), latencies[i].begin(), latencies[i].end());
+    failed += failures[i];
+  }
+  std::sort(all.begin(), all.end());
+
+  auto result = LoadRunDto::createShared();
+  result->concurrency = config.concurrency;
+  result->requestsPerClient = config.requestsPerClient;
+  result->keepAlive = config.keepAlive;
+  result->requests = (v_int64) all.size();
+  result->failures = failed;
+  result->seconds = seconds;
+  result->throughput = seconds > 0 ? all.size() / seconds : 0;
+  result->p50 = percentile(all, 0.5);
+  result->p99 = percentile(all, 0.99);
+  result->p999 = percentile(all, 0.999);
+  result->max = all.empty() ? 0 : all.back();
+  result->rssKb = getRssKb();
+  result->peakRssKb = getPeakRssKb();
+  return result;
+
+}
+
+v_int64 LoadGenerator::getRssKb() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while(std::getline(status, line)) {
+    if(line.compare(0, 6, "VmRSS:") == 0) {
+      return std::stoll(line.substr(6));
+    }
+  }
+  return 0;
+}
+
+v_int64 LoadGenerator::getPeakRssKb() {
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+  return usage.ru_maxrss;
+#endif
+}
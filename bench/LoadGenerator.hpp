@@ -0,0 +1,72 @@
+#ifndef LoadGenerator_hpp
+#define LoadGenerator_hpp
+
+#include "LoadReportDto.hpp"
+
+#include "oatpp/network/ConnectionProvider.hpp"
+#include "oatpp/core/data/mapping/ObjectMapper.hpp"
+
+/**
+ * Drives a server with `MyApiTestClient` from several client threads and measures every `GET /`.
+ * Works over any client connection provider - virtual interface or TCP.
+ */
+class LoadGenerator {
+public:
+
+  /**
+   * Load settings.
+   */
+  struct Config {
+
+    /**
+     * Number of client threads.
+     */
+    v_int32 concurrency;
+
+    /**
+     * Requests sent by each client thread.
+     */
+    v_int64 requestsPerClient;
+
+    /**
+     * Reuse one connection per client thread. Otherwise every request opens a new connection.
+     */
+    bool keepAlive;
+
+  };
+
+private:
+  std::shared_ptr<oatpp::network::ClientConnectionProvider> m_connectionProvider;
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> m_objectMapper;
+public:
+
+  /**
+   * Constructor.
+   * @param connectionProvider - client connection provider of the transport under test.
+   * @param objectMapper - object mapper of the api client.
+   */
+  LoadGenerator(const std::shared_ptr<oatpp::network::ClientConnectionProvider>& connectionProvider,
+                const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper);
+
+  /**
+   * Run load and block until all clients are done.
+   * @param config - &l:LoadGenerator::Config;.
+   * @return - filled &l:LoadRunDto;. `transport` is left empty.
+   */
+  oatpp::Object<LoadRunDto> run(const Config& config);
+
+  /**
+   * Current resident set size of the process.
+   * @return - kilobytes, `0` if unknown.
+   */
+  static v_int64 getRssKb();
+
+  /**
+   * Peak resident set size of the process.
+   * @return - kilobytes, `0` if unknown.
+   */
+  static v_int64 getPeakRssKb();
+
+};
+
+#endif // LoadGenerator_hpp
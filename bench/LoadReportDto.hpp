@@ -0,0 +1,51 @@
+#ifndef LoadReportDto_hpp
+#define LoadReportDto_hpp
+
+#include "oatpp/core/macro/codegen.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * Result of one load run - one transport, concurrency and keep-alive setting.
+ * Latencies are in microseconds, memory in kilobytes.
+ */
+class LoadRunDto : public oatpp::DTO {
+
+  DTO_INIT(LoadRunDto, DTO)
+
+  DTO_FIELD(String, transport);
+  DTO_FIELD(Int32, concurrency);
+  DTO_FIELD(Int64, requestsPerClient);
+  DTO_FIELD(Boolean, keepAlive);
+
+  DTO_FIELD(Int64, requests);
+  DTO_FIELD(Int64, failures);
+  DTO_FIELD(Float64, seconds);
+  DTO_FIELD(Float64, throughput);
+
+  DTO_FIELD(Int64, p50);
+  DTO_FIELD(Int64, p99);
+  DTO_FIELD(Int64, p999);
+  DTO_FIELD(Int64, max);
+
+  DTO_FIELD(Int64, rssKb);
+  DTO_FIELD(Int64, peakRssKb);
+
+};
+
+/**
+ * Machine-readable report of a whole benchmark.
+ */
+class LoadReportDto : public oatpp::DTO {
+
+  DTO_INIT(LoadReportDto, DTO)
+
+  DTO_FIELD(String, benchmark);
+  DTO_FIELD(List<Object<LoadRunDto>>, runs) = {};
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#endif // LoadReportDto_hpp
@@ -0,0 +1,277 @@
+#include "LoopbackClient.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+int connectLoopback(v_uint16 port) {
+
+  int handle = ::socket(AF_INET, SOCK_STREAM, 0);
+  if(handle < 0) {
+    return -1;
+  }
+
+  sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+  if(::connect(handle, (sockaddr*) &address, sizeof(address)) != 0) {
+    ::close(handle);
+    return -1;
+  }
+
+  return handle;
+
+}
+
+bool sendAll(int handle, const char* data, size_t size) {
+  while(size > 0) {
+    auto res = ::send(handle, data, size, MSG_NOSIGNAL);
+    if(res <= 0) {
+      return false;
+    }
+    data += res;
+    size -= (size_t) res;
+  }
+  return true;
+}
+
+}
+
+constexpr v_int32 LoopbackClient::ERROR_SEND;
+constexpr v_int32 LoopbackClient::ERROR_RESPONSE;
+
+bool LoopbackClient::requestOnce(v_uint16 port) {
+
+  int handle = connectLoopback(port);
+  if(handle < 0) {
+    return false;
+  }
+
+  static const char request[] = "GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+  if(!sendAll(handle, request, sizeof(request) - 1)) {
+    ::close(handle);
+    return false;
+  }
+
+  char buffer[1024];
+  v_int64 received = 0;
+  ssize_t res;
+  while((res = ::recv(handle, buffer, sizeof(buffer), 0)) > 0) {
+    received += res;
+  }
+
+  ::close(handle);
+  return received > 0;
+
+}
+
+LoopbackClient::LoopbackClient(v_uint16 port)
+  : m_handle(connectLoopback(port))
+  , m_receivedBytes(0)
+{}
+
+LoopbackClient::~LoopbackClient() {
+  close();
+}
+
+void LoopbackClient::close() {
+  if(m_handle >= 0) {
+    ::close(m_handle);
+    m_handle = -1;
+  }
+  m_buffer.clear();
+}
+
+bool LoopbackClient::receive() {
+  char chunk[4096];
+  auto res = ::recv(m_handle, chunk, sizeof(chunk), 0);
+  if(res <= 0) {
+    return false;
+  }
+  m_buffer.append(chunk, (size_t) res);
+  m_receivedBytes += res;
+  return true;
+}
+
+bool LoopbackClient::readChunkedBody(size_t bodyStart) {
+
+  /* "<hex size>\r\n<data>\r\n" ... "0\r\n\r\n" - data is skipped, only the framing is followed */
+  size_t pos = bodyStart;
+  while(true) {
+
+    size_t lineEnd;
+    while((lineEnd = m_buffer.find("\r\n", pos)) == std::string::npos) {
+      if(!receive()) {
+        return false;
+      }
+    }
+
+    auto size = (size_t) std::strtoull(m_buffer.c_str() + pos, nullptr, 16);
+    auto chunkEnd = lineEnd + 2 + size + 2; // the last chunk has no data, only the final CRLF
+    while(m_buffer.size() < chunkEnd) {
+      if(!receive()) {
+        return false;
+      }
+    }
+
+    /* Keep the buffer small - drop what was parsed */
+    m_buffer.erase(0, chunkEnd);
+    pos = 0;
+
+    if(size == 0) {
+      return true;
+    }
+
+  }
+
+}
+
+bool LoopbackClient::readResponse(v_int32& status) {
+
+  size_t headersEnd;
+
+  while((headersEnd = m_buffer.find("\r\n\r\n")) == std::string::npos) {
+    if(!receive()) {
+      return false;
+    }
+  }
+
+  /* "HTTP/1.1 200 OK" */
+  if(m_buffer.size() < 12 || m_buffer.compare(0, 5, "HTTP/") != 0) {
+    return false;
+  }
+  status = (v_int32) std::strtol(m_buffer.c_str() + 9, nullptr, 10);
+
+  std::string headers = m_buffer.substr(0, headersEnd + 2);
+  std::transform(headers.begin(), headers.end(), headers.begin(), [](char c) {
+    return (char) std::tolower((unsigned char) c);
+  });
+
+  if(headers.find("\r\ntransfer-encoding: chunked\r\n") != std::string::npos) {
+    if(!readChunkedBody(headersEnd + 4)) {
+      return false;
+    }
+    if(headers.find("\r\nconnection: close\r\n") != std::string::npos) {
+      close();
+    }
+    return true;
+  }
+
+  size_t contentLength = 0;
+  auto pos = headers.find("\r\ncontent-length:");
+  if(pos != std::string::npos) {
+    contentLength = (size_t) std::strtoull(headers.c_str() + pos + 17, nullptr, 10);
+  }
+
+  auto responseSize = headersEnd + 4 + contentLength;
+  if(m_buffer.size() >= responseSize) {
+    m_buffer.erase(0, responseSize);
+  } else {
+    /* Rest of the body is discarded as it arrives - never read past it, the next response may follow */
+    static thread_local char body[64 * 1024];
+    auto left = responseSize - m_buffer.size();
+    m_buffer.clear();
+    while(left > 0) {
+      auto res = ::recv(m_handle, body, std::min(left, sizeof(body)), 0);
+      if(res <= 0) {
+        return false;
+      }
+      m_receivedBytes += res;
+      left -= (size_t) res;
+    }
+  }
+
+  if(headers.find("\r\nconnection: close\r\n") != std::string::npos) {
+    close();
+  }
+
+  return true;
+
+}
+
+v_int32 LoopbackClient::request(const char* path, const std::string& extraHeaders) {
+
+  if(m_handle < 0) {
+    return ERROR_SEND;
+  }
+
+  std::string request = "GET ";
+  request += path;
+  request += " HTTP/1.1\r\nHost: localhost\r\n";
+  request += extraHeaders;
+  request += "\r\n";
+
+  if(!sendAll(m_handle, request.data(), request.size())) {
+    close();
+    return ERROR_SEND;
+  }
+
+  v_int32 status;
+  if(!readResponse(status)) {
+    close();
+    return ERROR_RESPONSE;
+  }
+
+  return status;
+
+}
+
+v_int32 LoopbackClient::pipeline(const char* path, v_int32 depth) {
+
+  if(m_handle < 0) {
+    return ERROR_SEND;
+  }
+
+  std::string request = "GET ";
+  request += path;
+  request += " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+
+  std::string requests;
+  requests.reserve(request.size() * (size_t) depth);
+  for(v_int32 i = 0; i < depth; i ++) {
+    requests += request;
+  }
+
+  if(!sendAll(m_handle, requests.data(), requests.size())) {
+    close();
+    return ERROR_SEND;
+  }
+
+  v_int32 ok = 0;
+  for(v_int32 i = 0; i < depth; i ++) {
+    v_int32 status;
+    if(!readResponse(status)) {
+      close();
+      return ERROR_RESPONSE;
+    }
+    if(status == 200) {
+      ok ++;
+    }
+  }
+
+  return ok;
+
+}
+
+bool LoopbackClient::isConnected() const {
+  return m_handle >= 0;
+}
+
+v_int64 LoopbackClient::getReceivedBytes() const {
+  return m_receivedBytes;
+}
@@ -0,0 +1,89 @@
+#ifndef LoopbackClient_hpp
+#define LoopbackClient_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <string>
+
+/**
+ * Minimal blocking HTTP client over raw loopback sockets.
+ * Used by benchmarks so that client-side overhead stays small and doesn't depend on the server under test.
+ */
+class LoopbackClient {
+public:
+
+  /**
+   * Returned by &l:LoopbackClient::request (); if the request couldn't be sent.
+   */
+  static constexpr v_int32 ERROR_SEND = -1;
+
+  /**
+   * Returned by &l:LoopbackClient::request (); if the request was sent but no complete response was received.
+   */
+  static constexpr v_int32 ERROR_RESPONSE = -2;
+
+private:
+  int m_handle;
+  std::string m_buffer;
+  v_int64 m_receivedBytes;
+private:
+  bool receive();
+  bool readChunkedBody(size_t bodyStart);
+  bool readResponse(v_int32& status);
+  void close();
+public:
+
+  /**
+   * Open a connection to `127.0.0.1:port`, send one `GET /` with `Connection: close` and read until the server closes.
+   * @param port
+   * @return - `true` if the server responded.
+   */
+  static bool requestOnce(v_uint16 port);
+
+public:
+
+  /**
+   * Open a keep-alive connection to `127.0.0.1:port`.
+   * @param port
+   */
+  LoopbackClient(v_uint16 port);
+
+  LoopbackClient(const LoopbackClient&) = delete;
+  LoopbackClient& operator=(const LoopbackClient&) = delete;
+
+  /**
+   * Non-virtual Destructor. Closes the connection.
+   */
+  ~LoopbackClient();
+
+  /**
+   * Send `GET` over the keep-alive connection and read the whole response (`Content-Length` or chunked).
+   * @param path - request path.
+   * @param extraHeaders - additional header lines, each terminated with `\r\n`.
+   * @return - response status code, `ERROR_SEND` or `ERROR_RESPONSE`. The connection is closed on error or `Connection: close`.
+   */
+  v_int32 request(const char* path = "/", const std::string& extraHeaders = "");
+
+  /**
+   * Send `depth` pipelined `GET`s in one write, then read all the responses.
+   * @param path - request path.
+   * @param depth - number of requests.
+   * @return - number of responses with status `200`, `ERROR_SEND` or `ERROR_RESPONSE`. The connection is closed on error.
+   */
+  v_int32 pipeline(const char* path, v_int32 depth);
+
+  /**
+   * Check if the connection is open.
+   * @return
+   */
+  bool isConnected() const;
+
+  /**
+   * Get bytes received over the connection - heads and bodies as they came over the wire.
+   * @return
+   */
+  v_int64 getReceivedBytes() const;
+
+};
+
+#endif // LoopbackClient_hpp
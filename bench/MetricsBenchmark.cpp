@@ -0,0 +1,98 @@
+#include "MetricsBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "metrics/RequestMetrics.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+double runRound(const std::shared_ptr<oatpp::web::server::HttpRouter>& router,
+                const std::shared_ptr<RequestMetrics>& metrics,
+                v_int32 clientThreads,
+                const std::chrono::milliseconds& duration)
+{
+
+  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  if(metrics) {
+    connectionHandler->addRequestInterceptor(std::make_shared<RequestMetrics::RequestInterceptor>(metrics));
+    connectionHandler->addResponseInterceptor(std::make_shared<RequestMetrics::ResponseInterceptor>(metrics));
+  }
+
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  std::atomic<v_int64> served(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, &served, &clientsShouldContinue] {
+      LoopbackClient client(port);
+      while(clientsShouldContinue && client.request("/") == 200) {
+        served ++;
+      }
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  lifecycle.stop();
+
+  return served / std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+
+}
+
+double median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  return values[values.size() / 2];
+}
+
+}
+
+void MetricsBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "client threads=%d, rounds=%d x %lldms", m_clientThreads, m_rounds, (long long) m_roundDuration.count());
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  auto metrics = RequestMetrics::createShared();
+
+  std::vector<double> plain;
+  std::vector<double> instrumented;
+
+  /* Alternate, so that drift of the machine affects both sides equally */
+  for(v_int32 i = 0; i < m_rounds; i ++) {
+    plain.push_back(runRound(router, nullptr, m_clientThreads, m_roundDuration));
+    instrumented.push_back(runRound(router, metrics, m_clientThreads, m_roundDuration));
+  }
+
+  auto plainRate = median(plain);
+  auto instrumentedRate = median(instrumented);
+  auto overhead = (plainRate - instrumentedRate) / plainRate * 100.0;
+
+  OATPP_LOGI(TAG, "without metrics req/s=%.1f, with metrics req/s=%.1f, overhead=%.2f%%", plainRate, instrumentedRate, overhead);
+
+  if(overhead > 1.0) {
+    OATPP_LOGW(TAG, "Overhead is above the 1%% budget");
+  }
+
+}
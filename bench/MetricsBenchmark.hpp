@@ -0,0 +1,31 @@
+#ifndef MetricsBenchmark_hpp
+#define MetricsBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Overhead of &l:RequestMetrics; on `GET /`.
+ * Runs the same server with and without the metrics interceptors in alternating rounds over keep-alive loopback
+ * connections and compares the median req/s. The budget is 1%.
+ */
+class MetricsBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_clientThreads;
+  std::chrono::milliseconds m_roundDuration;
+  v_int32 m_rounds;
+public:
+
+  MetricsBenchmark(v_int32 clientThreads = 8,
+                   const std::chrono::milliseconds& roundDuration = std::chrono::seconds(2),
+                   v_int32 rounds = 5)
+    : UnitTest("BENCH[MetricsBenchmark]")
+    , m_clientThreads(clientThreads)
+    , m_roundDuration(roundDuration)
+    , m_rounds(rounds)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // MetricsBenchmark_hpp
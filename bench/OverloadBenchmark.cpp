@@ -0,0 +1,111 @@
+#include "OverloadBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "AppComponent.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "limit/ConcurrencyLimiter.hpp"
+
+#include "app/SlowController.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr v_int64 BACKEND_CAPACITY = 4;
+constexpr v_int64 SERVICE_TIME_MS = 10;
+constexpr v_int64 GOOD_LATENCY_MICROS = 10 * SERVICE_TIME_MS * 1000;
+
+void run(bool limited, v_int32 clientsCount, const std::chrono::milliseconds& duration) {
+
+  AppComponent::Options options;
+  if(limited) {
+    options.limiter = std::make_shared<ConcurrencyLimiter::Config>();
+  }
+
+  AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE, options);
+  components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(
+    std::make_shared<SlowController>(BACKEND_CAPACITY, std::chrono::milliseconds(SERVICE_TIME_MS))
+  );
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  std::atomic<bool> clientsShouldContinue(true);
+  std::atomic<v_int64> good(0);
+  std::atomic<v_int64> shed(0);
+  std::atomic<v_int64> failed(0);
+  std::mutex latenciesMutex;
+  std::vector<v_int64> latencies;
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientsCount; i ++) {
+    clients.push_back(std::thread([port, &clientsShouldContinue, &good, &shed, &failed, &latenciesMutex, &latencies] {
+      std::vector<v_int64> served;
+      std::unique_ptr<LoopbackClient> client(new LoopbackClient(port));
+      while(clientsShouldContinue) {
+        auto start = std::chrono::steady_clock::now();
+        auto status = client->request("/slow");
+        auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        if(status == 200) {
+          served.push_back(micros);
+          good += micros <= GOOD_LATENCY_MICROS ? 1 : 0;
+        } else if(status == 503) {
+          shed ++;
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        } else {
+          failed ++;
+        }
+        if(!client->isConnected()) {
+          client.reset(new LoopbackClient(port));
+        }
+      }
+      std::lock_guard<std::mutex> lock(latenciesMutex);
+      latencies.insert(latencies.end(), served.begin(), served.end());
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  v_int32 limit = 0;
+  if(limited) {
+    limit = components.get<std::shared_ptr<ConcurrencyLimiter>>()->getLimit();
+  }
+
+  lifecycle.stop();
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) -> double {
+    return latencies.empty() ? 0 : latencies[(size_t) (p / 100 * (double) (latencies.size() - 1))] / 1000.0;
+  };
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+
+  OATPP_LOGI("OverloadBenchmark", "%-18s clients=%-3d served/s=%.1f goodput/s=%.1f shed/s=%.1f failed=%lld p50=%.1fms p99=%.1fms limit=%d",
+             limited ? "ConcurrencyLimiter" : "no limiter", clientsCount, latencies.size() / seconds, good / seconds,
+             shed / seconds, (long long) failed.load(), percentile(50), percentile(99), limit);
+
+}
+
+}
+
+void OverloadBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "backend capacity=%lld, service time=%lldms, duration=%lldms",
+             (long long) BACKEND_CAPACITY, (long long) SERVICE_TIME_MS, (long long) m_duration.count());
+
+  for(v_int32 clientsCount : {4, 16, 64}) {
+    run(false, clientsCount, m_duration);
+    run(true, clientsCount, m_duration);
+  }
+
+}
@@ -0,0 +1,26 @@
+#ifndef OverloadBenchmark_hpp
+#define OverloadBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Thread-per-connection server in front of a slow backend (`SlowController` - 4 at a time, 10ms each), with and
+ * without &l:ConcurrencyLimiter;, at and over the backend capacity. Closed-loop keep-alive clients back off 5ms after a
+ * `503`. Reports throughput, goodput (`200`s within 10x the service time), shed requests, latency of served requests
+ * and the limit at the end of the run.
+ */
+class OverloadBenchmark : public oatpp::test::UnitTest {
+private:
+  std::chrono::milliseconds m_duration;
+public:
+
+  OverloadBenchmark(const std::chrono::milliseconds& duration = std::chrono::seconds(3))
+    : UnitTest("BENCH[OverloadBenchmark]")
+    , m_duration(duration)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // OverloadBenchmark_hpp
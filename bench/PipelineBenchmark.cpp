@@ -0,0 +1,126 @@
+#include "PipelineBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "controller/MyController.hpp"
+#include "handler/ParkingConnectionHandler.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+/**
+ * Read + write syscalls of the process so far, from `/proc/self/io`.
+ * @return - number of syscalls or `-1` if not available.
+ */
+v_int64 countSyscalls() {
+  std::ifstream io("/proc/self/io");
+  std::string line;
+  v_int64 result = 0;
+  v_int32 found = 0;
+  while(std::getline(io, line)) {
+    if(line.compare(0, 6, "syscr:") == 0 || line.compare(0, 6, "syscw:") == 0) {
+      result += std::atoll(line.c_str() + 6);
+      found ++;
+    }
+  }
+  return found == 2 ? result : -1;
+}
+
+void run(const char* name,
+         const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler,
+         const std::shared_ptr<ParkingConnectionHandler>& parkingHandler,
+         v_int32 clientThreads,
+         v_int32 depth,
+         const std::chrono::milliseconds& duration)
+{
+
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  std::atomic<v_int64> served(0);
+  std::atomic<v_int64> failed(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  ParkingConnectionHandler::Stats statsBefore = {0, 0, 0, 0, 0};
+  if(parkingHandler) {
+    statsBefore = parkingHandler->getStats();
+  }
+  auto syscallsBefore = countSyscalls();
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, depth, &served, &failed, &clientsShouldContinue] {
+      std::unique_ptr<LoopbackClient> client(new LoopbackClient(port));
+      while(clientsShouldContinue) {
+        auto ok = client->pipeline("/", depth);
+        if(ok > 0) {
+          served += ok;
+        }
+        failed += ok >= 0 ? depth - ok : depth;
+        if(!client->isConnected()) {
+          client.reset(new LoopbackClient(port));
+        }
+      }
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  auto syscalls = countSyscalls();
+
+  lifecycle.stop();
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+  auto requests = std::max<v_int64>(served.load(), 1);
+
+  double syscallsPerRequest = syscalls >= 0 && syscallsBefore >= 0 ? (double) (syscalls - syscallsBefore) / requests : -1;
+  double serverWritesPerRequest = -1;
+  if(parkingHandler) {
+    auto stats = parkingHandler->getStats();
+    serverWritesPerRequest = (double) (stats.writes - statsBefore.writes) / std::max<v_int64>(stats.requests - statsBefore.requests, 1);
+  }
+
+  OATPP_LOGI("PipelineBenchmark", "%-24s depth=%-3d req/s=%.1f failed=%lld process syscalls/req=%.2f server writes/req=%.2f",
+             name, depth, served / seconds, (long long) failed.load(), syscallsPerRequest, serverWritesPerRequest);
+
+}
+
+}
+
+void PipelineBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "client threads=%d, depth=%d, duration=%lldms", m_clientThreads, m_depth, (long long) m_duration.count());
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  ParkingConnectionHandler::Config config;
+  config.workersCount = m_clientThreads;
+  config.idleTimeout = std::chrono::seconds(60);
+
+  for(v_int32 depth : {1, m_depth}) {
+    run("HttpConnectionHandler", oatpp::web::server::HttpConnectionHandler::createShared(router), nullptr,
+        m_clientThreads, depth, m_duration);
+    auto parkingHandler = ParkingConnectionHandler::createShared(router, config);
+    run("ParkingConnectionHandler", parkingHandler, parkingHandler, m_clientThreads, depth, m_duration);
+  }
+
+}
@@ -0,0 +1,32 @@
+#ifndef PipelineBenchmark_hpp
+#define PipelineBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Compares `HttpConnectionHandler` with &l:ParkingConnectionHandler;, which batches the responses of pipelined
+ * requests into one gather write - req/s and syscalls per request, with and without pipelining.
+ * Syscalls are counted for the whole process from `/proc/self/io` (the loopback clients included, they are the same
+ * for every handler); write syscalls of the server alone are reported by ParkingConnectionHandler.
+ */
+class PipelineBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_clientThreads;
+  v_int32 m_depth;
+  std::chrono::milliseconds m_duration;
+public:
+
+  PipelineBenchmark(v_int32 clientThreads = 8,
+                    v_int32 depth = 16,
+                    const std::chrono::milliseconds& duration = std::chrono::seconds(3))
+    : UnitTest("BENCH[PipelineBenchmark]")
+    , m_clientThreads(clientThreads)
+    , m_depth(depth)
+    , m_duration(duration)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // PipelineBenchmark_hpp
@@ -0,0 +1,95 @@
+#include "RouterBenchmark.hpp"
+
+#include "router/CompiledRouter.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+
+#include <chrono>
+#include <vector>
+
+namespace {
+
+class StubHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(oatpp::web::protocol::http::Status::CODE_200, "stub");
+  }
+};
+
+/**
+ * Time `iterations` calls of `lookup` over `paths`.
+ * @return - ns per lookup.
+ */
+template<class F>
+double measure(const std::vector<oatpp::data::share::StringKeyLabel>& paths, v_int64 iterations, F lookup) {
+
+  v_int64 found = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(v_int64 i = 0; i < iterations; i ++) {
+    found += lookup(paths[(size_t) (i % (v_int64) paths.size())]) ? 1 : 0;
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(std::chrono::steady_clock::now() - start);
+
+  OATPP_ASSERT(found == iterations);
+  return elapsed.count() / iterations;
+
+}
+
+}
+
+void RouterBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "iterations=%lld", (long long) m_iterations);
+
+  auto handler = std::make_shared<StubHandler>();
+  oatpp::data::share::StringKeyLabel method("GET");
+
+  for(v_int32 routesCount : {10, 100, 1000}) {
+
+    auto stock = oatpp::web::server::HttpRouter::createShared();
+    auto compiled = CompiledRouter::createShared();
+    std::vector<oatpp::data::share::StringKeyLabel> paths;
+
+    /* Three route shapes per resource: literal tail, one parameter, two parameters */
+    for(v_int32 i = 0; (v_int32) paths.size() < routesCount; i ++) {
+
+      auto resource = "/api/v1/resource" + std::to_string(i);
+      std::vector<std::pair<std::string, std::string>> routes = {
+        {resource + "/stats", resource + "/stats"},
+        {resource + "/{id}", resource + "/12345?fields=all"},
+        {resource + "/{id}/items/{item}", resource + "/12345/items/678"}
+      };
+
+      for(auto& route : routes) {
+        if((v_int32) paths.size() == routesCount) {
+          break;
+        }
+        stock->route("GET", route.first, handler);
+        compiled->route("GET", route.first, handler);
+        paths.push_back(oatpp::data::share::StringKeyLabel(oatpp::String(route.second)));
+      }
+
+    }
+
+    compiled->freeze();
+
+    auto stockNs = measure(paths, m_iterations, [&stock, &method](const oatpp::data::share::StringKeyLabel& path) {
+      return (bool) stock->getRoute(method, path);
+    });
+
+    auto findNs = measure(paths, m_iterations, [&compiled, &method](const oatpp::data::share::StringKeyLabel& path) {
+      return (bool) compiled->findRoute(method, path);
+    });
+
+    CompiledRouter::Captures captures;
+    auto lookupNs = measure(paths, m_iterations, [&compiled, &method, &captures](const oatpp::data::share::StringKeyLabel& path) {
+      return compiled->lookup(method, path, captures) != nullptr;
+    });
+
+    OATPP_LOGI("RouterBenchmark", "routes=%-5d HttpRouter::getRoute=%.1fns CompiledRouter::findRoute=%.1fns CompiledRouter::lookup=%.1fns",
+               routesCount, stockNs, findNs, lookupNs);
+
+  }
+
+}
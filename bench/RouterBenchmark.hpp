@@ -0,0 +1,25 @@
+#ifndef RouterBenchmark_hpp
+#define RouterBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Route lookup cost of the stock `HttpRouter` against &l:CompiledRouter; with 10, 100 and 1000 routes - ns per lookup
+ * for `getRoute()`, for `findRoute()` (same result type, MatchMap included) and for the allocation-free `lookup()`.
+ * Looked up paths cycle over all routes, with path parameters and a query.
+ */
+class RouterBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int64 m_iterations;
+public:
+
+  RouterBenchmark(v_int64 iterations = 1000000)
+    : UnitTest("BENCH[RouterBenchmark]")
+    , m_iterations(iterations)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // RouterBenchmark_hpp
@@ -0,0 +1,82 @@
+#include "ServerGroupBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerGroup.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace {
+
+void runGroup(v_int32 acceptorsCount, bool pinThreads, v_int32 clientThreads, const std::chrono::milliseconds& duration) {
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  /* All members share one router */
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  ServerGroup group({"127.0.0.1", 0, oatpp::network::Address::IP_4}, acceptorsCount, [router](v_int32) {
+    return oatpp::web::server::HttpConnectionHandler::createShared(router);
+  }, pinThreads);
+
+  group.start();
+
+  auto port = group.getPort();
+
+  std::atomic<v_int64> served(0);
+  std::atomic<v_int64> failed(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, &served, &failed, &clientsShouldContinue] {
+      while(clientsShouldContinue) {
+        if(LoopbackClient::requestOnce(port)) {
+          served ++;
+        } else {
+          failed ++;
+        }
+      }
+    }));
+  }
+
+  std::this_thread::sleep_for(duration);
+  clientsShouldContinue = false;
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  group.stop();
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+
+  OATPP_LOGI("ServerGroupBenchmark", "acceptors=%-3d pinned=%d accepts/s=%.1f served=%lld failed=%lld",
+             acceptorsCount, (int) pinThreads, served / seconds, (long long) served.load(), (long long) failed.load());
+
+}
+
+}
+
+void ServerGroupBenchmark::onRun() {
+
+  v_int32 cpusCount = std::max<v_int32>(1, (v_int32) std::thread::hardware_concurrency());
+
+  OATPP_LOGI(TAG, "client threads=%d, duration=%lldms, cpus=%d", m_clientThreads, (long long) m_duration.count(), cpusCount);
+
+  /* Single acceptor, same as StopSimple-exe */
+  runGroup(1, false, m_clientThreads, m_duration);
+
+  for(v_int32 acceptors = 2; acceptors <= cpusCount; acceptors *= 2) {
+    runGroup(acceptors, false, m_clientThreads, m_duration);
+  }
+
+  runGroup(cpusCount, true, m_clientThreads, m_duration);
+
+}
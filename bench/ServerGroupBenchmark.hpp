@@ -0,0 +1,26 @@
+#ifndef ServerGroupBenchmark_hpp
+#define ServerGroupBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Measures connections accepted and served per second by a &l:ServerGroup; with a growing number of acceptors.
+ * One acceptor is the single accept loop of the "StopSimple" example.
+ */
+class ServerGroupBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_clientThreads;
+  std::chrono::milliseconds m_duration;
+public:
+
+  ServerGroupBenchmark(v_int32 clientThreads = 16, const std::chrono::milliseconds& duration = std::chrono::seconds(5))
+    : UnitTest("BENCH[ServerGroupBenchmark]")
+    , m_clientThreads(clientThreads)
+    , m_duration(duration)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // ServerGroupBenchmark_hpp
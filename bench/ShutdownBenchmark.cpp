@@ -0,0 +1,432 @@
+#include "ShutdownBenchmark.hpp"
+#include "LoopbackClient.hpp"
+#include "ShutdownReportDto.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/DrainingConnectionHandler.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <future>
+#include <vector>
+
+#include OATPP_CODEGEN_BEGIN(ApiController)
+
+/**
+ * Endpoint which takes a while, so that requests are in flight when stop is requested.
+ */
+class SlowController : public oatpp::web::server::api::ApiController {
+private:
+  std::chrono::milliseconds m_delay;
+public:
+
+  SlowController(const std::shared_ptr<ObjectMapper>& objectMapper, const std::chrono::milliseconds& delay)
+    : oatpp::web::server::api::ApiController(objectMapper)
+    , m_delay(delay)
+  {}
+
+  ENDPOINT("GET", "/slow", slow) {
+    std::this_thread::sleep_for(m_delay);
+    return createResponse(Status::CODE_200, "slow");
+  }
+
+};
+
+#include OATPP_CODEGEN_END(ApiController)
+
+namespace {
+
+std::unique_ptr<AppComponent> createComponents(const std::chrono::milliseconds& delay,
+                                               const std::shared_ptr<ParkingConnectionHandler::Config>& parking = nullptr) {
+  AppComponent::Options options;
+  options.parking = parking;
+  std::unique_ptr<AppComponent> components(new AppComponent({"127.0.0.1", 0, oatpp::network::Address::IP_4},
+                                                            AppComponent::Scope::INSTANCE, options));
+  auto objectMapper = components->get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  auto router = components->get<std::shared_ptr<oatpp::web::server::HttpRouter>>();
+  router->addController(std::make_shared<MyController>(objectMapper));
+  router->addController(std::make_shared<SlowController>(objectMapper, delay));
+  return components;
+}
+
+v_uint16 getPort(const AppComponent& components) {
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  return std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+}
+
+std::shared_ptr<DrainingConnectionHandler> createDrainingHandler(const AppComponent& components) {
+  auto connectionHandler = components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>();
+  return DrainingConnectionHandler::createShared(
+    std::static_pointer_cast<oatpp::web::server::HttpConnectionHandler>(connectionHandler), std::chrono::seconds(5)
+  );
+}
+
+/**
+ * Server started and stopped the way one of the examples does it.
+ */
+class Strategy {
+protected:
+  DrainingConnectionHandler::Report m_drainReport = {0, 0, std::chrono::microseconds(0)};
+public:
+
+  virtual ~Strategy() = default;
+
+  virtual const char* getName() const = 0;
+
+  /**
+   * Start serving.
+   * @return - port.
+   */
+  virtual v_uint16 start(const std::chrono::milliseconds& delay) = 0;
+
+  /**
+   * Request stop and block until the server is quiescent.
+   */
+  virtual void stop() = 0;
+
+  const DrainingConnectionHandler::Report& getDrainReport() const {
+    return m_drainReport;
+  }
+
+};
+
+/**
+ * App_StopSimple - components in the caller's scope, lifecycle.stop() with a draining handler.
+ */
+class StopSimpleStrategy : public Strategy {
+private:
+  std::unique_ptr<AppComponent> m_components;
+  std::shared_ptr<DrainingConnectionHandler> m_drainingHandler;
+  std::unique_ptr<ServerLifecycle> m_lifecycle;
+public:
+
+  const char* getName() const override {
+    return "StopSimple";
+  }
+
+  v_uint16 start(const std::chrono::milliseconds& delay) override {
+    m_components = createComponents(delay);
+    m_drainingHandler = createDrainingHandler(*m_components);
+    m_lifecycle.reset(new ServerLifecycle(m_components->get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>(),
+                                          m_drainingHandler));
+    m_lifecycle->start();
+    return getPort(*m_components);
+  }
+
+  void stop() override {
+    m_lifecycle->stop();
+    m_drainReport = m_drainingHandler->getReport();
+  }
+
+};
+
+/**
+ * App_StopByConditionCheck - components in the caller's scope, lifecycle.run() in a thread until the stop signal.
+ */
+class StopByConditionCheckStrategy : public Strategy {
+private:
+  std::unique_ptr<AppComponent> m_components;
+  std::shared_ptr<StopSignal> m_stopSignal;
+  std::unique_ptr<ServerLifecycle> m_lifecycle;
+  std::thread m_thread;
+public:
+
+  const char* getName() const override {
+    return "StopByConditionCheck";
+  }
+
+  v_uint16 start(const std::chrono::milliseconds& delay) override {
+    m_components = createComponents(delay);
+    m_stopSignal = std::make_shared<StopSignal>();
+    m_lifecycle.reset(new ServerLifecycle(m_components->get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>(),
+                                          m_components->get<std::shared_ptr<oatpp::network::ConnectionHandler>>(),
+                                          m_stopSignal));
+    m_thread = std::thread([this] {
+      m_lifecycle->run();
+    });
+    return getPort(*m_components);
+  }
+
+  void stop() override {
+    m_stopSignal->signal();
+    m_thread.join();
+  }
+
+};
+
+/**
+ * App_StopWithFullEnclosure, App_StopByConditionWithFullEnclosure and App_RunAndStopInFunctions -
+ * everything is created in the server thread, the caller only signals and joins.
+ * The Oat++ environment stays process-wide here, it can't be initialized once more per thread inside the benchmark.
+ */
+class FullEnclosureStrategy : public Strategy {
+private:
+  const char* m_name;
+  bool m_draining;
+  std::shared_ptr<StopSignal> m_stopSignal;
+  std::thread m_thread;
+public:
+
+  /**
+   * Constructor.
+   * @param name - name of the example.
+   * @param draining - wrap the handler in DrainingConnectionHandler and publish the lifecycle's stop signal from
+   * the thread (StopWithFullEnclosure), otherwise pass a stop signal created by the caller (ByCondition variants).
+   */
+  FullEnclosureStrategy(const char* name, bool draining)
+    : m_name(name)
+    , m_draining(draining)
+  {}
+
+  const char* getName() const override {
+    return m_name;
+  }
+
+  v_uint16 start(const std::chrono::milliseconds& delay) override {
+
+    if(!m_draining) {
+      m_stopSignal = std::make_shared<StopSignal>();
+    }
+
+    std::promise<v_uint16> started;
+    auto port = started.get_future();
+
+    m_thread = std::thread([this, delay, &started] {
+
+      auto components = createComponents(delay);
+      auto connectionProvider = components->get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+
+      std::shared_ptr<DrainingConnectionHandler> drainingHandler;
+      std::unique_ptr<ServerLifecycle> lifecycle;
+
+      if(m_draining) {
+        drainingHandler = createDrainingHandler(*components);
+        lifecycle.reset(new ServerLifecycle(connectionProvider, drainingHandler));
+        m_stopSignal = lifecycle->getStopSignal();
+      } else {
+        lifecycle.reset(new ServerLifecycle(connectionProvider,
+                                            components->get<std::shared_ptr<oatpp::network::ConnectionHandler>>(),
+                                            m_stopSignal));
+      }
+
+      /* Publish the port - this also releases the stop signal to the caller */
+      started.set_value(getPort(*components));
+
+      lifecycle->run();
+
+      if(drainingHandler) {
+        m_drainReport = drainingHandler->getReport();
+      }
+
+    });
+
+    return port.get();
+
+  }
+
+  void stop() override {
+    m_stopSignal->signal();
+    m_thread.join();
+  }
+
+};
+
+/**
+ * StopSimple with &l:ParkingConnectionHandler; - idle keep-alive connections parked in epoll instead of a thread each.
+ */
+class ParkingStrategy : public Strategy {
+private:
+  std::unique_ptr<AppComponent> m_components;
+  std::unique_ptr<ServerLifecycle> m_lifecycle;
+public:
+
+  const char* getName() const override {
+    return "StopSimple+ParkingConnectionHandler";
+  }
+
+  v_uint16 start(const std::chrono::milliseconds& delay) override {
+    auto parking = std::make_shared<ParkingConnectionHandler::Config>();
+    parking->workersCount = 32;
+    parking->idleTimeout = std::chrono::seconds(60);
+    m_components = createComponents(delay, parking);
+    m_lifecycle.reset(new ServerLifecycle(m_components->get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>(),
+                                          m_components->get<std::shared_ptr<oatpp::network::ConnectionHandler>>()));
+    m_lifecycle->start();
+    return getPort(*m_components);
+  }
+
+  void stop() override {
+    m_lifecycle->stop();
+  }
+
+};
+
+/**
+ * Threads of the process now, from `/proc/self/status`.
+ * @return - number of threads or `-1` if not available.
+ */
+v_int64 countThreads() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while(std::getline(status, line)) {
+    if(line.compare(0, 8, "Threads:") == 0) {
+      return std::atoll(line.c_str() + 8);
+    }
+  }
+  return -1;
+}
+
+v_int64 microsSince(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+oatpp::Object<ShutdownRunDto> measure(Strategy& strategy, v_int32 inFlight, v_int32 idle, const std::chrono::milliseconds& delay) {
+
+  auto port = strategy.start(delay);
+
+  std::atomic<v_int64> completed(0);
+  std::atomic<v_int64> lost(0);
+  std::atomic<bool> quiescent(false);
+
+  /* Idle keep-alive connections - one request each, then nothing */
+  std::vector<std::unique_ptr<LoopbackClient>> idleClients;
+  for(v_int32 i = 0; i < idle; i ++) {
+    std::unique_ptr<LoopbackClient> client(new LoopbackClient(port));
+    client->request("/");
+    idleClients.push_back(std::move(client));
+  }
+
+  /* In-flight connections - slow requests back to back until the server refuses to connect */
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < inFlight; i ++) {
+    clients.push_back(std::thread([port, &completed, &lost, &quiescent] {
+      std::unique_ptr<LoopbackClient> client(new LoopbackClient(port));
+      while(client->isConnected()) {
+        auto status = client->request("/slow");
+        if(status > 0) {
+          completed ++;
+        } else if(status == LoopbackClient::ERROR_RESPONSE) {
+          lost ++;
+        }
+        if(!client->isConnected() && !quiescent) {
+          client.reset(new LoopbackClient(port));
+        }
+      }
+    }));
+  }
+
+  /* Let every in-flight connection get a request running */
+  std::this_thread::sleep_for(delay * 2 + std::chrono::milliseconds(100));
+
+  auto threads = countThreads();
+  auto stopRequested = std::chrono::steady_clock::now();
+
+  /* The listener stopped accepting when a connect is refused. Probes are spaced to not flood the accept loop */
+  std::atomic<v_int64> acceptStoppedAfter(-1);
+  std::thread prober([port, stopRequested, &acceptStoppedAfter, &quiescent] {
+    while(!quiescent) {
+      LoopbackClient probe(port);
+      if(!probe.isConnected()) {
+        acceptStoppedAfter = microsSince(stopRequested);
+        return;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  });
+
+  strategy.stop();
+  auto quiescentAfter = microsSince(stopRequested);
+  quiescent = true;
+
+  prober.join();
+  for(auto& client : clients) {
+    client.join();
+  }
+  idleClients.clear();
+
+  auto result = ShutdownRunDto::createShared();
+  result->strategy = strategy.getName();
+  result->inFlightConnections = inFlight;
+  result->idleConnections = idle;
+  result->requestDelayMs = (v_int64) delay.count();
+  result->threads = threads;
+  result->acceptStoppedAfter = acceptStoppedAfter.load();
+  result->quiescentAfter = quiescentAfter;
+  result->completed = completed.load();
+  result->lost = lost.load();
+  result->drained = strategy.getDrainReport().drained;
+  result->aborted = strategy.getDrainReport().aborted;
+
+  OATPP_LOGI("ShutdownBenchmark", "%-36s threads=%lld accept-stop=%lldus quiescent=%lldus completed=%lld lost=%lld drained=%lld aborted=%lld",
+             strategy.getName(), (long long) *result->threads,
+             (long long) *result->acceptStoppedAfter, (long long) *result->quiescentAfter,
+             (long long) *result->completed, (long long) *result->lost,
+             (long long) *result->drained, (long long) *result->aborted);
+
+  return result;
+
+}
+
+}
+
+void ShutdownBenchmark::applyEnvironment() {
+
+  if(const char* value = std::getenv("SHUTDOWN_BENCH_IN_FLIGHT")) {
+    m_inFlight = std::atoi(value);
+  }
+
+  if(const char* value = std::getenv("SHUTDOWN_BENCH_IDLE")) {
+    m_idle = std::atoi(value);
+  }
+
+  if(const char* value = std::getenv("SHUTDOWN_BENCH_DELAY_MS")) {
+    m_delay = std::chrono::milliseconds(std::atoll(value));
+  }
+
+  if(const char* value = std::getenv("SHUTDOWN_BENCH_OUTPUT")) {
+    m_outputPath = value;
+  }
+
+}
+
+void ShutdownBenchmark::onRun() {
+
+  applyEnvironment();
+
+  OATPP_LOGI(TAG, "in-flight=%d, idle=%d, delay=%lldms", m_inFlight, m_idle, (long long) m_delay.count());
+
+  /* NoStop has no way to stop - its listener accepts until the process exits */
+  OATPP_LOGI(TAG, "NoStop skipped - no stop method");
+
+  std::vector<std::unique_ptr<Strategy>> strategies;
+  strategies.emplace_back(new StopSimpleStrategy());
+  strategies.emplace_back(new StopByConditionCheckStrategy());
+  strategies.emplace_back(new FullEnclosureStrategy("StopWithFullEnclosure", true));
+  strategies.emplace_back(new FullEnclosureStrategy("StopByConditionWithFullEnclosure", false));
+  strategies.emplace_back(new FullEnclosureStrategy("RunAndStopInFunctions", false));
+  strategies.emplace_back(new ParkingStrategy());
+
+  auto report = ShutdownReportDto::createShared();
+  report->benchmark = "ShutdownBenchmark";
+
+  for(auto& strategy : strategies) {
+    report->runs->push_back(measure(*strategy, m_inFlight, m_idle, m_delay));
+  }
+
+  auto jsonMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  jsonMapper->getSerializer()->getConfig()->useBeautifier = true;
+  auto json = jsonMapper->writeToString(report);
+
+  std::ofstream output(m_outputPath);
+  output << *json << "\n";
+
+  if(output) {
+    OATPP_LOGI(TAG, "Report written to '%s'", m_outputPath.c_str());
+  } else {
+    OATPP_LOGE(TAG, "Can't write report to '%s'", m_outputPath.c_str());
+  }
+
+}
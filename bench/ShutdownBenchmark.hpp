@@ -0,0 +1,45 @@
+#ifndef ShutdownBenchmark_hpp
+#define ShutdownBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Measures how each stop strategy of the examples behaves under load.
+ * Every strategy is started the way its `App_<example>.cpp` does it, loaded with in-flight requests to a slow
+ * endpoint and idle keep-alive connections, and stopped programmatically instead of by `std::cin.ignore()`.
+ * Records the time until the listener refuses connections, the time until the server is fully quiescent
+ * (stop call returned, server thread joined) and the number of requests sent which never got a response.
+ * The StopSimple setup is also measured with &l:ParkingConnectionHandler; - compare the thread counts.
+ *
+ * Settings can be overridden with environment variables:
+ * - `SHUTDOWN_BENCH_IN_FLIGHT` - connections sending requests to the slow endpoint back to back.
+ * - `SHUTDOWN_BENCH_IDLE` - idle keep-alive connections.
+ * - `SHUTDOWN_BENCH_DELAY_MS` - processing time of the slow endpoint.
+ * - `SHUTDOWN_BENCH_OUTPUT` - path of the JSON report.
+ */
+class ShutdownBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_inFlight;
+  v_int32 m_idle;
+  std::chrono::milliseconds m_delay;
+  std::string m_outputPath;
+private:
+  void applyEnvironment();
+public:
+
+  ShutdownBenchmark(v_int32 inFlight = 16,
+                    v_int32 idle = 64,
+                    const std::chrono::milliseconds& delay = std::chrono::milliseconds(100),
+                    const std::string& outputPath = "shutdown-bench.json")
+    : UnitTest("BENCH[ShutdownBenchmark]")
+    , m_inFlight(inFlight)
+    , m_idle(idle)
+    , m_delay(delay)
+    , m_outputPath(outputPath)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // ShutdownBenchmark_hpp
@@ -0,0 +1,48 @@
+#ifndef ShutdownReportDto_hpp
+#define ShutdownReportDto_hpp
+
+#include "oatpp/core/macro/codegen.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * Shutdown of one stop strategy under load. Times are in microseconds from the moment stop was requested.
+ * `threads` - threads of the process under load, right before stop.
+ */
+class ShutdownRunDto : public oatpp::DTO {
+
+  DTO_INIT(ShutdownRunDto, DTO)
+
+  DTO_FIELD(String, strategy);
+  DTO_FIELD(Int32, inFlightConnections);
+  DTO_FIELD(Int32, idleConnections);
+  DTO_FIELD(Int64, requestDelayMs);
+  DTO_FIELD(Int64, threads);
+
+  DTO_FIELD(Int64, acceptStoppedAfter);
+  DTO_FIELD(Int64, quiescentAfter);
+
+  DTO_FIELD(Int64, completed);
+  DTO_FIELD(Int64, lost);
+
+  DTO_FIELD(Int64, drained);
+  DTO_FIELD(Int64, aborted);
+
+};
+
+/**
+ * Machine-readable report of the shutdown benchmark.
+ */
+class ShutdownReportDto : public oatpp::DTO {
+
+  DTO_INIT(ShutdownReportDto, DTO)
+
+  DTO_FIELD(String, benchmark);
+  DTO_FIELD(List<Object<ShutdownRunDto>>, runs) = {};
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#endif // ShutdownReportDto_hpp
@@ -0,0 +1,114 @@
+#include "SocketOptionsBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "AppComponent.hpp"
+#include "config/ServerConfig.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef std::vector<std::pair<std::string, std::string>> Settings;
+
+/**
+ * Latency percentile.
+ * @param samples - sorted latencies, ns.
+ * @param percentile - `0..100`.
+ * @return - microseconds.
+ */
+double percentileUs(const std::vector<v_int64>& samples, double percentile) {
+  if(samples.empty()) {
+    return 0;
+  }
+  auto index = (size_t) (percentile / 100 * (double) (samples.size() - 1));
+  return samples[index] / 1000.0;
+}
+
+v_int64 elapsedNs(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void run(const char* name, const Settings& settings, v_int32 requests, v_int32 connections) {
+
+  ServerConfig config(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4));
+  for(auto& setting : settings) {
+    config.set(setting.first, setting.second);
+  }
+
+  AppComponent components(config, AppComponent::Scope::INSTANCE);
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(objectMapper));
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  v_int64 failures = 0;
+
+  /* Keep-alive requests, after a warm-up */
+  std::vector<v_int64> keepAlive;
+  keepAlive.reserve((size_t) requests);
+  {
+    LoopbackClient client(port);
+    for(v_int32 i = 0; i < requests / 10; i ++) {
+      client.request("/");
+    }
+    for(v_int32 i = 0; i < requests && client.isConnected(); i ++) {
+      auto start = std::chrono::steady_clock::now();
+      auto status = client.request("/");
+      keepAlive.push_back(elapsedNs(start));
+      failures += status == 200 ? 0 : 1;
+    }
+  }
+
+  /* A new connection per request */
+  std::vector<v_int64> connect;
+  connect.reserve((size_t) connections);
+  for(v_int32 i = 0; i < connections; i ++) {
+    auto start = std::chrono::steady_clock::now();
+    auto ok = LoopbackClient::requestOnce(port);
+    connect.push_back(elapsedNs(start));
+    failures += ok ? 0 : 1;
+  }
+
+  lifecycle.stop();
+
+  std::sort(keepAlive.begin(), keepAlive.end());
+  std::sort(connect.begin(), connect.end());
+
+  OATPP_LOGI("SocketOptionsBenchmark", "%-28s keep-alive p50=%.1fus p99=%.1fus  new connection p50=%.1fus p99=%.1fus  failures=%lld",
+             name, percentileUs(keepAlive, 50), percentileUs(keepAlive, 99),
+             percentileUs(connect, 50), percentileUs(connect, 99), (long long) failures);
+
+}
+
+}
+
+void SocketOptionsBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "keep-alive requests=%d, connections=%d", m_requests, m_connections);
+
+  std::vector<std::pair<const char*, Settings>> matrix = {
+    {"defaults", {}},
+    {"tcp_nodelay=0", {{"tcp_nodelay", "0"}}},
+    {"backlog=128", {{"backlog", "128"}}},
+    {"so_rcvbuf=so_sndbuf=16k", {{"so_rcvbuf", "16384"}, {"so_sndbuf", "16384"}}},
+    {"so_rcvbuf=so_sndbuf=1m", {{"so_rcvbuf", "1048576"}, {"so_sndbuf", "1048576"}}},
+    {"tcp_defer_accept=1", {{"tcp_defer_accept", "1"}}},
+    {"tcp_fastopen=256", {{"tcp_fastopen", "256"}}},
+    {"defer_accept+fastopen", {{"tcp_defer_accept", "1"}, {"tcp_fastopen", "256"}}}
+  };
+
+  for(auto& row : matrix) {
+    run(row.first, row.second, m_requests, m_connections);
+  }
+
+}
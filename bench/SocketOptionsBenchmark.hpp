@@ -0,0 +1,29 @@
+#ifndef SocketOptionsBenchmark_hpp
+#define SocketOptionsBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Small-response latency over loopback for each socket option of &l:ServerConfig; - defaults, one option at a time and
+ * the options together. Every row is an `AppComponent` built from the config, serving `GET /` of MyController.
+ * Reports p50/p99 of a request on a keep-alive connection and of a request on a new connection (connect, accept,
+ * request, close) - backlog, `TCP_DEFER_ACCEPT` and `TCP_FASTOPEN` only affect the latter.
+ * The loopback client doesn't send data in the SYN, so `TCP_FASTOPEN` shows the cost of enabling it, not the gain.
+ */
+class SocketOptionsBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_requests;
+  v_int32 m_connections;
+public:
+
+  SocketOptionsBenchmark(v_int32 requests = 20000, v_int32 connections = 2000)
+    : UnitTest("BENCH[SocketOptionsBenchmark]")
+    , m_requests(requests)
+    , m_connections(connections)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // SocketOptionsBenchmark_hpp
@@ -0,0 +1,157 @@
+#include "WarmUpBenchmark.hpp"
+#include "LoopbackClient.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr v_int32 REQUESTS_PER_CONNECTION = 8;
+
+/**
+ * Result of a run, sent from the child process over a pipe.
+ */
+struct Result {
+  v_int64 requests;
+  v_int64 failed;
+  v_int64 p50;
+  v_int64 p99;
+  v_int64 max;
+  v_int64 warmUpMicros;
+};
+
+Result measure(bool warm, bool pooled, v_int32 clientThreads, const std::chrono::milliseconds& duration) {
+
+  ServerConfig config(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4));
+  config.warmUp.enabled = warm;
+  config.warmUp.paths = {"/", "/items/100"};
+
+  AppComponent::Options options;
+  if(pooled) {
+    options.pool = std::make_shared<PooledConnectionHandler::Config>();
+  }
+
+  AppComponent components(config, AppComponent::Scope::INSTANCE, options);
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(objectMapper));
+
+  Result result;
+  result.warmUpMicros = components.warmUp().duration.count();
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  auto deadline = std::chrono::steady_clock::now() + duration;
+  std::atomic<v_int64> failed(0);
+  std::mutex latenciesMutex;
+  std::vector<v_int64> latencies;
+
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < clientThreads; i ++) {
+    clients.push_back(std::thread([port, deadline, &failed, &latenciesMutex, &latencies] {
+      std::vector<v_int64> measured;
+      v_int64 count = 0;
+      while(std::chrono::steady_clock::now() < deadline) {
+        /* Connecting is part of the latency - the server accepts and spawns for it */
+        auto start = std::chrono::steady_clock::now();
+        LoopbackClient client(port);
+        for(v_int32 j = 0; j < REQUESTS_PER_CONNECTION && client.isConnected(); j ++) {
+          auto status = client.request(count ++ % 2 == 0 ? "/" : "/items/100");
+          auto now = std::chrono::steady_clock::now();
+          if(status == 200) {
+            measured.push_back(std::chrono::duration_cast<std::chrono::microseconds>(now - start).count());
+          } else {
+            failed ++;
+          }
+          start = now;
+          if(now >= deadline) {
+            break;
+          }
+        }
+      }
+      std::lock_guard<std::mutex> lock(latenciesMutex);
+      latencies.insert(latencies.end(), measured.begin(), measured.end());
+    }));
+  }
+
+  for(auto& client : clients) {
+    client.join();
+  }
+
+  lifecycle.stop();
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) -> v_int64 {
+    return latencies.empty() ? 0 : latencies[(size_t) (p / 100 * (double) (latencies.size() - 1))];
+  };
+
+  result.requests = (v_int64) latencies.size();
+  result.failed = failed;
+  result.p50 = percentile(50);
+  result.p99 = percentile(99);
+  result.max = latencies.empty() ? 0 : latencies.back();
+  return result;
+
+}
+
+void run(bool warm, bool pooled, v_int32 clientThreads, const std::chrono::milliseconds& duration) {
+
+  int fds[2];
+  OATPP_ASSERT(::pipe(fds) == 0);
+
+  auto pid = ::fork();
+  OATPP_ASSERT(pid >= 0);
+
+  if(pid == 0) {
+    ::close(fds[0]);
+    auto result = measure(warm, pooled, clientThreads, duration);
+    auto written = ::write(fds[1], &result, sizeof(result));
+    /* No destructors of the parent's statics in the child */
+    ::_exit(written == (ssize_t) sizeof(result) ? 0 : 1);
+  }
+
+  ::close(fds[1]);
+  Result result;
+  auto res = ::read(fds[0], &result, sizeof(result));
+  ::close(fds[0]);
+
+  int status = 0;
+  ::waitpid(pid, &status, 0);
+  OATPP_ASSERT(res == (ssize_t) sizeof(result));
+  OATPP_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+  auto seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+
+  OATPP_LOGI("WarmUpBenchmark", "%-22s %-7s req/s=%.1f p50=%lldus p99=%lldus max=%lldus failed=%lld warm-up=%lldms",
+             pooled ? "PooledConnectionHandler" : "thread per connection", warm ? "warm" : "cold",
+             result.requests / seconds, (long long) result.p50, (long long) result.p99, (long long) result.max,
+             (long long) result.failed, (long long) result.warmUpMicros / 1000);
+
+}
+
+}
+
+void WarmUpBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "client threads=%d, first %lldms after start, reconnect every %d requests",
+             m_clientThreads, (long long) m_duration.count(), REQUESTS_PER_CONNECTION);
+
+  for(bool pooled : {false, true}) {
+    run(false, pooled, m_clientThreads, m_duration);
+    run(true, pooled, m_clientThreads, m_duration);
+  }
+
+}
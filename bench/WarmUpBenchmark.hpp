@@ -0,0 +1,31 @@
+#ifndef WarmUpBenchmark_hpp
+#define WarmUpBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Latency of the first second of a server - started right after its components are constructed, and started after
+ * &l:AppComponent::warmUp ();. Thread-per-connection and &l:PooledConnectionHandler;.
+ * Every run is a forked child of the benchmark process, so that no run finds the process warmed by the one before -
+ * the benchmark runs first, while the process has served nothing. Closed-loop clients alternate `GET /` and
+ * `GET /items/100` and reconnect every few requests, so that connections keep arriving.
+ * Reports p50/p99/max latency and throughput of the first second, and how long the warm-up took.
+ */
+class WarmUpBenchmark : public oatpp::test::UnitTest {
+private:
+  v_int32 m_clientThreads;
+  std::chrono::milliseconds m_duration;
+public:
+
+  WarmUpBenchmark(v_int32 clientThreads = 8,
+                  const std::chrono::milliseconds& duration = std::chrono::seconds(1))
+    : UnitTest("BENCH[WarmUpBenchmark]")
+    , m_clientThreads(clientThreads)
+    , m_duration(duration)
+  {}
+
+  void onRun() override;
+
+};
+
+#endif // WarmUpBenchmark_hpp
@@ -0,0 +1,56 @@
+
+#include "AcceptRateBenchmark.hpp"
+#include "ArenaBenchmark.hpp"
+#include "CachedResponseBenchmark.hpp"
+#include "CompressionBenchmark.hpp"
+#include "DtoSerializerBenchmark.hpp"
+#include "FileServingBenchmark.hpp"
+#include "JsonMapperBenchmark.hpp"
+#include "LoadBenchmark.hpp"
+#include "MetricsBenchmark.hpp"
+#include "OverloadBenchmark.hpp"
+#include "PipelineBenchmark.hpp"
+#include "RouterBenchmark.hpp"
+#include "ServerGroupBenchmark.hpp"
+#include "ShutdownBenchmark.hpp"
+#include "SocketOptionsBenchmark.hpp"
+#include "WarmUpBenchmark.hpp"
+
+#include <iostream>
+
+void runBenchmarks() {
+  /* First - its runs are forked from a process which hasn't served anything yet */
+  OATPP_RUN_TEST(WarmUpBenchmark);
+  OATPP_RUN_TEST(AcceptRateBenchmark);
+  OATPP_RUN_TEST(ServerGroupBenchmark);
+  OATPP_RUN_TEST(CachedResponseBenchmark);
+  OATPP_RUN_TEST(ArenaBenchmark);
+  OATPP_RUN_TEST(JsonMapperBenchmark);
+  OATPP_RUN_TEST(DtoSerializerBenchmark);
+  OATPP_RUN_TEST(LoadBenchmark);
+  OATPP_RUN_TEST(MetricsBenchmark);
+  OATPP_RUN_TEST(PipelineBenchmark);
+  OATPP_RUN_TEST(FileServingBenchmark);
+  OATPP_RUN_TEST(CompressionBenchmark);
+  OATPP_RUN_TEST(RouterBenchmark);
+  OATPP_RUN_TEST(SocketOptionsBenchmark);
+  OATPP_RUN_TEST(OverloadBenchmark);
+  OATPP_RUN_TEST(ShutdownBenchmark);
+}
+
+int main() {
+
+  oatpp::base::Environment::init();
+
+  runBenchmarks();
+
+  /* Print how much objects were created during app running, and what have left-probably leaked */
+  /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+  std::cout << "\nEnvironment:\n";
+  std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n\n";
+
+  oatpp::base::Environment::destroy();
+
+  return 0;
+}
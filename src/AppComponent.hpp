@@ -1,49 +1,343 @@
 #ifndef AppComponent_hpp
 #define AppComponent_hpp
 
-#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "component/ComponentRegistry.hpp"
+#include "compression/ResponseCompression.hpp"
+#include "config/ServerConfig.hpp"
+#include "handler/ParkingConnectionHandler.hpp"
+#include "handler/PooledConnectionHandler.hpp"
+#include "lifecycle/WarmUp.hpp"
+#include "limit/ConcurrencyLimiter.hpp"
+#include "mapping/SimdObjectMapper.hpp"
+#include "metrics/RequestMetrics.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+#include "router/CompiledRouter.hpp"
 
-#include "oatpp/network/tcp/server/ConnectionProvider.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
 
 #include "oatpp/parser/json/mapping/ObjectMapper.hpp"
 
 #include "oatpp/core/macro/component.hpp"
 
+#include <vector>
+
 /**
- *  Class which creates and holds Application components and registers components in oatpp::base::Environment
+ *  Class which creates and holds Application components.
+ *  Components live in the instance's ComponentRegistry. In GLOBAL scope they are also registered in
+ *  oatpp::base::Environment, so that OATPP_COMPONENT finds them - only one GLOBAL AppComponent may exist at a time.
+ *  In INSTANCE scope nothing is registered globally and several AppComponents (different ports, routers and handlers)
+ *  can run in one process - get their components with get<T>() instead of OATPP_COMPONENT.
  *  Order of components initialization is from top to bottom
  */
 class AppComponent {
 public:
-  
+
+  /**
+   * Where components are visible.
+   */
+  enum class Scope {
+    GLOBAL,
+    INSTANCE
+  };
+
+  /**
+   * ObjectMapper implementation.
+   */
+  enum class JsonMapper {
+    /**
+     * `oatpp::parser::json::mapping::ObjectMapper`.
+     */
+    STOCK,
+    /**
+     * &l:SimdObjectMapper; - same DTOs, vectorized string scanning.
+     */
+    SIMD
+  };
+
+  /**
+   * Router implementation.
+   */
+  enum class RouterMode {
+    /**
+     * `oatpp::web::server::HttpRouter` - patterns of the method are matched one by one.
+     */
+    STOCK,
+    /**
+     * &l:CompiledRouter; - also available as `std::shared_ptr<CompiledRouter>` component. Add controllers through
+     * that component - `HttpRouter` methods are not virtual - &l:AppComponent::warmUp (); compiles them.
+     */
+    COMPILED
+  };
+
+  /**
+   * Optional components and implementations. Defaults - thread per connection, stock mapper and router, no limiter,
+   * no compression.
+   */
+  struct Options {
+
+    /**
+     * If set, connections are served by a &l:PooledConnectionHandler; with these settings (also available as
+     * `std::shared_ptr<PooledConnectionHandler>` component). Otherwise by `HttpConnectionHandler` with a thread
+     * per connection.
+     */
+    std::shared_ptr<PooledConnectionHandler::Config> pool;
+
+    /**
+     * ObjectMapper implementation.
+     */
+    JsonMapper jsonMapper = JsonMapper::STOCK;
+
+    /**
+     * If set (and `pool` is not), connections are served by a &l:ParkingConnectionHandler; with these settings
+     * (also available as `std::shared_ptr<ParkingConnectionHandler>` component). If not set, the `handler` of
+     * &l:ServerConfig; decides.
+     */
+    std::shared_ptr<ParkingConnectionHandler::Config> parking;
+
+    /**
+     * Router implementation.
+     */
+    RouterMode routerMode = RouterMode::STOCK;
+
+    /**
+     * If set, a &l:ConcurrencyLimiter; with these settings sheds requests over its adaptive limit with `503` before
+     * routing (also available as `std::shared_ptr<ConcurrencyLimiter>` component).
+     */
+    std::shared_ptr<ConcurrencyLimiter::Config> limiter;
+
+    /**
+     * If set, responses are compressed with the `Content-Encoding` the client accepts by a &l:ResponseCompression;
+     * with these settings (also available as `std::shared_ptr<ResponseCompression>` component).
+     */
+    std::shared_ptr<ResponseCompression::Config> compression;
+
+  };
+
+private:
+  Scope m_scope;
+  WarmUp::Config m_warmUp;
+  ComponentRegistry m_components;
+  std::vector<std::shared_ptr<void>> m_environmentComponents;
+private:
+
+  template<class T>
+  void put(const T& component) {
+    m_components.put<T>(component);
+    if(m_scope == Scope::GLOBAL) {
+      m_environmentComponents.push_back(std::make_shared<oatpp::base::Environment::Component<T>>(component));
+    }
+  }
+
+  /**
+   *  Request interceptors run in this order: metrics, the limiter (sheds before routing), the compiled router (last).
+   *  Response compression is the last response interceptor - it may replace the response
+   */
+  template<class Handler>
+  static void addInterceptors(const std::shared_ptr<Handler>& handler,
+                              const std::shared_ptr<RequestMetrics>& metrics,
+                              const std::shared_ptr<ConcurrencyLimiter>& limiter,
+                              const std::shared_ptr<CompiledRouter>& compiledRouter,
+                              const std::shared_ptr<ResponseCompression>& compression)
+  {
+    handler->addRequestInterceptor(std::make_shared<RequestMetrics::RequestInterceptor>(metrics));
+    if(limiter) {
+      handler->addRequestInterceptor(std::make_shared<ConcurrencyLimiter::RequestInterceptor>(limiter));
+    }
+    if(compiledRouter) {
+      handler->addRequestInterceptor(std::make_shared<CompiledRouter::RequestInterceptor>(compiledRouter));
+    }
+    handler->addResponseInterceptor(std::make_shared<RequestMetrics::ResponseInterceptor>(metrics));
+    if(limiter) {
+      handler->addResponseInterceptor(std::make_shared<ConcurrencyLimiter::ResponseInterceptor>(limiter));
+    }
+    if(compression) {
+      handler->addResponseInterceptor(std::make_shared<ResponseCompression::ResponseInterceptor>(compression));
+    }
+  }
+
+public:
+
+  /**
+   * Constructor. Default &l:AppComponent::Options;.
+   * @param address - address to listen on, default socket options.
+   * @param scope - where components are visible.
+   */
+  AppComponent(const oatpp::network::Address& address = {"0.0.0.0", 8000, oatpp::network::Address::IP_4},
+               Scope scope = Scope::GLOBAL)
+    : AppComponent(ServerConfig(address), scope, Options())
+  {}
+
   /**
-   *  Create ConnectionProvider component which listens on the port
+   * Constructor.
+   * @param address - address to listen on, default socket options.
+   * @param scope - where components are visible.
+   * @param options - &l:AppComponent::Options;.
    */
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, serverConnectionProvider)([] {
-    return oatpp::network::tcp::server::ConnectionProvider::createShared({"0.0.0.0", 8000, oatpp::network::Address::IP_4});
-  }());
-  
+  AppComponent(const oatpp::network::Address& address, Scope scope, const Options& options)
+    : AppComponent(ServerConfig(address), scope, options)
+  {}
+
   /**
-   *  Create Router component
+   * Constructor. Default &l:AppComponent::Options;.
+   * @param config - see the overload with options.
+   * @param scope - where components are visible.
    */
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, httpRouter)([] {
-    return oatpp::web::server::HttpRouter::createShared();
-  }());
-  
+  AppComponent(const ServerConfig& config, Scope scope = Scope::GLOBAL)
+    : AppComponent(config, scope, Options())
+  {}
+
   /**
-   *  Create ConnectionHandler component which uses Router component to route requests
+   * Constructor.
+   * @param config - address and socket options of the listener and the warm-up, e.g. &l:ServerConfig::load ();.
+   * With warm-up on, the port is bound but not listened on until &l:AppComponent::warmUp (); or the start of
+   * &l:ServerLifecycle;.
+   * @param scope - where components are visible.
+   * @param options - &l:AppComponent::Options;.
    */
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
-    OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router); // get Router component
-    return oatpp::web::server::HttpConnectionHandler::createShared(router);
-  }());
-  
+  AppComponent(const ServerConfig& config, Scope scope, const Options& options)
+    : m_scope(scope)
+    , m_warmUp(config.warmUp)
+  {
+
+    OATPP_LOGI("AppComponent", "Server config: %s", config.toString().c_str());
+
+    /**
+     *  Create ConnectionProvider component which listens on the port.
+     *  Its stop() wakes the accept loop immediately, see ServerLifecycle.
+     *  Socket options of the config are applied to the listener and to accepted connections.
+     *  With warm-up on, connection attempts are refused until warmUp() opens the port.
+     */
+    auto socketOptions = config.socketOptions;
+    socketOptions.deferListen = socketOptions.deferListen || config.warmUp.enabled;
+    put<std::shared_ptr<oatpp::network::ServerConnectionProvider>>(ListenerConnectionProvider::createShared(config.address, socketOptions));
+
+    /**
+     *  Create Router component
+     */
+    std::shared_ptr<CompiledRouter> compiledRouter;
+    if(options.routerMode == RouterMode::COMPILED) {
+      compiledRouter = CompiledRouter::createShared();
+      put<std::shared_ptr<CompiledRouter>>(compiledRouter);
+      put<std::shared_ptr<oatpp::web::server::HttpRouter>>(compiledRouter);
+    } else {
+      put<std::shared_ptr<oatpp::web::server::HttpRouter>>(oatpp::web::server::HttpRouter::createShared());
+    }
+
+    /**
+     *  Create RequestMetrics component - per-route counters served by MetricsController
+     */
+    put<std::shared_ptr<RequestMetrics>>(RequestMetrics::createShared());
+
+    /**
+     *  Create ConcurrencyLimiter component if requests are to be shed under overload
+     */
+    std::shared_ptr<ConcurrencyLimiter> concurrencyLimiter;
+    if(options.limiter) {
+      concurrencyLimiter = ConcurrencyLimiter::createShared(*options.limiter);
+      put<std::shared_ptr<ConcurrencyLimiter>>(concurrencyLimiter);
+    }
+
+    /**
+     *  Create ResponseCompression component if responses are to be compressed
+     */
+    std::shared_ptr<ResponseCompression> responseCompression;
+    if(options.compression) {
+      responseCompression = ResponseCompression::createShared(*options.compression);
+      put<std::shared_ptr<ResponseCompression>>(responseCompression);
+    }
+
+    /**
+     *  Create ConnectionHandler component which uses Router component to route requests
+     *  and records every request in RequestMetrics component.
+     *  The compiled router resolves requests in the last request interceptor - after the metrics and limiter ones
+     */
+    auto router = get<std::shared_ptr<oatpp::web::server::HttpRouter>>(); // get Router component
+    auto metrics = get<std::shared_ptr<RequestMetrics>>(); // get RequestMetrics component
+    if(options.pool) {
+      auto pooledHandler = PooledConnectionHandler::createShared(router, *options.pool);
+      addInterceptors(pooledHandler, metrics, concurrencyLimiter, compiledRouter, responseCompression);
+      put<std::shared_ptr<PooledConnectionHandler>>(pooledHandler);
+      put<std::shared_ptr<oatpp::network::ConnectionHandler>>(pooledHandler);
+    } else if(options.parking || config.parkingHandler) {
+      auto parkingHandler = ParkingConnectionHandler::createShared(router, options.parking ? *options.parking : config.parking);
+      addInterceptors(parkingHandler, metrics, concurrencyLimiter, compiledRouter, responseCompression);
+      put<std::shared_ptr<ParkingConnectionHandler>>(parkingHandler);
+      put<std::shared_ptr<oatpp::network::ConnectionHandler>>(parkingHandler);
+    } else {
+      auto httpHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+      addInterceptors(httpHandler, metrics, concurrencyLimiter, compiledRouter, responseCompression);
+      put<std::shared_ptr<oatpp::network::ConnectionHandler>>(httpHandler);
+    }
+
+    /**
+     *  Create ObjectMapper component to serialize/deserialize DTOs in Contoller's API
+     */
+    if(options.jsonMapper == JsonMapper::SIMD) {
+      put<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>(SimdObjectMapper::createShared());
+    } else {
+      put<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>(oatpp::parser::json::mapping::ObjectMapper::createShared());
+    }
+
+  }
+
+  /**
+   * Freeze the compiled router, warm the server up and open its port. Call after all controllers are added, before
+   * the server is started. If warm-up is off in the config, only freezes the router and opens the port.
+   * Warm-up requests are served by a separate `HttpConnectionHandler` on the same router, with the compiled router and
+   * compression interceptors, but without the metrics and limiter ones - `/metrics` and the adaptive limit start from
+   * real traffic. Workers of &l:PooledConnectionHandler; and &l:ParkingConnectionHandler; are spawned in their
+   * constructors already. The thread-per-connection handler spawns a thread per accepted connection - the warm-up
+   * doesn't leave any threads behind for it. &l:BufferPool; is pre-faulted only for &l:ParkingConnectionHandler; -
+   * the other handlers don't take buffers from it.
+   * @return - &l:WarmUp::Report;, zeros if there was no warm-up.
+   */
+  WarmUp::Report warmUp() {
+
+    auto listener = std::static_pointer_cast<ListenerConnectionProvider>(get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>());
+
+    /* Warm-up requests run through the compiled table already */
+    if(m_components.contains<std::shared_ptr<CompiledRouter>>()) {
+      get<std::shared_ptr<CompiledRouter>>()->freeze();
+    }
+
+    WarmUp::Report report = {0, 0, 0, std::chrono::microseconds(0)};
+
+    if(m_warmUp.enabled && !listener->isListening()) {
+
+      auto handler = oatpp::web::server::HttpConnectionHandler::createShared(get<std::shared_ptr<oatpp::web::server::HttpRouter>>());
+      if(m_components.contains<std::shared_ptr<CompiledRouter>>()) {
+        handler->addRequestInterceptor(std::make_shared<CompiledRouter::RequestInterceptor>(get<std::shared_ptr<CompiledRouter>>()));
+      }
+      if(m_components.contains<std::shared_ptr<ResponseCompression>>()) {
+        handler->addResponseInterceptor(std::make_shared<ResponseCompression::ResponseInterceptor>(get<std::shared_ptr<ResponseCompression>>()));
+      }
+
+      auto config = m_warmUp;
+      if(!m_components.contains<std::shared_ptr<ParkingConnectionHandler>>()) {
+        config.bufferPoolBytes = 0;
+      }
+
+      report = WarmUp::run(config, handler);
+      OATPP_LOGI("AppComponent", "Warmed up in %lldms: %lld requests (%lld failed), %lld bytes of buffers pre-faulted",
+                 (long long) report.duration.count() / 1000, (long long) report.requests, (long long) report.failed,
+                 (long long) report.prefaultedBytes);
+
+    }
+
+    listener->listen();
+    return report;
+
+  }
+
   /**
-   *  Create ObjectMapper component to serialize/deserialize DTOs in Contoller's API
+   * Get component of this instance.
+   * @tparam T - component type, same as in `OATPP_COMPONENT`.
+   * @return - component.
    */
-  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::data::mapping::ObjectMapper>, apiObjectMapper)([] {
-    return oatpp::parser::json::mapping::ObjectMapper::createShared();
-  }());
+  template<class T>
+  const T& get() const {
+    return m_components.get<T>();
+  }
 
 };
 
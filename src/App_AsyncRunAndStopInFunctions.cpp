@@ -0,0 +1,139 @@
+#include "./controller/AsyncMetricsController.hpp"
+#include "./controller/MyAsyncController.hpp"
+#include "./AsyncAppComponent.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
+
+#include <iostream>
+
+/* Could be implemented as class but must be kept singleton if no parallelization preparations were done */
+namespace MyOatppFunctions {
+
+bool server_running = false;
+std::mutex server_op_mutex;
+std::shared_ptr<StopSignal> server_stop_signal;
+std::thread oatppThread;
+
+/**
+ * You can't run two of those threads in one application concurrently in this setup. Especially with the AppComponents inside the
+ * Threads scope. If you want to run multiple threads with multiple servers you either have to manage the components
+ * by yourself and do not rely on the OATPP_COMPONENT mechanism or have one process-global AppComponent.
+ * Further you have to make sure you don't have multiple ServerConnectionProvider listening to the same port
+ * unless they share it with SO_REUSEPORT like the servers of a ServerGroup (see App_ServerGroup.cpp).
+ */
+void StartOatppServer() {
+  std::lock_guard<std::mutex> lock(server_op_mutex);
+
+  /* Check if server is already running, if so, do nothing. */
+  if (server_running) {
+    return;
+  }
+
+  /* Signal that the server is running */
+  server_running = true;
+
+  /* Tell the server it should run. A signaled StopSignal stays signaled, so every run gets a fresh one */
+  server_stop_signal = std::make_shared<StopSignal>();
+
+  auto stopSignal = server_stop_signal;
+
+  oatppThread = std::thread([stopSignal] {
+    /* Register components in scope of thread WARNING: COMPONENTS ONLY VALID WHILE THREAD IS RUNNING! */
+    AsyncAppComponent components;
+
+    /* Get router component */
+    OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+
+    /* Create MyAsyncController and add all of its endpoints to router */
+    router->addController(std::make_shared<MyAsyncController>());
+
+    /* Create AsyncMetricsController and add its /metrics endpoint to router */
+    router->addController(std::make_shared<AsyncMetricsController>());
+
+    /* Get connection handler component */
+    OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
+
+    /* Get connection provider component */
+    OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
+
+    /* Get Async Executor component */
+    OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+
+    /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler.
+     * The lifecycle also stops the Async Executor once all connections are served */
+    ServerLifecycle lifecycle(connectionProvider, connectionHandler, executor, stopSignal);
+
+    /* Print info about server port */
+    OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
+
+    /* Run server until the stop signal is signaled.
+     * Then the server, the ServerConnectionProvider and the ConnectionHandler are stopped (in that order)
+     * and all running connections are served */
+    lifecycle.run();
+  });
+}
+
+void StopOatppServer() {
+  std::lock_guard<std::mutex> lock(server_op_mutex);
+
+  /* Tell server to stop */
+  if (server_stop_signal) {
+    server_stop_signal->signal();
+  }
+
+  /* Wait for the server to stop */
+  if (oatppThread.joinable()) {
+    oatppThread.join();
+  }
+
+  /* Allow the server to be started again */
+  server_running = false;
+}
+
+}
+
+
+void myBackendLogicDummy() {
+  OATPP_LOGI("MyBackend", "Press enter to continue the loop");
+  std::cin.ignore();
+}
+
+/**
+ * Async (coroutine-based) variant of App_RunAndStopInFunctions.cpp. Connections are served by AsyncHttpConnectionHandler
+ * on the threads of the Async Executor instead of one thread per connection.
+ * This example shows how to start the server and stop it gracefully with a call to stop().
+ * You are free to have the components, server and controller in your main stack and just run the server in its own
+ * thread like in the StopSimple example and still use the condition function.
+ */
+void run() {
+
+ MyOatppFunctions::StartOatppServer();
+
+ myBackendLogicDummy();
+
+ MyOatppFunctions::StopOatppServer();
+
+}
+
+/**
+ *  main
+ */
+int main(int argc, const char * argv[]) {
+
+  oatpp::base::Environment::init();
+
+  run();
+
+  /* Print how much objects were created during app running, and what have left-probably leaked */
+  /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+  std::cout << "\nEnvironment:\n";
+  std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+
+  oatpp::base::Environment::destroy();
+
+  return 0;
+}
@@ -0,0 +1,99 @@
+#include "./controller/AsyncMetricsController.hpp"
+#include "./controller/MyAsyncController.hpp"
+#include "./AsyncAppComponent.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
+
+#include <iostream>
+
+/* Stop condition. Signaling it wakes the server once - it is not checked on every accepted connection */
+std::shared_ptr<StopSignal> server_stop_signal = std::make_shared<StopSignal>();
+
+void myBackendLogicDummy() {
+    OATPP_LOGI("MyBackend", "Press enter to continue the loop");
+    std::cin.ignore();
+}
+
+/**
+ * Async (coroutine-based) variant of App_StopByConditionCheck.cpp. Connections are served by AsyncHttpConnectionHandler
+ * on the threads of the Async Executor instead of one thread per connection.
+ * This example shows how to start the server and stop it gracefully with a stop condition.
+ * You are free to have the components, server and controller in your main stack and just run the server in its own
+ * thread like in the StopSimple example and still use the stop condition.
+ */
+void run() {
+
+  /* Register components in scope of run() */
+  AsyncAppComponent components;
+
+  /* Get router component */
+  OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+
+  /* Create MyAsyncController and add all of its endpoints to router */
+  router->addController(std::make_shared<MyAsyncController>());
+
+  /* Create AsyncMetricsController and add its /metrics endpoint to router */
+  router->addController(std::make_shared<AsyncMetricsController>());
+
+  /* Get connection handler component */
+  OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
+
+  /* Get connection provider component */
+  OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
+
+  /* Get Async Executor component */
+  OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+
+  /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler.
+   * The lifecycle also stops the Async Executor once all connections are served */
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler, executor, server_stop_signal);
+
+  std::thread oatppThread([&lifecycle] {
+
+    /* Run server until the stop condition is signaled.
+     * Unlike a condition function, the stop condition costs nothing on the accept path:
+     * the accept loop is woken exactly once when the condition is signaled.
+     * After that the server, the ServerConnectionProvider and the ConnectionHandler are stopped (in that order) */
+    lifecycle.run();
+  });
+
+  /* Print info about server port */
+  OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
+
+  /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
+  myBackendLogicDummy();
+
+  /* Signal the stop condition */
+  server_stop_signal->signal();
+
+  /* Check if the thread has already stopped or if we need to wait for the server to stop */
+  if(oatppThread.joinable()) {
+
+    /* We need to wait until the thread is done and all running connections are closed */
+    oatppThread.join();
+  }
+
+}
+
+/**
+ *  main
+ */
+int main(int argc, const char * argv[]) {
+
+  oatpp::base::Environment::init();
+
+  run();
+  
+  /* Print how much objects were created during app running, and what have left-probably leaked */
+  /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+  std::cout << "\nEnvironment:\n";
+  std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  
+  oatpp::base::Environment::destroy();
+  
+  return 0;
+}
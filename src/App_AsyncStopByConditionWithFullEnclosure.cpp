@@ -0,0 +1,108 @@
+#include "./controller/AsyncMetricsController.hpp"
+#include "./controller/MyAsyncController.hpp"
+#include "./AsyncAppComponent.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
+
+#include <iostream>
+
+/* Stop condition. It lives outside of the Oat++ environment, so it is safe to signal it from any thread at any time */
+std::shared_ptr<StopSignal> server_stop_signal = std::make_shared<StopSignal>();
+
+void myBackendLogicDummy() {
+  std::cout << "Press enter to shut down" << std::endl;
+  std::cin.ignore();
+}
+
+/**
+ * Async (coroutine-based) variant of App_StopByConditionWithFullEnclosure.cpp. Connections are served by AsyncHttpConnectionHandler
+ * on the threads of the Async Executor instead of one thread per connection.
+ * This example shows how to keep Oat++ entirely in its own thread and let it stop by a check condition. This might be
+ * a more straight forward solution compared to calling `server->stop()`.
+ * Some may encounter the situation where the whole Oat++ runtime AND environment should be enclosed in a single thread
+ * and its stack. A "full enclosure".
+ * WARNING: This also encapsulates the Oat++ environment in the thread. Thus other Oat++ mechanisms like logging is only
+ * available while the thread is running. However, you should NOT rely on using Oat++ environment mechanisms outside
+ * of the Oat++ part of your project. If you still want to use Oat++ Logging and other Oat++ functions, call the
+ * environments init and destroy in main or their respective scope.
+ */
+void run() {
+
+  std::thread oatppThread([] {
+
+    /* Init Oat++ Environment in the scope of the thread */
+    oatpp::base::Environment::init();
+
+    /* Have the thread logic in a sub-scope so every Oat++ object is destroyed when we destroy the environment on thread close */
+    {
+      /* Register Components in scope of run() method */
+      AsyncAppComponent components;
+
+      /* Get router component */
+      OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+
+      /* Create MyAsyncController and add all of its endpoints to router */
+      router->addController(std::make_shared<MyAsyncController>());
+
+      /* Create AsyncMetricsController and add its /metrics endpoint to router */
+      router->addController(std::make_shared<AsyncMetricsController>());
+
+      /* Get connection handler component */
+      OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
+
+      /* Get connection provider component */
+      OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
+
+      /* Get Async Executor component */
+      OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+
+      /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler.
+       * The lifecycle also stops the Async Executor once all connections are served */
+      ServerLifecycle lifecycle(connectionProvider, connectionHandler, executor, server_stop_signal);
+
+      /* Print info about server port */
+      OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
+
+      /* Run server until the stop condition is signaled.
+       * The accept loop is woken exactly once when the condition is signaled, nothing is checked per connection.
+       * Then the server, the ServerConnectionProvider and the ConnectionHandler are stopped (in that order)
+       * and all running connections are served */
+      lifecycle.run();
+    }
+
+    /* Print how much objects were created during app running, and what have left-probably leaked */
+    /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+    std::cout << "\nEnvironment:\n";
+    std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+    std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+    /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+    /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+    std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+
+    oatpp::base::Environment::destroy();
+  });
+
+  /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
+  myBackendLogicDummy();
+
+  /* Signal the stop condition */
+  server_stop_signal->signal();
+
+  /* Check if we have already stopped or if we need to wait for the server to stop */
+  if(oatppThread.joinable()) {
+
+    /* We need to wait until the thread is done */
+    oatppThread.join();
+  }
+  
+}
+
+/**
+ *  main
+ */
+int main(int argc, const char * argv[]) {
+
+  run();
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+#include "./controller/AsyncMetricsController.hpp"
+#include "./controller/MyAsyncController.hpp"
+#include "./AsyncAppComponent.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
+
+#include <iostream>
+
+void myBackendLogicDummy() {
+    OATPP_LOGI("MyBackend", "Press enter to continue the loop");
+    std::cin.ignore();
+}
+
+/**
+ * Async (coroutine-based) variant of App_StopSimple.cpp. Connections are served by AsyncHttpConnectionHandler
+ * on the threads of the Async Executor instead of one thread per connection.
+ * This example shows how to start the server and stop it gracefully with a call to stop().
+ */
+void run() {
+
+  /* Register Components in scope of run() method */
+  AsyncAppComponent components;
+
+  /* Get router component */
+  OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+
+  /* Create MyAsyncController and add all of its endpoints to router */
+  router->addController(std::make_shared<MyAsyncController>());
+
+  /* Create AsyncMetricsController and add its /metrics endpoint to router */
+  router->addController(std::make_shared<AsyncMetricsController>());
+
+
+  /* Get connection handler component */
+  OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
+
+
+  /* Get connection provider component */
+  OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
+
+  /* Get Async Executor component */
+  OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+
+  /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler.
+   * The lifecycle also stops the Async Executor once all connections are served */
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler, executor);
+
+  /* Run server in its own thread */
+  lifecycle.start();
+
+  /* Print info about server port */
+  OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
+
+  /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
+  myBackendLogicDummy();
+
+  /* Stop the server, the ServerConnectionProvider and the ConnectionHandler (in that order).
+   * Blocks until the server-thread is done, all running connections are closed and the Async Executor is stopped */
+  lifecycle.stop();
+
+}
+
+/**
+ *  main
+ */
+int main(int argc, const char * argv[]) {
+
+  oatpp::base::Environment::init();
+
+  run();
+  
+  /* Print how much objects were created during app running, and what have left-probably leaked */
+  /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+  std::cout << "\nEnvironment:\n";
+  std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  
+  oatpp::base::Environment::destroy();
+  
+  return 0;
+}
@@ -0,0 +1,140 @@
+#include "./controller/AsyncMetricsController.hpp"
+#include "./controller/MyAsyncController.hpp"
+#include "./AsyncAppComponent.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
+
+#include <iostream>
+
+void myBackendLogicDummy() {
+  std::cout << "Press enter to shut down" << std::endl;
+  std::cin.ignore();
+}
+
+/**
+ * Async (coroutine-based) variant of App_StopWithFullEnclosure.cpp. Connections are served by AsyncHttpConnectionHandler
+ * on the threads of the Async Executor instead of one thread per connection.
+ * This example shows how to start the server without and stop it with a call to signal() on the StopSignal of its lifecycle;
+ * Some may encounter the situation where the whole Oat++ runtime AND environment should be enclosed in a single thread
+ * and its stack. A "full enclosure".
+ * WARNING: This also encapsulates the Oat++ environment in the thread. Thus other Oat++ mechanisms like logging is only
+ * available while the thread is running. However, you should NOT rely on using Oat++ environment mechanisms outside
+ * of the Oat++ part of your project. If you still want to use Oat++ Logging and other Oat++ functions, call the
+ * environments init and destroy in main or their respective scope.
+ */
+void run() {
+  /* In this example, the thread creates the server lifecycle and places a reference to its stop signal here.
+   * The stop signal is not an Oat++ object, so it is safe to keep it outside of the thread's environment. */
+  std::shared_ptr<StopSignal> stopSignal;
+
+  /* Optional race-condition prevention, see big comment further down */
+  std::condition_variable race_guard;
+  std::mutex race_guard_mutex;
+  bool ready = false;
+
+  /**
+   * You can't run two of those threads in one application concurrently in this setup. Especially with the AppComponents inside the
+   * Threads scope. If you want to run multiple threads with multiple servers you either have to manage the components
+   * by yourself and do not rely on the OATPP_COMPONENT mechanism or have one process-global AppComponent.
+   * Further you have to make sure you don't have multiple ServerConnectionProvider listening to the same port
+   * unless they share it with SO_REUSEPORT like the servers of a ServerGroup (see App_ServerGroup.cpp).
+   */
+  std::thread oatppThread([&stopSignal, &race_guard_mutex, &race_guard, &ready] {
+
+    /* Init Oat++ Environment in the scope of the thread */
+    oatpp::base::Environment::init();
+
+    /* Have the thread logic in a sub-scope so every Oat++ object is destroyed when we destroy the environment on thread close */
+    {
+      /* Register Components in scope of run() method */
+      AsyncAppComponent components;
+
+      /* Get router component */
+      OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
+
+      /* Create MyAsyncController and add all of its endpoints to router */
+      router->addController(std::make_shared<MyAsyncController>());
+
+      /* Create AsyncMetricsController and add its /metrics endpoint to router */
+      router->addController(std::make_shared<AsyncMetricsController>());
+
+      /* Get connection handler component */
+      OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
+
+
+      /* Get connection provider component */
+      OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
+
+      /* Get Async Executor component */
+      OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor);
+
+      /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler.
+       * The lifecycle also stops the Async Executor once all connections are served */
+      ServerLifecycle lifecycle(connectionProvider, connectionHandler, executor);
+
+      /* Publish the stop signal and unlock the race-guard */
+      {
+        std::lock_guard<std::mutex> lock(race_guard_mutex);
+        stopSignal = lifecycle.getStopSignal();
+        ready = true;
+      }
+      race_guard.notify_one();
+
+      /* Print info about server port */
+      OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
+
+      /* Run server until signal() is called on its stop signal.
+       * Then the server, the ServerConnectionProvider and the ConnectionHandler are stopped (in that order)
+       * and all running connections are served */
+      lifecycle.run();
+    }
+
+    /* Print how much objects were created during app running, and what have left-probably leaked */
+    /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+    std::cout << "\nEnvironment:\n";
+    std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+    std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+    /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+    /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+    std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+
+    oatpp::base::Environment::destroy();
+  });
+
+  /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
+  myBackendLogicDummy();
+
+  /*
+   * Warning:
+   * Keep in mind we can have a race-condition here. If myBackendLogicDummy() exits before the stop signal is assigned
+   * the pointer is still empty and the stop-command will never be sent. Therefore it is advised to have i.E. a condition
+   * variable to prevent this kind of situation. In C++20, a std::binary_semaphore could be used for less lines of code.
+   * This is optional if you are 100% positive that your logic will never return this quickly.
+   * Also, if you need to have Oat++ up and running before your logic starts, you can move this
+   */
+  {
+    std::unique_lock<std::mutex> race_guard_lock(race_guard_mutex);
+    race_guard.wait(race_guard_lock, [&ready]{return ready;});
+  }
+
+  /* Send the stop-command. Signaling a server which is already done is a no-op */
+  stopSignal->signal();
+
+  /* Check if we have already stopped or if we need to wait for the server to stop */
+  if(oatppThread.joinable()) {
+
+    /* We need to wait until the thread is done */
+    oatppThread.join();
+  }
+  
+}
+
+/**
+ *  main
+ */
+int main(int argc, const char * argv[]) {
+
+  run();
+
+  return 0;
+}
@@ -0,0 +1,105 @@
+#include "./controller/MetricsController.hpp"
+#include "./controller/MyController.hpp"
+#include "./lifecycle/DrainingConnectionHandler.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./network/ListenerHandoff.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+
+#include <iostream>
+
+/**
+ * This example shows how to restart the server without refusing a single connection.
+ * Start `HotRestart-exe` and then start it once more: the new process takes the listening socket over from the
+ * running one through a Unix domain socket, starts accepting on it and the old process drains and exits.
+ * Usage: HotRestart-exe [port] [handoff-socket-path]
+ * AppComponent is not used here because its ConnectionProvider always binds a new listening socket.
+ */
+void run(v_uint16 port, const oatpp::String& handoffPath) {
+
+  /* Take the listener over from a running process, or bind a new one if this is the first process */
+  std::shared_ptr<ListenerConnectionProvider> connectionProvider = ListenerHandoff::takeOver(handoffPath);
+  if(!connectionProvider) {
+    connectionProvider = ListenerConnectionProvider::createShared({"0.0.0.0", port, oatpp::network::Address::IP_4});
+  }
+
+  /* Create ObjectMapper to serialize/deserialize DTOs in Contoller's API */
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  /* Create router */
+  auto router = oatpp::web::server::HttpRouter::createShared();
+
+  /* Create MyController and add all of its endpoints to router */
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  /* Create metrics of this process */
+  auto metrics = RequestMetrics::createShared();
+
+  /* Create MetricsController and add its /metrics endpoint to router */
+  router->addController(std::make_shared<MetricsController>(metrics));
+
+  /* Create HTTP connection handler which records every request in metrics */
+  auto httpConnectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+  httpConnectionHandler->addRequestInterceptor(std::make_shared<RequestMetrics::RequestInterceptor>(metrics));
+  httpConnectionHandler->addResponseInterceptor(std::make_shared<RequestMetrics::ResponseInterceptor>(metrics));
+
+  /* Wrap it so that it drains within 5 seconds once the listener was handed over */
+  auto connectionHandler = DrainingConnectionHandler::createShared(httpConnectionHandler, std::chrono::seconds(5));
+
+  /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler */
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+
+  /* Serve the listener to the next process. When it takes the listener over, the lifecycle is signaled to stop */
+  ListenerHandoff handoff(handoffPath, connectionProvider, lifecycle.getStopSignal());
+
+  std::thread oatppThread([&lifecycle] {
+    lifecycle.run();
+  });
+
+  /* Print info about server port */
+  OATPP_LOGI("MyApp", "Server running on port %s, handoff socket '%s'",
+             connectionProvider->getProperty("port").getData(), handoffPath->c_str());
+
+  /* Stop when enter is pressed or stdin is closed. Detached, because after a handoff nobody presses enter */
+  auto stopSignal = lifecycle.getStopSignal();
+  std::thread([stopSignal] {
+    std::cin.ignore();
+    stopSignal->signal();
+  }).detach();
+
+  /* Wait until the server is stopped - either by the user or by the handoff - and all connections are drained */
+  oatppThread.join();
+
+  auto report = connectionHandler->getReport();
+  OATPP_LOGI("MyApp", "%s. Connections drained: %lld, aborted: %lld",
+             handoff.isHandedOff() ? "Handed over" : "Stopped", (long long) report.drained, (long long) report.aborted);
+
+}
+
+/**
+ *  main
+ */
+int main(int argc, const char * argv[]) {
+
+  v_uint16 port = argc > 1 ? (v_uint16) oatpp::utils::conversion::strToInt32(argv[1]) : 8000;
+  const char* handoffPath = argc > 2 ? argv[2] : "/tmp/my-threaded-project.handoff";
+
+  oatpp::base::Environment::init();
+
+  run(port, handoffPath);
+  
+  /* Print how much objects were created during app running, and what have left-probably leaked */
+  /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+  std::cout << "\nEnvironment:\n";
+  std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  
+  oatpp::base::Environment::destroy();
+  
+  return 0;
+}
@@ -0,0 +1,89 @@
+#include "./controller/MetricsController.hpp"
+#include "./controller/MyController.hpp"
+#include "./AppComponent.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
+
+#include <iostream>
+
+void myBackendLogicDummy() {
+    OATPP_LOGI("MyBackend", "Press enter to continue the loop");
+    std::cin.ignore();
+}
+
+/**
+ * This example shows how to run several independent servers in one process, e.g. a public API and an admin listener.
+ * Every server has its own AppComponent in INSTANCE scope - own port, router and connection handler - so nothing is
+ * registered in the global Oat++ environment and the servers can be started and stopped independently.
+ * Components are taken from the AppComponent with get<T>() instead of OATPP_COMPONENT.
+ */
+void run() {
+
+  /* Register Components in scope of the instances, not globally */
+  AppComponent publicComponents({"0.0.0.0", 8000, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE);
+  AppComponent adminComponents({"127.0.0.1", 8001, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE);
+
+  /* Create MyController and add all of its endpoints to the router of the public server */
+  auto publicObjectMapper = publicComponents.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  publicComponents.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(publicObjectMapper));
+
+  /* ToDo: Add your admin controllers here. We are just adding MyController once more */
+  auto adminObjectMapper = adminComponents.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  adminComponents.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(adminObjectMapper));
+
+  /* Serve metrics of the public server on the admin server */
+  auto publicMetrics = publicComponents.get<std::shared_ptr<RequestMetrics>>();
+  adminComponents.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MetricsController>(publicMetrics));
+
+  /* Warm both servers up before their ports are opened */
+  publicComponents.warmUp();
+  adminComponents.warmUp();
+
+  /* Create server lifecycles which take provided TCP connections and pass them to HTTP connection handlers */
+  ServerLifecycle publicLifecycle(publicComponents.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>(),
+                                  publicComponents.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+
+  ServerLifecycle adminLifecycle(adminComponents.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>(),
+                                 adminComponents.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+
+  /* Run servers in their own threads */
+  publicLifecycle.start();
+  adminLifecycle.start();
+
+  /* Print info about server ports */
+  OATPP_LOGI("MyApp", "Public server running on port %s",
+             publicComponents.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>()->getProperty("port").getData());
+  OATPP_LOGI("MyApp", "Admin server running on port %s",
+             adminComponents.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>()->getProperty("port").getData());
+
+  /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
+  myBackendLogicDummy();
+
+  /* Stop the servers independently of each other */
+  publicLifecycle.stop();
+  adminLifecycle.stop();
+
+}
+
+/**
+ *  main
+ */
+int main(int argc, const char * argv[]) {
+
+  oatpp::base::Environment::init();
+
+  run();
+  
+  /* Print how much objects were created during app running, and what have left-probably leaked */
+  /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+  std::cout << "\nEnvironment:\n";
+  std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  
+  oatpp::base::Environment::destroy();
+  
+  return 0;
+}
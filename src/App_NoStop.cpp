@@ -1,7 +1,9 @@
+#include "./controller/MetricsController.hpp"
 #include "./controller/MyController.hpp"
 #include "./AppComponent.hpp"
-
-#include "oatpp/network/Server.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./memory/BufferPool.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
 
 #include <iostream>
 
@@ -20,7 +22,8 @@ void run() {
 
   std::thread oatppThread([] {
     /* Register Components in scope of thread method */
-    AppComponent components;
+    /* Listen address, socket options and warm-up come from the file in APP_CONFIG and APP_<KEY> variables, see ServerConfig */
+    AppComponent components(ServerConfig::load());
 
     /* Get router component */
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
@@ -28,20 +31,26 @@ void run() {
     /* Create MyController and add all of its endpoints to router */
     router->addController(std::make_shared<MyController>());
 
+    /* Create MetricsController and add its /metrics endpoint to router */
+    router->addController(std::make_shared<MetricsController>());
+
+    /* Warm up - run requests through the router over a virtual interface, pre-fault buffers - then open the port */
+    components.warmUp();
+
     /* Get connection handler component */
     OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
 
     /* Get connection provider component */
     OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
 
-    /* Create server which takes provided TCP connections and passes them to HTTP connection handler */
-    oatpp::network::Server server(connectionProvider, connectionHandler);
+    /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler */
+    ServerLifecycle lifecycle(connectionProvider, connectionHandler);
 
     /* Print info about server port */
     OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
 
-    /* Run server */
-    server.run();
+    /* Run server. Nobody signals the stop, so this never returns */
+    lifecycle.run();
   });
 
   /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
@@ -62,7 +71,15 @@ int main(int argc, const char * argv[]) {
   /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
   std::cout << "\nEnvironment:\n";
   std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
-  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  /* Print how many connection buffers were reused from the pool and how much memory it still retains.
+   * Only the parking handler (`handler = parking` in the config) takes its buffers from the pool */
+  if(BufferPool::getStats().acquired > 0) {
+    std::cout << BufferPool::formatReport() << "\n";
+  }
   
   oatpp::base::Environment::destroy();
   
@@ -1,7 +1,9 @@
+#include "./controller/MetricsController.hpp"
 #include "./controller/MyController.hpp"
 #include "./AppComponent.hpp"
-
-#include "oatpp/network/Server.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./memory/BufferPool.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
 
 #include <iostream>
 
@@ -10,14 +12,16 @@ namespace MyOatppFunctions {
 
 bool server_running = false;
 std::mutex server_op_mutex;
-std::atomic_bool server_should_continue;
+std::shared_ptr<StopSignal> server_stop_signal;
 std::thread oatppThread;
 
 /**
  * You can't run two of those threads in one application concurrently in this setup. Especially with the AppComponents inside the
  * Threads scope. If you want to run multiple threads with multiple servers you either have to manage the components
  * by yourself and do not rely on the OATPP_COMPONENT mechanism or have one process-global AppComponent.
- * Further you have to make sure you don't have multiple ServerConnectionProvider listening to the same port.
+ * AppComponent in INSTANCE scope does the former for you, see App_MultiInstance.cpp.
+ * Further you have to make sure you don't have multiple ServerConnectionProvider listening to the same port
+ * unless they share it with SO_REUSEPORT like the servers of a ServerGroup (see App_ServerGroup.cpp).
  */
 void StartOatppServer() {
   std::lock_guard<std::mutex> lock(server_op_mutex);
@@ -30,12 +34,15 @@ void StartOatppServer() {
   /* Signal that the server is running */
   server_running = true;
 
-  /* Tell the server it should run */
-  server_should_continue.store(true);
+  /* Tell the server it should run. A signaled StopSignal stays signaled, so every run gets a fresh one */
+  server_stop_signal = std::make_shared<StopSignal>();
+
+  auto stopSignal = server_stop_signal;
 
-  oatppThread = std::thread([] {
+  oatppThread = std::thread([stopSignal] {
     /* Register components in scope of thread WARNING: COMPONENTS ONLY VALID WHILE THREAD IS RUNNING! */
-    AppComponent components;
+    /* Listen address, socket options and warm-up come from the file in APP_CONFIG and APP_<KEY> variables, see ServerConfig */
+    AppComponent components(ServerConfig::load());
 
     /* Get router component */
     OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
@@ -43,34 +50,28 @@ void StartOatppServer() {
     /* Create MyController and add all of its endpoints to router */
     router->addController(std::make_shared<MyController>());
 
+    /* Create MetricsController and add its /metrics endpoint to router */
+    router->addController(std::make_shared<MetricsController>());
+
+    /* Warm up - run requests through the router over a virtual interface, pre-fault buffers - then open the port */
+    components.warmUp();
+
     /* Get connection handler component */
     OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
 
     /* Get connection provider component */
     OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
 
-    /* Create server which takes provided TCP connections and passes them to HTTP connection handler */
-    oatpp::network::Server server(connectionProvider, connectionHandler);
-
-    /* Run server, let it check a lambda-function if it should continue to run
-     * Return true to keep the server up, return false to stop it.
-     * Treat this function like a ISR: Don't do anything heavy in it! Just check some flags or at max some very
-     * lightweight logic.
-     * The performance of your REST-API depends on this function returning as fast as possible! */
-    std::function<bool()> condition = [](){
-      return server_should_continue.load();
-    };
+    /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler */
+    ServerLifecycle lifecycle(connectionProvider, connectionHandler, stopSignal);
 
     /* Print info about server port */
     OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
 
-    server.run(condition);
-
-    /* Server has shut down, so we dont want to connect any new connections */
-    connectionProvider->stop();
-
-    /* Now stop the connection handler and wait until all running connections are served */
-    connectionHandler->stop();
+    /* Run server until the stop signal is signaled.
+     * Then the server, the ServerConnectionProvider and the ConnectionHandler are stopped (in that order)
+     * and all running connections are served */
+    lifecycle.run();
   });
 }
 
@@ -78,12 +79,17 @@ void StopOatppServer() {
   std::lock_guard<std::mutex> lock(server_op_mutex);
 
   /* Tell server to stop */
-  server_should_continue.store(false);
+  if (server_stop_signal) {
+    server_stop_signal->signal();
+  }
 
   /* Wait for the server to stop */
   if (oatppThread.joinable()) {
     oatppThread.join();
   }
+
+  /* Allow the server to be started again */
+  server_running = false;
 }
 
 }
@@ -122,7 +128,15 @@ int main(int argc, const char * argv[]) {
   /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
   std::cout << "\nEnvironment:\n";
   std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
-  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  /* Print how many connection buffers were reused from the pool and how much memory it still retains.
+   * Only the parking handler (`handler = parking` in the config) takes its buffers from the pool */
+  if(BufferPool::getStats().acquired > 0) {
+    std::cout << BufferPool::formatReport() << "\n";
+  }
 
   oatpp::base::Environment::destroy();
 
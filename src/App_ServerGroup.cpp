@@ -0,0 +1,87 @@
+#include "./controller/MetricsController.hpp"
+#include "./controller/MyController.hpp"
+#include "./lifecycle/ServerGroup.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <iostream>
+
+void myBackendLogicDummy() {
+    OATPP_LOGI("MyBackend", "Press enter to continue the loop");
+    std::cin.ignore();
+}
+
+/**
+ * This example shows how to accept connections on one port with several servers, each with its own
+ * SO_REUSEPORT listener and acceptor thread, and stop all of them gracefully with one call to stop().
+ * AppComponent is not used here because its ConnectionProvider would occupy the port with a single listener.
+ * Instead the components are created by hand: all servers share one router, every server has its own
+ * connection handler.
+ */
+void run() {
+
+  /* Create ObjectMapper to serialize/deserialize DTOs in Contoller's API */
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  /* Create router shared by all servers */
+  auto router = oatpp::web::server::HttpRouter::createShared();
+
+  /* Create MyController and add all of its endpoints to router */
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  /* Create metrics shared by all servers - every thread writes to its own shard, so they don't contend */
+  auto metrics = RequestMetrics::createShared();
+
+  /* Create MetricsController and add its /metrics endpoint to router */
+  router->addController(std::make_shared<MetricsController>(metrics));
+
+  /* One acceptor per CPU, each pinned to its CPU */
+  v_int32 acceptorsCount = std::thread::hardware_concurrency() > 0 ? (v_int32) std::thread::hardware_concurrency() : 1;
+
+  /* Create server group which takes provided TCP connections and passes them to HTTP connection handlers */
+  ServerGroup group({"0.0.0.0", 8000, oatpp::network::Address::IP_4}, acceptorsCount, [router, metrics](v_int32) {
+    auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+    connectionHandler->addRequestInterceptor(std::make_shared<RequestMetrics::RequestInterceptor>(metrics));
+    connectionHandler->addResponseInterceptor(std::make_shared<RequestMetrics::ResponseInterceptor>(metrics));
+    return connectionHandler;
+  }, true /* pin acceptor threads */);
+
+  /* Run servers in their own threads */
+  group.start();
+
+  /* Print info about server port */
+  OATPP_LOGI("MyApp", "Server group of %d acceptors running on port %d", group.getAcceptorsCount(), group.getPort());
+
+  /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
+  myBackendLogicDummy();
+
+  /* Stop accepting on all servers, then stop all ConnectionHandlers.
+   * Blocks until all acceptor threads are done and all running connections are closed */
+  group.stop();
+
+}
+
+/**
+ *  main
+ */
+int main(int argc, const char * argv[]) {
+
+  oatpp::base::Environment::init();
+
+  run();
+  
+  /* Print how much objects were created during app running, and what have left-probably leaked */
+  /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
+  std::cout << "\nEnvironment:\n";
+  std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  
+  oatpp::base::Environment::destroy();
+  
+  return 0;
+}
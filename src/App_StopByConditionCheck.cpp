@@ -1,11 +1,14 @@
+#include "./controller/MetricsController.hpp"
 #include "./controller/MyController.hpp"
 #include "./AppComponent.hpp"
-
-#include "oatpp/network/Server.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./memory/BufferPool.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
 
 #include <iostream>
 
-std::atomic_bool server_should_continue(true);
+/* Stop condition. Signaling it wakes the server once - it is not checked on every accepted connection */
+std::shared_ptr<StopSignal> server_stop_signal = std::make_shared<StopSignal>();
 
 void myBackendLogicDummy() {
     OATPP_LOGI("MyBackend", "Press enter to continue the loop");
@@ -13,14 +16,15 @@ void myBackendLogicDummy() {
 }
 
 /**
- * This example shows how to start the server and stop it gracefully with a condition function.
+ * This example shows how to start the server and stop it gracefully with a stop condition.
  * You are free to have the components, server and controller in your main stack and just run the server in its own
- * thread like in the StopSimple example and still use the condition function.
+ * thread like in the StopSimple example and still use the stop condition.
  */
 void run() {
 
   /* Register components in scope of run() */
-  AppComponent components;
+  /* Listen address, socket options and warm-up come from the file in APP_CONFIG and APP_<KEY> variables, see ServerConfig */
+  AppComponent components(ServerConfig::load());
 
   /* Get router component */
   OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
@@ -28,27 +32,28 @@ void run() {
   /* Create MyController and add all of its endpoints to router */
   router->addController(std::make_shared<MyController>());
 
+  /* Create MetricsController and add its /metrics endpoint to router */
+  router->addController(std::make_shared<MetricsController>());
+
+  /* Warm up - run requests through the router over a virtual interface, pre-fault buffers - then open the port */
+  components.warmUp();
+
   /* Get connection handler component */
   OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
 
   /* Get connection provider component */
   OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
 
-  /* Create server which takes provided TCP connections and passes them to HTTP connection handler */
-  oatpp::network::Server server(connectionProvider, connectionHandler);
-
-  std::thread oatppThread([&server] {
+  /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler */
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler, server_stop_signal);
 
-    /* Run server, let it check a lambda-function if it should continue to run
-     * Return true to keep the server up, return false to stop it.
-     * Treat this function like a ISR: Don't do anything heavy in it! Just check some flags or at max some very
-     * lightweight logic.
-     * The performance of your REST-API depends on this function returning as fast as possible! */
-    std::function<bool()> condition = [](){
-      return server_should_continue.load();
-    };
+  std::thread oatppThread([&lifecycle] {
 
-    server.run(condition);
+    /* Run server until the stop condition is signaled.
+     * Unlike a condition function, the stop condition costs nothing on the accept path:
+     * the accept loop is woken exactly once when the condition is signaled.
+     * After that the server, the ServerConnectionProvider and the ConnectionHandler are stopped (in that order) */
+    lifecycle.run();
   });
 
   /* Print info about server port */
@@ -57,19 +62,13 @@ void run() {
   /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
   myBackendLogicDummy();
 
-  /* First, stop the ServerConnectionProvider so we don't accept any new connections */
-  connectionProvider->stop();
-
   /* Signal the stop condition */
-  server_should_continue.store(false);
-
-  /* Finally, stop the ConnectionHandler and wait until all running connections are closed */
-  connectionHandler->stop();
+  server_stop_signal->signal();
 
   /* Check if the thread has already stopped or if we need to wait for the server to stop */
   if(oatppThread.joinable()) {
 
-    /* We need to wait until the thread is done */
+    /* We need to wait until the thread is done and all running connections are closed */
     oatppThread.join();
   }
 
@@ -88,7 +87,15 @@ int main(int argc, const char * argv[]) {
   /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
   std::cout << "\nEnvironment:\n";
   std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
-  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  /* Print how many connection buffers were reused from the pool and how much memory it still retains.
+   * Only the parking handler (`handler = parking` in the config) takes its buffers from the pool */
+  if(BufferPool::getStats().acquired > 0) {
+    std::cout << BufferPool::formatReport() << "\n";
+  }
   
   oatpp::base::Environment::destroy();
   
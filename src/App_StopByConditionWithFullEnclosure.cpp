@@ -1,11 +1,14 @@
+#include "./controller/MetricsController.hpp"
 #include "./controller/MyController.hpp"
 #include "./AppComponent.hpp"
-
-#include "oatpp/network/Server.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./memory/BufferPool.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
 
 #include <iostream>
 
-std::atomic_bool server_should_continue(true);
+/* Stop condition. It lives outside of the Oat++ environment, so it is safe to signal it from any thread at any time */
+std::shared_ptr<StopSignal> server_stop_signal = std::make_shared<StopSignal>();
 
 void myBackendLogicDummy() {
   std::cout << "Press enter to shut down" << std::endl;
@@ -32,7 +35,8 @@ void run() {
     /* Have the thread logic in a sub-scope so every Oat++ object is destroyed when we destroy the environment on thread close */
     {
       /* Register Components in scope of run() method */
-      AppComponent components;
+      /* Listen address, socket options and warm-up come from the file in APP_CONFIG and APP_<KEY> variables, see ServerConfig */
+      AppComponent components(ServerConfig::load());
 
       /* Get router component */
       OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
@@ -40,42 +44,44 @@ void run() {
       /* Create MyController and add all of its endpoints to router */
       router->addController(std::make_shared<MyController>());
 
+      /* Create MetricsController and add its /metrics endpoint to router */
+      router->addController(std::make_shared<MetricsController>());
+
+      /* Warm up - run requests through the router over a virtual interface, pre-fault buffers - then open the port */
+      components.warmUp();
+
       /* Get connection handler component */
       OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
 
       /* Get connection provider component */
       OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
 
-      /* Create server which takes provided TCP connections and passes them to HTTP connection handler */
-      auto serverPtr = oatpp::network::Server::createShared(connectionProvider, connectionHandler);
+      /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler */
+      ServerLifecycle lifecycle(connectionProvider, connectionHandler, server_stop_signal);
 
       /* Print info about server port */
       OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
 
-      /* Run server, let it check a lambda-function if it should continue to run
-       * Return true to keep the server up, return false to stop it.
-       * Treat this function like a ISR: Don't do anything heavy in it! Just check some flags or at max some very
-       * lightweight logic.
-       * The performance of your REST-API depends on this function returning as fast as possible! */
-      std::function<bool()> condition = [](){
-        return server_should_continue.load();
-      };
-
-      /* Run server */
-      serverPtr->run(condition);
-
-      /* Server has shut down, so we dont want to connect any new connections */
-      connectionProvider->stop();
-
-      /* Now stop the connection handler and wait until all running connections are served */
-      connectionHandler->stop();
+      /* Run server until the stop condition is signaled.
+       * The accept loop is woken exactly once when the condition is signaled, nothing is checked per connection.
+       * Then the server, the ServerConnectionProvider and the ConnectionHandler are stopped (in that order)
+       * and all running connections are served */
+      lifecycle.run();
     }
 
     /* Print how much objects were created during app running, and what have left-probably leaked */
     /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
     std::cout << "\nEnvironment:\n";
     std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
-    std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n\n";
+    std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+    /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+    /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+    std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+    /* Print how many connection buffers were reused from the pool and how much memory it still retains.
+     * Only the parking handler (`handler = parking` in the config) takes its buffers from the pool */
+    if(BufferPool::getStats().acquired > 0) {
+      std::cout << BufferPool::formatReport() << "\n";
+    }
 
     oatpp::base::Environment::destroy();
   });
@@ -84,7 +90,7 @@ void run() {
   myBackendLogicDummy();
 
   /* Signal the stop condition */
-  server_should_continue.store(false);
+  server_stop_signal->signal();
 
   /* Check if we have already stopped or if we need to wait for the server to stop */
   if(oatppThread.joinable()) {
@@ -1,7 +1,10 @@
+#include "./controller/MetricsController.hpp"
 #include "./controller/MyController.hpp"
 #include "./AppComponent.hpp"
-
-#include "oatpp/network/Server.hpp"
+#include "./lifecycle/DrainingConnectionHandler.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./memory/BufferPool.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
 
 #include <iostream>
 
@@ -16,7 +19,8 @@ void myBackendLogicDummy() {
 void run() {
 
   /* Register Components in scope of run() method */
-  AppComponent components;
+  /* Listen address, socket options and warm-up come from the file in APP_CONFIG and APP_<KEY> variables, see ServerConfig */
+  AppComponent components(ServerConfig::load());
 
   /* Get router component */
   OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
@@ -24,20 +28,32 @@ void run() {
   /* Create MyController and add all of its endpoints to router */
   router->addController(std::make_shared<MyController>());
 
+  /* Create MetricsController and add its /metrics endpoint to router */
+  router->addController(std::make_shared<MetricsController>());
+
+  /* Warm up - run requests through the router over a virtual interface, pre-fault buffers - then open the port */
+  components.warmUp();
 
   /* Get connection handler component */
   OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
 
+  /* Wrap the thread-per-connection handler so that stopping it takes at most 5 seconds, even with slow keep-alive clients.
+   * The parking handler (`handler = parking` in the config) closes idle connections on stop() by itself */
+  auto serverHandler = connectionHandler;
+  std::shared_ptr<DrainingConnectionHandler> drainingHandler;
+  if(auto httpHandler = std::dynamic_pointer_cast<oatpp::web::server::HttpConnectionHandler>(connectionHandler)) {
+    drainingHandler = DrainingConnectionHandler::createShared(httpHandler, std::chrono::seconds(5));
+    serverHandler = drainingHandler;
+  }
+
   /* Get connection provider component */
   OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
 
-  /* Create server which takes provided TCP connections and passes them to HTTP connection handler */
-  oatpp::network::Server server(connectionProvider, connectionHandler);
+  /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler */
+  ServerLifecycle lifecycle(connectionProvider, serverHandler);
 
-  std::thread oatppThread([&server] {
-    /* Run server */
-    server.run();
-  });
+  /* Run server in its own thread */
+  lifecycle.start();
 
   /* Print info about server port */
   OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
@@ -45,22 +61,14 @@ void run() {
   /* ToDo: Call your logic here! We are just calling some blocking dummy logic here */
   myBackendLogicDummy();
 
-  /* First, stop the ServerConnectionProvider so we don't accept any new connections */
-  connectionProvider->stop();
+  /* Stop the server, the ServerConnectionProvider and the ConnectionHandler (in that order).
+   * Blocks until the server-thread is done and all running connections are closed.
+   * Connections still running after the drain deadline are force-closed */
+  lifecycle.stop();
 
-  /* Now, check if server is still running and stop it if needed */
-  if (server.getStatus() == oatpp::network::Server::STATUS_RUNNING) {
-    server.stop();
-  }
-
-  /* Finally, stop the ConnectionHandler and wait until all running connections are closed */
-  connectionHandler->stop();
-
-  /* Before returning, check if the server-thread has already stopped or if we need to wait for the server to stop */
-  if(oatppThread.joinable()) {
-
-    /* We need to wait until the thread is done */
-    oatppThread.join();
+  if(drainingHandler) {
+    auto report = drainingHandler->getReport();
+    OATPP_LOGI("MyApp", "Connections drained: %lld, aborted: %lld", (long long) report.drained, (long long) report.aborted);
   }
 
 }
@@ -78,7 +86,15 @@ int main(int argc, const char * argv[]) {
   /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
   std::cout << "\nEnvironment:\n";
   std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
-  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n\n";
+  std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+  /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+  /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+  std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+  /* Print how many connection buffers were reused from the pool and how much memory it still retains.
+   * Only the parking handler (`handler = parking` in the config) takes its buffers from the pool */
+  if(BufferPool::getStats().acquired > 0) {
+    std::cout << BufferPool::formatReport() << "\n";
+  }
   
   oatpp::base::Environment::destroy();
   
@@ -1,7 +1,10 @@
+#include "./controller/MetricsController.hpp"
 #include "./controller/MyController.hpp"
 #include "./AppComponent.hpp"
-
-#include "oatpp/network/Server.hpp"
+#include "./lifecycle/DrainingConnectionHandler.hpp"
+#include "./lifecycle/ServerLifecycle.hpp"
+#include "./memory/BufferPool.hpp"
+#include "./telemetry/AllocationTelemetry.hpp"
 
 #include <iostream>
 
@@ -11,7 +14,7 @@ void myBackendLogicDummy() {
 }
 
 /**
- * This example shows how to start the server without and stop it with a call to server::stop();
+ * This example shows how to start the server without and stop it with a call to signal() on the StopSignal of its lifecycle;
  * Some may encounter the situation where the whole Oat++ runtime AND environment should be enclosed in a single thread
  * and its stack. A "full enclosure".
  * WARNING: This also encapsulates the Oat++ environment in the thread. Thus other Oat++ mechanisms like logging is only
@@ -20,23 +23,24 @@ void myBackendLogicDummy() {
  * environments init and destroy in main or their respective scope.
  */
 void run() {
-  /* In this example, we keep the server in a shared pointer and pass a weak pointer to the thread where
-   * it should place a reference to the server. */
-  std::weak_ptr<oatpp::network::Server> weakServerPtr;
+  /* In this example, the thread creates the server lifecycle and places a reference to its stop signal here.
+   * The stop signal is not an Oat++ object, so it is safe to keep it outside of the thread's environment. */
+  std::shared_ptr<StopSignal> stopSignal;
 
   /* Optional race-condition prevention, see big comment further down */
   std::condition_variable race_guard;
   std::mutex race_guard_mutex;
-  std::unique_lock<std::mutex> race_guard_lock(race_guard_mutex);
   bool ready = false;
 
   /**
    * You can't run two of those threads in one application concurrently in this setup. Especially with the AppComponents inside the
    * Threads scope. If you want to run multiple threads with multiple servers you either have to manage the components
    * by yourself and do not rely on the OATPP_COMPONENT mechanism or have one process-global AppComponent.
-   * Further you have to make sure you don't have multiple ServerConnectionProvider listening to the same port.
+   * AppComponent in INSTANCE scope does the former for you, see App_MultiInstance.cpp.
+   * Further you have to make sure you don't have multiple ServerConnectionProvider listening to the same port
+   * unless they share it with SO_REUSEPORT like the servers of a ServerGroup (see App_ServerGroup.cpp).
    */
-  std::thread oatppThread([&weakServerPtr, &race_guard, &ready] {
+  std::thread oatppThread([&stopSignal, &race_guard_mutex, &race_guard, &ready] {
 
     /* Init Oat++ Environment in the scope of the thread */
     oatpp::base::Environment::init();
@@ -44,7 +48,8 @@ void run() {
     /* Have the thread logic in a sub-scope so every Oat++ object is destroyed when we destroy the environment on thread close */
     {
       /* Register Components in scope of run() method */
-      AppComponent components;
+      /* Listen address, socket options and warm-up come from the file in APP_CONFIG and APP_<KEY> variables, see ServerConfig */
+      AppComponent components(ServerConfig::load());
 
       /* Get router component */
       OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router);
@@ -52,39 +57,65 @@ void run() {
       /* Create MyController and add all of its endpoints to router */
       router->addController(std::make_shared<MyController>());
 
+      /* Create MetricsController and add its /metrics endpoint to router */
+      router->addController(std::make_shared<MetricsController>());
+
+      /* Warm up - run requests through the router over a virtual interface, pre-fault buffers - then open the port */
+      components.warmUp();
+
       /* Get connection handler component */
       OATPP_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, connectionHandler);
 
+      /* Wrap the thread-per-connection handler so that stopping it takes at most 5 seconds, even with slow keep-alive clients.
+       * The parking handler (`handler = parking` in the config) closes idle connections on stop() by itself */
+      auto serverHandler = connectionHandler;
+      std::shared_ptr<DrainingConnectionHandler> drainingHandler;
+      if(auto httpHandler = std::dynamic_pointer_cast<oatpp::web::server::HttpConnectionHandler>(connectionHandler)) {
+        drainingHandler = DrainingConnectionHandler::createShared(httpHandler, std::chrono::seconds(5));
+        serverHandler = drainingHandler;
+      }
+
       /* Get connection provider component */
       OATPP_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, connectionProvider);
 
-      /* Create server which takes provided TCP connections and passes them to HTTP connection handler */
-      auto serverPtr = oatpp::network::Server::createShared(connectionProvider, connectionHandler);
-
-      weakServerPtr = serverPtr;
+      /* Create server lifecycle which takes provided TCP connections and passes them to HTTP connection handler */
+      ServerLifecycle lifecycle(connectionProvider, serverHandler);
 
-      /* Unlock the race-guard */
-      ready = true;
+      /* Publish the stop signal and unlock the race-guard */
+      {
+        std::lock_guard<std::mutex> lock(race_guard_mutex);
+        stopSignal = lifecycle.getStopSignal();
+        ready = true;
+      }
       race_guard.notify_one();
 
       /* Print info about server port */
       OATPP_LOGI("MyApp", "Server running on port %s", connectionProvider->getProperty("port").getData());
 
-      /* Run server */
-      serverPtr->run();
+      /* Run server until signal() is called on its stop signal.
+       * Then the server, the ServerConnectionProvider and the ConnectionHandler are stopped (in that order)
+       * and running connections are drained. Connections still running after the deadline are force-closed */
+      lifecycle.run();
 
-      /* Server has shut down, so we dont want to connect any new connections */
-      connectionProvider->stop();
-
-      /* Now stop the connection handler and wait until all running connections are served */
-      connectionHandler->stop();
+      if(drainingHandler) {
+        auto report = drainingHandler->getReport();
+        OATPP_LOGI("MyApp", "Connections drained: %lld, aborted: %lld", (long long) report.drained, (long long) report.aborted);
+      }
     }
 
     /* Print how much objects were created during app running, and what have left-probably leaked */
     /* Disable object counting for release builds using '-D OATPP_DISABLE_ENV_OBJECT_COUNTERS' flag for better performance */
     std::cout << "\nEnvironment:\n";
     std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
-    std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n\n";
+    std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n";
+    /* Print per-type created/live/peak counts of tracked objects - non-zero live counts are probably leaked */
+    /* Compile telemetry out for release builds using the '-D ALLOCATION_TELEMETRY=OFF' CMake option */
+    std::cout << "\n" << AllocationTelemetry::formatReport() << "\n";
+    /* Print how many connection buffers were reused from the pool and how much memory it still retains.
+     * Only the parking handler (`handler = parking` in the config) takes its buffers from the pool */
+    if(BufferPool::getStats().acquired > 0) {
+      std::cout << BufferPool::formatReport() << "\n";
+    }
 
     oatpp::base::Environment::destroy();
   });
@@ -94,20 +125,20 @@ void run() {
 
   /*
    * Warning:
-   * Keep in mind we can have a race-condition here. If myBackendLogicDummy() exits before the weak pointer is assigned
-   * the pointer appears expired and stop() will never be called. Therefore it is advised to have i.E. a condition
+   * Keep in mind we can have a race-condition here. If myBackendLogicDummy() exits before the stop signal is assigned
+   * the pointer is still empty and the stop-command will never be sent. Therefore it is advised to have i.E. a condition
    * variable to prevent this kind of situation. In C++20, a std::binary_semaphore could be used for less lines of code.
    * This is optional if you are 100% positive that your logic will never return this quickly.
    * Also, if you need to have Oat++ up and running before your logic starts, you can move this
    */
-  race_guard.wait(race_guard_lock, [&ready]{return ready;});
-
-  /* Check if the weak pointer to the server instance still valid */
-  if (!weakServerPtr.expired()) {
-    /* Pointer still valid, lock the pointer send the stop-command */
-    weakServerPtr.lock()->stop();
+  {
+    std::unique_lock<std::mutex> race_guard_lock(race_guard_mutex);
+    race_guard.wait(race_guard_lock, [&ready]{return ready;});
   }
 
+  /* Send the stop-command. Signaling a server which is already done is a no-op */
+  stopSignal->signal();
+
   /* Check if we have already stopped or if we need to wait for the server to stop */
   if(oatppThread.joinable()) {
 
@@ -0,0 +1,82 @@
+#ifndef AsyncAppComponent_hpp
+#define AsyncAppComponent_hpp
+
+#include "config/ServerConfig.hpp"
+#include "metrics/RequestMetrics.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/web/server/AsyncHttpConnectionHandler.hpp"
+
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include "oatpp/core/async/Executor.hpp"
+#include "oatpp/core/macro/component.hpp"
+
+/**
+ *  Class which creates and holds Application components for the async (coroutine-based) API
+ *  and registers components in oatpp::base::Environment
+ *  Order of components initialization is from top to bottom
+ */
+class AsyncAppComponent {
+public:
+
+  /**
+   *  Create Async Executor which runs the coroutines of all connections on a fixed number of threads
+   */
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor)([] {
+    return std::make_shared<oatpp::async::Executor>(
+      4 /* Data-Processing threads */,
+      1 /* I/O threads */,
+      1 /* Timer threads */
+    );
+  }());
+
+  /**
+   *  Create ConnectionProvider component which listens on the port.
+   *  Its stop() wakes the accept loop immediately, see ServerLifecycle.
+   *  Address and socket options are read with ServerConfig::load(), like in the threaded examples.
+   */
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ServerConnectionProvider>, serverConnectionProvider)([] {
+    auto config = ServerConfig::load();
+    OATPP_LOGI("AsyncAppComponent", "Server config: %s", config.toString().c_str());
+    return config.createConnectionProvider();
+  }());
+
+  /**
+   *  Create Router component
+   */
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, httpRouter)([] {
+    return oatpp::web::server::HttpRouter::createShared();
+  }());
+
+  /**
+   *  Create RequestMetrics component - per-route counters served by AsyncMetricsController
+   */
+  OATPP_CREATE_COMPONENT(std::shared_ptr<RequestMetrics>, requestMetrics)([] {
+    return RequestMetrics::createShared();
+  }());
+
+  /**
+   *  Create ConnectionHandler component which uses Router component to route requests,
+   *  runs them as coroutines on the Executor component and records them in RequestMetrics component
+   */
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::network::ConnectionHandler>, serverConnectionHandler)([] {
+    OATPP_COMPONENT(std::shared_ptr<oatpp::web::server::HttpRouter>, router); // get Router component
+    OATPP_COMPONENT(std::shared_ptr<oatpp::async::Executor>, executor); // get Async executor component
+    OATPP_COMPONENT(std::shared_ptr<RequestMetrics>, metrics); // get RequestMetrics component
+    auto connectionHandler = oatpp::web::server::AsyncHttpConnectionHandler::createShared(router, executor);
+    connectionHandler->addRequestInterceptor(std::make_shared<RequestMetrics::RequestInterceptor>(metrics));
+    connectionHandler->addResponseInterceptor(std::make_shared<RequestMetrics::ResponseInterceptor>(metrics));
+    return connectionHandler;
+  }());
+
+  /**
+   *  Create ObjectMapper component to serialize/deserialize DTOs in Contoller's API
+   */
+  OATPP_CREATE_COMPONENT(std::shared_ptr<oatpp::data::mapping::ObjectMapper>, apiObjectMapper)([] {
+    return oatpp::parser::json::mapping::ObjectMapper::createShared();
+  }());
+
+};
+
+#endif /* AsyncAppComponent_hpp */
@@ -0,0 +1,102 @@
+#include "CachedResponse.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include <cstdio>
+
+CachedResponse::CachedResponse(const Status& status, const oatpp::String& body, const oatpp::String& contentType)
+  : m_status(status)
+  , m_body(body ? body : oatpp::String(""))
+  , m_contentType(contentType)
+  , m_etag(computeETag(m_body))
+{}
+
+std::shared_ptr<CachedResponse> CachedResponse::createShared(const Status& status,
+                                                             const oatpp::String& body,
+                                                             const oatpp::String& contentType)
+{
+  return std::make_shared<CachedResponse>(status, body, contentType);
+}
+
+std::shared_ptr<CachedResponse> CachedResponse::createDtoResponse(const Status& status,
+                                                                  const oatpp::Void& dto,
+                                                                  const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper)
+{
+  return createShared(status, objectMapper->writeToString(dto), objectMapper->getInfo().http_content_type);
+}
+
+oatpp::String CachedResponse::computeETag(const oatpp::String& body) {
+
+  /* FNV-1a 64 - strong enough to tell versions of the same resource apart */
+  v_uint64 hash = 14695981039346656037ULL;
+  for(auto c : *body) {
+    hash ^= (v_uint8) c;
+    hash *= 1099511628211ULL;
+  }
+
+  char buffer[24];
+  std::snprintf(buffer, sizeof(buffer), "\"%016llx\"", (unsigned long long) hash);
+  return oatpp::String(buffer);
+
+}
+
+bool CachedResponse::matches(const oatpp::String& ifNoneMatch) const {
+
+  const std::string& value = *ifNoneMatch;
+  const std::string& etag = *m_etag;
+
+  /* If-None-Match: "a", W/"b", ... or * */
+  size_t pos = 0;
+  while(pos < value.size()) {
+
+    auto end = value.find(',', pos);
+    if(end == std::string::npos) {
+      end = value.size();
+    }
+
+    auto begin = value.find_first_not_of(" \t", pos);
+    auto last = value.find_last_not_of(" \t", end - 1);
+
+    if(begin != std::string::npos && begin < end && last != std::string::npos && last >= begin) {
+      if(value.compare(begin, 2, "W/") == 0) {
+        begin += 2; // weak comparison
+      }
+      auto size = last - begin + 1;
+      if((size == 1 && value[begin] == '*') || value.compare(begin, size, etag) == 0) {
+        return true;
+      }
+    }
+
+    pos = end + 1;
+
+  }
+
+  return false;
+
+}
+
+std::shared_ptr<CachedResponse::OutgoingResponse> CachedResponse::respond(const std::shared_ptr<IncomingRequest>& request) const {
+
+  if(request) {
+    auto ifNoneMatch = request->getHeader("If-None-Match");
+    if(ifNoneMatch && matches(ifNoneMatch)) {
+      auto response = OutgoingResponse::createShared(Status::CODE_304, nullptr);
+      response->putHeader("ETag", m_etag);
+      return response;
+    }
+  }
+
+  auto body = oatpp::web::protocol::http::outgoing::BufferBody::createShared(m_body, m_contentType);
+  auto response = OutgoingResponse::createShared(m_status, body);
+  response->putHeader("ETag", m_etag);
+  return response;
+
+}
+
+const oatpp::String& CachedResponse::getETag() const {
+  return m_etag;
+}
+
+const oatpp::String& CachedResponse::getBody() const {
+  return m_body;
+}
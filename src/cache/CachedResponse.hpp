@@ -0,0 +1,82 @@
+#ifndef CachedResponse_hpp
+#define CachedResponse_hpp
+
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/protocol/http/incoming/Request.hpp"
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/core/data/mapping/ObjectMapper.hpp"
+
+/**
+ * Pre-serialized response for endpoints whose payload never changes.
+ * The body is serialized once and kept in an immutable shared buffer together with its ETag.
+ * Every request gets a new response object which references that buffer - nothing is copied or serialized again.
+ * Requests with a matching `If-None-Match` get `304 Not Modified` without a body.
+ */
+class CachedResponse : public AllocationTracked<CachedResponse> {
+public:
+  typedef oatpp::web::protocol::http::Status Status;
+  typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+  typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+private:
+  Status m_status;
+  oatpp::String m_body;
+  oatpp::String m_contentType;
+  oatpp::String m_etag;
+private:
+  static oatpp::String computeETag(const oatpp::String& body);
+  bool matches(const oatpp::String& ifNoneMatch) const;
+public:
+
+  /**
+   * Constructor.
+   * @param status - status of the full response.
+   * @param body - serialized body.
+   * @param contentType - value of the `Content-Type` header.
+   */
+  CachedResponse(const Status& status, const oatpp::String& body, const oatpp::String& contentType);
+
+  /**
+   * Create shared CachedResponse.
+   * @param status - status of the full response.
+   * @param body - serialized body.
+   * @param contentType - value of the `Content-Type` header.
+   * @return - `std::shared_ptr` to CachedResponse.
+   */
+  static std::shared_ptr<CachedResponse> createShared(const Status& status,
+                                                      const oatpp::String& body,
+                                                      const oatpp::String& contentType);
+
+  /**
+   * Serialize DTO once, same as `ApiController::createDtoResponse()` does on every call.
+   * @param status - status of the full response.
+   * @param dto - DTO to serialize.
+   * @param objectMapper - mapper used for serialization and `Content-Type`.
+   * @return - `std::shared_ptr` to CachedResponse.
+   */
+  static std::shared_ptr<CachedResponse> createDtoResponse(const Status& status,
+                                                           const oatpp::Void& dto,
+                                                           const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper);
+
+  /**
+   * Create response for the request.
+   * @param request - incoming request. May be `nullptr`, then the full response is returned.
+   * @return - `304 Not Modified` if `If-None-Match` matches the ETag, otherwise the full response.
+   */
+  std::shared_ptr<OutgoingResponse> respond(const std::shared_ptr<IncomingRequest>& request) const;
+
+  /**
+   * Get ETag (quoted, as sent in the header).
+   * @return
+   */
+  const oatpp::String& getETag() const;
+
+  /**
+   * Get serialized body.
+   * @return
+   */
+  const oatpp::String& getBody() const;
+
+};
+
+#endif /* CachedResponse_hpp */
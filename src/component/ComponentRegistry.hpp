@@ -0,0 +1,69 @@
+#ifndef ComponentRegistry_hpp
+#define ComponentRegistry_hpp
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+/**
+ * Instance-scoped component container.
+ * Same lookup model as `OATPP_CREATE_COMPONENT`/`OATPP_COMPONENT` - by type and optional qualifier - but components
+ * live in the registry object instead of the process-global `oatpp::base::Environment`.
+ * Several registries with components of the same type can exist at the same time.
+ */
+class ComponentRegistry {
+private:
+  std::unordered_map<std::string, std::shared_ptr<void>> m_components;
+private:
+
+  template<class T>
+  static std::string makeKey(const std::string& qualifier) {
+    return std::string(typeid(T).name()) + "::" + qualifier;
+  }
+
+public:
+
+  /**
+   * Put component. Replaces component of the same type and qualifier.
+   * @tparam T - component type, usually `std::shared_ptr<...>`.
+   * @param component
+   * @param qualifier
+   */
+  template<class T>
+  void put(const T& component, const std::string& qualifier = "") {
+    m_components[makeKey<T>(qualifier)] = std::make_shared<T>(component);
+  }
+
+  /**
+   * Get component.
+   * @tparam T - component type, usually `std::shared_ptr<...>`.
+   * @param qualifier
+   * @return - component.
+   * @throws - `std::runtime_error` if there is no such component.
+   */
+  template<class T>
+  const T& get(const std::string& qualifier = "") const {
+    auto it = m_components.find(makeKey<T>(qualifier));
+    if(it == m_components.end()) {
+      throw std::runtime_error("[ComponentRegistry::get()]: Error. Component of given type doesn't exist: type='"
+                               + std::string(typeid(T).name()) + "', qualifier='" + qualifier + "'");
+    }
+    return *std::static_pointer_cast<T>(it->second);
+  }
+
+  /**
+   * Check if registry has component.
+   * @tparam T - component type.
+   * @param qualifier
+   * @return - `true` if component exists.
+   */
+  template<class T>
+  bool contains(const std::string& qualifier = "") const {
+    return m_components.find(makeKey<T>(qualifier)) != m_components.end();
+  }
+
+};
+
+#endif /* ComponentRegistry_hpp */
@@ -0,0 +1,54 @@
+#include "CompressedBody.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+CompressedBody::CompressedBody(const std::shared_ptr<Body>& body, std::unique_ptr<Compressor> compressor, v_buff_size chunkSize)
+  : m_body(body)
+  , m_compressor(std::move(compressor))
+  , m_chunkSize(chunkSize)
+  , m_input(new v_char8[chunkSize])
+  , m_outputPosition(0)
+  , m_finished(false)
+{}
+
+oatpp::v_io_size CompressedBody::read(void *buffer, v_buff_size count, oatpp::async::Action& action) {
+
+  /* Compress chunks of the source until there is output - the compressor may keep small chunks for itself */
+  while(m_outputPosition == m_output.size()) {
+
+    if(m_finished) {
+      return 0;
+    }
+
+    m_output.clear();
+    m_outputPosition = 0;
+
+    auto res = m_body->read(m_input.get(), m_chunkSize, action);
+    if(res < 0) {
+      return res;
+    }
+
+    m_finished = (res == 0);
+    m_compressor->write(m_input.get(), res, m_finished, m_output);
+
+  }
+
+  auto size = std::min<size_t>((size_t) count, m_output.size() - m_outputPosition);
+  std::memcpy(buffer, m_output.data() + m_outputPosition, size);
+  m_outputPosition += size;
+  return (oatpp::v_io_size) size;
+
+}
+
+void CompressedBody::declareHeaders(Headers& headers) {
+  m_body->declareHeaders(headers);
+}
+
+p_char8 CompressedBody::getKnownData() {
+  return nullptr;
+}
+
+v_int64 CompressedBody::getKnownSize() {
+  return -1;
+}
@@ -0,0 +1,62 @@
+#ifndef CompressedBody_hpp
+#define CompressedBody_hpp
+
+#include "Compressor.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+
+/**
+ * Body which compresses another body while the connection reads it.
+ * The source is read `chunkSize` bytes at a time and each chunk goes through the &l:Compressor; - neither the whole
+ * source nor the whole compressed stream is ever in memory. The size is not known, so the response is sent with
+ * `Transfer-Encoding: chunked`.
+ */
+class CompressedBody : public oatpp::web::protocol::http::outgoing::Body {
+private:
+  std::shared_ptr<Body> m_body;
+  std::unique_ptr<Compressor> m_compressor;
+  v_buff_size m_chunkSize;
+  std::unique_ptr<v_char8[]> m_input;
+  std::string m_output;
+  size_t m_outputPosition;
+  bool m_finished;
+public:
+
+  /**
+   * Constructor.
+   * @param body - source body.
+   * @param compressor - compressor of a new stream.
+   * @param chunkSize - bytes read from the source per compression step.
+   */
+  CompressedBody(const std::shared_ptr<Body>& body, std::unique_ptr<Compressor> compressor, v_buff_size chunkSize);
+
+  /**
+   * Read the next part of the compressed stream.
+   * @param buffer
+   * @param count
+   * @param action
+   * @return - bytes read, `0` at the end of the stream, or the error of the source body.
+   */
+  oatpp::v_io_size read(void *buffer, v_buff_size count, oatpp::async::Action& action) override;
+
+  /**
+   * Headers of the source body.
+   * @param headers
+   */
+  void declareHeaders(Headers& headers) override;
+
+  /**
+   * Data is not in memory.
+   * @return - `nullptr`.
+   */
+  p_char8 getKnownData() override;
+
+  /**
+   * Size is not known.
+   * @return - `-1`.
+   */
+  v_int64 getKnownSize() override;
+
+};
+
+#endif /* CompressedBody_hpp */
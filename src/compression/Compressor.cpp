@@ -0,0 +1,153 @@
+#include "Compressor.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#ifdef APP_WITH_BROTLI
+#include <brotli/encode.h>
+#endif
+
+namespace {
+
+/* Output is appended in steps of this size */
+constexpr size_t OUTPUT_STEP = 16 * 1024;
+
+class ZlibCompressor : public Compressor {
+private:
+  z_stream m_stream;
+public:
+
+  ZlibCompressor(Encoding encoding, v_int32 level) {
+    std::memset(&m_stream, 0, sizeof(m_stream));
+    /* 15 - zlib wrapper (HTTP deflate), 16 + 15 - gzip wrapper */
+    int windowBits = encoding == Encoding::GZIP ? 16 + 15 : 15;
+    if(deflateInit2(&m_stream, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw std::runtime_error("[Compressor::create()]: Error. Can't initialize zlib stream.");
+    }
+  }
+
+  ~ZlibCompressor() override {
+    deflateEnd(&m_stream);
+  }
+
+  void write(const void* data, v_buff_size size, bool finish, std::string& out) override {
+
+    m_stream.next_in = (Bytef*) data;
+    m_stream.avail_in = (uInt) size;
+
+    while(true) {
+
+      auto offset = out.size();
+      out.resize(offset + OUTPUT_STEP);
+      m_stream.next_out = (Bytef*) &out[offset];
+      m_stream.avail_out = (uInt) OUTPUT_STEP;
+
+      auto res = deflate(&m_stream, finish ? Z_FINISH : Z_NO_FLUSH);
+      out.resize(offset + OUTPUT_STEP - m_stream.avail_out);
+
+      if(res == Z_STREAM_ERROR) {
+        throw std::runtime_error("[Compressor::write()]: Error. zlib stream error.");
+      }
+
+      /* Without flush zlib stops with free output space only once all input is taken */
+      if(finish ? res == Z_STREAM_END : m_stream.avail_out != 0) {
+        break;
+      }
+
+    }
+
+  }
+
+};
+
+#ifdef APP_WITH_BROTLI
+
+class BrotliCompressor : public Compressor {
+private:
+  BrotliEncoderState* m_state;
+public:
+
+  BrotliCompressor(v_int32 quality)
+    : m_state(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr))
+  {
+    if(m_state == nullptr) {
+      throw std::runtime_error("[Compressor::create()]: Error. Can't create brotli encoder.");
+    }
+    BrotliEncoderSetParameter(m_state, BROTLI_PARAM_QUALITY, (uint32_t) quality);
+  }
+
+  ~BrotliCompressor() override {
+    BrotliEncoderDestroyInstance(m_state);
+  }
+
+  void write(const void* data, v_buff_size size, bool finish, std::string& out) override {
+
+    auto nextIn = (const uint8_t*) data;
+    size_t availIn = (size_t) size;
+
+    while(true) {
+
+      auto offset = out.size();
+      out.resize(offset + OUTPUT_STEP);
+      auto nextOut = (uint8_t*) &out[offset];
+      size_t availOut = OUTPUT_STEP;
+
+      auto ok = BrotliEncoderCompressStream(m_state, finish ? BROTLI_OPERATION_FINISH : BROTLI_OPERATION_PROCESS,
+                                            &availIn, &nextIn, &availOut, &nextOut, nullptr);
+      out.resize(offset + OUTPUT_STEP - availOut);
+
+      if(!ok) {
+        throw std::runtime_error("[Compressor::write()]: Error. brotli stream error.");
+      }
+
+      if(finish ? BrotliEncoderIsFinished(m_state) : availIn == 0 && !BrotliEncoderHasMoreOutput(m_state)) {
+        break;
+      }
+
+    }
+
+  }
+
+};
+
+#endif
+
+}
+
+const char* Compressor::getEncodingName(Encoding encoding) {
+  switch(encoding) {
+    case Encoding::GZIP: return "gzip";
+    case Encoding::DEFLATE: return "deflate";
+    case Encoding::BROTLI: return "br";
+  }
+  return nullptr;
+}
+
+bool Compressor::isSupported(Encoding encoding) {
+#ifdef APP_WITH_BROTLI
+  (void) encoding;
+  return true;
+#else
+  return encoding != Encoding::BROTLI;
+#endif
+}
+
+std::unique_ptr<Compressor> Compressor::create(Encoding encoding, v_int32 level) {
+  if(encoding == Encoding::BROTLI) {
+#ifdef APP_WITH_BROTLI
+    return std::unique_ptr<Compressor>(new BrotliCompressor(level));
+#else
+    throw std::runtime_error("[Compressor::create()]: Error. Built without brotli.");
+#endif
+  }
+  return std::unique_ptr<Compressor>(new ZlibCompressor(encoding, level));
+}
+
+std::string Compressor::compress(Encoding encoding, v_int32 level, const void* data, v_buff_size size) {
+  std::string result;
+  result.reserve((size_t) size / 4 + OUTPUT_STEP);
+  create(encoding, level)->write(data, size, true, result);
+  return result;
+}
@@ -0,0 +1,78 @@
+#ifndef Compressor_hpp
+#define Compressor_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <memory>
+#include <string>
+
+/**
+ * Streaming compressor of one `Content-Encoding`.
+ * gzip and deflate (zlib format, which is what HTTP calls `deflate`) come from zlib. brotli is available only if the
+ * project is built with libbrotlienc (`APP_WITH_BROTLI`, see CMakeLists.txt) - check &l:Compressor::isSupported ();.
+ */
+class Compressor {
+public:
+
+  /**
+   * Content encoding.
+   */
+  enum class Encoding {
+    GZIP,
+    DEFLATE,
+    BROTLI
+  };
+
+public:
+
+  /**
+   * Get the name of the encoding as in `Content-Encoding`.
+   * @param encoding
+   * @return - `"gzip"`, `"deflate"` or `"br"`.
+   */
+  static const char* getEncodingName(Encoding encoding);
+
+  /**
+   * Check if the encoding is compiled in.
+   * @param encoding
+   * @return
+   */
+  static bool isSupported(Encoding encoding);
+
+  /**
+   * Create compressor.
+   * @param encoding - must be supported.
+   * @param level - zlib level `1..9` for gzip and deflate, quality `0..11` for brotli.
+   * @return - compressor of a new stream.
+   */
+  static std::unique_ptr<Compressor> create(Encoding encoding, v_int32 level);
+
+  /**
+   * Compress a whole buffer.
+   * @param encoding - must be supported.
+   * @param level - see &l:Compressor::create ();.
+   * @param data
+   * @param size
+   * @return - complete compressed stream.
+   */
+  static std::string compress(Encoding encoding, v_int32 level, const void* data, v_buff_size size);
+
+public:
+
+  /**
+   * Virtual Destructor.
+   */
+  virtual ~Compressor() = default;
+
+  /**
+   * Compress the next part of the stream.
+   * @param data - input.
+   * @param size - input size, may be `0`.
+   * @param finish - `true` for the last part - the end of the stream is written too. Don't write after that.
+   * @param out - compressed bytes are appended here. Nothing may be appended until enough input is collected.
+   */
+  virtual void write(const void* data, v_buff_size size, bool finish, std::string& out) = 0;
+
+};
+
+#endif /* Compressor_hpp */
@@ -0,0 +1,335 @@
+#include "ResponseCompression.hpp"
+
+#include "CompressedBody.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+typedef oatpp::web::protocol::http::Header Header;
+
+/* In order of preference */
+const Compressor::Encoding ENCODINGS[] = {Compressor::Encoding::BROTLI, Compressor::Encoding::GZIP, Compressor::Encoding::DEFLATE};
+
+void trim(const std::string& str, size_t& begin, size_t& end) {
+  while(begin < end && (str[begin] == ' ' || str[begin] == '\t')) {
+    begin ++;
+  }
+  while(end > begin && (str[end - 1] == ' ' || str[end - 1] == '\t')) {
+    end --;
+  }
+}
+
+bool equalsIgnoreCase(const std::string& str, size_t begin, size_t end, const char* value) {
+  for(auto i = begin; i < end; i ++, value ++) {
+    if(*value == 0 || std::tolower((unsigned char) str[i]) != *value) {
+      return false;
+    }
+  }
+  return *value == 0;
+}
+
+std::string toLower(const std::string& str) {
+  std::string result(str);
+  for(auto& c : result) {
+    c = (char) std::tolower((unsigned char) c);
+  }
+  return result;
+}
+
+/**
+ * `q` parameter of an `Accept-Encoding` element - `1` if there is none.
+ */
+double parseQuality(const std::string& str, size_t begin, size_t end) {
+  while(begin < end) {
+    auto next = str.find(';', begin);
+    if(next == std::string::npos || next > end) {
+      next = end;
+    }
+    auto paramBegin = begin;
+    auto paramEnd = next;
+    trim(str, paramBegin, paramEnd);
+    if(paramEnd - paramBegin > 2 && std::tolower((unsigned char) str[paramBegin]) == 'q' && str[paramBegin + 1] == '=') {
+      return std::strtod(str.substr(paramBegin + 2, paramEnd - paramBegin - 2).c_str(), nullptr);
+    }
+    begin = next + 1;
+  }
+  return 1;
+}
+
+void addVary(ResponseCompression::OutgoingResponse& response) {
+  auto vary = response.getHeader("Vary");
+  if(!vary) {
+    response.putHeader("Vary", "Accept-Encoding");
+    return;
+  }
+  auto lower = toLower(*vary);
+  if(lower.find("accept-encoding") == std::string::npos && lower.find('*') == std::string::npos) {
+    response.getHeaders().putOrReplace("Vary", oatpp::String(*vary + ", Accept-Encoding"));
+  }
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ResponseCompression::ResponseInterceptor
+
+ResponseCompression::ResponseInterceptor::ResponseInterceptor(const std::shared_ptr<ResponseCompression>& compression)
+  : m_compression(compression)
+{}
+
+std::shared_ptr<ResponseCompression::OutgoingResponse>
+ResponseCompression::ResponseInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request,
+                                                    const std::shared_ptr<OutgoingResponse>& response)
+{
+  if(!request || !response) {
+    return response;
+  }
+  return m_compression->compress(request, response);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ResponseCompression
+
+ResponseCompression::ResponseCompression(const Config& config)
+  : m_config(config)
+  , m_brotli(Compressor::isSupported(Encoding::BROTLI))
+  , m_buffered(0)
+  , m_streamed(0)
+  , m_cacheHits(0)
+  , m_cacheBytes(0)
+  , m_cacheEvictions(0)
+{}
+
+std::shared_ptr<ResponseCompression> ResponseCompression::createShared(const Config& config) {
+  return std::make_shared<ResponseCompression>(config);
+}
+
+bool ResponseCompression::selectEncoding(const oatpp::String& acceptEncoding, bool brotli, Encoding& encoding) {
+
+  if(!acceptEncoding) {
+    return false;
+  }
+
+  const std::string& value = *acceptEncoding;
+
+  /* q-value of br, gzip, deflate and '*' - negative if not listed */
+  double quality[3] = {-1, -1, -1};
+  double any = -1;
+
+  size_t pos = 0;
+  while(pos < value.size()) {
+
+    auto end = value.find(',', pos);
+    if(end == std::string::npos) {
+      end = value.size();
+    }
+
+    auto nameEnd = value.find(';', pos);
+    if(nameEnd == std::string::npos || nameEnd > end) {
+      nameEnd = end;
+    }
+
+    auto nameBegin = pos;
+    trim(value, nameBegin, nameEnd);
+    auto q = parseQuality(value, nameEnd, end);
+
+    if(equalsIgnoreCase(value, nameBegin, nameEnd, "br")) {
+      quality[0] = q;
+    } else if(equalsIgnoreCase(value, nameBegin, nameEnd, "gzip") || equalsIgnoreCase(value, nameBegin, nameEnd, "x-gzip")) {
+      quality[1] = q;
+    } else if(equalsIgnoreCase(value, nameBegin, nameEnd, "deflate")) {
+      quality[2] = q;
+    } else if(equalsIgnoreCase(value, nameBegin, nameEnd, "*")) {
+      any = q;
+    }
+
+    pos = end + 1;
+
+  }
+
+  /* Highest q wins, ties go to the preferred encoding. q=0 means "not acceptable" */
+  double best = 0;
+  bool found = false;
+  for(v_int32 i = 0; i < 3; i ++) {
+    if(i == 0 && !brotli) {
+      continue;
+    }
+    auto q = quality[i] >= 0 ? quality[i] : (any >= 0 ? any : 0);
+    if(q > best) {
+      best = q;
+      encoding = ENCODINGS[i];
+      found = true;
+    }
+  }
+
+  return found;
+
+}
+
+bool ResponseCompression::isCompressible(const oatpp::String& contentType) {
+
+  if(!contentType) {
+    return false;
+  }
+
+  auto type = toLower(*contentType);
+  auto end = type.find(';');
+  if(end != std::string::npos) {
+    type.resize(end);
+  }
+  size_t begin = 0;
+  end = type.size();
+  trim(type, begin, end);
+  type = type.substr(begin, end - begin);
+
+  auto endsWith = [&type](const char* suffix, size_t size) {
+    return type.size() >= size && type.compare(type.size() - size, size, suffix) == 0;
+  };
+
+  return type.compare(0, 5, "text/") == 0
+         || type == "application/json"
+         || type == "application/javascript"
+         || type == "application/xml"
+         || type == "image/svg+xml"
+         || endsWith("+json", 5)
+         || endsWith("+xml", 4);
+
+}
+
+v_int32 ResponseCompression::getLevel(Encoding encoding) const {
+  return encoding == Encoding::BROTLI ? m_config.brotliQuality : m_config.level;
+}
+
+oatpp::String ResponseCompression::compressCached(const std::string& key, Encoding encoding, const void* data, v_buff_size size) {
+
+  {
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto it = m_cache.find(key);
+    if(it != m_cache.end()) {
+      m_cacheOrder.splice(m_cacheOrder.begin(), m_cacheOrder, it->second.position);
+      m_cacheHits.fetch_add(1, std::memory_order_relaxed);
+      return it->second.body;
+    }
+  }
+
+  /* Outside of the lock - concurrent first requests may compress the same body twice, only one copy is kept */
+  oatpp::String compressed(Compressor::compress(encoding, getLevel(encoding), data, size));
+  m_buffered.fetch_add(1, std::memory_order_relaxed);
+
+  auto compressedSize = (v_int64) compressed->size();
+  if(compressedSize > m_config.cacheMaxBytes) {
+    return compressed;
+  }
+
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  if(m_cache.find(key) != m_cache.end()) {
+    return compressed;
+  }
+
+  while(m_cacheBytes + compressedSize > m_config.cacheMaxBytes) {
+    auto it = m_cache.find(m_cacheOrder.back());
+    m_cacheBytes -= (v_int64) it->second.body->size();
+    m_cache.erase(it);
+    m_cacheOrder.pop_back();
+    m_cacheEvictions ++;
+  }
+
+  m_cacheOrder.push_front(key);
+  CacheEntry entry = {compressed, m_cacheOrder.begin()};
+  m_cache.emplace(key, entry);
+  m_cacheBytes += compressedSize;
+
+  return compressed;
+
+}
+
+std::shared_ptr<ResponseCompression::OutgoingResponse>
+ResponseCompression::compress(const std::shared_ptr<IncomingRequest>& request, const std::shared_ptr<OutgoingResponse>& response) {
+
+  auto body = response->getBody();
+  if(!body) {
+    return response;
+  }
+
+  auto code = response->getStatus().code;
+  if(code < 200 || code == 204 || code == 206 || code == 304) {
+    return response;
+  }
+
+  if(response->getHeader(Header::CONTENT_ENCODING) || response->getHeader(Header::CONTENT_LENGTH) || response->getHeader("Content-Range")) {
+    return response;
+  }
+
+  /* The body may be replaced - its Content-Type goes to the response headers */
+  body->declareHeaders(response->getHeaders());
+  if(!isCompressible(response->getHeader(Header::CONTENT_TYPE))) {
+    return response;
+  }
+
+  auto size = body->getKnownSize();
+  if(size >= 0 && size < m_config.minSize) {
+    return response;
+  }
+
+  addVary(*response);
+
+  Encoding encoding;
+  if(!selectEncoding(request->getHeader("Accept-Encoding"), m_brotli, encoding)) {
+    return response;
+  }
+
+  auto etag = response->getHeader("ETag");
+  bool strongETag = etag && etag->compare(0, 2, "W/") != 0;
+
+  std::shared_ptr<oatpp::web::protocol::http::outgoing::Body> compressedBody;
+
+  auto data = body->getKnownData();
+  if(data != nullptr && size >= 0) {
+
+    oatpp::String compressed;
+    if(strongETag) {
+      /* A strong ETag identifies the bytes - same ETag, same body, whatever the path and query it was served on */
+      auto key = *etag + "\n" + Compressor::getEncodingName(encoding);
+      compressed = compressCached(key, encoding, data, size);
+    } else if(size <= m_config.bufferedMaxSize) {
+      compressed = oatpp::String(Compressor::compress(encoding, getLevel(encoding), data, size));
+      m_buffered.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if(compressed) {
+      compressedBody = oatpp::web::protocol::http::outgoing::BufferBody::createShared(compressed, nullptr);
+    }
+
+  }
+
+  if(!compressedBody) {
+    compressedBody = std::make_shared<CompressedBody>(body, Compressor::create(encoding, getLevel(encoding)), m_config.chunkSize);
+    m_streamed.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  auto result = OutgoingResponse::createShared(response->getStatus(), compressedBody);
+  result->getHeaders() = response->getHeaders();
+  result->putHeader(Header::CONTENT_ENCODING, Compressor::getEncodingName(encoding));
+  if(strongETag) {
+    result->getHeaders().putOrReplace("ETag", oatpp::String("W/" + *etag));
+  }
+
+  return result;
+
+}
+
+ResponseCompression::Stats ResponseCompression::getStats() const {
+  Stats stats;
+  stats.buffered = m_buffered.load(std::memory_order_relaxed);
+  stats.streamed = m_streamed.load(std::memory_order_relaxed);
+  stats.cacheHits = m_cacheHits.load(std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(m_cacheMutex);
+  stats.cacheEvictions = m_cacheEvictions;
+  stats.cacheEntries = (v_int64) m_cache.size();
+  stats.cacheBytes = m_cacheBytes;
+  return stats;
+}
@@ -0,0 +1,198 @@
+#ifndef ResponseCompression_hpp
+#define ResponseCompression_hpp
+
+#include "Compressor.hpp"
+
+#include "oatpp/web/server/interceptor/ResponseInterceptor.hpp"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Negotiated `Content-Encoding` of responses - gzip, deflate and, if built with it, brotli.
+ * The encoding is picked from `Accept-Encoding` (q-values honored, brotli preferred, then gzip, then deflate).
+ * Only compressible types (`text/...`, JSON, JavaScript, XML, SVG) are encoded, and only bodies of at least
+ * `minSize` bytes. Such responses get `Vary: Accept-Encoding` whether they are encoded or not.
+ * - A body in memory with a strong ETag (e.g. &l:CachedResponse;) is compressed once per ETag and encoding and the
+ * compressed variant is served from a cache afterwards. Its ETag becomes weak, as the bytes differ.
+ * - Other bodies in memory up to `bufferedMaxSize` are compressed in one go and sent with `Content-Length`.
+ * - Larger bodies and streamed ones (&l:JsonArrayReadCallback;, &l:FileBody;) are wrapped in a &l:CompressedBody;
+ * which compresses them chunk by chunk while the response is written.
+ * Partial (`206`) and already encoded responses are left as they are.
+ *
+ * Attach &l:ResponseCompression::ResponseInterceptor; to a connection handler as the last response interceptor.
+ */
+class ResponseCompression {
+public:
+  typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+  typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+  typedef Compressor::Encoding Encoding;
+public:
+
+  /**
+   * Compression settings.
+   */
+  struct Config {
+
+    /**
+     * zlib level of gzip and deflate, `1` (fastest) to `9` (smallest).
+     */
+    v_int32 level = 6;
+
+    /**
+     * Quality of brotli, `0` to `11`.
+     */
+    v_int32 brotliQuality = 5;
+
+    /**
+     * Bodies of a known size below this are sent as they are - the saved bytes don't pay for the CPU.
+     */
+    v_int64 minSize = 1024;
+
+    /**
+     * Bodies in memory up to this size are compressed in one go. Larger ones are streamed.
+     */
+    v_int64 bufferedMaxSize = 256 * 1024;
+
+    /**
+     * Bytes read from a streamed body per compression step.
+     */
+    v_buff_size chunkSize = 16 * 1024;
+
+    /**
+     * Max bytes of compressed variants kept in the cache. Least recently used variants are evicted to make room for
+     * new ones. `0` - no cache.
+     */
+    v_int64 cacheMaxBytes = 16 * 1024 * 1024;
+
+  };
+
+  /**
+   * Counters.
+   */
+  struct Stats {
+
+    /**
+     * Responses compressed in one go, cache misses included.
+     */
+    v_int64 buffered;
+
+    /**
+     * Responses compressed while they were written.
+     */
+    v_int64 streamed;
+
+    /**
+     * Responses served from the cache of compressed variants.
+     */
+    v_int64 cacheHits;
+
+    /**
+     * Compressed variants evicted from the cache to make room for others.
+     */
+    v_int64 cacheEvictions;
+
+    /**
+     * Compressed variants in the cache.
+     */
+    v_int64 cacheEntries;
+
+    /**
+     * Bytes of compressed variants in the cache.
+     */
+    v_int64 cacheBytes;
+
+  };
+
+public:
+
+  /**
+   * Compresses the response if the client accepts it.
+   */
+  class ResponseInterceptor : public oatpp::web::server::interceptor::ResponseInterceptor {
+  private:
+    std::shared_ptr<ResponseCompression> m_compression;
+  public:
+    ResponseInterceptor(const std::shared_ptr<ResponseCompression>& compression);
+    std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                                const std::shared_ptr<OutgoingResponse>& response) override;
+  };
+
+private:
+  Config m_config;
+  bool m_brotli;
+  std::atomic<v_int64> m_buffered;
+  std::atomic<v_int64> m_streamed;
+  std::atomic<v_int64> m_cacheHits;
+private:
+
+  /**
+   * Compressed variant and its place in the LRU order.
+   */
+  struct CacheEntry {
+    oatpp::String body;
+    std::list<std::string>::iterator position;
+  };
+
+private:
+  /* Compressed variants by ETag and encoding, guarded by m_cacheMutex. Keys in m_cacheOrder - most recently used first */
+  mutable std::mutex m_cacheMutex;
+  std::unordered_map<std::string, CacheEntry> m_cache;
+  std::list<std::string> m_cacheOrder;
+  v_int64 m_cacheBytes;
+  v_int64 m_cacheEvictions;
+private:
+  v_int32 getLevel(Encoding encoding) const;
+  oatpp::String compressCached(const std::string& key, Encoding encoding, const void* data, v_buff_size size);
+public:
+
+  /**
+   * Constructor.
+   * @param config - &l:ResponseCompression::Config;.
+   */
+  ResponseCompression(const Config& config);
+
+  /**
+   * Create shared ResponseCompression.
+   * @param config - &l:ResponseCompression::Config;.
+   * @return - `std::shared_ptr` to ResponseCompression.
+   */
+  static std::shared_ptr<ResponseCompression> createShared(const Config& config);
+
+  /**
+   * Pick the encoding of a response.
+   * @param acceptEncoding - value of `Accept-Encoding`, may be `nullptr`.
+   * @param brotli - whether brotli may be picked.
+   * @param encoding - the picked encoding.
+   * @return - `false` if no supported encoding is acceptable - send the body as it is.
+   */
+  static bool selectEncoding(const oatpp::String& acceptEncoding, bool brotli, Encoding& encoding);
+
+  /**
+   * Check if bodies of the type are worth compressing.
+   * @param contentType - value of `Content-Type`, may be `nullptr`.
+   * @return
+   */
+  static bool isCompressible(const oatpp::String& contentType);
+
+  /**
+   * Compress the response for the request if possible.
+   * @param request
+   * @param response
+   * @return - the compressed response, or `response` as it is.
+   */
+  std::shared_ptr<OutgoingResponse> compress(const std::shared_ptr<IncomingRequest>& request,
+                                             const std::shared_ptr<OutgoingResponse>& response);
+
+  /**
+   * Get counters.
+   * @return - &l:ResponseCompression::Stats;.
+   */
+  Stats getStats() const;
+
+};
+
+#endif /* ResponseCompression_hpp */
@@ -0,0 +1,247 @@
+#include "ServerConfig.hpp"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+constexpr const char* ServerConfig::FILE_VARIABLE;
+constexpr const char* ServerConfig::ENVIRONMENT_PREFIX;
+
+namespace {
+
+const char* const KEYS[] = {
+  "host", "port", "family", "backlog", "so_rcvbuf", "so_sndbuf",
+  "tcp_nodelay", "tcp_defer_accept", "tcp_fastopen", "ipv6_dualstack", "reuse_port",
+  "warm_up", "warm_up_paths", "warm_up_requests",
+  "handler", "workers", "idle_timeout_ms"
+};
+
+constexpr v_int32 DEFAULT_WORKERS = 16;
+constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT(5000);
+
+std::string trim(const std::string& str) {
+  auto begin = str.find_first_not_of(" \t\r\n");
+  if(begin == std::string::npos) {
+    return "";
+  }
+  auto end = str.find_last_not_of(" \t\r\n");
+  return str.substr(begin, end - begin + 1);
+}
+
+std::string toLower(std::string str) {
+  for(auto& c : str) {
+    c = (char) std::tolower((unsigned char) c);
+  }
+  return str;
+}
+
+std::runtime_error invalidValue(const std::string& key, const std::string& value) {
+  return std::runtime_error("[ServerConfig::set()]: Error. Invalid value of '" + key + "': '" + value + "'.");
+}
+
+v_int32 parseInt(const std::string& key, const std::string& value, long min, long max) {
+  errno = 0;
+  char* end;
+  auto result = std::strtol(value.c_str(), &end, 10);
+  if(value.empty() || *end != 0 || errno != 0 || result < min || result > max) {
+    throw invalidValue(key, value);
+  }
+  return (v_int32) result;
+}
+
+bool parseBool(const std::string& key, const std::string& value) {
+  auto lower = toLower(value);
+  if(lower == "1" || lower == "true" || lower == "yes" || lower == "on") {
+    return true;
+  }
+  if(lower == "0" || lower == "false" || lower == "no" || lower == "off") {
+    return false;
+  }
+  throw invalidValue(key, value);
+}
+
+std::vector<std::string> parsePaths(const std::string& key, const std::string& value) {
+  std::vector<std::string> paths;
+  std::stringstream stream(value);
+  std::string path;
+  while(std::getline(stream, path, ',')) {
+    path = trim(path);
+    if(path.empty() || path[0] != '/') {
+      throw invalidValue(key, value);
+    }
+    paths.push_back(path);
+  }
+  return paths;
+}
+
+}
+
+ServerConfig::ServerConfig()
+  : ServerConfig(oatpp::network::Address("0.0.0.0", 8000, oatpp::network::Address::IP_4))
+{}
+
+ServerConfig::ServerConfig(const oatpp::network::Address& address)
+  : address(address)
+  , parkingHandler(false)
+{
+  parking.workersCount = DEFAULT_WORKERS;
+  parking.idleTimeout = DEFAULT_IDLE_TIMEOUT;
+}
+
+bool ServerConfig::set(const std::string& key, const std::string& value) {
+
+  if(key == "host") {
+    if(value.empty()) {
+      throw invalidValue(key, value);
+    }
+    address.host = value.c_str();
+  } else if(key == "port") {
+    address.port = (v_uint16) parseInt(key, value, 0, 65535);
+  } else if(key == "family") {
+    auto lower = toLower(value);
+    if(lower == "ipv4") {
+      address.family = oatpp::network::Address::IP_4;
+    } else if(lower == "ipv6") {
+      address.family = oatpp::network::Address::IP_6;
+    } else if(lower == "any") {
+      address.family = oatpp::network::Address::UNSPEC;
+    } else {
+      throw invalidValue(key, value);
+    }
+  } else if(key == "backlog") {
+    socketOptions.backlog = parseInt(key, value, 1, 1 << 20);
+  } else if(key == "so_rcvbuf") {
+    socketOptions.receiveBufferSize = parseInt(key, value, 0, 1 << 30);
+  } else if(key == "so_sndbuf") {
+    socketOptions.sendBufferSize = parseInt(key, value, 0, 1 << 30);
+  } else if(key == "tcp_nodelay") {
+    socketOptions.noDelay = parseBool(key, value);
+  } else if(key == "tcp_defer_accept") {
+    socketOptions.deferAcceptSeconds = parseInt(key, value, 0, 3600);
+  } else if(key == "tcp_fastopen") {
+    socketOptions.fastOpenQueue = parseInt(key, value, 0, 1 << 20);
+  } else if(key == "ipv6_dualstack") {
+    socketOptions.dualStack = parseBool(key, value);
+  } else if(key == "reuse_port") {
+    socketOptions.reusePort = parseBool(key, value);
+  } else if(key == "warm_up") {
+    warmUp.enabled = parseBool(key, value);
+  } else if(key == "warm_up_paths") {
+    warmUp.paths = parsePaths(key, value);
+  } else if(key == "warm_up_requests") {
+    warmUp.requestsPerPath = parseInt(key, value, 0, 1 << 20);
+  } else if(key == "handler") {
+    auto lower = toLower(value);
+    if(lower == "thread") {
+      parkingHandler = false;
+    } else if(lower == "parking") {
+      parkingHandler = true;
+    } else {
+      throw invalidValue(key, value);
+    }
+  } else if(key == "workers") {
+    parking.workersCount = parseInt(key, value, 1, 1 << 16);
+  } else if(key == "idle_timeout_ms") {
+    parking.idleTimeout = std::chrono::milliseconds(parseInt(key, value, 0, 1 << 30));
+  } else {
+    return false;
+  }
+
+  return true;
+
+}
+
+void ServerConfig::readFile(const std::string& path) {
+
+  std::ifstream file(path);
+  if(!file) {
+    throw std::runtime_error("[ServerConfig::readFile()]: Error. Can't read '" + path + "'.");
+  }
+
+  std::string line;
+  v_int32 lineNumber = 0;
+  while(std::getline(file, line)) {
+
+    lineNumber ++;
+    line = trim(line);
+    if(line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    auto separator = line.find('=');
+    if(separator == std::string::npos) {
+      throw std::runtime_error("[ServerConfig::readFile()]: Error. Expected 'key = value' at " + path + ":" + std::to_string(lineNumber) + ".");
+    }
+
+    auto key = toLower(trim(line.substr(0, separator)));
+    if(!set(key, trim(line.substr(separator + 1)))) {
+      OATPP_LOGW("[ServerConfig::readFile()]", "Warning. Unknown key '%s' at %s:%d", key.c_str(), path.c_str(), lineNumber);
+    }
+
+  }
+
+}
+
+void ServerConfig::readEnvironment(const std::string& prefix) {
+  for(const char* key : KEYS) {
+    std::string name = prefix;
+    for(const char* c = key; *c != 0; c ++) {
+      name += (char) std::toupper((unsigned char) *c);
+    }
+    if(const char* value = std::getenv(name.c_str())) {
+      set(key, trim(value));
+    }
+  }
+}
+
+ServerConfig ServerConfig::load() {
+  ServerConfig config;
+  if(const char* path = std::getenv(FILE_VARIABLE)) {
+    if(*path != 0) {
+      config.readFile(path);
+    }
+  }
+  config.readEnvironment();
+  return config;
+}
+
+std::string ServerConfig::toString() const {
+
+  const char* family = "any";
+  if(address.family == oatpp::network::Address::IP_4) {
+    family = "ipv4";
+  } else if(address.family == oatpp::network::Address::IP_6) {
+    family = "ipv6";
+  }
+
+  std::stringstream stream;
+  stream << "host=" << (address.host ? address.host->c_str() : "")
+         << " port=" << address.port
+         << " family=" << family
+         << " backlog=" << socketOptions.backlog
+         << " so_rcvbuf=" << socketOptions.receiveBufferSize
+         << " so_sndbuf=" << socketOptions.sendBufferSize
+         << " tcp_nodelay=" << (int) socketOptions.noDelay
+         << " tcp_defer_accept=" << socketOptions.deferAcceptSeconds
+         << " tcp_fastopen=" << socketOptions.fastOpenQueue
+         << " ipv6_dualstack=" << (int) socketOptions.dualStack
+         << " reuse_port=" << (int) socketOptions.reusePort
+         << " warm_up=" << (int) warmUp.enabled
+         << " warm_up_paths=";
+  for(size_t i = 0; i < warmUp.paths.size(); i ++) {
+    stream << (i == 0 ? "" : ",") << warmUp.paths[i];
+  }
+  stream << " warm_up_requests=" << warmUp.requestsPerPath
+         << " handler=" << (parkingHandler ? "parking" : "thread")
+         << " workers=" << parking.workersCount
+         << " idle_timeout_ms=" << parking.idleTimeout.count();
+  return stream.str();
+
+}
+
+std::shared_ptr<ListenerConnectionProvider> ServerConfig::createConnectionProvider() const {
+  return ListenerConnectionProvider::createShared(address, socketOptions);
+}
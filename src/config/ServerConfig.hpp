@@ -0,0 +1,129 @@
+#ifndef ServerConfig_hpp
+#define ServerConfig_hpp
+
+#include "handler/ParkingConnectionHandler.hpp"
+#include "lifecycle/WarmUp.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "oatpp/network/Address.hpp"
+
+#include <string>
+
+/**
+ * Listen address and socket options of a server, read at startup so that they can be tuned without recompiling.
+ * Keys and values (`APP_<KEY>` in the environment, `key = value` lines in a file):
+ *   - `host` - listen host, `0.0.0.0` by default (`::` with `family = ipv6` and `ipv6_dualstack = 1` for both families).
+ *   - `port` - listen port, `8000` by default, `0` picks an ephemeral port.
+ *   - `family` - `ipv4` (default), `ipv6` or `any`.
+ *   - `backlog` - `listen()` backlog, `10000` by default.
+ *   - `so_rcvbuf`, `so_sndbuf` - socket buffer sizes in bytes, `0` - system default.
+ *   - `tcp_nodelay` - `TCP_NODELAY` on accepted sockets, on by default.
+ *   - `tcp_defer_accept` - `TCP_DEFER_ACCEPT` seconds, `0` - off.
+ *   - `tcp_fastopen` - `TCP_FASTOPEN` queue length, `0` - off.
+ *   - `ipv6_dualstack` - IPv6 listener accepts IPv4 too.
+ *   - `reuse_port` - `SO_REUSEPORT`.
+ *   - `warm_up` - warm the server up before the port is opened, on by default, see &l:AppComponent::warmUp ();.
+ *   - `warm_up_paths` - comma separated paths requested by the warm-up, `/` by default.
+ *   - `warm_up_requests` - warm-up requests per path, `100` by default.
+ *   - `handler` - `thread` (default) - a thread per connection, or `parking` - &l:ParkingConnectionHandler;.
+ *   - `workers` - workers of the parking handler, `16` by default.
+ *   - `idle_timeout_ms` - idle timeout of the parking handler, `5000` by default, `0` - never.
+ * Booleans are `1/0`, `true/false`, `yes/no` or `on/off`. An invalid value throws `std::runtime_error`,
+ * an unknown key in a file is skipped with a warning.
+ */
+class ServerConfig {
+public:
+
+  /**
+   * Environment variable with the path of the config file read by &l:ServerConfig::load ();.
+   */
+  static constexpr const char* FILE_VARIABLE = "APP_CONFIG";
+
+  /**
+   * Prefix of the environment variables read by &l:ServerConfig::load ();.
+   */
+  static constexpr const char* ENVIRONMENT_PREFIX = "APP_";
+
+public:
+
+  /**
+   * Address to listen on.
+   */
+  oatpp::network::Address address;
+
+  /**
+   * Options of the listening socket and of accepted connections.
+   */
+  ListenerConnectionProvider::Options socketOptions;
+
+  /**
+   * Warm-up before the port is opened.
+   */
+  WarmUp::Config warmUp;
+
+  /**
+   * Serve connections with a &l:ParkingConnectionHandler; with the `parking` settings, otherwise with
+   * `HttpConnectionHandler`.
+   */
+  bool parkingHandler;
+
+  /**
+   * Settings of the parking handler.
+   */
+  ParkingConnectionHandler::Config parking;
+
+public:
+
+  /**
+   * Constructor. `0.0.0.0:8000`, IPv4, default socket options.
+   */
+  ServerConfig();
+
+  /**
+   * Constructor. Default socket options.
+   * @param address - address to listen on.
+   */
+  explicit ServerConfig(const oatpp::network::Address& address);
+
+  /**
+   * Set one value. Throws `std::runtime_error` if the value is invalid.
+   * @param key - key, see class description.
+   * @param value - value.
+   * @return - `false` if the key is unknown.
+   */
+  bool set(const std::string& key, const std::string& value);
+
+  /**
+   * Read `key = value` lines of a file. Empty lines and lines starting with `#` are skipped.
+   * Throws `std::runtime_error` if the file can't be read or has an invalid line.
+   * @param path - file path.
+   */
+  void readFile(const std::string& path);
+
+  /**
+   * Read values from the environment variables `<prefix><KEY>` (e.g. `APP_TCP_NODELAY`).
+   * @param prefix - variable name prefix.
+   */
+  void readEnvironment(const std::string& prefix = ENVIRONMENT_PREFIX);
+
+  /**
+   * Defaults, overridden by the file named in `APP_CONFIG` (if set), overridden by `APP_<KEY>` variables.
+   * @return - config.
+   */
+  static ServerConfig load();
+
+  /**
+   * All values as `key=value` pairs, for the startup log.
+   * @return
+   */
+  std::string toString() const;
+
+  /**
+   * Create the listening connection provider.
+   * @return - `std::shared_ptr` to &l:ListenerConnectionProvider;.
+   */
+  std::shared_ptr<ListenerConnectionProvider> createConnectionProvider() const;
+
+};
+
+#endif /* ServerConfig_hpp */
@@ -0,0 +1,47 @@
+#ifndef AsyncMetricsController_hpp
+#define AsyncMetricsController_hpp
+
+#include "metrics/RequestMetrics.hpp"
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+#include "oatpp/core/macro/component.hpp"
+
+#include OATPP_CODEGEN_BEGIN(ApiController) //<-- Begin Codegen
+
+/**
+ * Async variant of MetricsController.
+ */
+class AsyncMetricsController : public oatpp::web::server::api::ApiController {
+private:
+  std::shared_ptr<RequestMetrics> m_metrics;
+public:
+  /**
+   * Constructor with metrics.
+   * @param metrics - metrics to serve.
+   */
+  AsyncMetricsController(OATPP_COMPONENT(std::shared_ptr<RequestMetrics>, metrics))
+    : oatpp::web::server::api::ApiController(nullptr)
+    , m_metrics(metrics)
+  {}
+public:
+
+  ENDPOINT_ASYNC("GET", "/metrics", GetMetrics) {
+
+    ENDPOINT_ASYNC_INIT(GetMetrics)
+
+    Action act() override {
+      auto response = controller->createResponse(Status::CODE_200,
+                                                controller->m_metrics->renderPrometheus() + AllocationTelemetry::renderPrometheus());
+      response->putHeader(Header::CONTENT_TYPE, "text/plain; version=0.0.4");
+      return _return(response);
+    }
+
+  };
+
+};
+
+#include OATPP_CODEGEN_END(ApiController) //<-- End Codegen
+
+#endif /* AsyncMetricsController_hpp */
@@ -0,0 +1,49 @@
+#ifndef MetricsController_hpp
+#define MetricsController_hpp
+
+#include "limit/ConcurrencyLimiter.hpp"
+#include "metrics/RequestMetrics.hpp"
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+#include "oatpp/core/macro/component.hpp"
+
+#include OATPP_CODEGEN_BEGIN(ApiController) //<-- Begin Codegen
+
+/**
+ * Serves &l:RequestMetrics;, &l:AllocationTelemetry; and the &l:ConcurrencyLimiter; state in the Prometheus text format.
+ */
+class MetricsController : public oatpp::web::server::api::ApiController {
+private:
+  std::shared_ptr<RequestMetrics> m_metrics;
+  std::shared_ptr<ConcurrencyLimiter> m_limiter;
+public:
+  /**
+   * Constructor with metrics.
+   * @param metrics - metrics to serve.
+   * @param limiter - limiter whose limit and counters are served too, may be `nullptr`.
+   */
+  MetricsController(OATPP_COMPONENT(std::shared_ptr<RequestMetrics>, metrics),
+                    const std::shared_ptr<ConcurrencyLimiter>& limiter = nullptr)
+    : oatpp::web::server::api::ApiController(nullptr)
+    , m_metrics(metrics)
+    , m_limiter(limiter)
+  {}
+public:
+
+  ENDPOINT("GET", "/metrics", getMetrics) {
+    auto text = m_metrics->renderPrometheus() + AllocationTelemetry::renderPrometheus();
+    if(m_limiter) {
+      text += m_limiter->renderPrometheus();
+    }
+    auto response = createResponse(Status::CODE_200, text);
+    response->putHeader(Header::CONTENT_TYPE, "text/plain; version=0.0.4");
+    return response;
+  }
+
+};
+
+#include OATPP_CODEGEN_END(ApiController) //<-- End Codegen
+
+#endif /* MetricsController_hpp */
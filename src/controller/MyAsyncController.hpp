@@ -0,0 +1,58 @@
+#ifndef MyAsyncController_hpp
+#define MyAsyncController_hpp
+
+#include "cache/CachedResponse.hpp"
+#include "dto/DTOs.hpp"
+
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+#include "oatpp/core/macro/component.hpp"
+
+#include OATPP_CODEGEN_BEGIN(ApiController) //<-- Begin Codegen
+
+/**
+ * Sample async Api Controller. Serves the same API as MyController, but with coroutines.
+ */
+class MyAsyncController : public oatpp::web::server::api::ApiController {
+private:
+  std::shared_ptr<CachedResponse> m_rootResponse;
+private:
+
+  static oatpp::Object<MyDto> createRootDto() {
+    auto dto = MyDto::createShared();
+    dto->statusCode = 200;
+    dto->message = "Hello World!";
+    return dto;
+  }
+
+public:
+  /**
+   * Constructor with object mapper.
+   * @param objectMapper - default object mapper used to serialize/deserialize DTOs.
+   */
+  MyAsyncController(OATPP_COMPONENT(std::shared_ptr<ObjectMapper>, objectMapper))
+    : oatpp::web::server::api::ApiController(objectMapper)
+    , m_rootResponse(CachedResponse::createDtoResponse(Status::CODE_200, createRootDto(), objectMapper))
+  {}
+public:
+
+  /**
+   * Served from the cache, see MyController::root.
+   */
+  ENDPOINT_ASYNC("GET", "/", Root) {
+
+    ENDPOINT_ASYNC_INIT(Root)
+
+    Action act() override {
+      return _return(controller->m_rootResponse->respond(request));
+    }
+
+  };
+
+  // TODO Insert Your endpoints here !!!
+
+};
+
+#include OATPP_CODEGEN_END(ApiController) //<-- End Codegen
+
+#endif /* MyAsyncController_hpp */
@@ -1,3 +1,5 @@
 #include "MyController.hpp"
 
+constexpr v_int32 MyController::MAX_ITEMS;
+
 // TODO - SOME CODE HERE
\ No newline at end of file
@@ -1,7 +1,11 @@
 #ifndef MyController_hpp
 #define MyController_hpp
 
+#include "cache/CachedResponse.hpp"
 #include "dto/DTOs.hpp"
+#include "memory/RequestArena.hpp"
+#include "stream/FileBody.hpp"
+#include "stream/JsonArrayReadCallback.hpp"
 
 #include "oatpp/web/server/api/ApiController.hpp"
 #include "oatpp/core/macro/codegen.hpp"
@@ -13,21 +17,92 @@
  * Sample Api Controller.
  */
 class MyController : public oatpp::web::server::api::ApiController {
+public:
+
+  /**
+   * Max number of elements served by `GET /items/{count}`.
+   */
+  static constexpr v_int32 MAX_ITEMS = 1000000;
+
+private:
+  std::shared_ptr<CachedResponse> m_rootResponse;
+  oatpp::String m_assetsDirectory;
+private:
+
+  static oatpp::Object<MyDto> createRootDto() {
+    auto dto = MyDto::createShared();
+    dto->statusCode = 200;
+    dto->message = "Hello World!";
+    return dto;
+  }
+
 public:
   /**
    * Constructor with object mapper.
    * @param objectMapper - default object mapper used to serialize/deserialize DTOs.
+   * @param assetsDirectory - directory served by `GET /assets/{name}`.
    */
-  MyController(OATPP_COMPONENT(std::shared_ptr<ObjectMapper>, objectMapper))
+  MyController(OATPP_COMPONENT(std::shared_ptr<ObjectMapper>, objectMapper),
+               const oatpp::String& assetsDirectory = "assets")
     : oatpp::web::server::api::ApiController(objectMapper)
+    , m_rootResponse(CachedResponse::createDtoResponse(Status::CODE_200, createRootDto(), objectMapper))
+    , m_assetsDirectory(assetsDirectory)
   {}
 public:
   
-  ENDPOINT("GET", "/", root) {
-    auto dto = MyDto::createShared();
-    dto->statusCode = 200;
-    dto->message = "Hello World!";
-    return createDtoResponse(Status::CODE_200, dto);
+  /**
+   * The payload never changes - it is serialized once and served from the cache.
+   * Clients which send its ETag in `If-None-Match` get 304.
+   */
+  ENDPOINT("GET", "/", root,
+           REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+    return m_rootResponse->respond(request);
+  }
+  
+  /**
+   * `count` generated items as a JSON array.
+   * Items are created and serialized while the response is written (chunked), so memory doesn't grow with `count`.
+   */
+  ENDPOINT("GET", "/items/{count}", getItems,
+           PATH(Int32, count)) {
+    OATPP_ASSERT_HTTP(*count >= 0 && *count <= MAX_ITEMS, Status::CODE_400, "count is out of range");
+    v_int32 total = *count;
+    v_int32 index = 0;
+    return JsonArrayReadCallback::createResponse(Status::CODE_200, [total, index](oatpp::Void& element) mutable -> bool {
+      if(index == total) {
+        return false;
+      }
+      auto dto = MyDto::createShared();
+      dto->statusCode = 200;
+      dto->message = "Item " + std::to_string(index ++);
+      element = dto;
+      return true;
+    }, getDefaultObjectMapper());
+  }
+  
+  /**
+   * Greeting built for every request. The DTO, its fields, the serialized body and the response are allocated in a
+   * &l:RequestArena; - released in bulk once the response is sent.
+   */
+  ENDPOINT("GET", "/hello/{name}", hello,
+           PATH(String, name)) {
+    auto arena = RequestArena::create();
+    auto dto = arena->create<oatpp::Object<MyDto>>();
+    dto->statusCode = arena->create<oatpp::Int32>(200);
+    dto->message = arena->create<oatpp::String>("Hello " + *name + "!");
+    return arena->createDtoResponse(Status::CODE_200, dto, getDefaultObjectMapper());
+  }
+  
+  /**
+   * File of the assets directory. Honors a single-range `Range` header (see &l:FileBody::createResponse ();).
+   * Sent with `sendfile` by &l:ParkingConnectionHandler;, read through a buffer by the other handlers.
+   */
+  ENDPOINT("GET", "/assets/{name}", getAsset,
+           PATH(String, name),
+           REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+    OATPP_ASSERT_HTTP(name->find('/') == std::string::npos && name->find('\\') == std::string::npos && name->compare(0, 1, ".") != 0,
+                      Status::CODE_400, "Invalid asset name");
+    return FileBody::createResponse(request, m_assetsDirectory + "/" + name, "application/octet-stream");
   }
   
   // TODO Insert Your endpoints here !!!
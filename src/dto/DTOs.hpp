@@ -1,6 +1,8 @@
 #ifndef DTOs_hpp
 #define DTOs_hpp
 
+#include "StaticDto.hpp"
+
 #include "oatpp/core/macro/codegen.hpp"
 #include "oatpp/core/Types.hpp"
 
@@ -21,4 +23,10 @@ class MyDto : public oatpp::DTO {
 
 #include OATPP_CODEGEN_END(DTO)
 
+/* Field list for StaticJsonObjectMapper */
+STATIC_DTO(MyDto,
+  STATIC_DTO_FIELD(statusCode)
+  STATIC_DTO_FIELD(message)
+)
+
 #endif /* DTOs_hpp */
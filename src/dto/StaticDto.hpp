@@ -0,0 +1,51 @@
+#ifndef StaticDto_hpp
+#define StaticDto_hpp
+
+/**
+ * Compile-time field list of a DTO, used by &l:StaticJsonObjectMapper; instead of the runtime property map.
+ * Not declared for a type - the type is serialized by oatpp reflection as usual.
+ * Declare it with `STATIC_DTO` next to the DTO:
+ * ```
+ * STATIC_DTO(MyDto,
+ *   STATIC_DTO_FIELD(statusCode)
+ *   STATIC_DTO_FIELD(message)
+ * )
+ * ```
+ * Fields must be listed in the `DTO_FIELD` order, base class fields first. A field declared with a custom name
+ * (`DTO_FIELD(String, message, "msg")`) is listed with `STATIC_DTO_FIELD_AS(message, "msg")`.
+ * &l:StaticJsonObjectMapper::registerDto; checks the list against the DTO's fields and throws on a mismatch.
+ * @tparam T - DTO type.
+ */
+template<class T>
+struct StaticDtoFields {
+  static constexpr bool ENABLED = false;
+};
+
+/**
+ * Field with a custom JSON name. The key literal `"name":` is built at compile time.
+ * A field of a base class is visited as a member of the DTO.
+ */
+#define STATIC_DTO_FIELD_AS(NAME, QUALIFIER) \
+  visitor("\"" QUALIFIER "\":", static_cast<decltype(Dto::NAME) Dto::*>(&Dto::NAME));
+
+/**
+ * Field named in JSON as in C++.
+ */
+#define STATIC_DTO_FIELD(NAME) \
+  STATIC_DTO_FIELD_AS(NAME, #NAME)
+
+/**
+ * Declare the field list of a DTO. Use at global scope after the DTO class.
+ */
+#define STATIC_DTO(DTO_CLASS, FIELDS) \
+template<> \
+struct StaticDtoFields<DTO_CLASS> { \
+  typedef DTO_CLASS Dto; \
+  static constexpr bool ENABLED = true; \
+  template<class Visitor> \
+  static void visit(Visitor& visitor) { \
+    FIELDS \
+  } \
+};
+
+#endif /* StaticDto_hpp */
@@ -0,0 +1,603 @@
+#include "ParkingConnectionHandler.hpp"
+
+#include "memory/BufferPool.hpp"
+
+#include "oatpp/web/protocol/http/incoming/Request.hpp"
+#include "oatpp/network/tcp/Connection.hpp"
+#include "oatpp/core/data/buffer/IOBuffer.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
+
+namespace {
+
+constexpr v_int32 EVENTS_BATCH = 64;
+
+/* Shared buffer pool is trimmed when no connection took a buffer for this long */
+constexpr std::chrono::seconds BUFFER_POOL_IDLE(10);
+
+std::shared_ptr<std::string> acquireReadBuffer() {
+  auto buffer = BufferPool::acquire(oatpp::data::buffer::IOBuffer::BUFFER_SIZE);
+  buffer->resize(oatpp::data::buffer::IOBuffer::BUFFER_SIZE);
+  return buffer;
+}
+
+/**
+ * Input stream of a blocking socket on which an expired `SO_RCVTIMEO` is an error.
+ * oatpp reports the expiry as `RETRY_READ`, and its blocking read loops (headers, bodies) retry it - the worker
+ * would just start another wait.
+ */
+class TimeoutInputStream : public oatpp::data::stream::InputStream {
+private:
+  std::shared_ptr<oatpp::data::stream::IOStream> m_stream;
+public:
+
+  explicit TimeoutInputStream(const std::shared_ptr<oatpp::data::stream::IOStream>& stream)
+    : m_stream(stream)
+  {}
+
+  oatpp::v_io_size read(void *buffer, v_buff_size count, oatpp::async::Action& action) override {
+    auto res = m_stream->read(buffer, count, action);
+    if(res == oatpp::IOError::RETRY_READ && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return oatpp::IOError::BROKEN_PIPE;
+    }
+    return res;
+  }
+
+  void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override {
+    m_stream->setInputStreamIOMode(ioMode);
+  }
+
+  oatpp::data::stream::IOMode getInputStreamIOMode() override {
+    return m_stream->getInputStreamIOMode();
+  }
+
+  oatpp::data::stream::Context& getInputStreamContext() override {
+    return m_stream->getInputStreamContext();
+  }
+
+};
+
+std::shared_ptr<oatpp::data::stream::InputStream> createReadStream(const std::shared_ptr<oatpp::data::stream::IOStream>& stream,
+                                                                   oatpp::v_io_handle handle)
+{
+  if(handle < 0) {
+    return stream;
+  }
+  return std::make_shared<TimeoutInputStream>(stream);
+}
+
+/* Timeout of every blocking read and write on the socket, `0` - none */
+void setSocketTimeouts(oatpp::v_io_handle handle, std::chrono::milliseconds timeout) {
+  timeval value;
+  value.tv_sec = (time_t) (timeout.count() / 1000);
+  value.tv_usec = (suseconds_t) (timeout.count() % 1000 * 1000);
+  if(::setsockopt(handle, SOL_SOCKET, SO_RCVTIMEO, &value, sizeof(value)) != 0 ||
+     ::setsockopt(handle, SOL_SOCKET, SO_SNDTIMEO, &value, sizeof(value)) != 0)
+  {
+    OATPP_LOGW("[ParkingConnectionHandler]", "Warning. Can't set socket timeouts: %s", std::strerror(errno));
+  }
+}
+
+}
+
+ParkingConnectionHandler::Connection::Connection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& pResource,
+                                                 oatpp::v_io_handle pHandle,
+                                                 const oatpp::web::server::HttpProcessor::Config& config)
+  : resource(pResource)
+  , handle(pHandle)
+  , headersInBuffer(config.headersInBufferInitial)
+  , headersOutBuffer(config.headersOutBufferInitial)
+  , headersReader(&headersInBuffer, config.headersReaderChunkSize, config.headersReaderMaxSize)
+  , inStream(oatpp::data::stream::InputStreamBufferedProxy::createShared(createReadStream(resource.object, pHandle), acquireReadBuffer()))
+  , outStream(resource.object, pHandle)
+  , registered(false)
+{
+  resource.object->initContexts();
+}
+
+ParkingConnectionHandler::ParkingConnectionHandler(const std::shared_ptr<oatpp::web::server::HttpRouter>& router, const Config& config)
+  : m_components(std::make_shared<oatpp::web::server::HttpProcessor::Components>(router))
+  , m_config(config)
+  , m_epoll(-1)
+  , m_stopped(false)
+  , m_timedOut(0)
+  , m_requests(0)
+  , m_writes(0)
+{
+
+  if(m_config.workersCount < 1) {
+    throw std::runtime_error("[ParkingConnectionHandler::ParkingConnectionHandler()]: Error. Invalid workers count.");
+  }
+
+#if defined(__linux__)
+  m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+  if(m_epoll < 0) {
+    throw std::runtime_error("[ParkingConnectionHandler::ParkingConnectionHandler()]: Error. Call to epoll_create1() failed.");
+  }
+  epoll_event event;
+  std::memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.fd = m_pollerStop.getHandle();
+  ::epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_pollerStop.getHandle(), &event);
+  m_poller = std::thread(&ParkingConnectionHandler::poll, this);
+#endif
+
+  m_workers.reserve(m_config.workersCount);
+  for(v_int32 i = 0; i < m_config.workersCount; i ++) {
+    m_workers.push_back(std::thread(&ParkingConnectionHandler::work, this));
+  }
+
+}
+
+std::shared_ptr<ParkingConnectionHandler> ParkingConnectionHandler::createShared(const std::shared_ptr<oatpp::web::server::HttpRouter>& router,
+                                                                                 const Config& config)
+{
+  return std::make_shared<ParkingConnectionHandler>(router, config);
+}
+
+ParkingConnectionHandler::~ParkingConnectionHandler() {
+  stop();
+  if(m_epoll >= 0) {
+    ::close(m_epoll);
+  }
+}
+
+void ParkingConnectionHandler::addRequestInterceptor(const std::shared_ptr<oatpp::web::server::interceptor::RequestInterceptor>& interceptor) {
+  m_components->requestInterceptors.push_back(interceptor);
+}
+
+void ParkingConnectionHandler::addResponseInterceptor(const std::shared_ptr<oatpp::web::server::interceptor::ResponseInterceptor>& interceptor) {
+  m_components->responseInterceptors.push_back(interceptor);
+}
+
+std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> ParkingConnectionHandler::handleCurrentError() {
+
+  /* Same catch clauses as oatpp::web::server::HttpProcessor - HttpError keeps its status and headers */
+
+  try {
+    throw;
+  } catch (oatpp::web::protocol::http::HttpError& error) {
+    return m_components->errorHandler->handleError(error.getInfo().status, error.getMessage(), error.getHeaders());
+  } catch (std::exception& error) {
+    return m_components->errorHandler->handleError(oatpp::web::protocol::http::Status::CODE_500, error.what());
+  } catch (...) {
+    return m_components->errorHandler->handleError(oatpp::web::protocol::http::Status::CODE_500, "Unhandled Error");
+  }
+
+}
+
+ParkingConnectionHandler::ConnectionState ParkingConnectionHandler::processNextRequest(Connection& connection) {
+
+  /* Same steps as oatpp::web::server::HttpProcessor, on the connection's own buffers */
+
+  oatpp::web::protocol::http::HttpError::Info error;
+  auto headersReadResult = connection.headersReader.readHeaders(connection.inStream.get(), error);
+
+  if(error.ioStatus <= 0) {
+    return ConnectionState::DEAD;
+  }
+
+  m_requests ++;
+
+  ConnectionState connectionState = ConnectionState::ALIVE;
+  std::shared_ptr<oatpp::web::protocol::http::incoming::Request> request;
+  std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> response;
+
+  if(error.status.code != 0) {
+
+    response = m_components->errorHandler->handleError(error.status, "Invalid Request Headers");
+    connectionState = ConnectionState::CLOSING;
+
+  } else {
+
+    request = oatpp::web::protocol::http::incoming::Request::createShared(connection.resource.object,
+                                                                           headersReadResult.startingLine,
+                                                                           headersReadResult.headers,
+                                                                           connection.inStream,
+                                                                           m_components->bodyDecoder);
+
+    try {
+
+      for(auto& interceptor : m_components->requestInterceptors) {
+        response = interceptor->intercept(request);
+        if(response) {
+          break;
+        }
+      }
+
+      if(!response) {
+        auto route = m_components->router->getRoute(request->getStartingLine().method, request->getStartingLine().path);
+        if(route) {
+          request->setPathVariables(route.getMatchMap());
+          response = route.getEndpoint()->handle(request);
+        } else {
+          oatpp::data::stream::BufferOutputStream message;
+          message << "No mapping for HTTP-method: '" << request->getStartingLine().method.toString()
+                  << "', URL: '" << request->getStartingLine().path.toString() << "'";
+          response = m_components->errorHandler->handleError(oatpp::web::protocol::http::Status::CODE_404, message.toString());
+          connectionState = ConnectionState::CLOSING;
+        }
+      }
+
+    } catch (...) {
+      response = handleCurrentError();
+      connectionState = ConnectionState::CLOSING;
+    }
+
+    /* Like HttpProcessor - error responses go through the response interceptors too, so that they see every request */
+    try {
+
+      for(auto& interceptor : m_components->responseInterceptors) {
+        response = interceptor->intercept(request, response);
+        if(!response) {
+          response = m_components->errorHandler->handleError(oatpp::web::protocol::http::Status::CODE_500,
+                                                             "Response Interceptor returned an Invalid Response - 'null'");
+          connectionState = ConnectionState::CLOSING;
+        }
+      }
+
+    } catch (...) {
+      response = handleCurrentError();
+      connectionState = ConnectionState::CLOSING;
+    }
+
+    response->putHeaderIfNotExists(oatpp::web::protocol::http::Header::SERVER, oatpp::web::protocol::http::Header::Value::SERVER);
+    oatpp::web::protocol::http::utils::CommunicationUtils::considerConnectionState(request, response, connectionState);
+
+    if(connectionState == ConnectionState::ALIVE) {
+      response->putHeaderIfNotExists(oatpp::web::protocol::http::Header::CONNECTION,
+                                     oatpp::web::protocol::http::Header::Value::CONNECTION_KEEP_ALIVE);
+    } else if(connectionState != ConnectionState::DELEGATED) {
+      response->putHeaderIfNotExists(oatpp::web::protocol::http::Header::CONNECTION,
+                                     oatpp::web::protocol::http::Header::Value::CONNECTION_CLOSE);
+    } else if(!response->getConnectionUpgradeHandler()) {
+      OATPP_LOGW("[ParkingConnectionHandler::processNextRequest()]", "Warning. ConnectionUpgradeHandler not set!");
+      connectionState = ConnectionState::CLOSING;
+    }
+
+  }
+
+  auto contentEncoderProvider =
+    oatpp::web::protocol::http::utils::CommunicationUtils::selectEncoder(request, m_components->contentEncodingProviders);
+
+  auto fileBody = std::dynamic_pointer_cast<FileBody>(response->getBody());
+  if(fileBody && connection.handle >= 0 && !contentEncoderProvider) {
+    if(!sendFileResponse(connection, *response, *fileBody)) {
+      return ConnectionState::DEAD;
+    }
+  } else {
+    response->send(&connection.outStream, &connection.headersOutBuffer, contentEncoderProvider.get());
+  }
+
+  /* Delegate the connection only after the response is sent */
+  if(connectionState == ConnectionState::DELEGATED) {
+    connection.outStream.flush();
+    /* The upgrade handler has timeouts of its own, if any */
+    if(connection.handle >= 0) {
+      setSocketTimeouts(connection.handle, std::chrono::milliseconds(0));
+    }
+    response->getConnectionUpgradeHandler()->handleConnection(connection.resource, response->getConnectionUpgradeParameters());
+  }
+
+  return connectionState;
+
+}
+
+bool ParkingConnectionHandler::sendFileResponse(Connection& connection,
+                                                oatpp::web::protocol::http::outgoing::Response& response,
+                                                FileBody& body)
+{
+
+  /* Head written like outgoing::Response::send() does it, then the body goes to the socket without user-space copies */
+
+  body.declareHeaders(response.getHeaders());
+  response.putHeader(oatpp::web::protocol::http::Header::CONTENT_LENGTH, oatpp::utils::conversion::int64ToStr(body.getKnownSize()));
+
+  auto& head = connection.headersOutBuffer;
+  head.setCurrentPosition(0);
+  head.writeSimple("HTTP/1.1 ", 9);
+  head.writeAsString(response.getStatus().code);
+  head.writeSimple(" ", 1);
+  head.writeSimple(response.getStatus().description);
+  head.writeSimple("\r\n", 2);
+  oatpp::web::protocol::http::Utils::writeHeaders(response.getHeaders(), &head);
+  head.writeSimple("\r\n", 2);
+
+  /* Responses batched before this one and the head go out first */
+  head.flushToStream(&connection.outStream);
+  if(!connection.outStream.flush()) {
+    return false;
+  }
+
+  return body.sendTo(connection.handle);
+
+}
+
+ParkingConnectionHandler::Next ParkingConnectionHandler::serve(Connection& connection) {
+
+  auto writeCalls = connection.outStream.getWriteCalls();
+  auto next = Next::CLOSE;
+
+  try {
+
+    while(true) {
+
+      auto connectionState = processNextRequest(connection);
+      if(connectionState == ConnectionState::DELEGATED) {
+        next = Next::RELEASE;
+        break;
+      }
+      if(connectionState != ConnectionState::ALIVE) {
+        connection.outStream.flush();
+        break;
+      }
+
+      /* Pipelined request already read ahead - its response joins the batch */
+      if(connection.inStream->availableToRead() > 0) {
+        continue;
+      }
+
+      /* Nothing buffered - send the batch before the next read can block */
+      if(!connection.outStream.flush()) {
+        break;
+      }
+
+      if(connection.handle < 0) {
+        continue;
+      }
+
+      v_char8 peek;
+      auto res = ::recv(connection.handle, &peek, 1, MSG_PEEK | MSG_DONTWAIT);
+      if(res > 0) {
+        continue;
+      }
+      if(res < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        connection.outStream.releaseBuffer();
+        next = Next::PARK;
+      }
+      break;
+
+    }
+
+  } catch (...) {
+    next = Next::CLOSE;
+  }
+
+  m_writes += connection.outStream.getWriteCalls() - writeCalls;
+  return next;
+
+}
+
+void ParkingConnectionHandler::work() {
+
+  while(true) {
+
+    std::shared_ptr<Connection> connection;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if(m_ready.empty()) {
+        /* Going idle - buffers cached by this thread go where other workers can take them */
+        BufferPool::releaseThreadCache();
+      }
+      m_condition.wait(lock, [this] { return m_stopped || !m_ready.empty(); });
+      if(m_stopped) {
+        return;
+      }
+      connection = std::move(m_ready.front());
+      m_ready.pop_front();
+      m_active[connection.get()] = connection;
+    }
+
+    auto next = serve(*connection);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_active.erase(connection.get());
+    switch(next) {
+      case Next::PARK: park(connection); break;
+      case Next::CLOSE: close(connection); break;
+      case Next::RELEASE: break;
+    }
+
+  }
+
+}
+
+void ParkingConnectionHandler::poll() {
+#if defined(__linux__)
+
+  /* Idle connections are swept a few times per timeout, so they are closed at most ~25% late */
+  const auto sweepInterval = std::max(std::chrono::milliseconds(10), std::min(std::chrono::milliseconds(1000), m_config.idleTimeout / 4));
+  const int waitTimeout = m_config.idleTimeout.count() > 0 ? (int) sweepInterval.count() : -1;
+  auto lastSweep = std::chrono::steady_clock::now();
+
+  epoll_event events[EVENTS_BATCH];
+
+  while(true) {
+
+    auto count = ::epoll_wait(m_epoll, events, EVENTS_BATCH, waitTimeout);
+
+    if(count < 0 && errno != EINTR) {
+      OATPP_LOGE("[ParkingConnectionHandler::poll()]", "Error. Call to epoll_wait() failed: %s", std::strerror(errno));
+      return;
+    }
+
+    {
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      for(v_int32 i = 0; i < count; i ++) {
+        if(events[i].data.fd == m_pollerStop.getHandle()) {
+          return;
+        }
+        auto it = m_parked.find(events[i].data.fd);
+        if(it != m_parked.end()) {
+          m_ready.push_back(std::move(it->second));
+          m_parked.erase(it);
+          m_condition.notify_one();
+        }
+      }
+
+      if(waitTimeout > 0 && std::chrono::steady_clock::now() - lastSweep >= sweepInterval) {
+        sweep();
+        BufferPool::trimIfIdle(BUFFER_POOL_IDLE);
+        lastSweep = std::chrono::steady_clock::now();
+      }
+
+    }
+
+  }
+
+#endif
+}
+
+void ParkingConnectionHandler::sweep() {
+  auto deadline = std::chrono::steady_clock::now() - m_config.idleTimeout;
+  for(auto it = m_parked.begin(); it != m_parked.end();) {
+    if(it->second->parkedAt < deadline) {
+      close(it->second);
+      it = m_parked.erase(it);
+      m_timedOut ++;
+    } else {
+      it ++;
+    }
+  }
+}
+
+void ParkingConnectionHandler::schedule(const std::shared_ptr<Connection>& connection) {
+  if(m_stopped) {
+    close(connection);
+    return;
+  }
+  m_ready.push_back(connection);
+  m_condition.notify_one();
+}
+
+void ParkingConnectionHandler::park(const std::shared_ptr<Connection>& connection) {
+
+  if(m_stopped) {
+    close(connection);
+    return;
+  }
+
+  if(connection->handle < 0) {
+    schedule(connection);
+    return;
+  }
+
+#if defined(__linux__)
+
+  connection->parkedAt = std::chrono::steady_clock::now();
+  m_parked[connection->handle] = connection;
+
+  /* One-shot - the connection is handed to one worker per arrival and re-armed on the next park */
+  epoll_event event;
+  std::memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+  event.data.fd = connection->handle;
+
+  if(::epoll_ctl(m_epoll, connection->registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, connection->handle, &event) == 0) {
+    connection->registered = true;
+    return;
+  }
+
+  OATPP_LOGW("[ParkingConnectionHandler::park()]", "Warning. Call to epoll_ctl() failed: %s. Connection is served without parking.",
+             std::strerror(errno));
+  m_parked.erase(connection->handle);
+  connection->handle = -1;
+
+#endif
+
+  schedule(connection);
+
+}
+
+void ParkingConnectionHandler::close(const std::shared_ptr<Connection>& connection) {
+#if defined(__linux__)
+  /* Deregister before the descriptor can be closed and reused by a new connection */
+  if(connection->registered) {
+    ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, connection->handle, nullptr);
+    connection->registered = false;
+  }
+#endif
+  connection->resource.invalidator->invalidate(connection->resource.object);
+}
+
+void ParkingConnectionHandler::handleConnection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection,
+                                                const std::shared_ptr<const ParameterMap>& params)
+{
+
+  (void) params;
+
+  oatpp::v_io_handle handle = -1;
+  if(m_epoll >= 0) {
+    auto tcpConnection = std::dynamic_pointer_cast<oatpp::network::tcp::Connection>(connection.object);
+    if(tcpConnection) {
+      handle = tcpConnection->getHandle();
+    }
+  }
+
+  /* A client which stops reading or writing mid-request fails it after the idle timeout instead of holding the worker */
+  if(handle >= 0 && m_config.idleTimeout.count() > 0) {
+    setSocketTimeouts(handle, m_config.idleTimeout);
+  }
+
+  auto parkedConnection = std::make_shared<Connection>(connection, handle, *m_components->config);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  park(parkedConnection);
+
+}
+
+void ParkingConnectionHandler::stop() {
+
+  std::vector<std::thread> workers;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_stopped) {
+      return;
+    }
+    m_stopped = true;
+    for(auto& pair : m_parked) {
+      close(pair.second);
+    }
+    m_parked.clear();
+    for(auto& connection : m_ready) {
+      close(connection);
+    }
+    m_ready.clear();
+    for(auto& pair : m_active) {
+      pair.second->resource.invalidator->invalidate(pair.second->resource.object);
+    }
+    workers = std::move(m_workers);
+  }
+
+  m_pollerStop.signal();
+  m_condition.notify_all();
+
+  if(m_poller.joinable()) {
+    m_poller.join();
+  }
+
+  for(auto& worker : workers) {
+    worker.join();
+  }
+
+}
+
+ParkingConnectionHandler::Stats ParkingConnectionHandler::getStats() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return {(v_int64) m_parked.size(), (v_int64) (m_ready.size() + m_active.size()), m_timedOut, m_requests.load(), m_writes.load()};
+}
@@ -0,0 +1,208 @@
+#ifndef ParkingConnectionHandler_hpp
+#define ParkingConnectionHandler_hpp
+
+#include "lifecycle/StopSignal.hpp"
+#include "stream/FileBody.hpp"
+#include "stream/ResponseBatchStream.hpp"
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/server/HttpProcessor.hpp"
+#include "oatpp/web/protocol/http/incoming/RequestHeadersReader.hpp"
+#include "oatpp/web/protocol/http/utils/CommunicationUtils.hpp"
+#include "oatpp/network/ConnectionHandler.hpp"
+#include "oatpp/core/data/stream/StreamBufferedProxy.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * HTTP connection handler which doesn't keep a thread per idle keep-alive connection.
+ * A fixed number of workers serve requests. When a response is sent and the client has nothing more to read,
+ * the connection is parked in a shared epoll set and its worker takes the next ready connection.
+ * A parked connection goes back to a worker only when bytes arrive, and it is closed when it stays idle longer than
+ * the idle timeout or when the handler is stopped - `stop()` doesn't wait for idle clients.
+ * Connections which are not TCP sockets (virtual transport), and all connections on platforms without epoll, are served
+ * by a worker until they close, like in &l:PooledConnectionHandler;.
+ * Pipelined requests are processed in order, and their responses are collected in a &l:ResponseBatchStream; until
+ * no more requests are buffered - then they are sent with one gather write.
+ * A &l:FileBody; (when no content encoding is negotiated) is sent with `sendfile`/`splice` right after its head.
+ * Read and write buffers of connections come from &l:BufferPool;. The pool is trimmed after 10 seconds without new
+ * buffers (checked with the idle timeout), and a worker going idle hands its cached buffers to the shared pool.
+ */
+class ParkingConnectionHandler : public oatpp::network::ConnectionHandler, public AllocationTracked<ParkingConnectionHandler> {
+public:
+
+  /**
+   * Handler settings.
+   */
+  struct Config {
+
+    /**
+     * Number of worker threads - max number of requests processed at the same time.
+     */
+    v_int32 workersCount;
+
+    /**
+     * Parked connection is closed when no bytes arrive within this time. It is also the timeout of every blocking read
+     * and write of a worker on a TCP connection - a client stalled mid-request fails it. `0` - never.
+     */
+    std::chrono::milliseconds idleTimeout;
+
+  };
+
+  /**
+   * Counters.
+   */
+  struct Stats {
+
+    /**
+     * Idle connections in the epoll set now.
+     */
+    v_int64 parked;
+
+    /**
+     * Connections served by workers or waiting for a worker now.
+     */
+    v_int64 active;
+
+    /**
+     * Connections closed by the idle timeout since start.
+     */
+    v_int64 timedOut;
+
+    /**
+     * Requests processed since start.
+     */
+    v_int64 requests;
+
+    /**
+     * Write syscalls made to send the responses since start.
+     */
+    v_int64 writes;
+
+  };
+
+private:
+  typedef oatpp::web::protocol::http::utils::CommunicationUtils::ConnectionState ConnectionState;
+private:
+
+  /**
+   * Connection with the state which survives parking - the read-ahead buffer included, so nothing the client has
+   * sent is lost between requests. Responses are written to `outStream`.
+   */
+  struct Connection {
+
+    Connection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& pResource,
+               oatpp::v_io_handle pHandle,
+               const oatpp::web::server::HttpProcessor::Config& config);
+
+    oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> resource;
+    oatpp::v_io_handle handle;
+    oatpp::data::stream::BufferOutputStream headersInBuffer;
+    oatpp::data::stream::BufferOutputStream headersOutBuffer;
+    oatpp::web::protocol::http::incoming::RequestHeadersReader headersReader;
+    std::shared_ptr<oatpp::data::stream::InputStreamBufferedProxy> inStream;
+    ResponseBatchStream outStream;
+    bool registered;
+    std::chrono::steady_clock::time_point parkedAt;
+
+  };
+
+  /**
+   * What to do with the connection after a worker is done with it.
+   */
+  enum class Next {
+    PARK,
+    CLOSE,
+    RELEASE
+  };
+
+private:
+  std::shared_ptr<oatpp::web::server::HttpProcessor::Components> m_components;
+  Config m_config;
+  int m_epoll;
+  StopSignal m_pollerStop;
+  std::thread m_poller;
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::shared_ptr<Connection>> m_ready;
+  std::unordered_map<oatpp::v_io_handle, std::shared_ptr<Connection>> m_parked;
+  std::unordered_map<Connection*, std::shared_ptr<Connection>> m_active;
+  bool m_stopped;
+  v_int64 m_timedOut;
+  std::atomic<v_int64> m_requests;
+  std::atomic<v_int64> m_writes;
+private:
+  std::shared_ptr<oatpp::web::protocol::http::outgoing::Response> handleCurrentError();
+  ConnectionState processNextRequest(Connection& connection);
+  bool sendFileResponse(Connection& connection, oatpp::web::protocol::http::outgoing::Response& response, FileBody& body);
+  Next serve(Connection& connection);
+  void work();
+  void poll();
+  void sweep();
+  void schedule(const std::shared_ptr<Connection>& connection);
+  void park(const std::shared_ptr<Connection>& connection);
+  void close(const std::shared_ptr<Connection>& connection);
+public:
+
+  /**
+   * Constructor. Starts the workers and the epoll thread.
+   * @param router - router of the endpoints.
+   * @param config - &l:ParkingConnectionHandler::Config;.
+   */
+  ParkingConnectionHandler(const std::shared_ptr<oatpp::web::server::HttpRouter>& router, const Config& config);
+
+  /**
+   * Create shared ParkingConnectionHandler.
+   * @param router - router of the endpoints.
+   * @param config - &l:ParkingConnectionHandler::Config;.
+   * @return - `std::shared_ptr` to ParkingConnectionHandler.
+   */
+  static std::shared_ptr<ParkingConnectionHandler> createShared(const std::shared_ptr<oatpp::web::server::HttpRouter>& router,
+                                                                const Config& config);
+
+  /**
+   * Destructor. Stops the handler if not stopped.
+   */
+  ~ParkingConnectionHandler() override;
+
+  /**
+   * Add request interceptor. Must be called before the server is started.
+   * @param interceptor
+   */
+  void addRequestInterceptor(const std::shared_ptr<oatpp::web::server::interceptor::RequestInterceptor>& interceptor);
+
+  /**
+   * Add response interceptor. Must be called before the server is started.
+   * @param interceptor
+   */
+  void addResponseInterceptor(const std::shared_ptr<oatpp::web::server::interceptor::ResponseInterceptor>& interceptor);
+
+  /**
+   * Park the connection until its first request arrives. Never blocks.
+   * @param connection
+   * @param params
+   */
+  void handleConnection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection,
+                        const std::shared_ptr<const ParameterMap>& params) override;
+
+  /**
+   * Close parked connections right away, close the rest and join the threads.
+   */
+  void stop() override;
+
+  /**
+   * Get counters.
+   * @return - &l:ParkingConnectionHandler::Stats;.
+   */
+  Stats getStats();
+
+};
+
+#endif /* ParkingConnectionHandler_hpp */
@@ -0,0 +1,246 @@
+#include "PooledConnectionHandler.hpp"
+
+#include "oatpp/network/tcp/Connection.hpp"
+
+#include <cerrno>
+
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace {
+
+/* How long a rejected connection waits for the client's FIN before it is closed anyway */
+constexpr std::chrono::milliseconds REJECT_LINGER(100);
+
+/* Max rejected connections lingering at once - beyond that they are closed right away */
+constexpr size_t MAX_LINGERING = 1024;
+
+/* Poll timeout of the linger thread - how soon it picks up newly rejected connections */
+constexpr std::chrono::milliseconds LINGER_POLL_INTERVAL(10);
+
+}
+
+PooledConnectionHandler::PooledConnectionHandler(const std::shared_ptr<oatpp::web::server::HttpRouter>& router, const Config& config)
+  : m_components(std::make_shared<oatpp::web::server::HttpProcessor::Components>(router))
+  , m_config(config)
+  , m_stopped(false)
+  , m_accepted(0)
+  , m_rejected(0)
+{
+
+  if(m_config.workersCount < 1) {
+    throw std::runtime_error("[PooledConnectionHandler::PooledConnectionHandler()]: Error. Invalid workers count.");
+  }
+
+  m_rejectResponse = "HTTP/1.1 503 Service Unavailable\r\n"
+                     "Retry-After: " + std::to_string(m_config.retryAfter.count()) + "\r\n"
+                     "Content-Length: 0\r\n"
+                     "Connection: close\r\n"
+                     "\r\n";
+
+  m_workers.reserve(m_config.workersCount);
+  for(v_int32 i = 0; i < m_config.workersCount; i ++) {
+    m_workers.push_back(std::thread(&PooledConnectionHandler::work, this));
+  }
+
+  m_lingerThread = std::thread(&PooledConnectionHandler::linger, this);
+
+}
+
+std::shared_ptr<PooledConnectionHandler> PooledConnectionHandler::createShared(const std::shared_ptr<oatpp::web::server::HttpRouter>& router,
+                                                                               const Config& config)
+{
+  return std::make_shared<PooledConnectionHandler>(router, config);
+}
+
+PooledConnectionHandler::~PooledConnectionHandler() {
+  stop();
+}
+
+void PooledConnectionHandler::addRequestInterceptor(const std::shared_ptr<oatpp::web::server::interceptor::RequestInterceptor>& interceptor) {
+  m_components->requestInterceptors.push_back(interceptor);
+}
+
+void PooledConnectionHandler::addResponseInterceptor(const std::shared_ptr<oatpp::web::server::interceptor::ResponseInterceptor>& interceptor) {
+  m_components->responseInterceptors.push_back(interceptor);
+}
+
+void PooledConnectionHandler::work() {
+
+  while(true) {
+
+    oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> connection;
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_stopped || !m_queue.empty(); });
+      if(m_stopped) {
+        return;
+      }
+      connection = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+
+    oatpp::web::server::HttpProcessor::Task task(m_components, connection, this);
+    task.run();
+
+  }
+
+}
+
+void PooledConnectionHandler::linger() {
+
+  std::vector<Lingering> lingering;
+  std::vector<pollfd> handles;
+
+  while(true) {
+
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if(lingering.empty()) {
+        m_lingerCondition.wait(lock, [this] { return m_stopped || !m_lingering.empty(); });
+      }
+      for(auto& entry : m_lingering) {
+        lingering.push_back(std::move(entry));
+      }
+      m_lingering.clear();
+      if(m_stopped) {
+        break;
+      }
+    }
+
+    handles.resize(lingering.size());
+    for(size_t i = 0; i < lingering.size(); i ++) {
+      handles[i].fd = lingering[i].handle;
+      handles[i].events = POLLIN;
+      handles[i].revents = 0;
+    }
+
+    ::poll(handles.data(), (nfds_t) handles.size(), (int) LINGER_POLL_INTERVAL.count());
+
+    auto now = std::chrono::steady_clock::now();
+
+    for(size_t i = lingering.size(); i > 0; i --) {
+
+      auto& entry = lingering[i - 1];
+      bool done = now >= entry.deadline;
+
+      if(!done && handles[i - 1].revents != 0) {
+        /* Discard what the client still sends, up to its FIN */
+        v_char8 buffer[4096];
+        auto res = ::recv(entry.handle, buffer, sizeof(buffer), MSG_DONTWAIT);
+        done = res == 0 || (res < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+      }
+
+      if(done) {
+        entry.connection.invalidator->invalidate(entry.connection.object);
+        lingering.erase(lingering.begin() + (i - 1));
+      }
+
+    }
+
+  }
+
+  for(auto& entry : lingering) {
+    entry.connection.invalidator->invalidate(entry.connection.object);
+  }
+
+}
+
+void PooledConnectionHandler::reject(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) {
+
+  connection.object->setOutputStreamIOMode(oatpp::data::stream::IOMode::ASYNCHRONOUS);
+  connection.object->writeSimple(m_rejectResponse.data(), (v_buff_size) m_rejectResponse.size());
+
+  auto tcpConnection = std::dynamic_pointer_cast<oatpp::network::tcp::Connection>(connection.object);
+  if(tcpConnection) {
+
+    /* The client reads the 503 up to EOF, while its request may still be arriving */
+    ::shutdown(tcpConnection->getHandle(), SHUT_WR);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!m_stopped && m_lingering.size() < MAX_LINGERING) {
+      m_lingering.push_back({connection, tcpConnection->getHandle(), std::chrono::steady_clock::now() + REJECT_LINGER});
+      m_lingerCondition.notify_one();
+      return;
+    }
+
+  }
+
+  connection.invalidator->invalidate(connection.object);
+
+}
+
+void PooledConnectionHandler::handleConnection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection,
+                                               const std::shared_ptr<const ParameterMap>& params)
+{
+
+  (void) params;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!m_stopped && m_queue.size() < (size_t) m_config.queueSize) {
+      m_queue.push_back(connection);
+      m_accepted ++;
+      m_condition.notify_one();
+      return;
+    }
+  }
+
+  m_rejected ++;
+  reject(connection);
+
+}
+
+void PooledConnectionHandler::stop() {
+
+  std::vector<std::thread> workers;
+  std::thread lingerThread;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_stopped) {
+      return;
+    }
+    m_stopped = true;
+    for(auto& connection : m_queue) {
+      connection.invalidator->invalidate(connection.object);
+    }
+    m_queue.clear();
+    for(auto& pair : m_connections) {
+      pair.second.invalidator->invalidate(pair.second.object);
+    }
+    workers = std::move(m_workers);
+    lingerThread = std::move(m_lingerThread);
+  }
+
+  m_condition.notify_all();
+  m_lingerCondition.notify_all();
+
+  if(lingerThread.joinable()) {
+    lingerThread.join();
+  }
+
+  for(auto& worker : workers) {
+    worker.join();
+  }
+
+}
+
+void PooledConnectionHandler::onTaskStart(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_connections[(v_uint64) connection.object.get()] = connection;
+  if(m_stopped) {
+    connection.invalidator->invalidate(connection.object);
+  }
+}
+
+void PooledConnectionHandler::onTaskEnd(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_connections.erase((v_uint64) connection.object.get());
+}
+
+PooledConnectionHandler::Stats PooledConnectionHandler::getStats() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return {(v_int64) m_queue.size(), (v_int64) m_connections.size(), m_accepted.load(), m_rejected.load()};
+}
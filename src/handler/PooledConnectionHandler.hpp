@@ -0,0 +1,167 @@
+#ifndef PooledConnectionHandler_hpp
+#define PooledConnectionHandler_hpp
+
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/server/HttpProcessor.hpp"
+#include "oatpp/network/ConnectionHandler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * HTTP connection handler with a fixed number of worker threads and a bounded accept queue.
+ * Unlike `oatpp::web::server::HttpConnectionHandler` it doesn't spawn a thread per connection.
+ * A connection occupies a worker for its whole life, keep-alive included.
+ * When the queue is full, the connection is rejected in the accept thread with a prebuilt
+ * `503 Service Unavailable` + `Retry-After` - it is written without blocking, so the accept thread never waits for the pool.
+ * The rejected connection is then half-closed and handed to a linger thread, which discards what the client still
+ * sends and closes the connection on the client's FIN or after a short timeout - closing it with unread data right
+ * away would reset it, and the client could lose the 503.
+ */
+class PooledConnectionHandler : public oatpp::network::ConnectionHandler, public oatpp::web::server::HttpProcessor::TaskProcessingListener,
+                                public AllocationTracked<PooledConnectionHandler> {
+public:
+
+  /**
+   * Pool settings.
+   */
+  struct Config {
+
+    /**
+     * Number of worker threads - max number of connections served at the same time.
+     */
+    v_int32 workersCount;
+
+    /**
+     * Max number of accepted connections waiting for a free worker.
+     */
+    v_int32 queueSize;
+
+    /**
+     * Value of the `Retry-After` header of rejections.
+     */
+    std::chrono::seconds retryAfter;
+
+  };
+
+  /**
+   * Counters.
+   */
+  struct Stats {
+
+    /**
+     * Connections waiting for a worker now.
+     */
+    v_int64 queueDepth;
+
+    /**
+     * Connections served by workers now.
+     */
+    v_int64 active;
+
+    /**
+     * Connections taken into the queue since start.
+     */
+    v_int64 accepted;
+
+    /**
+     * Connections rejected with 503 since start.
+     */
+    v_int64 rejected;
+
+  };
+
+private:
+
+  struct Lingering {
+    oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> connection;
+    oatpp::v_io_handle handle;
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+private:
+  std::shared_ptr<oatpp::web::server::HttpProcessor::Components> m_components;
+  Config m_config;
+  std::string m_rejectResponse;
+  std::vector<std::thread> m_workers;
+  std::thread m_lingerThread;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::condition_variable m_lingerCondition;
+  std::vector<Lingering> m_lingering;
+  std::deque<oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>> m_queue;
+  std::unordered_map<v_uint64, oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>> m_connections;
+  bool m_stopped;
+  std::atomic<v_int64> m_accepted;
+  std::atomic<v_int64> m_rejected;
+private:
+  void work();
+  void linger();
+  void reject(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection);
+public:
+
+  /**
+   * Constructor. Starts the workers and the linger thread.
+   * @param router - router of the endpoints.
+   * @param config - &l:PooledConnectionHandler::Config;.
+   */
+  PooledConnectionHandler(const std::shared_ptr<oatpp::web::server::HttpRouter>& router, const Config& config);
+
+  /**
+   * Create shared PooledConnectionHandler.
+   * @param router - router of the endpoints.
+   * @param config - &l:PooledConnectionHandler::Config;.
+   * @return - `std::shared_ptr` to PooledConnectionHandler.
+   */
+  static std::shared_ptr<PooledConnectionHandler> createShared(const std::shared_ptr<oatpp::web::server::HttpRouter>& router,
+                                                               const Config& config);
+
+  /**
+   * Destructor. Stops the workers if not stopped.
+   */
+  ~PooledConnectionHandler() override;
+
+  /**
+   * Add request interceptor. Must be called before the server is started.
+   * @param interceptor
+   */
+  void addRequestInterceptor(const std::shared_ptr<oatpp::web::server::interceptor::RequestInterceptor>& interceptor);
+
+  /**
+   * Add response interceptor. Must be called before the server is started.
+   * @param interceptor
+   */
+  void addResponseInterceptor(const std::shared_ptr<oatpp::web::server::interceptor::ResponseInterceptor>& interceptor);
+
+  /**
+   * Queue the connection for a worker or reject it right away. Never blocks.
+   * @param connection
+   * @param params
+   */
+  void handleConnection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection,
+                        const std::shared_ptr<const ParameterMap>& params) override;
+
+  /**
+   * Close queued, running and lingering connections and join the threads.
+   */
+  void stop() override;
+
+  void onTaskStart(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) override;
+  void onTaskEnd(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection) override;
+
+  /**
+   * Get counters.
+   * @return - &l:PooledConnectionHandler::Stats;.
+   */
+  Stats getStats();
+
+};
+
+#endif /* PooledConnectionHandler_hpp */
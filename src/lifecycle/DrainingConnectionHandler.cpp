@@ -0,0 +1,237 @@
+#include "DrainingConnectionHandler.hpp"
+
+#include "oatpp/network/tcp/Connection.hpp"
+
+#include <sys/socket.h>
+
+namespace {
+
+/* How long stop() waits for force-closed connections which are blocked in an endpoint */
+constexpr std::chrono::seconds FORCE_CLOSE_GRACE(1);
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DrainingConnectionHandler::TrackedConnection
+
+DrainingConnectionHandler::TrackedConnection::TrackedConnection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection,
+                                                                const std::shared_ptr<Registry>& registry,
+                                                                const std::shared_ptr<oatpp::web::server::HttpConnectionHandler>& handler)
+  : m_connection(connection)
+  , m_registry(registry)
+  , m_handler(handler)
+  , m_inRequest(false)
+  , m_idle(false)
+  , m_aborted(false)
+{
+  std::lock_guard<std::mutex> lock(m_registry->mutex);
+  m_registry->connections.insert(this);
+}
+
+DrainingConnectionHandler::TrackedConnection::~TrackedConnection() {
+  {
+    std::lock_guard<std::mutex> lock(m_registry->mutex);
+    m_registry->connections.erase(this);
+    if(!m_aborted) {
+      m_registry->drained ++;
+    }
+  }
+  m_registry->condition.notify_all();
+}
+
+oatpp::v_io_size DrainingConnectionHandler::TrackedConnection::write(const void *data, v_buff_size count, oatpp::async::Action& action) {
+  /* Writing means the request was read - the next read waits for a new request */
+  m_inRequest = false;
+  return m_connection.object->write(data, count, action);
+}
+
+oatpp::v_io_size DrainingConnectionHandler::TrackedConnection::read(void *buffer, v_buff_size count, oatpp::async::Action& action) {
+  /* The flag is set before the read returns, so stop() may see a connection as idle while a request is arriving -
+   * closeIdle() leaves such a request its response */
+  if(!m_inRequest) {
+    m_idle = true;
+  }
+  auto res = m_connection.object->read(buffer, count, action);
+  if(res > 0) {
+    m_inRequest = true;
+  }
+  m_idle = false;
+  return res;
+}
+
+void DrainingConnectionHandler::TrackedConnection::setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) {
+  m_connection.object->setOutputStreamIOMode(ioMode);
+}
+
+oatpp::data::stream::IOMode DrainingConnectionHandler::TrackedConnection::getOutputStreamIOMode() {
+  return m_connection.object->getOutputStreamIOMode();
+}
+
+oatpp::data::stream::Context& DrainingConnectionHandler::TrackedConnection::getOutputStreamContext() {
+  return m_connection.object->getOutputStreamContext();
+}
+
+void DrainingConnectionHandler::TrackedConnection::setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) {
+  m_connection.object->setInputStreamIOMode(ioMode);
+}
+
+oatpp::data::stream::IOMode DrainingConnectionHandler::TrackedConnection::getInputStreamIOMode() {
+  return m_connection.object->getInputStreamIOMode();
+}
+
+oatpp::data::stream::Context& DrainingConnectionHandler::TrackedConnection::getInputStreamContext() {
+  return m_connection.object->getInputStreamContext();
+}
+
+bool DrainingConnectionHandler::TrackedConnection::isIdle() const {
+  return m_idle;
+}
+
+void DrainingConnectionHandler::TrackedConnection::closeIdle() {
+  auto tcpConnection = std::dynamic_pointer_cast<oatpp::network::tcp::Connection>(m_connection.object);
+  if(tcpConnection) {
+    /* Wakes the blocked read with EOF, the response side stays open */
+    ::shutdown(tcpConnection->getHandle(), SHUT_RD);
+  } else {
+    invalidate(false);
+  }
+}
+
+void DrainingConnectionHandler::TrackedConnection::invalidate(bool abort) {
+  if(abort) {
+    m_aborted = true;
+  }
+  m_connection.invalidator->invalidate(m_connection.object);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DrainingConnectionHandler::ConnectionInvalidator
+
+void DrainingConnectionHandler::ConnectionInvalidator::invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) {
+  std::static_pointer_cast<TrackedConnection>(connection)->invalidate(false);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DrainingConnectionHandler::ConnectionCloseInterceptor
+
+DrainingConnectionHandler::ConnectionCloseInterceptor::ConnectionCloseInterceptor(const std::shared_ptr<Registry>& registry)
+  : m_registry(registry)
+{}
+
+std::shared_ptr<DrainingConnectionHandler::ConnectionCloseInterceptor::OutgoingResponse>
+DrainingConnectionHandler::ConnectionCloseInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request,
+                                                                 const std::shared_ptr<OutgoingResponse>& response)
+{
+  (void) request;
+  if(m_registry->draining) {
+    response->putHeader(oatpp::web::protocol::http::Header::CONNECTION, oatpp::web::protocol::http::Header::Value::CONNECTION_CLOSE);
+  }
+  return response;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// DrainingConnectionHandler
+
+DrainingConnectionHandler::DrainingConnectionHandler(const std::shared_ptr<oatpp::web::server::HttpConnectionHandler>& handler,
+                                                     const std::chrono::milliseconds& deadline)
+  : m_handler(handler)
+  , m_deadline(deadline)
+  , m_registry(std::make_shared<Registry>())
+  , m_invalidator(std::make_shared<ConnectionInvalidator>())
+  , m_stopped(false)
+  , m_report({0, 0, std::chrono::microseconds(0)})
+{
+  m_handler->addResponseInterceptor(std::make_shared<ConnectionCloseInterceptor>(m_registry));
+}
+
+std::shared_ptr<DrainingConnectionHandler> DrainingConnectionHandler::createShared(const std::shared_ptr<oatpp::web::server::HttpConnectionHandler>& handler,
+                                                                                   const std::chrono::milliseconds& deadline)
+{
+  return std::make_shared<DrainingConnectionHandler>(handler, deadline);
+}
+
+void DrainingConnectionHandler::handleConnection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection,
+                                                 const std::shared_ptr<const ParameterMap>& params)
+{
+  if(m_registry->draining) {
+    connection.invalidator->invalidate(connection.object);
+    return;
+  }
+
+  auto tracked = std::make_shared<TrackedConnection>(connection, m_registry, m_handler);
+  m_handler->handleConnection(oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(tracked, m_invalidator), params);
+}
+
+void DrainingConnectionHandler::stop() {
+
+  std::lock_guard<std::mutex> stopLock(m_stopMutex);
+
+  if(m_stopped) {
+    return;
+  }
+  m_stopped = true;
+
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + m_deadline;
+
+  std::unique_lock<std::mutex> lock(m_registry->mutex);
+
+  /* From now on every response gets 'Connection: close' */
+  m_registry->draining = true;
+
+  auto drainedBefore = m_registry->drained;
+
+  /* Nothing is in flight on idle keep-alive connections - close them right away */
+  for(auto connection : m_registry->connections) {
+    if(connection->isIdle()) {
+      connection->closeIdle();
+    }
+  }
+
+  /* Give in-flight requests the rest of the deadline */
+  m_registry->condition.wait_until(lock, deadline, [this] {
+    return m_registry->connections.empty();
+  });
+
+  /* Force-close stragglers */
+  m_report.aborted = (v_int64) m_registry->connections.size();
+  for(auto connection : m_registry->connections) {
+    connection->invalidate(true);
+  }
+
+  /* A connection blocked in an endpoint notices the close only when the endpoint returns - don't wait for it forever */
+  auto closed = m_registry->condition.wait_until(lock, std::chrono::steady_clock::now() + FORCE_CLOSE_GRACE, [this] {
+    return m_registry->connections.empty();
+  });
+
+  m_report.drained = m_registry->drained - drainedBefore;
+  auto blocked = (v_int64) m_registry->connections.size();
+
+  lock.unlock();
+
+  if(closed) {
+    m_handler->stop();
+  } else {
+    /* HttpConnectionHandler::stop() would wait for them too. Their threads are detached and end with the endpoint -
+     * the wrapped handler lives on in their connections until then */
+    OATPP_LOGW("[DrainingConnectionHandler::stop()]", "Warning. %lld connections are still blocked in endpoints after the force-close",
+               (long long) blocked);
+  }
+
+  m_report.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+}
+
+bool DrainingConnectionHandler::isDraining() const {
+  return m_registry->draining;
+}
+
+v_int64 DrainingConnectionHandler::getConnectionsCount() {
+  std::lock_guard<std::mutex> lock(m_registry->mutex);
+  return (v_int64) m_registry->connections.size();
+}
+
+DrainingConnectionHandler::Report DrainingConnectionHandler::getReport() {
+  std::lock_guard<std::mutex> lock(m_stopMutex);
+  return m_report;
+}
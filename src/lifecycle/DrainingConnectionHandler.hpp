@@ -0,0 +1,183 @@
+#ifndef DrainingConnectionHandler_hpp
+#define DrainingConnectionHandler_hpp
+
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/web/server/interceptor/ResponseInterceptor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <unordered_set>
+
+/**
+ * Connection handler which stops within a bounded time.
+ * Wraps `oatpp::web::server::HttpConnectionHandler` and tracks every connection it hands over.
+ * On stop() it drains:
+ * - connections idle between keep-alive requests are closed right away;
+ * - responses to requests arriving during the drain get `Connection: close`;
+ * - in-flight requests get the rest of the deadline;
+ * - connections still open at the deadline are force-closed (aborted).
+ * A connection blocked in an endpoint ignores the force-close until the endpoint returns. stop() waits for such
+ * connections at most a second more, then returns with a warning - their threads finish on their own. Each connection
+ * holds the wrapped handler, so these threads never call into a handler which was destroyed after stop() returned.
+ */
+class DrainingConnectionHandler : public oatpp::network::ConnectionHandler {
+public:
+
+  /**
+   * Result of the drain.
+   */
+  struct Report {
+    /**
+     * Connections which were closed gracefully while draining.
+     */
+    v_int64 drained;
+
+    /**
+     * Connections which were force-closed at the deadline, including those which were still blocked in an endpoint
+     * when stop() returned.
+     */
+    v_int64 aborted;
+
+    /**
+     * Time the drain took.
+     */
+    std::chrono::microseconds duration;
+  };
+
+private:
+
+  class TrackedConnection;
+
+  /**
+   * Open connections and the drain flag. Shared with the connections and with the response interceptor on the
+   * wrapped handler, so it outlives the DrainingConnectionHandler if they do.
+   */
+  struct Registry {
+    std::atomic<bool> draining{false};
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::unordered_set<TrackedConnection*> connections;
+    v_int64 drained = 0;
+  };
+
+  class TrackedConnection : public oatpp::base::Countable, public oatpp::data::stream::IOStream, public AllocationTracked<TrackedConnection> {
+  private:
+    oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> m_connection;
+    std::shared_ptr<Registry> m_registry;
+    /* The task of the connection calls back into the handler when it ends - keep it alive until then */
+    std::shared_ptr<oatpp::web::server::HttpConnectionHandler> m_handler;
+    std::atomic<bool> m_inRequest;
+    std::atomic<bool> m_idle;
+    std::atomic<bool> m_aborted;
+  public:
+
+    TrackedConnection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection,
+                      const std::shared_ptr<Registry>& registry,
+                      const std::shared_ptr<oatpp::web::server::HttpConnectionHandler>& handler);
+
+    ~TrackedConnection() override;
+
+    oatpp::v_io_size write(const void *data, v_buff_size count, oatpp::async::Action& action) override;
+    oatpp::v_io_size read(void *buffer, v_buff_size count, oatpp::async::Action& action) override;
+
+    void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override;
+    oatpp::data::stream::IOMode getOutputStreamIOMode() override;
+    oatpp::data::stream::Context& getOutputStreamContext() override;
+
+    void setInputStreamIOMode(oatpp::data::stream::IOMode ioMode) override;
+    oatpp::data::stream::IOMode getInputStreamIOMode() override;
+    oatpp::data::stream::Context& getInputStreamContext() override;
+
+    /**
+     * Idle connection is blocked waiting for the first byte of its next request.
+     */
+    bool isIdle() const;
+
+    /**
+     * Close an idle connection. TCP connections are only shut down for reading - if a request arrived just before,
+     * it is still answered (with `Connection: close`), then the next read ends the connection.
+     */
+    void closeIdle();
+
+    /**
+     * Close the underlying connection.
+     * @param abort - count the connection as aborted.
+     */
+    void invalidate(bool abort);
+
+  };
+
+  class ConnectionInvalidator : public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+  public:
+    void invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) override;
+  };
+
+  class ConnectionCloseInterceptor : public oatpp::web::server::interceptor::ResponseInterceptor {
+  private:
+    std::shared_ptr<Registry> m_registry;
+  public:
+    ConnectionCloseInterceptor(const std::shared_ptr<Registry>& registry);
+    std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                                const std::shared_ptr<OutgoingResponse>& response) override;
+  };
+
+private:
+  std::shared_ptr<oatpp::web::server::HttpConnectionHandler> m_handler;
+  std::chrono::milliseconds m_deadline;
+  std::shared_ptr<Registry> m_registry;
+  std::shared_ptr<ConnectionInvalidator> m_invalidator;
+  std::mutex m_stopMutex;
+  bool m_stopped;
+  Report m_report;
+public:
+
+  /**
+   * Constructor.
+   * @param handler - HTTP connection handler to wrap. A response interceptor is added to it.
+   * @param deadline - max time stop() waits for running connections before force-closing them.
+   */
+  DrainingConnectionHandler(const std::shared_ptr<oatpp::web::server::HttpConnectionHandler>& handler,
+                            const std::chrono::milliseconds& deadline);
+
+  /**
+   * Create shared DrainingConnectionHandler.
+   * @param handler - HTTP connection handler to wrap.
+   * @param deadline - max time stop() waits for running connections before force-closing them.
+   * @return - `std::shared_ptr` to DrainingConnectionHandler.
+   */
+  static std::shared_ptr<DrainingConnectionHandler> createShared(const std::shared_ptr<oatpp::web::server::HttpConnectionHandler>& handler,
+                                                                 const std::chrono::milliseconds& deadline);
+
+  void handleConnection(const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>& connection,
+                        const std::shared_ptr<const ParameterMap>& params) override;
+
+  /**
+   * Drain connections within the deadline and stop the wrapped handler.
+   */
+  void stop() override;
+
+  /**
+   * Check if the handler is draining or stopped.
+   * @return - `true` if draining.
+   */
+  bool isDraining() const;
+
+  /**
+   * Get number of open connections.
+   * @return - number of open connections.
+   */
+  v_int64 getConnectionsCount();
+
+  /**
+   * Get result of the last drain. Valid after stop() returned.
+   * @return - &l:DrainingConnectionHandler::Report;.
+   */
+  Report getReport();
+
+};
+
+#endif /* DrainingConnectionHandler_hpp */
@@ -0,0 +1,132 @@
+#include "ServerGroup.hpp"
+
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+ServerGroup::ServerGroup(const oatpp::network::Address& address,
+                         v_int32 acceptorsCount,
+                         const ConnectionHandlerFactory& connectionHandlerFactory,
+                         bool pinThreads,
+                         const std::shared_ptr<StopSignal>& stopSignal)
+  : m_pinThreads(pinThreads)
+  , m_stopSignal(stopSignal)
+  , m_started(false)
+  , m_stopped(false)
+{
+
+  if(acceptorsCount < 1) {
+    throw std::runtime_error("[ServerGroup::ServerGroup()]: Error. acceptorsCount must be at least 1.");
+  }
+
+  m_members.resize(acceptorsCount);
+
+  oatpp::network::Address memberAddress = address;
+
+  for(v_int32 i = 0; i < acceptorsCount; i ++) {
+
+    auto& member = m_members[i];
+
+    member.connectionProvider = ListenerConnectionProvider::createShared(memberAddress, true);
+    member.lifecycle = std::make_shared<ServerLifecycle>(member.connectionProvider, connectionHandlerFactory(i), m_stopSignal);
+
+    /* Others join the port picked by the first member */
+    memberAddress.port = member.connectionProvider->getPort();
+
+  }
+
+}
+
+ServerGroup::~ServerGroup() {
+  stop();
+}
+
+void ServerGroup::pinCurrentThread(v_int32 index) {
+#if defined(__linux__)
+  auto cpusCount = std::thread::hardware_concurrency();
+  if(cpusCount == 0) {
+    return;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(index % cpusCount, &cpuSet);
+  if(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+    OATPP_LOGW("ServerGroup", "Can't pin acceptor %d to CPU %d", index, (int) (index % cpusCount));
+  }
+#else
+  (void) index;
+#endif
+}
+
+void ServerGroup::start() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(m_started || m_stopped) {
+    return;
+  }
+  m_started = true;
+
+  for(v_int32 i = 0; i < (v_int32) m_members.size(); i ++) {
+    if(m_pinThreads) {
+      m_members[i].lifecycle->start([i] {
+        pinCurrentThread(i);
+      });
+    } else {
+      m_members[i].lifecycle->start();
+    }
+  }
+}
+
+void ServerGroup::run() {
+  start();
+  m_stopSignal->wait();
+  shutdown();
+}
+
+void ServerGroup::stop() {
+  m_stopSignal->signal();
+  shutdown();
+}
+
+void ServerGroup::shutdown() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(m_stopped) {
+    return;
+  }
+  m_stopped = true;
+
+  /* Stop accepting on every member before draining any of them */
+  for(auto& member : m_members) {
+    member.lifecycle->stopAccepting();
+  }
+
+  /* Drain members in parallel */
+  std::vector<std::thread> stopThreads;
+  for(auto& member : m_members) {
+    auto lifecycle = member.lifecycle;
+    stopThreads.push_back(std::thread([lifecycle] {
+      lifecycle->stop();
+    }));
+  }
+
+  for(auto& thread : stopThreads) {
+    thread.join();
+  }
+}
+
+v_int32 ServerGroup::getAcceptorsCount() const {
+  return (v_int32) m_members.size();
+}
+
+v_uint16 ServerGroup::getPort() const {
+  return m_members.front().connectionProvider->getPort();
+}
+
+const std::shared_ptr<StopSignal>& ServerGroup::getStopSignal() const {
+  return m_stopSignal;
+}
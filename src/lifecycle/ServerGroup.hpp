@@ -0,0 +1,104 @@
+#ifndef ServerGroup_hpp
+#define ServerGroup_hpp
+
+#include "ServerLifecycle.hpp"
+#include "StopSignal.hpp"
+
+#include "network/ListenerConnectionProvider.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Group of servers accepting on the same port.
+ * Every member has its own `SO_REUSEPORT` listener, connection handler and acceptor thread, so the kernel spreads
+ * incoming connections over the acceptors instead of funneling them through one accept loop.
+ * Every member is a &l:ServerLifecycle;. Members' connection handlers are created by a factory and usually share
+ * one router.
+ * Stopping the group first stops accepting on every member, then stops all connection handlers in parallel,
+ * so a draining handler's deadline applies to the group once and not once per member.
+ */
+class ServerGroup {
+public:
+
+  /**
+   * Creates connection handler for the member with the given index.
+   */
+  typedef std::function<std::shared_ptr<oatpp::network::ConnectionHandler>(v_int32 index)> ConnectionHandlerFactory;
+
+private:
+
+  struct Member {
+    std::shared_ptr<ListenerConnectionProvider> connectionProvider;
+    std::shared_ptr<ServerLifecycle> lifecycle;
+  };
+
+private:
+  std::vector<Member> m_members;
+  bool m_pinThreads;
+  std::shared_ptr<StopSignal> m_stopSignal;
+  std::mutex m_mutex;
+  bool m_started;
+  bool m_stopped;
+private:
+  static void pinCurrentThread(v_int32 index);
+  void shutdown();
+public:
+
+  /**
+   * Constructor. Binds all listeners.
+   * @param address - address to listen on. With port `0` the first member picks the port and the others join it.
+   * @param acceptorsCount - number of members.
+   * @param connectionHandlerFactory - creates connection handler for each member.
+   * @param pinThreads - pin acceptor thread `i` to CPU `i % hardware_concurrency` (Linux only).
+   * @param stopSignal - signal which requests stop. A new one is created if not specified.
+   */
+  ServerGroup(const oatpp::network::Address& address,
+              v_int32 acceptorsCount,
+              const ConnectionHandlerFactory& connectionHandlerFactory,
+              bool pinThreads = false,
+              const std::shared_ptr<StopSignal>& stopSignal = std::make_shared<StopSignal>());
+
+  /**
+   * Destructor. Stops the group if it is still running.
+   */
+  ~ServerGroup();
+
+  /**
+   * Start accepting connections on every member and return immediately.
+   */
+  void start();
+
+  /**
+   * Start accepting connections and block until stop is signaled and all connections are served.
+   */
+  void run();
+
+  /**
+   * Signal stop and block until every member is stopped. Safe to call from any thread, more than once.
+   */
+  void stop();
+
+  /**
+   * Get number of members.
+   * @return - number of members.
+   */
+  v_int32 getAcceptorsCount() const;
+
+  /**
+   * Get port the group listens on.
+   * @return - port.
+   */
+  v_uint16 getPort() const;
+
+  /**
+   * Get stop signal of this group.
+   * @return - &l:StopSignal;.
+   */
+  const std::shared_ptr<StopSignal>& getStopSignal() const;
+
+};
+
+#endif /* ServerGroup_hpp */
@@ -0,0 +1,127 @@
+#include "ServerLifecycle.hpp"
+
+#include "network/ListenerConnectionProvider.hpp"
+
+ServerLifecycle::ServerLifecycle(const std::shared_ptr<oatpp::network::ServerConnectionProvider>& connectionProvider,
+                                 const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler,
+                                 const std::shared_ptr<StopSignal>& stopSignal)
+  : ServerLifecycle(connectionProvider, connectionHandler, nullptr, stopSignal)
+{}
+
+ServerLifecycle::ServerLifecycle(const std::shared_ptr<oatpp::network::ServerConnectionProvider>& connectionProvider,
+                                 const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler,
+                                 const std::shared_ptr<oatpp::async::Executor>& executor,
+                                 const std::shared_ptr<StopSignal>& stopSignal)
+  : m_connectionProvider(connectionProvider)
+  , m_connectionHandler(connectionHandler)
+  , m_executor(executor)
+  , m_stopSignal(stopSignal)
+  , m_server(oatpp::network::Server::createShared(connectionProvider, connectionHandler))
+  , m_started(false)
+  , m_acceptStopped(false)
+  , m_stopped(false)
+{}
+
+ServerLifecycle::~ServerLifecycle() {
+  stop();
+}
+
+void ServerLifecycle::start(const std::function<void()>& onAcceptThreadStart) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(m_started || m_acceptStopped) {
+    return;
+  }
+  m_started = true;
+
+  /* Open the port here rather than in the accept thread - connection attempts must not race the first get() */
+  auto listener = std::dynamic_pointer_cast<ListenerConnectionProvider>(m_connectionProvider);
+  if(listener) {
+    listener->listen();
+  }
+
+  auto server = m_server;
+  m_acceptThread = std::thread([server, onAcceptThreadStart] {
+    if(onAcceptThreadStart) {
+      onAcceptThreadStart();
+    }
+    server->run();
+  });
+
+  /* Server::stop() ignores a server which run() hasn't moved out of STATUS_CREATED yet - the accept loop would then
+   * outlive the stop. Don't return before it's started */
+  while(m_server->getStatus() == oatpp::network::Server::STATUS_CREATED) {
+    std::this_thread::yield();
+  }
+}
+
+void ServerLifecycle::run() {
+  start();
+  m_stopSignal->wait();
+  shutdown();
+}
+
+void ServerLifecycle::stop() {
+  m_stopSignal->signal();
+  shutdown();
+}
+
+void ServerLifecycle::shutdown() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if(m_stopped) {
+    return;
+  }
+  m_stopped = true;
+
+  stopAcceptingLocked();
+
+  /* Wait until all running connections are served */
+  m_connectionHandler->stop();
+
+  if(m_executor) {
+
+    /* Let coroutines which are not bound to a connection finish, then stop the executor threads */
+    m_executor->waitTasksFinished();
+    m_executor->stop();
+    m_executor->join();
+
+    auto leaked = m_executor->getTasksCount();
+    if(leaked != 0) {
+      OATPP_LOGW("ServerLifecycle", "Executor stopped with %lld coroutines left", (long long) leaked);
+    }
+
+  }
+}
+
+void ServerLifecycle::stopAccepting() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  stopAcceptingLocked();
+}
+
+void ServerLifecycle::stopAcceptingLocked() {
+
+  if(m_acceptStopped) {
+    return;
+  }
+  m_acceptStopped = true;
+
+  /* Leave the accept loop on its next iteration... */
+  m_server->stop();
+
+  /* ...which happens right away, because stopping the provider wakes the blocked accept */
+  m_connectionProvider->stop();
+
+  if(m_acceptThread.joinable()) {
+    m_acceptThread.join();
+  }
+
+}
+
+bool ServerLifecycle::isRunning() {
+  return m_server->getStatus() == oatpp::network::Server::STATUS_RUNNING;
+}
+
+const std::shared_ptr<StopSignal>& ServerLifecycle::getStopSignal() const {
+  return m_stopSignal;
+}
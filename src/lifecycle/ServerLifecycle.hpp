@@ -0,0 +1,104 @@
+#ifndef ServerLifecycle_hpp
+#define ServerLifecycle_hpp
+
+#include "StopSignal.hpp"
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/network/Server.hpp"
+#include "oatpp/core/async/Executor.hpp"
+
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * Runs `oatpp::network::Server` and stops it in the right order:
+ * server -> connection provider -> connection handler.
+ * The server loop runs without a condition function, so nothing is called on the accept path.
+ * Stop is requested through a &l:StopSignal; which may be shared with threads that don't own the lifecycle.
+ */
+class ServerLifecycle : public AllocationTracked<ServerLifecycle> {
+private:
+  std::shared_ptr<oatpp::network::ServerConnectionProvider> m_connectionProvider;
+  std::shared_ptr<oatpp::network::ConnectionHandler> m_connectionHandler;
+  std::shared_ptr<oatpp::async::Executor> m_executor;
+  std::shared_ptr<StopSignal> m_stopSignal;
+  std::shared_ptr<oatpp::network::Server> m_server;
+  std::thread m_acceptThread;
+  std::mutex m_mutex;
+  bool m_started;
+  bool m_acceptStopped;
+  bool m_stopped;
+private:
+  void stopAcceptingLocked();
+  void shutdown();
+public:
+
+  /**
+   * Constructor.
+   * @param connectionProvider - provider of incoming connections.
+   * @param connectionHandler - handler of incoming connections.
+   * @param stopSignal - signal which requests stop. A new one is created if not specified.
+   */
+  ServerLifecycle(const std::shared_ptr<oatpp::network::ServerConnectionProvider>& connectionProvider,
+                  const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler,
+                  const std::shared_ptr<StopSignal>& stopSignal = std::make_shared<StopSignal>());
+
+  /**
+   * Constructor for async connection handlers.
+   * After the connection handler is stopped, waits for remaining coroutines of the executor and stops it.
+   * @param connectionProvider - provider of incoming connections.
+   * @param connectionHandler - async handler of incoming connections.
+   * @param executor - executor used by the connection handler.
+   * @param stopSignal - signal which requests stop. A new one is created if not specified.
+   */
+  ServerLifecycle(const std::shared_ptr<oatpp::network::ServerConnectionProvider>& connectionProvider,
+                  const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler,
+                  const std::shared_ptr<oatpp::async::Executor>& executor,
+                  const std::shared_ptr<StopSignal>& stopSignal = std::make_shared<StopSignal>());
+
+  /**
+   * Destructor. Stops the server if it is still running.
+   */
+  ~ServerLifecycle();
+
+  /**
+   * Start accepting connections in a new thread and return immediately.
+   * A &l:ListenerConnectionProvider; with deferred `listen()` starts listening before this returns,
+   * so that clients can connect right after.
+   * @param onAcceptThreadStart - called in the accept thread before the accept loop starts. Optional.
+   */
+  void start(const std::function<void()>& onAcceptThreadStart = nullptr);
+
+  /**
+   * Start accepting connections and block until stop is signaled and all connections are served.
+   */
+  void run();
+
+  /**
+   * Signal stop and block until all connections are served. Safe to call from any thread, more than once.
+   */
+  void stop();
+
+  /**
+   * Stop accepting connections and return without waiting for running connections.
+   * The connection handler is stopped later by &l:ServerLifecycle::stop ();. Lets several lifecycles on one port stop
+   * accepting before any of them is drained.
+   */
+  void stopAccepting();
+
+  /**
+   * Check if the server accepts connections.
+   * @return - `true` if running.
+   */
+  bool isRunning();
+
+  /**
+   * Get stop signal of this lifecycle.
+   * @return - &l:StopSignal;.
+   */
+  const std::shared_ptr<StopSignal>& getStopSignal() const;
+
+};
+
+#endif /* ServerLifecycle_hpp */
@@ -0,0 +1,86 @@
+#include "StopSignal.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+StopSignal::StopSignal()
+  : m_signaled(false)
+  , m_readHandle(-1)
+  , m_writeHandle(-1)
+{
+#if defined(__linux__)
+  m_readHandle = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if(m_readHandle < 0) {
+    throw std::runtime_error("[StopSignal::StopSignal()]: Error. Can't create eventfd.");
+  }
+  m_writeHandle = m_readHandle;
+#else
+  int handles[2];
+  if(::pipe(handles) != 0) {
+    throw std::runtime_error("[StopSignal::StopSignal()]: Error. Can't create pipe.");
+  }
+  for(int handle : handles) {
+    ::fcntl(handle, F_SETFL, ::fcntl(handle, F_GETFL) | O_NONBLOCK);
+    ::fcntl(handle, F_SETFD, FD_CLOEXEC);
+  }
+  m_readHandle = handles[0];
+  m_writeHandle = handles[1];
+#endif
+}
+
+StopSignal::~StopSignal() {
+  ::close(m_readHandle);
+  if(m_writeHandle != m_readHandle) {
+    ::close(m_writeHandle);
+  }
+}
+
+void StopSignal::signal() {
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_signaled.exchange(true)) {
+      return;
+    }
+  }
+
+  m_condition.notify_all();
+
+  /* The handle is never drained, so it stays readable for everyone polling it */
+#if defined(__linux__)
+  uint64_t value = 1;
+#else
+  char value = 1;
+#endif
+  ssize_t res;
+  do {
+    res = ::write(m_writeHandle, &value, sizeof(value));
+  } while(res < 0 && errno == EINTR);
+
+}
+
+bool StopSignal::isSignaled() const {
+  return m_signaled.load();
+}
+
+void StopSignal::wait() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_condition.wait(lock, [this]{ return m_signaled.load(); });
+}
+
+bool StopSignal::waitFor(const std::chrono::milliseconds& timeout) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return m_condition.wait_for(lock, timeout, [this]{ return m_signaled.load(); });
+}
+
+int StopSignal::getHandle() const {
+  return m_readHandle;
+}
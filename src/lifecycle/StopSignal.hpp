@@ -0,0 +1,60 @@
+#ifndef StopSignal_hpp
+#define StopSignal_hpp
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+/**
+ * One-shot stop token.
+ * Once signaled it stays signaled. Threads can block on it with wait()/waitFor(), and I/O loops can poll its
+ * handle together with their own sockets (eventfd on Linux, self-pipe elsewhere) to get woken exactly once on stop.
+ */
+class StopSignal {
+private:
+  std::atomic<bool> m_signaled;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  int m_readHandle;
+  int m_writeHandle;
+public:
+
+  StopSignal();
+  ~StopSignal();
+
+  StopSignal(const StopSignal&) = delete;
+  StopSignal& operator=(const StopSignal&) = delete;
+
+  /**
+   * Signal stop. Wakes every waiter and makes the handle readable. Calling it more than once is a no-op.
+   */
+  void signal();
+
+  /**
+   * Check if stop was signaled.
+   * @return - `true` if signaled.
+   */
+  bool isSignaled() const;
+
+  /**
+   * Block until stop is signaled.
+   */
+  void wait();
+
+  /**
+   * Block until stop is signaled or timeout expires.
+   * @param timeout
+   * @return - `true` if signaled.
+   */
+  bool waitFor(const std::chrono::milliseconds& timeout);
+
+  /**
+   * Get handle to poll for `POLLIN`. It becomes readable on signal() and stays readable.
+   * @return - file descriptor.
+   */
+  int getHandle() const;
+
+};
+
+#endif /* StopSignal_hpp */
@@ -0,0 +1,150 @@
+#include "WarmUp.hpp"
+
+#include "memory/BufferPool.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/virtual_/client/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/server/ConnectionProvider.hpp"
+#include "oatpp/network/virtual_/Interface.hpp"
+#include "oatpp/network/Server.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+/* Every run gets an interface of its own - several servers of one process may warm up at the same time */
+std::atomic<v_int64> interfaceCounter(0);
+
+/**
+ * Send `GET` requests of the thread `index` out of `threadsCount` over one keep-alive connection.
+ * A connection which failed is replaced.
+ */
+void sendRequests(const std::shared_ptr<oatpp::web::client::HttpRequestExecutor>& executor,
+                  const WarmUp::Config& config,
+                  v_int32 index,
+                  v_int32 threadsCount,
+                  std::atomic<v_int64>& requests,
+                  std::atomic<v_int64>& failed)
+{
+
+  std::shared_ptr<oatpp::web::client::RequestExecutor::ConnectionHandle> connection;
+  oatpp::web::protocol::http::Headers headers;
+
+  for(v_int32 i = index; i < config.requestsPerPath; i += threadsCount) {
+    for(auto& path : config.paths) {
+
+      requests ++;
+
+      try {
+        if(!connection) {
+          connection = executor->getConnection();
+        }
+        auto response = executor->execute("GET", path.c_str(), headers, nullptr, connection);
+        /* Read the body - serialization of streamed bodies runs while it is read */
+        response->readBodyToString();
+      } catch (const std::exception&) {
+        failed ++;
+        connection.reset();
+      }
+
+    }
+  }
+
+}
+
+}
+
+v_int64 WarmUp::prefaultBufferPool(v_int64 bytes) {
+
+  if(bytes <= 0) {
+    return 0;
+  }
+
+  v_int64 prefaulted = 0;
+
+  /* All buffers are held at once, so that each of them is a separate allocation */
+  std::vector<std::shared_ptr<std::string>> buffers;
+
+  for(v_int32 i = 0; i < BufferPool::CLASSES_COUNT; i ++) {
+
+    auto classSize = BufferPool::getClassSize(i);
+    auto count = std::min<v_int64>(std::max<v_int64>(bytes / BufferPool::CLASSES_COUNT / classSize, 1), BufferPool::SHARED_SLOTS);
+
+    for(v_int64 j = 0; j < count; j ++) {
+      auto buffer = BufferPool::acquire(classSize);
+      /* resize() writes every byte - pages are faulted in now rather than on the first read into the buffer */
+      buffer->resize((size_t) classSize);
+      buffers.push_back(buffer);
+      prefaulted += classSize;
+    }
+
+  }
+
+  /* Released to the cache of this thread first - move them to the shared pool, where handler threads find them */
+  buffers.clear();
+  BufferPool::releaseThreadCache();
+
+  return prefaulted;
+
+}
+
+WarmUp::Report WarmUp::run(const Config& config, const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler) {
+
+  auto startTime = std::chrono::steady_clock::now();
+
+  Report report;
+  report.requests = 0;
+  report.failed = 0;
+  report.prefaultedBytes = prefaultBufferPool(config.bufferPoolBytes);
+
+  auto interface = oatpp::network::virtual_::Interface::obtainShared("warm-up." + std::to_string(interfaceCounter ++));
+  auto serverConnectionProvider = oatpp::network::virtual_::server::ConnectionProvider::createShared(interface);
+  auto clientConnectionProvider = oatpp::network::virtual_::client::ConnectionProvider::createShared(interface);
+
+  auto server = oatpp::network::Server::createShared(serverConnectionProvider, connectionHandler);
+  std::thread serverThread([server] {
+    server->run();
+  });
+
+  /* Server::stop() ignores a server which run() hasn't moved out of STATUS_CREATED yet - with no requests to send,
+   * stop() would come first and join() would never return. Same as ServerLifecycle::start() */
+  while(server->getStatus() == oatpp::network::Server::STATUS_CREATED) {
+    std::this_thread::yield();
+  }
+
+  std::atomic<v_int64> requests(0);
+  std::atomic<v_int64> failed(0);
+
+  {
+
+    auto executor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+    auto threadsCount = std::max<v_int32>(config.connections, 1);
+
+    std::vector<std::thread> clients;
+    for(v_int32 i = 0; i < threadsCount; i ++) {
+      clients.push_back(std::thread([executor, &config, i, threadsCount, &requests, &failed] {
+        sendRequests(executor, config, i, threadsCount, requests, failed);
+      }));
+    }
+
+    for(auto& client : clients) {
+      client.join();
+    }
+
+  }
+
+  /* Client connections are closed - stop in the order of ServerLifecycle */
+  server->stop();
+  serverConnectionProvider->stop();
+  serverThread.join();
+  connectionHandler->stop();
+  clientConnectionProvider->stop();
+
+  report.requests = requests;
+  report.failed = failed;
+  report.duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+  return report;
+
+}
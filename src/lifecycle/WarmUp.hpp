@@ -0,0 +1,103 @@
+#ifndef WarmUp_hpp
+#define WarmUp_hpp
+
+#include "oatpp/network/ConnectionHandler.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Warm-up of a server before its port is opened, so that the first real requests don't pay for first-use costs.
+ * Pre-faults buffers of &l:BufferPool; and runs synthetic `GET` requests over an in-process virtual interface
+ * through a connection handler on the server's router - first serialization of DTOs, first route lookups, static
+ * tables of compressors, malloc arenas. The handler and its threads are thrown away afterwards - no threads are left
+ * spawned for the server; at most glibc's cache of freed thread stacks is reused by the threads spawned later.
+ * See &l:AppComponent::warmUp ();.
+ */
+class WarmUp {
+public:
+
+  /**
+   * Warm-up settings.
+   */
+  struct Config {
+
+    /**
+     * Warm up before the port is opened. Otherwise the port is opened right away.
+     */
+    bool enabled = true;
+
+    /**
+     * Paths requested with `GET`. Any status counts - the point is running the code, not the result.
+     */
+    std::vector<std::string> paths = {"/"};
+
+    /**
+     * Requests per path.
+     */
+    v_int32 requestsPerPath = 100;
+
+    /**
+     * Concurrent keep-alive connections the requests are sent over, each from its own thread.
+     */
+    v_int32 connections = 4;
+
+    /**
+     * Memory of &l:BufferPool; to pre-fault, split evenly between its size classes. `0` - none.
+     * &l:AppComponent::warmUp (); pre-faults only if the connection handler takes its buffers from the pool.
+     */
+    v_int64 bufferPoolBytes = 4 * 1024 * 1024;
+
+  };
+
+  /**
+   * What the warm-up did.
+   */
+  struct Report {
+
+    /**
+     * Requests sent.
+     */
+    v_int64 requests;
+
+    /**
+     * Requests which failed with an I/O error. Error statuses are not failures.
+     */
+    v_int64 failed;
+
+    /**
+     * Bytes of buffers pre-faulted and left in &l:BufferPool;.
+     */
+    v_int64 prefaultedBytes;
+
+    /**
+     * Time the warm-up took.
+     */
+    std::chrono::microseconds duration;
+
+  };
+
+public:
+
+  /**
+   * Acquire buffers of every size class of &l:BufferPool;, touch every page and release them to the shared pool.
+   * @param bytes - memory to pre-fault, split evenly between the size classes.
+   * @return - bytes pre-faulted.
+   */
+  static v_int64 prefaultBufferPool(v_int64 bytes);
+
+  /**
+   * Pre-fault &l:BufferPool; and serve the requests of the config with `connectionHandler` over a virtual interface
+   * of its own. Blocks until all requests are answered. The handler is stopped at the end - pass a dedicated one,
+   * not the one which will serve the port.
+   * @param config - &l:WarmUp::Config;.
+   * @param connectionHandler - handler on the server's router.
+   * @return - &l:WarmUp::Report;.
+   */
+  static Report run(const Config& config, const std::shared_ptr<oatpp::network::ConnectionHandler>& connectionHandler);
+
+};
+
+#endif /* WarmUp_hpp */
@@ -0,0 +1,179 @@
+#include "ConcurrencyLimiter.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const oatpp::String& startKey() {
+  static const oatpp::String key("ConcurrencyLimiter::start");
+  return key;
+}
+
+v_uint64 nowMicros() {
+  return (v_uint64) std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrencyLimiter::RequestInterceptor
+
+ConcurrencyLimiter::RequestInterceptor::RequestInterceptor(const std::shared_ptr<ConcurrencyLimiter>& limiter)
+  : m_limiter(limiter)
+{}
+
+std::shared_ptr<ConcurrencyLimiter::OutgoingResponse>
+ConcurrencyLimiter::RequestInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request) {
+
+  if(m_limiter->tryAcquire()) {
+    request->putBundleData(startKey(), oatpp::UInt64(nowMicros()));
+    return nullptr;
+  }
+
+  /* Null start - the response interceptor has nothing to release */
+  request->putBundleData(startKey(), oatpp::UInt64());
+  auto response = oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(
+    oatpp::web::protocol::http::Status::CODE_503, "Overloaded"
+  );
+  response->putHeader("Retry-After", m_limiter->m_retryAfter);
+  return response;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrencyLimiter::ResponseInterceptor
+
+ConcurrencyLimiter::ResponseInterceptor::ResponseInterceptor(const std::shared_ptr<ConcurrencyLimiter>& limiter)
+  : m_limiter(limiter)
+{}
+
+std::shared_ptr<ConcurrencyLimiter::OutgoingResponse>
+ConcurrencyLimiter::ResponseInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request,
+                                                   const std::shared_ptr<OutgoingResponse>& response)
+{
+
+  oatpp::UInt64 start;
+  try {
+    start = request->getBundleData<oatpp::UInt64>(startKey());
+  } catch (const std::runtime_error&) {
+    return response; // answered by an interceptor which ran before ours
+  }
+
+  if(start) {
+    m_limiter->release((v_int64) (nowMicros() - *start));
+  }
+
+  return response;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrencyLimiter
+
+ConcurrencyLimiter::ConcurrencyLimiter(const Config& config)
+  : m_config(config)
+  , m_retryAfter(std::to_string(config.retryAfter.count()))
+  , m_limit((v_int32) std::min(std::max(config.initialLimit, config.minLimit), config.maxLimit))
+  , m_inFlight(0)
+  , m_admitted(0)
+  , m_rejected(0)
+  , m_baselineLatency(0)
+  , m_estimatedLimit(std::min(std::max(config.initialLimit, config.minLimit), config.maxLimit))
+  , m_baselineLatencyValue(0)
+  , m_windowSum(0)
+  , m_windowCount(0)
+  , m_windowMaxInFlight(0)
+{}
+
+std::shared_ptr<ConcurrencyLimiter> ConcurrencyLimiter::createShared(const Config& config) {
+  return std::make_shared<ConcurrencyLimiter>(config);
+}
+
+bool ConcurrencyLimiter::tryAcquire() {
+  auto inFlight = m_inFlight.load(std::memory_order_relaxed);
+  do {
+    if(inFlight >= m_limit.load(std::memory_order_relaxed)) {
+      m_rejected.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  } while(!m_inFlight.compare_exchange_weak(inFlight, inFlight + 1, std::memory_order_relaxed));
+  m_admitted.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void ConcurrencyLimiter::release(v_int64 latencyMicros) {
+
+  auto inFlight = m_inFlight.fetch_sub(1, std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_windowSum += (double) std::max<v_int64>(latencyMicros, 1);
+  m_windowMaxInFlight = std::max(m_windowMaxInFlight, inFlight);
+  if(++ m_windowCount >= m_config.windowSize) {
+    update();
+  }
+
+}
+
+void ConcurrencyLimiter::update() {
+
+  double windowLatency = m_windowSum / m_windowCount;
+
+  /* Decaying minimum - a faster window is taken right away, a slower one pulls the baseline up slowly */
+  if(m_baselineLatencyValue == 0 || windowLatency < m_baselineLatencyValue) {
+    m_baselineLatencyValue = windowLatency;
+  } else {
+    m_baselineLatencyValue += (windowLatency - m_baselineLatencyValue) * m_config.baselineDecay;
+  }
+  m_baselineLatency.store((v_int64) m_baselineLatencyValue, std::memory_order_relaxed);
+
+  if(m_windowMaxInFlight >= m_estimatedLimit / 2) {
+
+    /* Only a limit which is used says something about the latency at that concurrency */
+    auto gradient = std::max(0.5, std::min(1.0, m_config.tolerance * m_baselineLatencyValue / windowLatency));
+    auto newLimit = m_estimatedLimit * gradient + std::sqrt(m_estimatedLimit);
+    newLimit = m_estimatedLimit * (1 - m_config.smoothing) + newLimit * m_config.smoothing;
+    m_estimatedLimit = std::max<double>(m_config.minLimit, std::min<double>(m_config.maxLimit, newLimit));
+
+  }
+
+  m_limit.store((v_int32) m_estimatedLimit, std::memory_order_relaxed);
+
+  m_windowSum = 0;
+  m_windowCount = 0;
+  m_windowMaxInFlight = 0;
+
+}
+
+v_int32 ConcurrencyLimiter::getLimit() const {
+  return m_limit.load(std::memory_order_relaxed);
+}
+
+ConcurrencyLimiter::Stats ConcurrencyLimiter::getStats() const {
+  Stats stats;
+  stats.limit = m_limit.load(std::memory_order_relaxed);
+  stats.inFlight = m_inFlight.load(std::memory_order_relaxed);
+  stats.admitted = m_admitted.load(std::memory_order_relaxed);
+  stats.rejected = m_rejected.load(std::memory_order_relaxed);
+  stats.baselineLatencyMicros = m_baselineLatency.load(std::memory_order_relaxed);
+  return stats;
+}
+
+std::string ConcurrencyLimiter::renderPrometheus() const {
+  auto stats = getStats();
+  return "# HELP app_concurrency_limit Current adaptive limit of requests in flight.\n"
+         "# TYPE app_concurrency_limit gauge\n"
+         "app_concurrency_limit " + std::to_string(stats.limit) + "\n"
+         "# HELP app_concurrency_in_flight Requests being processed.\n"
+         "# TYPE app_concurrency_in_flight gauge\n"
+         "app_concurrency_in_flight " + std::to_string(stats.inFlight) + "\n"
+         "# HELP app_concurrency_admitted_total Requests admitted by the limiter.\n"
+         "# TYPE app_concurrency_admitted_total counter\n"
+         "app_concurrency_admitted_total " + std::to_string(stats.admitted) + "\n"
+         "# HELP app_concurrency_rejected_total Requests shed with 503 by the limiter.\n"
+         "# TYPE app_concurrency_rejected_total counter\n"
+         "app_concurrency_rejected_total " + std::to_string(stats.rejected) + "\n";
+}
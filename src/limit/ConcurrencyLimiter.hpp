@@ -0,0 +1,202 @@
+#ifndef ConcurrencyLimiter_hpp
+#define ConcurrencyLimiter_hpp
+
+#include "oatpp/web/server/interceptor/RequestInterceptor.hpp"
+#include "oatpp/web/server/interceptor/ResponseInterceptor.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+
+/**
+ * Adaptive limit of requests processed at the same time, in front of the router.
+ * A request over the limit is answered with `503` and `Retry-After` right away, without routing. The limit follows the
+ * latency of admitted requests with a gradient: every window of samples it is multiplied by
+ * `tolerance * baselineLatency / windowLatency` (clamped to `0.5..1`) and gets `sqrt(limit)` of headroom.
+ * The baseline is the latency without queuing, observed passively - the minimum of the window latencies, rising by
+ * `baselineDecay` of the gap to every later window, so that a backend which got slower for good becomes the new normal.
+ * Traffic is never held at a lower limit to measure it. While latency stays near the baseline the limit grows; when the
+ * backend slows down and requests start to queue, it drops until the latency is back - excess load is shed instead of
+ * waiting in the backend. The limit doesn't grow while less than half of it is used.
+ *
+ * Attach &l:ConcurrencyLimiter::RequestInterceptor; (before the router, after &l:RequestMetrics;) and
+ * &l:ConcurrencyLimiter::ResponseInterceptor; to a connection handler. Latency is measured until the response is ready.
+ */
+class ConcurrencyLimiter {
+public:
+  typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+  typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+public:
+
+  /**
+   * Limiter settings.
+   */
+  struct Config {
+
+    /**
+     * Limit at start.
+     */
+    v_int32 initialLimit = 20;
+
+    /**
+     * The limit never drops below this.
+     */
+    v_int32 minLimit = 3;
+
+    /**
+     * The limit never grows above this.
+     */
+    v_int32 maxLimit = 1000;
+
+    /**
+     * How much the window latency may exceed the baseline latency before the limit drops.
+     */
+    double tolerance = 1.5;
+
+    /**
+     * Weight of a new limit estimate, `0..1`.
+     */
+    double smoothing = 0.2;
+
+    /**
+     * Samples per limit update.
+     */
+    v_int32 windowSize = 20;
+
+    /**
+     * Share of the gap to a slower window latency the baseline latency rises by, `0..1`. A faster window latency
+     * becomes the baseline right away.
+     */
+    double baselineDecay = 0.01;
+
+    /**
+     * Value of the `Retry-After` header of shed requests.
+     */
+    std::chrono::seconds retryAfter = std::chrono::seconds(1);
+
+  };
+
+  /**
+   * Counters.
+   */
+  struct Stats {
+
+    /**
+     * Current limit.
+     */
+    v_int32 limit;
+
+    /**
+     * Requests being processed now.
+     */
+    v_int32 inFlight;
+
+    /**
+     * Requests admitted since start.
+     */
+    v_int64 admitted;
+
+    /**
+     * Requests shed with `503` since start.
+     */
+    v_int64 rejected;
+
+    /**
+     * Latency without queuing, microseconds. `0` until the first window.
+     */
+    v_int64 baselineLatencyMicros;
+
+  };
+
+public:
+
+  /**
+   * Admits the request or answers it with `503`.
+   */
+  class RequestInterceptor : public oatpp::web::server::interceptor::RequestInterceptor {
+  private:
+    std::shared_ptr<ConcurrencyLimiter> m_limiter;
+  public:
+    RequestInterceptor(const std::shared_ptr<ConcurrencyLimiter>& limiter);
+    std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request) override;
+  };
+
+  /**
+   * Releases the slot of an admitted request and records its latency.
+   */
+  class ResponseInterceptor : public oatpp::web::server::interceptor::ResponseInterceptor {
+  private:
+    std::shared_ptr<ConcurrencyLimiter> m_limiter;
+  public:
+    ResponseInterceptor(const std::shared_ptr<ConcurrencyLimiter>& limiter);
+    std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                                const std::shared_ptr<OutgoingResponse>& response) override;
+  };
+
+private:
+  Config m_config;
+  oatpp::String m_retryAfter;
+  std::atomic<v_int32> m_limit;
+  std::atomic<v_int32> m_inFlight;
+  std::atomic<v_int64> m_admitted;
+  std::atomic<v_int64> m_rejected;
+  std::atomic<v_int64> m_baselineLatency;
+private:
+  /* Window state, guarded by m_mutex */
+  std::mutex m_mutex;
+  double m_estimatedLimit;
+  double m_baselineLatencyValue;
+  double m_windowSum;
+  v_int32 m_windowCount;
+  v_int32 m_windowMaxInFlight;
+private:
+  void update();
+public:
+
+  /**
+   * Constructor.
+   * @param config - &l:ConcurrencyLimiter::Config;.
+   */
+  ConcurrencyLimiter(const Config& config);
+
+  /**
+   * Create shared ConcurrencyLimiter.
+   * @param config - &l:ConcurrencyLimiter::Config;.
+   * @return - `std::shared_ptr` to ConcurrencyLimiter.
+   */
+  static std::shared_ptr<ConcurrencyLimiter> createShared(const Config& config);
+
+  /**
+   * Take a slot if fewer than `limit` requests are in flight.
+   * @return - `true` if admitted - call &l:ConcurrencyLimiter::release (); when done.
+   */
+  bool tryAcquire();
+
+  /**
+   * Give the slot back and record the latency of the request.
+   * @param latencyMicros - time from &l:ConcurrencyLimiter::tryAcquire (); to the response.
+   */
+  void release(v_int64 latencyMicros);
+
+  /**
+   * Get current limit.
+   * @return
+   */
+  v_int32 getLimit() const;
+
+  /**
+   * Get counters.
+   * @return - &l:ConcurrencyLimiter::Stats;.
+   */
+  Stats getStats() const;
+
+  /**
+   * Render the limit and counters in the Prometheus text format.
+   * @return
+   */
+  std::string renderPrometheus() const;
+
+};
+
+#endif /* ConcurrencyLimiter_hpp */
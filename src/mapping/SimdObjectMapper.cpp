@@ -0,0 +1,153 @@
+#include "SimdObjectMapper.hpp"
+
+#include "oatpp/parser/json/Utils.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_OBJECT_MAPPER_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+typedef oatpp::parser::json::mapping::Deserializer Deserializer;
+typedef oatpp::data::mapping::type::Type Type;
+
+v_buff_size findStopScalar(const char* data, v_buff_size size) {
+  for(v_buff_size i = 0; i < size; i ++) {
+    auto c = (v_uint8) data[i];
+    if(c == '"' || c == '\\' || c < 0x20) {
+      return i;
+    }
+  }
+  return size;
+}
+
+#ifdef SIMD_OBJECT_MAPPER_X86
+
+__attribute__((target("sse4.2")))
+v_buff_size findStopSse42(const char* data, v_buff_size size) {
+
+  /* Ranges: '"'..'"', '\\'..'\\', 0x00..0x1F */
+  const __m128i ranges = _mm_setr_epi8('"', '"', '\\', '\\', 0x00, 0x1F, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+  v_buff_size i = 0;
+  for(; i + 16 <= size; i += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    int index = _mm_cmpestri(ranges, 6, chunk, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+    if(index < 16) {
+      return i + index;
+    }
+  }
+
+  return i + findStopScalar(data + i, size - i);
+
+}
+
+__attribute__((target("avx2")))
+v_buff_size findStopAvx2(const char* data, v_buff_size size) {
+
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i maxControl = _mm256_set1_epi8(0x1F);
+
+  v_buff_size i = 0;
+  for(; i + 32 <= size; i += 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i stops = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash));
+    /* unsigned c <= 0x1F  <=>  min(c, 0x1F) == c */
+    stops = _mm256_or_si256(stops, _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, maxControl), chunk));
+    auto mask = (v_uint32) _mm256_movemask_epi8(stops);
+    if(mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+
+  return i + findStopSse42(data + i, size - i);
+
+}
+
+#endif
+
+SimdObjectMapper::Level detectLevel() {
+#ifdef SIMD_OBJECT_MAPPER_X86
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2")) {
+    return SimdObjectMapper::Level::AVX2;
+  }
+  if(__builtin_cpu_supports("sse4.2")) {
+    return SimdObjectMapper::Level::SSE42;
+  }
+#endif
+  return SimdObjectMapper::Level::SCALAR;
+}
+
+typedef v_buff_size (*FindStop)(const char* data, v_buff_size size);
+
+FindStop getFindStop(SimdObjectMapper::Level level) {
+  switch(level) {
+#ifdef SIMD_OBJECT_MAPPER_X86
+    case SimdObjectMapper::Level::AVX2: return &findStopAvx2;
+    case SimdObjectMapper::Level::SSE42: return &findStopSse42;
+#endif
+    default: return &findStopScalar;
+  }
+}
+
+oatpp::Void deserializeString(Deserializer* deserializer, oatpp::parser::Caret& caret, const Type* const type) {
+
+  (void) deserializer;
+  (void) type;
+
+  /* Deserializer methods are plain function pointers - the kernel is picked once per process */
+  static const FindStop findStop = getFindStop(SimdObjectMapper::getLevel());
+
+  if(caret.isAtText("null", true)) {
+    return oatpp::Void(oatpp::String::Class::getType());
+  }
+
+  if(caret.isAtChar('"')) {
+    auto begin = caret.getCurrData() + 1;
+    auto available = caret.getDataSize() - caret.getPosition() - 1;
+    auto stop = findStop(begin, available);
+    if(stop < available && begin[stop] == '"') {
+      caret.setPosition(caret.getPosition() + stop + 2);
+      return oatpp::Void(std::make_shared<std::string>(begin, stop), oatpp::String::Class::getType());
+    }
+  }
+
+  /* Escapes, control characters and errors - exactly as the stock deserializer */
+  return oatpp::Void(oatpp::parser::json::Utils::parseString(caret).getPtr(), oatpp::String::Class::getType());
+
+}
+
+}
+
+SimdObjectMapper::SimdObjectMapper(const std::shared_ptr<Serializer::Config>& serializerConfig,
+                                   const std::shared_ptr<Deserializer::Config>& deserializerConfig)
+  : oatpp::parser::json::mapping::ObjectMapper(serializerConfig, deserializerConfig)
+{
+  getDeserializer()->setDeserializerMethod(oatpp::data::mapping::type::__class::String::CLASS_ID, &deserializeString);
+}
+
+std::shared_ptr<SimdObjectMapper> SimdObjectMapper::createShared(const std::shared_ptr<Serializer::Config>& serializerConfig,
+                                                                 const std::shared_ptr<Deserializer::Config>& deserializerConfig)
+{
+  return std::make_shared<SimdObjectMapper>(serializerConfig, deserializerConfig);
+}
+
+SimdObjectMapper::Level SimdObjectMapper::getLevel() {
+  static const Level level = detectLevel();
+  return level;
+}
+
+const char* SimdObjectMapper::getLevelName(Level level) {
+  switch(level) {
+    case Level::AVX2: return "AVX2";
+    case Level::SSE42: return "SSE4.2";
+    default: return "scalar";
+  }
+}
+
+v_buff_size SimdObjectMapper::findStringStop(const char* data, v_buff_size size, Level level) {
+  return getFindStop(level)(data, size);
+}
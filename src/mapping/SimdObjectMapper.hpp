@@ -0,0 +1,72 @@
+#ifndef SimdObjectMapper_hpp
+#define SimdObjectMapper_hpp
+
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+/**
+ * JSON ObjectMapper which scans string values with SIMD instead of byte by byte.
+ * Same `oatpp::parser::json::mapping::ObjectMapper` otherwise - same configs, same DTOs, same serializer.
+ * The deserializer method for `oatpp::String` is replaced: the end of the string is found 16 (SSE4.2) or 32 (AVX2)
+ * bytes at a time and a string without escapes is copied in one go. Strings with escapes or control characters,
+ * and anything malformed, go to the stock parser from the same position, so results and errors are the same.
+ * The instruction set is picked at runtime; the scalar path is used on other CPUs.
+ */
+class SimdObjectMapper : public oatpp::parser::json::mapping::ObjectMapper {
+public:
+  typedef oatpp::parser::json::mapping::Serializer Serializer;
+  typedef oatpp::parser::json::mapping::Deserializer Deserializer;
+public:
+
+  /**
+   * Instruction set used to scan strings.
+   */
+  enum class Level : v_int32 {
+    SCALAR = 0,
+    SSE42 = 1,
+    AVX2 = 2
+  };
+
+public:
+
+  /**
+   * Constructor.
+   * @param serializerConfig - serializer config.
+   * @param deserializerConfig - deserializer config.
+   */
+  SimdObjectMapper(const std::shared_ptr<Serializer::Config>& serializerConfig = Serializer::Config::createShared(),
+                   const std::shared_ptr<Deserializer::Config>& deserializerConfig = Deserializer::Config::createShared());
+
+  /**
+   * Create shared SimdObjectMapper.
+   * @param serializerConfig - serializer config.
+   * @param deserializerConfig - deserializer config.
+   * @return - `std::shared_ptr` to SimdObjectMapper.
+   */
+  static std::shared_ptr<SimdObjectMapper> createShared(const std::shared_ptr<Serializer::Config>& serializerConfig = Serializer::Config::createShared(),
+                                                        const std::shared_ptr<Deserializer::Config>& deserializerConfig = Deserializer::Config::createShared());
+
+  /**
+   * Best level supported by this CPU. Used by all SimdObjectMappers.
+   * @return - &l:SimdObjectMapper::Level;.
+   */
+  static Level getLevel();
+
+  /**
+   * Name of the level for logs.
+   * @param level - &l:SimdObjectMapper::Level;.
+   * @return - name.
+   */
+  static const char* getLevelName(Level level);
+
+  /**
+   * Find the first `"`, `\` or control character (< 0x20).
+   * @param data - bytes after the opening quote.
+   * @param size - number of bytes.
+   * @param level - instruction set to use, must be supported by the CPU.
+   * @return - index of the character, `size` if there is none.
+   */
+  static v_buff_size findStringStop(const char* data, v_buff_size size, Level level);
+
+};
+
+#endif /* SimdObjectMapper_hpp */
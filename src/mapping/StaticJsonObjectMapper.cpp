@@ -0,0 +1,58 @@
+#include "StaticJsonObjectMapper.hpp"
+
+StaticJsonObjectMapper::StaticJsonObjectMapper(const std::shared_ptr<Serializer::Config>& serializerConfig,
+                                               const std::shared_ptr<Deserializer::Config>& deserializerConfig)
+  : oatpp::parser::json::mapping::ObjectMapper(serializerConfig, deserializerConfig)
+  , m_serializer(getSerializer())
+{}
+
+std::shared_ptr<StaticJsonObjectMapper> StaticJsonObjectMapper::createShared(const std::shared_ptr<Serializer::Config>& serializerConfig,
+                                                                             const std::shared_ptr<Deserializer::Config>& deserializerConfig)
+{
+  return std::make_shared<StaticJsonObjectMapper>(serializerConfig, deserializerConfig);
+}
+
+std::string StaticJsonObjectMapper::joinNames(const std::vector<std::string>& names) {
+  std::string result;
+  for(auto& name : names) {
+    if(!result.empty()) {
+      result += ", ";
+    }
+    result += name;
+  }
+  return result;
+}
+
+void StaticJsonObjectMapper::write(Stream* stream, const oatpp::Void& variant) const {
+
+  /* The static path writes the default layout only */
+  auto config = m_serializer->getConfig();
+  if(!config->useBeautifier && config->includeNullFields) {
+    auto it = m_entries.find(variant.getValueType());
+    if(it != m_entries.end()) {
+      it->second.writer(stream, m_serializer.get(), variant);
+      return;
+    }
+  }
+
+  oatpp::parser::json::mapping::ObjectMapper::write(stream, variant);
+
+}
+
+oatpp::Void StaticJsonObjectMapper::read(oatpp::parser::Caret& caret, const Type* const type) const {
+
+  auto it = m_entries.find(type);
+  if(it != m_entries.end()) {
+    /* Separate caret - a failed attempt leaves no error and no position change behind */
+    oatpp::parser::Caret attempt(caret.getData(), caret.getDataSize());
+    attempt.setPosition(caret.getPosition());
+    oatpp::Void result;
+    if(it->second.reader(attempt, result)) {
+      caret.setPosition(attempt.getPosition());
+      return result;
+    }
+  }
+
+  return oatpp::parser::json::mapping::ObjectMapper::read(caret, type);
+
+}
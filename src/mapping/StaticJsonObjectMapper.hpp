@@ -0,0 +1,392 @@
+#ifndef StaticJsonObjectMapper_hpp
+#define StaticJsonObjectMapper_hpp
+
+#include "dto/StaticDto.hpp"
+
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+#include "oatpp/parser/json/Utils.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * JSON ObjectMapper which serializes and deserializes registered DTOs with code generated from their
+ * &l:StaticDtoFields; - fields are visited in a compile-time list with precomputed key literals, without the property
+ * map and without type-erased dispatch per field.
+ * Everything else goes the runtime way, which stays the fallback:
+ * <ul>
+ *   <li>Types not registered with &l:StaticJsonObjectMapper::registerDto;.</li>
+ *   <li>Fields of types without a static path (lists, maps, enums, booleans, unregistered DTOs) are serialized by
+ *   the runtime serializer one by one; strings which need escaping as well.</li>
+ *   <li>Serializer configs other than the default layout (beautifier, `includeNullFields = false`).</li>
+ *   <li>On read - anything unexpected (unknown or escaped keys, such fields, malformed input): the runtime deserializer
+ *   reads the object again from the start, so results and errors are the same.</li>
+ * </ul>
+ */
+class StaticJsonObjectMapper : public oatpp::parser::json::mapping::ObjectMapper {
+public:
+  typedef oatpp::parser::json::mapping::Serializer Serializer;
+  typedef oatpp::parser::json::mapping::Deserializer Deserializer;
+  typedef oatpp::data::mapping::type::Type Type;
+  typedef oatpp::data::stream::ConsistentOutputStream Stream;
+private:
+
+  typedef void (*Writer)(Stream* stream, Serializer* serializer, const oatpp::Void& variant);
+  typedef bool (*Reader)(oatpp::parser::Caret& caret, oatpp::Void& result);
+
+  struct Entry {
+    Writer writer;
+    Reader reader;
+  };
+
+  template<class T>
+  struct FastNumber : std::integral_constant<bool,
+    std::is_same<T, v_int32>::value || std::is_same<T, v_int64>::value || std::is_same<T, v_float64>::value> {};
+
+private:
+
+  template<class Dto>
+  class FieldWriter {
+  private:
+    Stream* m_stream;
+    Serializer* m_serializer;
+    const Dto* m_dto;
+    bool m_first;
+  public:
+
+    FieldWriter(Stream* stream, Serializer* serializer, const Dto* dto)
+      : m_stream(stream)
+      , m_serializer(serializer)
+      , m_dto(dto)
+      , m_first(true)
+    {}
+
+    template<class Wrapper, std::size_t N>
+    void operator()(const char (&key)[N], Wrapper Dto::* field) {
+      if(!m_first) {
+        m_stream->writeCharSimple(',');
+      }
+      m_first = false;
+      m_stream->writeSimple(key, N - 1);
+      writeValue(m_stream, m_serializer, m_dto->*field);
+    }
+
+  };
+
+  template<class Dto>
+  class FieldReader {
+  private:
+    oatpp::parser::Caret& m_caret;
+    Dto* m_dto;
+  public:
+    bool matched;
+    bool ok;
+  public:
+
+    FieldReader(oatpp::parser::Caret& caret, Dto* dto)
+      : m_caret(caret)
+      , m_dto(dto)
+      , matched(false)
+      , ok(false)
+    {}
+
+    template<class Wrapper, std::size_t N>
+    void operator()(const char (&key)[N], Wrapper Dto::* field) {
+
+      /* key literal is "name": - compare "name" with its quotes */
+      const v_buff_size keySize = N - 2;
+
+      if(matched || m_caret.getDataSize() - m_caret.getPosition() < keySize ||
+         std::memcmp(m_caret.getCurrData(), key, keySize) != 0)
+      {
+        return;
+      }
+
+      matched = true;
+      m_caret.inc(keySize);
+      m_caret.skipBlankChars();
+      if(!m_caret.canContinueAtChar(':', 1)) {
+        return;
+      }
+      m_caret.skipBlankChars();
+      ok = readValue(m_caret, m_dto->*field);
+
+    }
+
+  };
+
+  template<class Dto>
+  class FieldNames {
+  public:
+    std::vector<std::string> names;
+  public:
+
+    template<class Wrapper, std::size_t N>
+    void operator()(const char (&key)[N], Wrapper Dto::* field) {
+      (void) field;
+      /* key literal is "name": */
+      names.push_back(std::string(key + 1, N - 4));
+    }
+
+  };
+
+private:
+
+  static std::string joinNames(const std::vector<std::string>& names);
+
+  /* STATIC_DTO is written by hand - it must list the same fields as DTO_FIELD, in the same order */
+  template<class T>
+  static void checkFields() {
+
+    FieldNames<T> declared;
+    StaticDtoFields<T>::visit(declared);
+
+    /* Properties are registered by the first object constructed */
+    T::createShared();
+
+    std::vector<std::string> reflected;
+    for(auto* property : T::Z__CLASS_GET_FIELDS_MAP()->getList()) {
+      reflected.push_back(property->name);
+    }
+
+    if(declared.names != reflected) {
+      throw std::runtime_error(std::string("[StaticJsonObjectMapper::registerDto()]: Error. STATIC_DTO of ") + T::Z__CLASS_TYPE_NAME() +
+                               " lists fields [" + joinNames(declared.names) + "], the DTO has [" + joinNames(reflected) + "].");
+    }
+
+  }
+
+private:
+
+  /* Serialization */
+
+  static void writeValue(Stream* stream, Serializer* serializer, const oatpp::String& value) {
+    if(!value) {
+      stream->writeSimple("null", 4);
+      return;
+    }
+    /* Conservative - anything the escape flags might touch goes to the runtime serializer */
+    for(auto c : *value) {
+      if(c < 0x20 || c > 0x7E || c == '"' || c == '\\' || c == '/') {
+        serializer->serializeToStream(stream, value);
+        return;
+      }
+    }
+    stream->writeCharSimple('"');
+    stream->writeSimple(value->data(), value->size());
+    stream->writeCharSimple('"');
+  }
+
+  template<class T, class Clazz>
+  static typename std::enable_if<FastNumber<T>::value>::type
+  writeValue(Stream* stream, Serializer* serializer, const oatpp::data::mapping::type::Primitive<T, Clazz>& value) {
+    (void) serializer;
+    if(!value) {
+      stream->writeSimple("null", 4);
+      return;
+    }
+    stream->writeAsString(*value);
+  }
+
+  template<class T>
+  static void writeValue(Stream* stream, Serializer* serializer, const oatpp::Object<T>& value) {
+    writeObject(stream, serializer, value, std::integral_constant<bool, StaticDtoFields<T>::ENABLED>());
+  }
+
+  template<class Wrapper>
+  static void writeValue(Stream* stream, Serializer* serializer, const Wrapper& value) {
+    serializer->serializeToStream(stream, value);
+  }
+
+  template<class T>
+  static void writeObject(Stream* stream, Serializer* serializer, const oatpp::Object<T>& value, std::true_type) {
+    if(!value) {
+      stream->writeSimple("null", 4);
+      return;
+    }
+    writeDto(stream, serializer, value.get());
+  }
+
+  template<class T>
+  static void writeObject(Stream* stream, Serializer* serializer, const oatpp::Object<T>& value, std::false_type) {
+    serializer->serializeToStream(stream, value);
+  }
+
+  template<class Dto>
+  static void writeDto(Stream* stream, Serializer* serializer, const Dto* dto) {
+    FieldWriter<Dto> writer(stream, serializer, dto);
+    stream->writeCharSimple('{');
+    StaticDtoFields<Dto>::visit(writer);
+    stream->writeCharSimple('}');
+  }
+
+  template<class Dto>
+  static void writeEntry(Stream* stream, Serializer* serializer, const oatpp::Void& variant) {
+    if(!variant) {
+      stream->writeSimple("null", 4);
+      return;
+    }
+    writeDto(stream, serializer, static_cast<const Dto*>(variant.get()));
+  }
+
+  /* Deserialization - false means "let the runtime deserializer do it" */
+
+  static bool readValue(oatpp::parser::Caret& caret, oatpp::String& value) {
+    if(caret.isAtText("null", true)) {
+      value = nullptr;
+      return true;
+    }
+    if(!caret.isAtChar('"')) {
+      return false;
+    }
+    value = oatpp::parser::json::Utils::parseString(caret);
+    return !caret.hasError();
+  }
+
+  template<class T, class Clazz>
+  static typename std::enable_if<FastNumber<T>::value, bool>::type
+  readValue(oatpp::parser::Caret& caret, oatpp::data::mapping::type::Primitive<T, Clazz>& value) {
+    if(caret.isAtText("null", true)) {
+      value = nullptr;
+      return true;
+    }
+    T number = std::is_floating_point<T>::value ? (T) caret.parseFloat64() : (T) caret.parseInt();
+    if(caret.hasError()) {
+      return false;
+    }
+    value = number;
+    return true;
+  }
+
+  template<class T>
+  static bool readValue(oatpp::parser::Caret& caret, oatpp::Object<T>& value) {
+    return readObject(caret, value, std::integral_constant<bool, StaticDtoFields<T>::ENABLED>());
+  }
+
+  template<class Wrapper>
+  static bool readValue(oatpp::parser::Caret& caret, Wrapper& value) {
+    (void) caret;
+    (void) value;
+    return false;
+  }
+
+  template<class T>
+  static bool readObject(oatpp::parser::Caret& caret, oatpp::Object<T>& value, std::true_type) {
+    if(caret.isAtText("null", true)) {
+      value = nullptr;
+      return true;
+    }
+    auto dto = T::createShared();
+    if(!readDto(caret, dto.get())) {
+      return false;
+    }
+    value = dto;
+    return true;
+  }
+
+  template<class T>
+  static bool readObject(oatpp::parser::Caret& caret, oatpp::Object<T>& value, std::false_type) {
+    (void) caret;
+    (void) value;
+    return false;
+  }
+
+  template<class Dto>
+  static bool readDto(oatpp::parser::Caret& caret, Dto* dto) {
+
+    if(!caret.canContinueAtChar('{', 1)) {
+      return false;
+    }
+
+    caret.skipBlankChars();
+    if(caret.canContinueAtChar('}', 1)) {
+      return true;
+    }
+
+    while(true) {
+
+      FieldReader<Dto> reader(caret, dto);
+      StaticDtoFields<Dto>::visit(reader);
+      if(!reader.ok) {
+        return false;
+      }
+
+      caret.skipBlankChars();
+      if(caret.canContinueAtChar(',', 1)) {
+        caret.skipBlankChars();
+        continue;
+      }
+
+      return caret.canContinueAtChar('}', 1);
+
+    }
+
+  }
+
+  template<class Dto>
+  static bool readEntry(oatpp::parser::Caret& caret, oatpp::Void& result) {
+    auto dto = Dto::createShared();
+    if(!readDto(caret, dto.get())) {
+      return false;
+    }
+    result = dto;
+    return true;
+  }
+
+private:
+  std::shared_ptr<Serializer> m_serializer;
+  std::unordered_map<const Type*, Entry> m_entries;
+public:
+
+  /**
+   * Constructor.
+   * @param serializerConfig - serializer config.
+   * @param deserializerConfig - deserializer config.
+   */
+  StaticJsonObjectMapper(const std::shared_ptr<Serializer::Config>& serializerConfig = Serializer::Config::createShared(),
+                         const std::shared_ptr<Deserializer::Config>& deserializerConfig = Deserializer::Config::createShared());
+
+  /**
+   * Create shared StaticJsonObjectMapper.
+   * @param serializerConfig - serializer config.
+   * @param deserializerConfig - deserializer config.
+   * @return - `std::shared_ptr` to StaticJsonObjectMapper.
+   */
+  static std::shared_ptr<StaticJsonObjectMapper> createShared(const std::shared_ptr<Serializer::Config>& serializerConfig = Serializer::Config::createShared(),
+                                                              const std::shared_ptr<Deserializer::Config>& deserializerConfig = Deserializer::Config::createShared());
+
+  /**
+   * Use the static path for `oatpp::Object<T>`. Register all DTOs before the mapper is used.
+   * Throws `std::runtime_error` if `STATIC_DTO` of the type doesn't list its fields as declared by `DTO_FIELD` -
+   * same names, same order.
+   * @tparam T - DTO type with &l:StaticDtoFields; declared by `STATIC_DTO`.
+   */
+  template<class T>
+  void registerDto() {
+    static_assert(StaticDtoFields<T>::ENABLED, "Declare the fields of the DTO with STATIC_DTO");
+    checkFields<T>();
+    m_entries[oatpp::Object<T>::Class::getType()] = {&writeEntry<T>, &readEntry<T>};
+  }
+
+  /**
+   * Serialize - registered DTOs with the static path, the rest with the runtime serializer.
+   * @param stream - stream to write to.
+   * @param variant - object to serialize.
+   */
+  void write(Stream* stream, const oatpp::Void& variant) const override;
+
+  /**
+   * Deserialize - registered DTOs with the static path, the rest and fallbacks with the runtime deserializer.
+   * @param caret - caret over the text.
+   * @param type - type to read.
+   * @return - object.
+   */
+  oatpp::Void read(oatpp::parser::Caret& caret, const Type* const type) const override;
+
+};
+
+#endif /* StaticJsonObjectMapper_hpp */
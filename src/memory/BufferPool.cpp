@@ -0,0 +1,286 @@
+#include "BufferPool.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+constexpr v_int32 BufferPool::CLASSES_COUNT;
+constexpr v_buff_size BufferPool::MIN_CLASS_SIZE;
+constexpr v_int32 BufferPool::THREAD_CACHE_SIZE;
+constexpr v_int32 BufferPool::SHARED_SLOTS;
+constexpr v_int64 BufferPool::DEFAULT_MAX_RETAINED_BYTES;
+
+namespace {
+
+/**
+ * Shared pool. Each slot holds one buffer or `nullptr`; `counts` tell if a class is worth scanning.
+ */
+class SharedPool {
+public:
+  std::atomic<std::string*> slots[BufferPool::CLASSES_COUNT][BufferPool::SHARED_SLOTS];
+  std::atomic<v_int32> counts[BufferPool::CLASSES_COUNT];
+  std::atomic<v_int64> retainedBytes;
+  std::atomic<v_int64> maxRetainedBytes;
+  std::atomic<v_int64> acquired;
+  std::atomic<v_int64> allocated;
+  std::atomic<v_int64> dropped;
+  std::atomic<v_int64> trimmedBytes;
+  std::atomic<v_int64> lastAcquireTicks;
+public:
+
+  SharedPool()
+    : retainedBytes(0)
+    , maxRetainedBytes(BufferPool::DEFAULT_MAX_RETAINED_BYTES)
+    , acquired(0)
+    , allocated(0)
+    , dropped(0)
+    , trimmedBytes(0)
+    , lastAcquireTicks(0)
+  {
+    for(v_int32 c = 0; c < BufferPool::CLASSES_COUNT; c ++) {
+      counts[c].store(0, std::memory_order_relaxed);
+      for(auto& slot : slots[c]) {
+        slot.store(nullptr, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /* Never destroyed - buffers may be released after static destructors ran */
+  static SharedPool& instance() {
+    static SharedPool* pool = new SharedPool();
+    return *pool;
+  }
+
+  std::string* pop(v_int32 sizeClass) {
+    if(counts[sizeClass].load(std::memory_order_relaxed) <= 0) {
+      return nullptr;
+    }
+    for(auto& slot : slots[sizeClass]) {
+      if(slot.load(std::memory_order_relaxed) != nullptr) {
+        auto buffer = slot.exchange(nullptr, std::memory_order_acquire);
+        if(buffer != nullptr) {
+          counts[sizeClass].fetch_sub(1, std::memory_order_relaxed);
+          retainedBytes.fetch_sub((v_int64) buffer->capacity(), std::memory_order_relaxed);
+          return buffer;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  /**
+   * Count `capacity` as retained if it fits under the cap - in a thread cache or in the shared pool.
+   */
+  bool reserve(v_int64 capacity) {
+    if(retainedBytes.fetch_add(capacity, std::memory_order_relaxed) + capacity <= maxRetainedBytes.load(std::memory_order_relaxed)) {
+      return true;
+    }
+    retainedBytes.fetch_sub(capacity, std::memory_order_relaxed);
+    return false;
+  }
+
+  /**
+   * Put a buffer counted with `reserve()` to a free slot, free it if there is none.
+   */
+  void push(v_int32 sizeClass, std::string* buffer) {
+
+    for(auto& slot : slots[sizeClass]) {
+      std::string* expected = nullptr;
+      if(slot.load(std::memory_order_relaxed) == nullptr &&
+         slot.compare_exchange_strong(expected, buffer, std::memory_order_release, std::memory_order_relaxed))
+      {
+        counts[sizeClass].fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+
+    retainedBytes.fetch_sub((v_int64) buffer->capacity(), std::memory_order_relaxed);
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    delete buffer;
+
+  }
+
+};
+
+/* Trivially destructible - readable while other thread_local objects are destroyed at thread exit */
+thread_local bool threadCacheDestroyed = false;
+
+/**
+ * Buffers cached by the thread, per class. Counted in the retained bytes of the shared pool, so that the cap covers
+ * the caches of all threads too.
+ */
+struct ThreadCache {
+
+  std::string* buffers[BufferPool::CLASSES_COUNT][BufferPool::THREAD_CACHE_SIZE];
+  v_int32 sizes[BufferPool::CLASSES_COUNT] = {};
+
+  ~ThreadCache() {
+    flush();
+    threadCacheDestroyed = true;
+  }
+
+  void flush() {
+    auto& pool = SharedPool::instance();
+    for(v_int32 c = 0; c < BufferPool::CLASSES_COUNT; c ++) {
+      while(sizes[c] > 0) {
+        pool.push(c, buffers[c][-- sizes[c]]);
+      }
+    }
+  }
+
+};
+
+ThreadCache& threadCache() {
+  thread_local ThreadCache cache;
+  return cache;
+}
+
+v_int64 nowTicks() {
+  return (v_int64) std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+/**
+ * Smallest class which fits `size`, `-1` if none.
+ */
+v_int32 classForSize(v_buff_size size) {
+  for(v_int32 c = 0; c < BufferPool::CLASSES_COUNT; c ++) {
+    if(size <= BufferPool::getClassSize(c)) {
+      return c;
+    }
+  }
+  return -1;
+}
+
+/**
+ * Biggest class whose size the capacity covers, `-1` if too small or grown too big to be kept.
+ */
+v_int32 classForCapacity(v_buff_size capacity) {
+  if(capacity > BufferPool::getClassSize(BufferPool::CLASSES_COUNT - 1) * 2) {
+    return -1;
+  }
+  for(v_int32 c = BufferPool::CLASSES_COUNT - 1; c >= 0; c --) {
+    if(capacity >= BufferPool::getClassSize(c)) {
+      return c;
+    }
+  }
+  return -1;
+}
+
+void release(std::string* buffer) {
+
+  auto& pool = SharedPool::instance();
+
+  auto sizeClass = classForCapacity((v_buff_size) buffer->capacity());
+  if(sizeClass < 0 || !pool.reserve((v_int64) buffer->capacity())) {
+    pool.dropped.fetch_add(1, std::memory_order_relaxed);
+    delete buffer;
+    return;
+  }
+
+  if(!threadCacheDestroyed) {
+    auto& cache = threadCache();
+    if(cache.sizes[sizeClass] < BufferPool::THREAD_CACHE_SIZE) {
+      cache.buffers[sizeClass][cache.sizes[sizeClass] ++] = buffer;
+      return;
+    }
+  }
+
+  pool.push(sizeClass, buffer);
+
+}
+
+}
+
+v_buff_size BufferPool::getClassSize(v_int32 sizeClass) {
+  return MIN_CLASS_SIZE << (2 * sizeClass);
+}
+
+std::shared_ptr<std::string> BufferPool::acquire(v_buff_size size) {
+
+  auto& pool = SharedPool::instance();
+  pool.acquired.fetch_add(1, std::memory_order_relaxed);
+  pool.lastAcquireTicks.store(nowTicks(), std::memory_order_relaxed);
+
+  auto sizeClass = classForSize(size);
+  if(sizeClass < 0) {
+    pool.allocated.fetch_add(1, std::memory_order_relaxed);
+    auto buffer = std::make_shared<std::string>();
+    buffer->reserve((size_t) size);
+    return buffer;
+  }
+
+  std::string* buffer = nullptr;
+
+  if(!threadCacheDestroyed) {
+    auto& cache = threadCache();
+    if(cache.sizes[sizeClass] > 0) {
+      buffer = cache.buffers[sizeClass][-- cache.sizes[sizeClass]];
+      pool.retainedBytes.fetch_sub((v_int64) buffer->capacity(), std::memory_order_relaxed);
+    }
+  }
+
+  if(buffer == nullptr) {
+    buffer = pool.pop(sizeClass);
+  }
+
+  if(buffer == nullptr) {
+    pool.allocated.fetch_add(1, std::memory_order_relaxed);
+    buffer = new std::string();
+    buffer->reserve((size_t) getClassSize(sizeClass));
+  }
+
+  return std::shared_ptr<std::string>(buffer, &release);
+
+}
+
+void BufferPool::setMaxRetainedBytes(v_int64 bytes) {
+  SharedPool::instance().maxRetainedBytes.store(bytes, std::memory_order_relaxed);
+}
+
+void BufferPool::releaseThreadCache() {
+  if(!threadCacheDestroyed) {
+    threadCache().flush();
+  }
+}
+
+v_int64 BufferPool::trim() {
+  auto& pool = SharedPool::instance();
+  v_int64 freed = 0;
+  for(v_int32 c = 0; c < CLASSES_COUNT; c ++) {
+    while(auto buffer = pool.pop(c)) {
+      freed += (v_int64) buffer->capacity();
+      delete buffer;
+    }
+  }
+  pool.trimmedBytes.fetch_add(freed, std::memory_order_relaxed);
+  return freed;
+}
+
+v_int64 BufferPool::trimIfIdle(const std::chrono::milliseconds& idleFor) {
+  auto& pool = SharedPool::instance();
+  auto idleTicks = std::chrono::duration_cast<std::chrono::steady_clock::duration>(idleFor).count();
+  if(pool.retainedBytes.load(std::memory_order_relaxed) <= 0 ||
+     nowTicks() - pool.lastAcquireTicks.load(std::memory_order_relaxed) < idleTicks)
+  {
+    return 0;
+  }
+  return trim();
+}
+
+BufferPool::Stats BufferPool::getStats() {
+  auto& pool = SharedPool::instance();
+  return {pool.acquired.load(std::memory_order_relaxed),
+          pool.allocated.load(std::memory_order_relaxed),
+          pool.dropped.load(std::memory_order_relaxed),
+          pool.trimmedBytes.load(std::memory_order_relaxed),
+          pool.retainedBytes.load(std::memory_order_relaxed)};
+}
+
+std::string BufferPool::formatReport() {
+  auto stats = getStats();
+  char report[256];
+  std::snprintf(report, sizeof(report),
+                "Buffer pool:\nacquired = %lld\nallocated = %lld\nreused = %lld\ndropped = %lld\ntrimmedBytes = %lld\nretainedBytes = %lld\n",
+                (long long) stats.acquired, (long long) stats.allocated, (long long) (stats.acquired - stats.allocated),
+                (long long) stats.dropped, (long long) stats.trimmedBytes, (long long) stats.retainedBytes);
+  return report;
+}
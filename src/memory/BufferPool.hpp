@@ -0,0 +1,138 @@
+#ifndef BufferPool_hpp
+#define BufferPool_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+/**
+ * Process-wide pool of I/O buffers for connections, so that connection churn doesn't allocate and free
+ * the same buffers over and over.
+ * Buffers are `std::string`s (what oatpp streams take as memory) in &l:BufferPool::CLASSES_COUNT; size classes:
+ * 4 KiB, 16 KiB, 64 KiB and 256 KiB of capacity. A released buffer goes to the cache of the releasing thread first
+ * (&l:BufferPool::THREAD_CACHE_SIZE; per class, no synchronization), then to the shared pool - an array of atomic
+ * slots per class, taken and filled with exchange/CAS without locks.
+ * The pool - thread caches included - retains at most `maxRetainedBytes` (see &l:BufferPool::setMaxRetainedBytes ();) -
+ * beyond that, and for buffers which grew past the biggest class, released buffers are freed.
+ * Idle memory is given back with &l:BufferPool::trim (); / &l:BufferPool::trimIfIdle ();, and a thread about to go idle
+ * moves its cache to the shared pool with &l:BufferPool::releaseThreadCache ();.
+ */
+class BufferPool {
+public:
+
+  /**
+   * Number of size classes.
+   */
+  static constexpr v_int32 CLASSES_COUNT = 4;
+
+  /**
+   * Capacity of the smallest class. Every next class is 4 times bigger.
+   */
+  static constexpr v_buff_size MIN_CLASS_SIZE = 4096;
+
+  /**
+   * Buffers of one class kept per thread.
+   */
+  static constexpr v_int32 THREAD_CACHE_SIZE = 8;
+
+  /**
+   * Slots of one class in the shared pool.
+   */
+  static constexpr v_int32 SHARED_SLOTS = 256;
+
+  /**
+   * Default cap of memory retained in the shared pool and the thread caches.
+   */
+  static constexpr v_int64 DEFAULT_MAX_RETAINED_BYTES = 32 * 1024 * 1024;
+
+  /**
+   * Counters.
+   */
+  struct Stats {
+
+    /**
+     * Buffers taken from the pool since start.
+     */
+    v_int64 acquired;
+
+    /**
+     * Buffers which had to be allocated because the pool had none.
+     */
+    v_int64 allocated;
+
+    /**
+     * Released buffers freed because the shared pool was full or they were too big.
+     */
+    v_int64 dropped;
+
+    /**
+     * Bytes freed by trimming since start.
+     */
+    v_int64 trimmedBytes;
+
+    /**
+     * Bytes retained in the shared pool and the thread caches now.
+     */
+    v_int64 retainedBytes;
+
+  };
+
+public:
+
+  /**
+   * Get capacity of a size class.
+   * @param sizeClass - `0` to `CLASSES_COUNT - 1`.
+   * @return - bytes.
+   */
+  static v_buff_size getClassSize(v_int32 sizeClass);
+
+  /**
+   * Take a buffer with capacity of at least `size` bytes.
+   * Its size is unspecified - `resize()` or `clear()` it before use. It returns to the pool when the last copy of
+   * the shared_ptr is destroyed. Requests bigger than the biggest class get a buffer which is not pooled.
+   * @param size - min capacity.
+   * @return - buffer.
+   */
+  static std::shared_ptr<std::string> acquire(v_buff_size size);
+
+  /**
+   * Set cap of memory retained in the shared pool and the thread caches.
+   * @param bytes
+   */
+  static void setMaxRetainedBytes(v_int64 bytes);
+
+  /**
+   * Move buffers cached by the calling thread to the shared pool.
+   */
+  static void releaseThreadCache();
+
+  /**
+   * Free all buffers of the shared pool.
+   * @return - bytes freed.
+   */
+  static v_int64 trim();
+
+  /**
+   * Free all buffers of the shared pool if no buffer was acquired within `idleFor`.
+   * @param idleFor
+   * @return - bytes freed.
+   */
+  static v_int64 trimIfIdle(const std::chrono::milliseconds& idleFor);
+
+  /**
+   * Get counters.
+   * @return - &l:BufferPool::Stats;.
+   */
+  static Stats getStats();
+
+  /**
+   * Format counters for the shutdown log.
+   * @return - report text.
+   */
+  static std::string formatReport();
+
+};
+
+#endif /* BufferPool_hpp */
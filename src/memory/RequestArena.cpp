@@ -0,0 +1,276 @@
+#include "RequestArena.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+constexpr v_buff_size RequestArena::CHUNK_SIZE;
+constexpr v_int32 RequestArena::MAX_CACHED_CHUNKS;
+
+namespace {
+
+/**
+ * Body over bytes which live in the arena. Like `BufferBody`, without a separate string allocation.
+ */
+class ArenaBody : public oatpp::web::protocol::http::outgoing::Body {
+private:
+  p_char8 m_data;
+  v_buff_size m_size;
+  v_buff_size m_position;
+  oatpp::data::share::StringKeyLabel m_contentType;
+public:
+
+  ArenaBody(p_char8 data, v_buff_size size, const char* contentType)
+    : m_data(data)
+    , m_size(size)
+    , m_position(0)
+    , m_contentType(contentType)
+  {}
+
+  oatpp::v_io_size read(void *buffer, v_buff_size count, oatpp::async::Action& action) override {
+    (void) action;
+    v_buff_size bytesLeft = m_size - m_position;
+    if(count > bytesLeft) {
+      count = bytesLeft;
+    }
+    std::memcpy(buffer, m_data + m_position, count);
+    m_position += count;
+    return count;
+  }
+
+  void declareHeaders(Headers& headers) override {
+    if(m_contentType) {
+      headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_TYPE, m_contentType);
+    }
+  }
+
+  p_char8 getKnownData() override {
+    return m_data;
+  }
+
+  v_int64 getKnownSize() override {
+    return m_size;
+  }
+
+};
+
+/* Chunk header is padded so that the first allocation in a chunk is aligned for any type */
+constexpr v_buff_size HEADER_SIZE = (sizeof(void*) * 2 + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+/* Serialization buffers bigger than that are not kept for the next request */
+constexpr v_buff_size MAX_KEPT_STREAM_CAPACITY = 64 * 1024;
+
+/* Trivially destructible - readable while other thread_local objects are destroyed at thread exit */
+thread_local bool threadCacheDestroyed = false;
+
+/**
+ * Free regular chunks of the thread. The first word of a free chunk links the next one.
+ */
+struct ChunkCache {
+
+  void* head = nullptr;
+  v_int32 size = 0;
+
+  ~ChunkCache() {
+    while(head != nullptr) {
+      void* next = *static_cast<void**>(head);
+      std::free(head);
+      head = next;
+    }
+    threadCacheDestroyed = true;
+  }
+
+};
+
+ChunkCache& threadCache() {
+  thread_local ChunkCache cache;
+  return cache;
+}
+
+}
+
+RequestArena::Ref::Ref(RequestArena* arena)
+  : m_arena(arena)
+{
+  m_arena->retain();
+}
+
+RequestArena::Ref::Ref(const Ref& other)
+  : m_arena(other.m_arena)
+{
+  if(m_arena) {
+    m_arena->retain();
+  }
+}
+
+RequestArena::Ref::Ref(Ref&& other)
+  : m_arena(other.m_arena)
+{
+  other.m_arena = nullptr;
+}
+
+RequestArena::Ref::~Ref() {
+  if(m_arena) {
+    m_arena->release();
+  }
+}
+
+RequestArena::Ref& RequestArena::Ref::operator=(const Ref& other) {
+  if(other.m_arena) {
+    other.m_arena->retain();
+  }
+  if(m_arena) {
+    m_arena->release();
+  }
+  m_arena = other.m_arena;
+  return *this;
+}
+
+RequestArena* RequestArena::Ref::operator->() const {
+  return m_arena;
+}
+
+RequestArena* RequestArena::Ref::get() const {
+  return m_arena;
+}
+
+RequestArena::RequestArena(Chunk* chunk)
+  : m_refs(0)
+  , m_chunks(chunk)
+  , m_position(reinterpret_cast<char*>(chunk) + HEADER_SIZE)
+  , m_end(reinterpret_cast<char*>(chunk) + chunk->size)
+  , m_bytesAllocated(0)
+{
+  /* the arena itself is the first object in its first chunk */
+  m_position += (sizeof(RequestArena) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+}
+
+RequestArena::~RequestArena() {
+}
+
+RequestArena::Chunk* RequestArena::obtainChunk(v_buff_size size) {
+
+  if(size <= CHUNK_SIZE) {
+    auto& cache = threadCache();
+    if(!threadCacheDestroyed && cache.head != nullptr) {
+      auto chunk = static_cast<Chunk*>(cache.head);
+      cache.head = *static_cast<void**>(cache.head);
+      cache.size --;
+      chunk->next = nullptr;
+      chunk->size = CHUNK_SIZE;
+      return chunk;
+    }
+    size = CHUNK_SIZE;
+  }
+
+  auto chunk = static_cast<Chunk*>(std::malloc(size));
+  if(chunk == nullptr) {
+    throw std::bad_alloc();
+  }
+  chunk->next = nullptr;
+  chunk->size = size;
+  return chunk;
+
+}
+
+void RequestArena::recycleChunk(Chunk* chunk) {
+
+  if(chunk->size == CHUNK_SIZE && !threadCacheDestroyed) {
+    auto& cache = threadCache();
+    if(cache.size < MAX_CACHED_CHUNKS) {
+      *reinterpret_cast<void**>(chunk) = cache.head;
+      cache.head = chunk;
+      cache.size ++;
+      return;
+    }
+  }
+
+  std::free(chunk);
+
+}
+
+RequestArena::Ref RequestArena::create() {
+  auto chunk = obtainChunk(CHUNK_SIZE);
+  return Ref(new (reinterpret_cast<char*>(chunk) + HEADER_SIZE) RequestArena(chunk));
+}
+
+void RequestArena::retain() {
+  m_refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void RequestArena::release() {
+  if(m_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    auto chunk = m_chunks;
+    this->~RequestArena();
+    while(chunk != nullptr) {
+      auto next = chunk->next;
+      recycleChunk(chunk);
+      chunk = next;
+    }
+  }
+}
+
+void* RequestArena::allocate(v_buff_size size, v_buff_size alignment) {
+
+  auto address = reinterpret_cast<std::uintptr_t>(m_position);
+  auto aligned = (address + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+
+  if(aligned + size > reinterpret_cast<std::uintptr_t>(m_end)) {
+
+    auto chunk = obtainChunk(HEADER_SIZE + size + alignment);
+
+    /* Keep bumping in the current chunk if the new one is a dedicated big chunk */
+    if(chunk->size == CHUNK_SIZE) {
+      chunk->next = m_chunks;
+      m_chunks = chunk;
+      m_position = reinterpret_cast<char*>(chunk) + HEADER_SIZE;
+      m_end = reinterpret_cast<char*>(chunk) + chunk->size;
+      address = reinterpret_cast<std::uintptr_t>(m_position);
+      aligned = (address + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+    } else {
+      chunk->next = m_chunks->next;
+      m_chunks->next = chunk;
+      address = reinterpret_cast<std::uintptr_t>(chunk) + HEADER_SIZE;
+      aligned = (address + alignment - 1) & ~(std::uintptr_t)(alignment - 1);
+      m_bytesAllocated += aligned - address + size;
+      return reinterpret_cast<void*>(aligned);
+    }
+
+  }
+
+  m_bytesAllocated += aligned - address + size;
+  m_position = reinterpret_cast<char*>(aligned + size);
+  return reinterpret_cast<void*>(aligned);
+
+}
+
+std::shared_ptr<RequestArena::OutgoingResponse> RequestArena::createDtoResponse(const Status& status,
+                                                                                const oatpp::Void& dto,
+                                                                                const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper)
+{
+
+  thread_local oatpp::data::stream::BufferOutputStream stream;
+  stream.setCurrentPosition(0);
+  objectMapper->write(&stream, dto);
+
+  auto size = stream.getCurrentPosition();
+  auto data = static_cast<p_char8>(allocate(size, 1));
+  std::memcpy(data, stream.getData(), size);
+
+  if(stream.getCapacity() > MAX_KEPT_STREAM_CAPACITY) {
+    stream.reset();
+  }
+
+  auto body = allocateShared<ArenaBody>(data, size, objectMapper->getInfo().http_content_type);
+  return allocateShared<OutgoingResponse>(status, body);
+
+}
+
+v_buff_size RequestArena::getBytesAllocated() const {
+  return m_bytesAllocated;
+}
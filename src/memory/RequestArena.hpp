@@ -0,0 +1,226 @@
+#ifndef RequestArena_hpp
+#define RequestArena_hpp
+
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/core/data/mapping/ObjectMapper.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <atomic>
+#include <memory>
+
+/**
+ * Bump allocator for the objects of one request - DTOs, their fields, the response and its body.
+ * Objects are created with `std::allocate_shared` and &l:RequestArena::Allocator;, so they are ordinary shared_ptrs
+ * and object wrappers for the rest of the code. Each of them keeps the arena alive; its memory is released in bulk
+ * once the last of them is destroyed - normally when the response is sent.
+ * Memory comes in &l:RequestArena::CHUNK_SIZE; chunks from a per-thread cache, so a handler thread doesn't call malloc
+ * for a request in the steady state and doesn't contend with other handler threads in the allocator.
+ * <br>
+ * Usage:
+ * ```
+ * auto arena = RequestArena::create();
+ * auto dto = arena->create<oatpp::Object<MyDto>>();
+ * dto->statusCode = arena->create<oatpp::Int32>(200);
+ * dto->message = arena->create<oatpp::String>("Hello World!");
+ * return arena->createDtoResponse(Status::CODE_200, dto, getDefaultObjectMapper());
+ * ```
+ * Only memory allocated through the arena is in the arena - characters of a `std::string` longer than its
+ * small-string buffer and headers added to the response later are still on the heap.
+ */
+class RequestArena : public AllocationTracked<RequestArena> {
+public:
+  typedef oatpp::web::protocol::http::Status Status;
+  typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+public:
+
+  /**
+   * Size of a regular chunk. Bigger allocations get a chunk of their own.
+   */
+  static constexpr v_buff_size CHUNK_SIZE = 4096;
+
+  /**
+   * Max free chunks kept per thread.
+   */
+  static constexpr v_int32 MAX_CACHED_CHUNKS = 32;
+
+public:
+
+  /**
+   * Standard allocator over the arena. Every copy holds a reference to the arena.
+   * @tparam T - value type.
+   */
+  template<class T>
+  class Allocator {
+    template<class U>
+    friend class Allocator;
+  private:
+    RequestArena* m_arena;
+  public:
+    typedef T value_type;
+  public:
+
+    explicit Allocator(RequestArena* arena)
+      : m_arena(arena)
+    {
+      m_arena->retain();
+    }
+
+    Allocator(const Allocator& other)
+      : m_arena(other.m_arena)
+    {
+      m_arena->retain();
+    }
+
+    template<class U>
+    Allocator(const Allocator<U>& other)
+      : m_arena(other.m_arena)
+    {
+      m_arena->retain();
+    }
+
+    ~Allocator() {
+      m_arena->release();
+    }
+
+    Allocator& operator=(const Allocator& other) {
+      other.m_arena->retain();
+      m_arena->release();
+      m_arena = other.m_arena;
+      return *this;
+    }
+
+    T* allocate(std::size_t n) {
+      return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) {
+      /* released with the arena */
+    }
+
+    template<class U>
+    bool operator==(const Allocator<U>& other) const {
+      return m_arena == other.m_arena;
+    }
+
+    template<class U>
+    bool operator!=(const Allocator<U>& other) const {
+      return m_arena != other.m_arena;
+    }
+
+  };
+
+  /**
+   * Owning reference to an arena.
+   */
+  class Ref {
+  private:
+    RequestArena* m_arena;
+  public:
+
+    explicit Ref(RequestArena* arena);
+    Ref(const Ref& other);
+    Ref(Ref&& other);
+    ~Ref();
+
+    Ref& operator=(const Ref& other);
+
+    RequestArena* operator->() const;
+    RequestArena* get() const;
+
+  };
+
+private:
+
+  struct Chunk {
+    Chunk* next;
+    v_buff_size size;
+  };
+
+private:
+  std::atomic<v_int64> m_refs;
+  Chunk* m_chunks;
+  char* m_position;
+  char* m_end;
+  v_buff_size m_bytesAllocated;
+private:
+
+  RequestArena(Chunk* chunk);
+  ~RequestArena();
+
+  static Chunk* obtainChunk(v_buff_size size);
+  static void recycleChunk(Chunk* chunk);
+
+public:
+
+  RequestArena(const RequestArena&) = delete;
+  RequestArena& operator=(const RequestArena&) = delete;
+
+  /**
+   * Create a new arena. Its header is placed in its first chunk.
+   * @return - &l:RequestArena::Ref;.
+   */
+  static Ref create();
+
+  /**
+   * Add a reference.
+   */
+  void retain();
+
+  /**
+   * Remove a reference. The last one returns all chunks.
+   */
+  void release();
+
+  /**
+   * Allocate memory in the arena.
+   * @param size - size in bytes.
+   * @param alignment - power of two.
+   * @return - pointer to memory which stays valid until the arena is released.
+   */
+  void* allocate(v_buff_size size, v_buff_size alignment);
+
+  /**
+   * Create an object in the arena.
+   * @tparam T - object type.
+   * @param args - constructor arguments.
+   * @return - `std::shared_ptr` to the object.
+   */
+  template<class T, class ... Args>
+  std::shared_ptr<T> allocateShared(Args&&... args) {
+    return std::allocate_shared<T>(Allocator<T>(this), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Create an oatpp object wrapper (`oatpp::Object<T>`, `oatpp::String`, `oatpp::Int32`, ...) whose object is in the arena.
+   * @tparam Wrapper - object wrapper type.
+   * @param args - constructor arguments of the wrapped object.
+   * @return - object wrapper.
+   */
+  template<class Wrapper, class ... Args>
+  Wrapper create(Args&&... args) {
+    return Wrapper(allocateShared<typename Wrapper::ObjectType>(std::forward<Args>(args)...));
+  }
+
+  /**
+   * Serialize the DTO into the arena and create the response with its body in the arena.
+   * The serializer writes to a per-thread buffer which is reused between requests.
+   * @param status - response status.
+   * @param dto - DTO to serialize.
+   * @param objectMapper - mapper to serialize with.
+   * @return - response.
+   */
+  std::shared_ptr<OutgoingResponse> createDtoResponse(const Status& status,
+                                                      const oatpp::Void& dto,
+                                                      const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper);
+
+  /**
+   * Bytes handed out by the arena so far, including alignment padding.
+   * @return - bytes.
+   */
+  v_buff_size getBytesAllocated() const;
+
+};
+
+#endif /* RequestArena_hpp */
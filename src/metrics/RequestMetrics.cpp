@@ -0,0 +1,429 @@
+#include "RequestMetrics.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+constexpr v_int32 RequestMetrics::MAX_ROUTES;
+constexpr v_int32 RequestMetrics::BUCKETS_COUNT;
+constexpr v_int32 RequestMetrics::STATUS_CLASSES_COUNT;
+
+namespace {
+
+const oatpp::String& startKey() {
+  static const oatpp::String key("RequestMetrics::start");
+  return key;
+}
+
+/* Only the owner thread writes a counter - a plain load/store is enough, no locked read-modify-write */
+void increment(std::atomic<v_uint64>& counter, v_uint64 value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+/**
+ * Route template of a matched request - path variables as `{name}`, the tail as `*`.
+ * Falls back to the path itself when nothing was matched.
+ */
+std::string routeTemplate(std::string path, const oatpp::web::url::mapping::Pattern::MatchMap& matchMap) {
+
+  auto tail = matchMap.getTail();
+  if(tail && (size_t) tail->size() <= path.size()) {
+    path.resize(path.size() - tail->size());
+    path += "*";
+  }
+
+  const auto& variables = matchMap.getVariables();
+  if(variables.empty()) {
+    return path;
+  }
+
+  std::string result;
+  result.reserve(path.size());
+  std::vector<bool> used(variables.size(), false);
+
+  size_t pos = 0;
+  while(pos <= path.size()) {
+
+    auto end = path.find('/', pos);
+    if(end == std::string::npos) {
+      end = path.size();
+    }
+    auto segment = path.substr(pos, end - pos);
+
+    /* Same value of two variables - whichever comes first, the label only groups requests */
+    size_t i = 0;
+    for(const auto& pair : variables) {
+      if(!used[i] && !segment.empty() && segment == pair.second.std_str()) {
+        segment = "{" + pair.first.std_str() + "}";
+        used[i] = true;
+        break;
+      }
+      i ++;
+    }
+
+    result += segment;
+    if(end < path.size()) {
+      result += "/";
+    }
+    pos = end + 1;
+
+  }
+
+  return result;
+
+}
+
+void appendEscaped(std::string& out, const std::string& value) {
+  for(auto c : value) {
+    switch(c) {
+      case '\\': out += "\\\\"; break;
+      case '"': out += "\\\""; break;
+      case '\n': out += "\\n"; break;
+      default: out += c;
+    }
+  }
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestMetrics::RequestInterceptor
+
+RequestMetrics::RequestInterceptor::RequestInterceptor(const std::shared_ptr<RequestMetrics>& metrics)
+  : m_metrics(metrics)
+{}
+
+std::shared_ptr<RequestMetrics::RequestInterceptor::OutgoingResponse>
+RequestMetrics::RequestInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request) {
+  request->putBundleData(startKey(), oatpp::UInt64(nowMicros()));
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestMetrics::ResponseInterceptor
+
+RequestMetrics::ResponseInterceptor::ResponseInterceptor(const std::shared_ptr<RequestMetrics>& metrics)
+  : m_metrics(metrics)
+{}
+
+std::shared_ptr<RequestMetrics::ResponseInterceptor::OutgoingResponse>
+RequestMetrics::ResponseInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request,
+                                               const std::shared_ptr<OutgoingResponse>& response)
+{
+
+  if(!response) {
+    return response;
+  }
+
+  oatpp::UInt64 start;
+  try {
+    start = request->getBundleData<oatpp::UInt64>(startKey());
+  } catch (const std::runtime_error&) {
+    return response; // answered by an interceptor which ran before ours
+  }
+
+  if(start) {
+    auto micros = nowMicros() - *start;
+    const auto& startingLine = request->getStartingLine();
+    auto path = startingLine.path.std_str();
+    auto queryStart = path.find('?');
+    if(queryStart != std::string::npos) {
+      path.resize(queryStart);
+    }
+    m_metrics->record(startingLine.method.std_str(), routeTemplate(path, request->getPathVariables()),
+                      response->getStatus().code, micros);
+  }
+
+  return response;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestMetrics::RouteSlot
+
+RequestMetrics::RouteSlot::RouteSlot() {
+  for(v_int32 i = 0; i < STATUS_CLASSES_COUNT; i ++) {
+    statusClasses[i].store(0, std::memory_order_relaxed);
+  }
+  sumMicros.store(0, std::memory_order_relaxed);
+  for(v_int32 i = 0; i < BUCKETS_COUNT; i ++) {
+    buckets[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestMetrics::Shard
+
+RequestMetrics::Shard::Shard() {
+  for(v_int32 i = 0; i < MAX_ROUTES; i ++) {
+    slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+RequestMetrics::Shard::~Shard() {
+  for(v_int32 i = 0; i < MAX_ROUTES; i ++) {
+    delete slots[i].load(std::memory_order_relaxed);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestMetrics::RouteTotals
+
+RequestMetrics::RouteTotals::RouteTotals()
+  : statusClasses()
+  , sumMicros(0)
+  , buckets()
+{}
+
+void RequestMetrics::RouteTotals::add(const RouteSlot& slot) {
+  for(v_int32 i = 0; i < STATUS_CLASSES_COUNT; i ++) {
+    statusClasses[i] += slot.statusClasses[i].load(std::memory_order_relaxed);
+  }
+  sumMicros += slot.sumMicros.load(std::memory_order_relaxed);
+  for(v_int32 i = 0; i < BUCKETS_COUNT; i ++) {
+    buckets[i] += slot.buckets[i].load(std::memory_order_relaxed);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestMetrics::Registry
+
+RequestMetrics::Registry::Registry()
+  : full(false)
+{
+  routes.push_back({"OTHER", "other"});
+  retired.resize(1);
+}
+
+v_int32 RequestMetrics::Registry::registerRoute(const std::string& key, const std::string& method, const std::string& path) {
+
+  if(full.load(std::memory_order_acquire)) {
+    auto it = routeIndexes.find(key);
+    return it != routeIndexes.end() ? it->second : 0;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto it = routeIndexes.find(key);
+  if(it != routeIndexes.end()) {
+    return it->second;
+  }
+
+  if(routes.size() >= (size_t) MAX_ROUTES) {
+    return 0;
+  }
+
+  auto index = (v_int32) routes.size();
+  routes.push_back({method, path});
+  routeIndexes[key] = index;
+  retired.resize(routes.size());
+
+  if(routes.size() >= (size_t) MAX_ROUTES) {
+    full.store(true, std::memory_order_release);
+  }
+
+  return index;
+
+}
+
+void RequestMetrics::Registry::retire(const std::shared_ptr<Shard>& shard) {
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  for(v_int32 i = 0; i < (v_int32) retired.size(); i ++) {
+    auto slot = shard->slots[i].load(std::memory_order_acquire);
+    if(slot) {
+      retired[i].add(*slot);
+    }
+  }
+
+  for(auto it = shards.begin(); it != shards.end(); ++ it) {
+    if(*it == shard) {
+      shards.erase(it);
+      break;
+    }
+  }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestMetrics::ThreadState
+
+RequestMetrics::ThreadState::~ThreadState() {
+  if(registry && shard) {
+    registry->retire(shard);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// RequestMetrics
+
+RequestMetrics::RequestMetrics()
+  : m_registry(std::make_shared<Registry>())
+{
+  static std::atomic<v_uint64> instancesCount(0);
+  m_id = ++ instancesCount;
+}
+
+std::shared_ptr<RequestMetrics> RequestMetrics::createShared() {
+  return std::make_shared<RequestMetrics>();
+}
+
+v_int32 RequestMetrics::bucketIndex(v_uint64 micros) {
+
+  if(micros < 4) {
+    return (v_int32) micros;
+  }
+
+  v_int32 power = 63;
+  while((micros >> power) == 0) {
+    power --;
+  }
+
+  /* [2^p, 2^(p+1)) is split in 4 sub-buckets */
+  v_int32 index = 4 * (power - 1) + (v_int32) ((micros >> (power - 2)) & 3);
+  return index < BUCKETS_COUNT ? index : BUCKETS_COUNT - 1;
+
+}
+
+v_uint64 RequestMetrics::nowMicros() {
+  return (v_uint64) std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()
+  ).count();
+}
+
+RequestMetrics::ThreadState& RequestMetrics::getThreadState() {
+
+  /* One state per instance per thread. Instance ids are never reused */
+  thread_local std::unordered_map<v_uint64, ThreadState> states;
+
+  auto& state = states[m_id];
+  if(!state.shard) {
+    state.registry = m_registry;
+    state.shard = std::make_shared<Shard>();
+    std::lock_guard<std::mutex> lock(m_registry->mutex);
+    m_registry->shards.push_back(state.shard);
+  }
+  return state;
+
+}
+
+void RequestMetrics::record(const std::string& method, const std::string& path, v_int32 status, v_uint64 micros) {
+
+  auto& state = getThreadState();
+
+  std::string key = method + " " + path;
+  v_int32 index;
+  auto it = state.routes.find(key);
+  if(it != state.routes.end()) {
+    index = it->second;
+  } else {
+    index = m_registry->registerRoute(key, method, path);
+    /* Overflowing keys are not cached - they are unbounded */
+    if(index != 0) {
+      state.routes[key] = index;
+    }
+  }
+
+  auto& slotRef = state.shard->slots[index];
+  auto slot = slotRef.load(std::memory_order_relaxed);
+  if(slot == nullptr) {
+    slot = new RouteSlot();
+    slotRef.store(slot, std::memory_order_release);
+  }
+
+  v_int32 statusClass = status / 100 - 1;
+  if(statusClass < 0) statusClass = 0;
+  if(statusClass >= STATUS_CLASSES_COUNT) statusClass = STATUS_CLASSES_COUNT - 1;
+
+  increment(slot->statusClasses[statusClass], 1);
+  increment(slot->sumMicros, micros);
+  increment(slot->buckets[bucketIndex(micros)], 1);
+
+}
+
+std::vector<RequestMetrics::RouteTotals> RequestMetrics::merge() {
+
+  /* Called with the registry mutex locked */
+
+  auto totals = m_registry->retired;
+  for(auto& shard : m_registry->shards) {
+    for(v_int32 i = 0; i < (v_int32) totals.size(); i ++) {
+      auto slot = shard->slots[i].load(std::memory_order_acquire);
+      if(slot) {
+        totals[i].add(*slot);
+      }
+    }
+  }
+
+  return totals;
+
+}
+
+oatpp::String RequestMetrics::renderPrometheus() {
+
+  std::lock_guard<std::mutex> lock(m_registry->mutex);
+
+  auto totals = merge();
+
+  static const char* const statusClassNames[STATUS_CLASSES_COUNT] = {"1xx", "2xx", "3xx", "4xx", "5xx"};
+
+  std::string requests;
+  requests += "# HELP http_requests_total Requests served, by route and status class.\n";
+  requests += "# TYPE http_requests_total counter\n";
+
+  std::string durations;
+  durations += "# HELP http_request_duration_seconds Time from reading the request headers to the response being ready.\n";
+  durations += "# TYPE http_request_duration_seconds histogram\n";
+
+  char number[64];
+
+  for(size_t i = 0; i < totals.size(); i ++) {
+
+    const auto& route = totals[i];
+
+    v_uint64 count = 0;
+    for(v_int32 c = 0; c < STATUS_CLASSES_COUNT; c ++) {
+      count += route.statusClasses[c];
+    }
+    if(count == 0) {
+      continue;
+    }
+
+    std::string labels = "method=\"";
+    appendEscaped(labels, m_registry->routes[i].method);
+    labels += "\",route=\"";
+    appendEscaped(labels, m_registry->routes[i].path);
+    labels += "\"";
+
+    for(v_int32 c = 0; c < STATUS_CLASSES_COUNT; c ++) {
+      if(route.statusClasses[c] > 0) {
+        std::snprintf(number, sizeof(number), "%llu", (unsigned long long) route.statusClasses[c]);
+        requests += "http_requests_total{" + labels + ",code=\"" + statusClassNames[c] + "\"} " + number + "\n";
+      }
+    }
+
+    /* Export below powers of two microseconds - fine buckets align with them. Fine buckets up to 2^p hold samples
+     * below 2^p, and samples are whole microseconds, so the inclusive `le` is 2^p - 1. 15us .. ~33.5s */
+    v_uint64 cumulative = 0;
+    v_int32 fineIndex = 0;
+    for(v_int32 power = 4; power <= 25; power ++) {
+      v_int32 boundary = 4 * (power - 1);
+      while(fineIndex < boundary) {
+        cumulative += route.buckets[fineIndex ++];
+      }
+      std::snprintf(number, sizeof(number), "%.6f\"} %llu", (double) ((1ULL << power) - 1) / 1000000.0, (unsigned long long) cumulative);
+      durations += "http_request_duration_seconds_bucket{" + labels + ",le=\"" + number + "\n";
+    }
+
+    std::snprintf(number, sizeof(number), "%llu", (unsigned long long) count);
+    durations += "http_request_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} " + number + "\n";
+    durations += "http_request_duration_seconds_count{" + labels + "} " + number + "\n";
+
+    std::snprintf(number, sizeof(number), "%.6f", (double) route.sumMicros / 1000000.0);
+    durations += "http_request_duration_seconds_sum{" + labels + "} " + number + "\n";
+
+  }
+
+  return oatpp::String(requests + durations);
+
+}
@@ -0,0 +1,177 @@
+#ifndef RequestMetrics_hpp
+#define RequestMetrics_hpp
+
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include "oatpp/web/server/interceptor/RequestInterceptor.hpp"
+#include "oatpp/web/server/interceptor/ResponseInterceptor.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Per-route request counters and latency histograms.
+ * Each thread writes to its own shard - no locks and no shared cache lines on the request path.
+ * Shards are merged only when metrics are rendered. The shard of a thread is folded into a retired total when the thread
+ * exits, so there are never more shards than live threads.
+ * Routes are `method + route template` - path variables matched by the router are rendered as `{name}` and the tail as
+ * `*`, so `/items/7` and `/items/8` are one route `/items/{count}`. Paths without a route are taken as is, and after
+ * &l:RequestMetrics::MAX_ROUTES; distinct routes the rest are counted as `route="other"`.
+ *
+ * Attach &l:RequestMetrics::RequestInterceptor; and &l:RequestMetrics::ResponseInterceptor; to a connection handler.
+ */
+class RequestMetrics {
+public:
+
+  /**
+   * Max number of distinct routes. Route index 0 is reserved for overflow.
+   */
+  static constexpr v_int32 MAX_ROUTES = 128;
+
+  /**
+   * Number of histogram buckets. Log-linear, 4 sub-buckets per power of two microseconds (HDR-style, <= 25% error).
+   */
+  static constexpr v_int32 BUCKETS_COUNT = 140;
+
+  /**
+   * Status classes 1xx..5xx.
+   */
+  static constexpr v_int32 STATUS_CLASSES_COUNT = 5;
+
+public:
+
+  /**
+   * Marks the start of a request. Must run before the router.
+   */
+  class RequestInterceptor : public oatpp::web::server::interceptor::RequestInterceptor {
+  private:
+    std::shared_ptr<RequestMetrics> m_metrics;
+  public:
+    RequestInterceptor(const std::shared_ptr<RequestMetrics>& metrics);
+    std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request) override;
+  };
+
+  /**
+   * Records the request once its response is ready.
+   */
+  class ResponseInterceptor : public oatpp::web::server::interceptor::ResponseInterceptor {
+  private:
+    std::shared_ptr<RequestMetrics> m_metrics;
+  public:
+    ResponseInterceptor(const std::shared_ptr<RequestMetrics>& metrics);
+    std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request,
+                                                const std::shared_ptr<OutgoingResponse>& response) override;
+  };
+
+private:
+
+  /**
+   * Counters of one route in one shard. Written only by the owner thread.
+   */
+  struct RouteSlot {
+    std::atomic<v_uint64> statusClasses[STATUS_CLASSES_COUNT];
+    std::atomic<v_uint64> sumMicros;
+    std::atomic<v_uint64> buckets[BUCKETS_COUNT];
+    RouteSlot();
+  };
+
+  /**
+   * Counters of one thread.
+   */
+  struct Shard : public AllocationTracked<Shard> {
+    std::atomic<RouteSlot*> slots[MAX_ROUTES];
+    Shard();
+    ~Shard();
+  };
+
+  /**
+   * Merged counters of one route.
+   */
+  struct RouteTotals {
+    v_uint64 statusClasses[STATUS_CLASSES_COUNT];
+    v_uint64 sumMicros;
+    v_uint64 buckets[BUCKETS_COUNT];
+    RouteTotals();
+    void add(const RouteSlot& slot);
+  };
+
+  struct Route {
+    std::string method;
+    std::string path;
+  };
+
+  /**
+   * Routes and shards of this instance. Shared with the threads, which may exit after the instance is destroyed.
+   */
+  struct Registry {
+
+    std::mutex mutex;
+    std::vector<Route> routes;
+    std::unordered_map<std::string, v_int32> routeIndexes;
+
+    /* Set once routes are full - they don't change after that, and routeIndexes is read without the mutex */
+    std::atomic<bool> full;
+
+    std::vector<std::shared_ptr<Shard>> shards;
+    std::vector<RouteTotals> retired;
+
+    Registry();
+    v_int32 registerRoute(const std::string& key, const std::string& method, const std::string& path);
+    void retire(const std::shared_ptr<Shard>& shard);
+
+  };
+
+  /**
+   * Per-thread view of this instance. Retires its shard when the thread exits.
+   */
+  struct ThreadState {
+    std::shared_ptr<Registry> registry;
+    std::shared_ptr<Shard> shard;
+    /* Routes known to the registry - never more than MAX_ROUTES */
+    std::unordered_map<std::string, v_int32> routes;
+    ~ThreadState();
+  };
+
+private:
+  static v_int32 bucketIndex(v_uint64 micros);
+  static v_uint64 nowMicros();
+private:
+  v_uint64 m_id;
+  std::shared_ptr<Registry> m_registry;
+private:
+  ThreadState& getThreadState();
+  std::vector<RouteTotals> merge();
+public:
+
+  /**
+   * Constructor.
+   */
+  RequestMetrics();
+
+  /**
+   * Create shared RequestMetrics.
+   * @return - `std::shared_ptr` to RequestMetrics.
+   */
+  static std::shared_ptr<RequestMetrics> createShared();
+
+  /**
+   * Record one request. Called by &l:RequestMetrics::ResponseInterceptor;.
+   * @param method - request method.
+   * @param path - route template, or request path without the query if no route matched.
+   * @param status - response status code.
+   * @param micros - request latency in microseconds.
+   */
+  void record(const std::string& method, const std::string& path, v_int32 status, v_uint64 micros);
+
+  /**
+   * Merge all shards and render them in the Prometheus text exposition format.
+   * @return - metrics text.
+   */
+  oatpp::String renderPrometheus();
+
+};
+
+#endif /* RequestMetrics_hpp */
@@ -0,0 +1,365 @@
+#include "ListenerConnectionProvider.hpp"
+
+#include "oatpp/network/tcp/Connection.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+void ListenerConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) {
+  auto c = std::static_pointer_cast<oatpp::network::tcp::Connection>(connection);
+  ::shutdown(c->getHandle(), SHUT_RDWR);
+}
+
+namespace {
+
+/* Pause of get() after a failed poll() or accept(), before it retries */
+constexpr std::chrono::milliseconds ERROR_BACKOFF(100);
+
+ListenerConnectionProvider::Options withReusePort(bool reusePort) {
+  ListenerConnectionProvider::Options options;
+  options.reusePort = reusePort;
+  return options;
+}
+
+void setOption(oatpp::v_io_handle handle, int level, int name, int value, const char* optionName) {
+  if(::setsockopt(handle, level, name, &value, sizeof(value)) != 0) {
+    OATPP_LOGW("[ListenerConnectionProvider::applyListenerOptions()]", "Warning. Can't set %s=%d: %s", optionName, value, std::strerror(errno));
+  }
+}
+
+}
+
+ListenerConnectionProvider::ListenerConnectionProvider(const oatpp::network::Address& address, bool reusePort)
+  : ListenerConnectionProvider(address, withReusePort(reusePort))
+{}
+
+ListenerConnectionProvider::ListenerConnectionProvider(const oatpp::network::Address& address, const Options& options)
+  : m_address(address)
+  , m_options(options)
+  , m_invalidator(std::make_shared<ConnectionInvalidator>())
+  , m_serverHandle(instantiateServer())
+  , m_closed(false)
+  , m_listening(!options.deferListen)
+  , m_port(m_address.port)
+{
+  readBoundAddress();
+}
+
+ListenerConnectionProvider::ListenerConnectionProvider(oatpp::v_io_handle serverHandle)
+  : m_address(nullptr, 0)
+  , m_invalidator(std::make_shared<ConnectionInvalidator>())
+  , m_serverHandle(serverHandle)
+  , m_closed(false)
+  , m_listening(true)
+  , m_port(0)
+{
+  /* O_NONBLOCK is shared with the process the handle came from, FD_CLOEXEC is not */
+  ::fcntl(m_serverHandle, F_SETFL, ::fcntl(m_serverHandle, F_GETFL) | O_NONBLOCK);
+  ::fcntl(m_serverHandle, F_SETFD, FD_CLOEXEC);
+  readBoundAddress();
+}
+
+std::shared_ptr<ListenerConnectionProvider> ListenerConnectionProvider::createShared(const oatpp::network::Address& address, bool reusePort) {
+  return std::make_shared<ListenerConnectionProvider>(address, reusePort);
+}
+
+std::shared_ptr<ListenerConnectionProvider> ListenerConnectionProvider::createShared(const oatpp::network::Address& address, const Options& options) {
+  return std::make_shared<ListenerConnectionProvider>(address, options);
+}
+
+std::shared_ptr<ListenerConnectionProvider> ListenerConnectionProvider::createShared(oatpp::v_io_handle serverHandle) {
+  return std::make_shared<ListenerConnectionProvider>(serverHandle);
+}
+
+void ListenerConnectionProvider::readBoundAddress() {
+
+  sockaddr_storage boundAddress;
+  socklen_t boundAddressSize = sizeof(boundAddress);
+
+  if(::getsockname(m_serverHandle, (sockaddr*) &boundAddress, &boundAddressSize) == 0) {
+
+    if(boundAddress.ss_family == AF_INET) {
+      m_port = ntohs(((sockaddr_in*) &boundAddress)->sin_port);
+      m_address.family = oatpp::network::Address::IP_4;
+    } else if(boundAddress.ss_family == AF_INET6) {
+      m_port = ntohs(((sockaddr_in6*) &boundAddress)->sin6_port);
+      m_address.family = oatpp::network::Address::IP_6;
+    }
+
+    if(!m_address.host) {
+      char host[NI_MAXHOST];
+      if(::getnameinfo((sockaddr*) &boundAddress, boundAddressSize, host, sizeof(host), nullptr, 0, NI_NUMERICHOST) == 0) {
+        m_address.host = host;
+      }
+    }
+
+  }
+
+  m_address.port = m_port;
+
+  setProperty(PROPERTY_HOST, m_address.host);
+  setProperty(PROPERTY_PORT, oatpp::utils::conversion::int32ToStr(m_port));
+
+}
+
+ListenerConnectionProvider::~ListenerConnectionProvider() {
+  stop();
+  ::close(m_serverHandle);
+}
+
+oatpp::v_io_handle ListenerConnectionProvider::instantiateServer() {
+
+  addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;
+  hints.ai_protocol = 0;
+
+  switch(m_address.family) {
+    case oatpp::network::Address::IP_4: hints.ai_family = AF_INET; break;
+    case oatpp::network::Address::IP_6: hints.ai_family = AF_INET6; break;
+    default: hints.ai_family = AF_UNSPEC;
+  }
+
+  auto portStr = oatpp::utils::conversion::int32ToStr(m_address.port);
+
+  addrinfo* result = nullptr;
+  auto res = ::getaddrinfo(m_address.host->c_str(), portStr->c_str(), &hints, &result);
+  if(res != 0) {
+    OATPP_LOGE("[ListenerConnectionProvider::instantiateServer()]", "Error. Call to getaddrinfo() failed: %s", gai_strerror(res));
+    throw std::runtime_error("[ListenerConnectionProvider::instantiateServer()]: Error. Call to getaddrinfo() failed.");
+  }
+
+  oatpp::v_io_handle serverHandle = -1;
+
+  for(addrinfo* current = result; current != nullptr; current = current->ai_next) {
+
+    serverHandle = ::socket(current->ai_family, current->ai_socktype, current->ai_protocol);
+    if(serverHandle < 0) {
+      continue;
+    }
+
+    applyListenerOptions(serverHandle, current->ai_family);
+
+    /* With deferListen the port is only bound here - it is reserved, but connection attempts are refused */
+    if(::bind(serverHandle, current->ai_addr, current->ai_addrlen) == 0 &&
+       (m_options.deferListen || ::listen(serverHandle, m_options.backlog) == 0)) {
+      break;
+    }
+
+    ::close(serverHandle);
+    serverHandle = -1;
+
+  }
+
+  ::freeaddrinfo(result);
+
+  if(serverHandle < 0) {
+    OATPP_LOGE("[ListenerConnectionProvider::instantiateServer()]", "Error. Can't bind to %s:%d", m_address.host->c_str(), m_address.port);
+    throw std::runtime_error("[ListenerConnectionProvider::instantiateServer()]: Error. Can't bind to address.");
+  }
+
+  /* Non-blocking, so that a connection reset between poll() and accept() doesn't block the accept loop */
+  ::fcntl(serverHandle, F_SETFL, ::fcntl(serverHandle, F_GETFL) | O_NONBLOCK);
+  ::fcntl(serverHandle, F_SETFD, FD_CLOEXEC);
+
+  return serverHandle;
+
+}
+
+void ListenerConnectionProvider::applyListenerOptions(oatpp::v_io_handle serverHandle, int family) {
+
+  int yes = 1;
+  ::setsockopt(serverHandle, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+
+  if(m_options.reusePort) {
+#ifdef SO_REUSEPORT
+    setOption(serverHandle, SOL_SOCKET, SO_REUSEPORT, 1, "SO_REUSEPORT");
+#else
+    OATPP_LOGW("[ListenerConnectionProvider::applyListenerOptions()]", "Warning. SO_REUSEPORT is not supported on this platform");
+#endif
+  }
+
+  /* Buffer sizes of the listener are inherited by accepted sockets, and only sizes set before listen() count for the window scale */
+  if(m_options.receiveBufferSize > 0) {
+    setOption(serverHandle, SOL_SOCKET, SO_RCVBUF, m_options.receiveBufferSize, "SO_RCVBUF");
+  }
+  if(m_options.sendBufferSize > 0) {
+    setOption(serverHandle, SOL_SOCKET, SO_SNDBUF, m_options.sendBufferSize, "SO_SNDBUF");
+  }
+
+  /* Explicit in both directions, so that the result doesn't depend on the net.ipv6.bindv6only sysctl */
+  if(family == AF_INET6) {
+    setOption(serverHandle, IPPROTO_IPV6, IPV6_V6ONLY, m_options.dualStack ? 0 : 1, "IPV6_V6ONLY");
+  }
+
+  if(m_options.deferAcceptSeconds > 0) {
+#ifdef TCP_DEFER_ACCEPT
+    setOption(serverHandle, IPPROTO_TCP, TCP_DEFER_ACCEPT, m_options.deferAcceptSeconds, "TCP_DEFER_ACCEPT");
+#else
+    OATPP_LOGW("[ListenerConnectionProvider::applyListenerOptions()]", "Warning. TCP_DEFER_ACCEPT is not supported on this platform");
+#endif
+  }
+
+  if(m_options.fastOpenQueue > 0) {
+#ifdef TCP_FASTOPEN
+    setOption(serverHandle, IPPROTO_TCP, TCP_FASTOPEN, m_options.fastOpenQueue, "TCP_FASTOPEN");
+#else
+    OATPP_LOGW("[ListenerConnectionProvider::applyListenerOptions()]", "Warning. TCP_FASTOPEN is not supported on this platform");
+#endif
+  }
+
+}
+
+void ListenerConnectionProvider::prepareConnectionHandle(oatpp::v_io_handle handle) {
+  /* BSD-derived systems inherit O_NONBLOCK from the listener */
+  ::fcntl(handle, F_SETFL, ::fcntl(handle, F_GETFL) & ~O_NONBLOCK);
+  ::fcntl(handle, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+  int yes = 1;
+  ::setsockopt(handle, SOL_SOCKET, SO_NOSIGPIPE, &yes, sizeof(yes));
+#endif
+  /* TCP_NODELAY is not inherited from the listener on every platform */
+  if(m_options.noDelay) {
+    int noDelay = 1;
+    ::setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+  }
+}
+
+void ListenerConnectionProvider::stop() {
+  if(!m_closed.exchange(true)) {
+    /* Refuse new connections right away. The handle itself is closed in the destructor, when nobody polls it anymore */
+    ::shutdown(m_serverHandle, SHUT_RDWR);
+    m_stopSignal.signal();
+  }
+}
+
+void ListenerConnectionProvider::detach() {
+  if(!m_closed.exchange(true)) {
+    /* No shutdown() here - it would stop the listening socket in every process which shares it */
+    m_stopSignal.signal();
+  }
+}
+
+void ListenerConnectionProvider::listen() {
+
+  if(m_listening) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_listenMutex);
+  if(m_listening) {
+    return;
+  }
+
+  if(::listen(m_serverHandle, m_options.backlog) != 0) {
+    OATPP_LOGE("[ListenerConnectionProvider::listen()]", "Error. Call to listen() failed: %s", std::strerror(errno));
+    throw std::runtime_error("[ListenerConnectionProvider::listen()]: Error. Call to listen() failed.");
+  }
+  m_listening = true;
+
+}
+
+bool ListenerConnectionProvider::isListening() const {
+  return m_listening;
+}
+
+void ListenerConnectionProvider::backOff(const char* call) {
+  if(m_closed) {
+    return;
+  }
+  OATPP_LOGE("[ListenerConnectionProvider::get()]", "Error. Call to %s() failed: %s. Retrying in %lldms", call,
+             std::strerror(errno), (long long) ERROR_BACKOFF.count());
+  /* get() must not return nullptr while the provider is open - the accept loop of oatpp::network::Server would spin */
+  m_stopSignal.waitFor(ERROR_BACKOFF);
+}
+
+oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> ListenerConnectionProvider::get() {
+
+  /* A bound socket which doesn't listen polls as POLLHUP - the accept loop would spin */
+  if(!m_listening && !m_closed) {
+    listen();
+  }
+
+  pollfd handles[2];
+  handles[0].fd = m_serverHandle;
+  handles[0].events = POLLIN;
+  handles[1].fd = m_stopSignal.getHandle();
+  handles[1].events = POLLIN;
+
+  while(!m_closed) {
+
+    handles[0].revents = 0;
+    handles[1].revents = 0;
+
+    auto res = ::poll(handles, 2, -1);
+
+    if(res < 0) {
+      if(errno != EINTR) {
+        backOff("poll");
+      }
+      continue;
+    }
+
+    if(handles[1].revents != 0) {
+      return nullptr;
+    }
+
+    if(handles[0].revents & POLLIN) {
+
+      oatpp::v_io_handle handle = ::accept(m_serverHandle, nullptr, nullptr);
+
+      if(handle >= 0) {
+        prepareConnectionHandle(handle);
+        return oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>(
+          std::make_shared<oatpp::network::tcp::Connection>(handle),
+          m_invalidator
+        );
+      }
+
+      if(errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNABORTED || errno == EINTR) {
+        continue;
+      }
+
+      /* EMFILE, ENFILE, ENOBUFS... - the pending connection stays in the backlog, retrying right away would spin */
+      backOff("accept");
+      continue;
+
+    }
+
+    if(handles[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+      backOff("poll");
+    }
+
+  }
+
+  return nullptr;
+
+}
+
+oatpp::async::CoroutineStarterForResult<const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&> ListenerConnectionProvider::getAsync() {
+  throw std::runtime_error("[ListenerConnectionProvider::getAsync()]: Error. Not implemented.");
+}
+
+oatpp::v_io_handle ListenerConnectionProvider::getHandle() const {
+  return m_serverHandle;
+}
+
+v_uint16 ListenerConnectionProvider::getPort() const {
+  return m_port;
+}
+
+const ListenerConnectionProvider::Options& ListenerConnectionProvider::getOptions() const {
+  return m_options;
+}
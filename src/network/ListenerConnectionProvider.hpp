@@ -0,0 +1,210 @@
+#ifndef ListenerConnectionProvider_hpp
+#define ListenerConnectionProvider_hpp
+
+#include "lifecycle/StopSignal.hpp"
+
+#include "oatpp/network/ConnectionProvider.hpp"
+#include "oatpp/network/Address.hpp"
+
+#include <atomic>
+#include <mutex>
+
+/**
+ * TCP server connection provider which owns its listening socket.
+ * Unlike `oatpp::network::tcp::server::ConnectionProvider` it doesn't wake up periodically to check if it was stopped.
+ * It polls the listening socket together with a &l:StopSignal; and `stop()` wakes a blocked `get()` exactly once.
+ */
+class ListenerConnectionProvider : public oatpp::network::ServerConnectionProvider {
+public:
+
+  /**
+   * Socket options. `0` leaves the system default.
+   */
+  struct Options {
+
+    /**
+     * Max number of connections waiting to be accepted - `listen()` backlog. Capped by `net.core.somaxconn` on Linux.
+     */
+    v_int32 backlog = 10000;
+
+    /**
+     * `SO_RCVBUF` of the listener, inherited by accepted sockets. Set before `listen()`, so that it counts for the
+     * TCP window scale negotiated in the handshake.
+     */
+    v_int32 receiveBufferSize = 0;
+
+    /**
+     * `SO_SNDBUF` of the listener, inherited by accepted sockets.
+     */
+    v_int32 sendBufferSize = 0;
+
+    /**
+     * Set `TCP_NODELAY` on accepted sockets - don't hold back small writes while an ACK is outstanding.
+     * On by default - a response written in parts would otherwise wait for the delayed ACK of the client.
+     */
+    bool noDelay = true;
+
+    /**
+     * `TCP_DEFER_ACCEPT` (Linux) - don't wake `accept()` until the first request bytes arrive or this many seconds pass.
+     */
+    v_int32 deferAcceptSeconds = 0;
+
+    /**
+     * `TCP_FASTOPEN` queue length - accept data in the SYN from clients which have a fast open cookie.
+     */
+    v_int32 fastOpenQueue = 0;
+
+    /**
+     * For IPv6 listeners - accept IPv4 connections too (`IPV6_V6ONLY` = 0). Otherwise IPv6 listeners are IPv6 only.
+     */
+    bool dualStack = false;
+
+    /**
+     * Set `SO_REUSEPORT`, so that several listeners can bind the same port.
+     */
+    bool reusePort = false;
+
+    /**
+     * Bind in the constructor, but don't call `listen()` until &l:ListenerConnectionProvider::listen ();.
+     * The port is reserved and known, connection attempts are refused until then - e.g. while the server warms up.
+     */
+    bool deferListen = false;
+
+  };
+
+private:
+
+  /**
+   * Shuts down the accepted connection so that a blocked reader gets woken.
+   */
+  class ConnectionInvalidator : public oatpp::provider::Invalidator<oatpp::data::stream::IOStream> {
+  public:
+    void invalidate(const std::shared_ptr<oatpp::data::stream::IOStream>& connection) override;
+  };
+
+private:
+  oatpp::network::Address m_address;
+  Options m_options;
+  std::shared_ptr<ConnectionInvalidator> m_invalidator;
+  StopSignal m_stopSignal;
+  oatpp::v_io_handle m_serverHandle;
+  std::atomic<bool> m_closed;
+  std::atomic<bool> m_listening;
+  std::mutex m_listenMutex;
+  v_uint16 m_port;
+private:
+  oatpp::v_io_handle instantiateServer();
+  void applyListenerOptions(oatpp::v_io_handle serverHandle, int family);
+  void readBoundAddress();
+  void prepareConnectionHandle(oatpp::v_io_handle handle);
+  void backOff(const char* call);
+public:
+
+  /**
+   * Constructor. Binds and starts listening on the address.
+   * @param address - address to listen on. Port `0` picks an ephemeral port, see `getProperty("port")`.
+   * @param reusePort - set `SO_REUSEPORT`, so that several listeners can bind the same port.
+   */
+  ListenerConnectionProvider(const oatpp::network::Address& address, bool reusePort = false);
+
+  /**
+   * Create shared ListenerConnectionProvider.
+   * @param address - address to listen on.
+   * @param reusePort - set `SO_REUSEPORT`, so that several listeners can bind the same port.
+   * @return - `std::shared_ptr` to ListenerConnectionProvider.
+   */
+  static std::shared_ptr<ListenerConnectionProvider> createShared(const oatpp::network::Address& address, bool reusePort = false);
+
+  /**
+   * Constructor. Binds and starts listening on the address with the socket options - only binds with
+   * &l:ListenerConnectionProvider::Options::deferListen;.
+   * Options which the platform doesn't support are skipped with a warning.
+   * @param address - address to listen on. Port `0` picks an ephemeral port, see `getProperty("port")`.
+   * @param options - &l:ListenerConnectionProvider::Options;.
+   */
+  ListenerConnectionProvider(const oatpp::network::Address& address, const Options& options);
+
+  /**
+   * Create shared ListenerConnectionProvider with socket options.
+   * @param address - address to listen on.
+   * @param options - &l:ListenerConnectionProvider::Options;.
+   * @return - `std::shared_ptr` to ListenerConnectionProvider.
+   */
+  static std::shared_ptr<ListenerConnectionProvider> createShared(const oatpp::network::Address& address, const Options& options);
+
+  /**
+   * Constructor. Takes ownership of a socket which is already bound and listening,
+   * e.g. one received from another process with &l:ListenerHandoff;.
+   * @param serverHandle - listening socket handle.
+   */
+  ListenerConnectionProvider(oatpp::v_io_handle serverHandle);
+
+  /**
+   * Create shared ListenerConnectionProvider on a socket which is already bound and listening.
+   * @param serverHandle - listening socket handle.
+   * @return - `std::shared_ptr` to ListenerConnectionProvider.
+   */
+  static std::shared_ptr<ListenerConnectionProvider> createShared(oatpp::v_io_handle serverHandle);
+
+  /**
+   * Virtual destructor. Closes the listening socket.
+   */
+  ~ListenerConnectionProvider() override;
+
+  /**
+   * Stop accepting connections. Wakes a blocked `get()` which then returns `nullptr`.
+   */
+  void stop() override;
+
+  /**
+   * Block until a connection is accepted or the provider is stopped.
+   * Errors of `poll()` and `accept()` are logged and retried after a pause (e.g. out of file descriptors).
+   * Starts listening first if `listen()` was deferred and wasn't called.
+   * @return - connection handle or `nullptr` if stopped.
+   */
+  oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream> get() override;
+
+  /**
+   * Stop accepting connections, but keep the listening socket open for other processes which share it.
+   * Wakes a blocked `get()` like `stop()`. A later `stop()` is a no-op.
+   */
+  void detach();
+
+  /**
+   * Start listening on the socket bound with &l:ListenerConnectionProvider::Options::deferListen;.
+   * No-op if the provider already listens. Throws `std::runtime_error` if `listen()` fails.
+   */
+  void listen();
+
+  /**
+   * Check if connections are accepted on the socket - always `true` unless `listen()` is deferred and wasn't called.
+   * @return
+   */
+  bool isListening() const;
+
+  /**
+   * Not implemented. The server accepts connections in its own thread, even for async handlers.
+   */
+  oatpp::async::CoroutineStarterForResult<const oatpp::provider::ResourceHandle<oatpp::data::stream::IOStream>&> getAsync() override;
+
+  /**
+   * Get listening socket handle.
+   * @return - listening socket handle.
+   */
+  oatpp::v_io_handle getHandle() const;
+
+  /**
+   * Get port the provider listens on. Differs from the configured port if that was `0`.
+   * @return - port.
+   */
+  v_uint16 getPort() const;
+
+  /**
+   * Get socket options of the provider. Default options for a provider on an inherited socket.
+   * @return - &l:ListenerConnectionProvider::Options;.
+   */
+  const Options& getOptions() const;
+
+};
+
+#endif /* ListenerConnectionProvider_hpp */
@@ -0,0 +1,255 @@
+#include "ListenerHandoff.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+const char HANDOFF_MESSAGE = 'L';
+const char HANDOFF_ACK = 'A';
+const int HANDOFF_ACK_TIMEOUT_MS = 5000;
+
+bool makeUnixAddress(const oatpp::String& path, sockaddr_un& address) {
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if(path->size() >= sizeof(address.sun_path)) {
+    return false;
+  }
+  std::memcpy(address.sun_path, path->data(), path->size());
+  return true;
+}
+
+int bindUnixSocket(const oatpp::String& path) {
+
+  sockaddr_un address;
+  if(!makeUnixAddress(path, address)) {
+    throw std::runtime_error("[ListenerHandoff]: Error. Unix domain socket path is too long.");
+  }
+
+  int handle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if(handle < 0) {
+    throw std::runtime_error("[ListenerHandoff]: Error. Can't create Unix domain socket.");
+  }
+
+  ::fcntl(handle, F_SETFD, FD_CLOEXEC);
+
+  /* Remove socket file left by a process which didn't exit cleanly */
+  ::unlink(path->c_str());
+
+  if(::bind(handle, (sockaddr*) &address, sizeof(address)) != 0 || ::listen(handle, 1) != 0) {
+    ::close(handle);
+    OATPP_LOGE("[ListenerHandoff]", "Error. Can't listen on '%s': %s", path->c_str(), std::strerror(errno));
+    throw std::runtime_error("[ListenerHandoff]: Error. Can't listen on Unix domain socket.");
+  }
+
+  return handle;
+
+}
+
+}
+
+ListenerHandoff::ListenerHandoff(const oatpp::String& path,
+                                 const std::shared_ptr<ListenerConnectionProvider>& connectionProvider,
+                                 const std::shared_ptr<StopSignal>& stopSignal)
+  : m_path(path)
+  , m_connectionProvider(connectionProvider)
+  , m_stopSignal(stopSignal)
+  , m_serverHandle(bindUnixSocket(path))
+  , m_handedOff(false)
+{
+  m_thread = std::thread(&ListenerHandoff::serve, this);
+}
+
+ListenerHandoff::~ListenerHandoff() {
+  m_closeSignal.signal();
+  if(m_thread.joinable()) {
+    m_thread.join();
+  }
+  if(m_serverHandle >= 0) {
+    ::close(m_serverHandle);
+    ::unlink(m_path->c_str());
+  }
+}
+
+void ListenerHandoff::serve() {
+
+  while(!m_closeSignal.isSignaled()) {
+
+    if(m_serverHandle < 0) {
+      try {
+        m_serverHandle = bindUnixSocket(m_path);
+      } catch(const std::runtime_error& e) {
+        OATPP_LOGE("[ListenerHandoff::serve()]", "Error. %s", e.what());
+        return;
+      }
+    }
+
+    pollfd handles[2];
+    handles[0].fd = m_serverHandle;
+    handles[0].events = POLLIN;
+    handles[0].revents = 0;
+    handles[1].fd = m_closeSignal.getHandle();
+    handles[1].events = POLLIN;
+    handles[1].revents = 0;
+
+    auto res = ::poll(handles, 2, -1);
+    if(res < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      OATPP_LOGE("[ListenerHandoff::serve()]", "Error. Call to poll() failed: %s", std::strerror(errno));
+      return;
+    }
+
+    if(handles[1].revents != 0) {
+      return;
+    }
+
+    int channelHandle = ::accept(m_serverHandle, nullptr, nullptr);
+    if(channelHandle < 0) {
+      continue;
+    }
+
+    /* Free the path right away - the new process serves its listener there for the next restart */
+    ::close(m_serverHandle);
+    ::unlink(m_path->c_str());
+    m_serverHandle = -1;
+
+    bool handedOff = handOff(channelHandle);
+    ::close(channelHandle);
+
+    if(handedOff) {
+      OATPP_LOGI("ListenerHandoff", "Listener handed over to the new process. Draining...");
+      m_handedOff = true;
+      m_connectionProvider->detach();
+      m_stopSignal->signal();
+      return;
+    }
+
+    OATPP_LOGW("ListenerHandoff", "Handoff failed, keep accepting");
+
+  }
+
+}
+
+bool ListenerHandoff::handOff(int channelHandle) {
+
+  int listenerHandle = m_connectionProvider->getHandle();
+
+  char payload = HANDOFF_MESSAGE;
+  iovec iov;
+  iov.iov_base = &payload;
+  iov.iov_len = sizeof(payload);
+
+  char control[CMSG_SPACE(sizeof(int))];
+  std::memset(control, 0, sizeof(control));
+
+  msghdr message;
+  std::memset(&message, 0, sizeof(message));
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+  std::memcpy(CMSG_DATA(cmsg), &listenerHandle, sizeof(int));
+
+  if(::sendmsg(channelHandle, &message, MSG_NOSIGNAL) != (ssize_t) sizeof(payload)) {
+    OATPP_LOGE("[ListenerHandoff::handOff()]", "Error. Call to sendmsg() failed: %s", std::strerror(errno));
+    return false;
+  }
+
+  /* Keep accepting until the new process confirms it owns the listener */
+  pollfd handle;
+  handle.fd = channelHandle;
+  handle.events = POLLIN;
+  handle.revents = 0;
+  if(::poll(&handle, 1, HANDOFF_ACK_TIMEOUT_MS) <= 0) {
+    OATPP_LOGE("[ListenerHandoff::handOff()]", "Error. No confirmation from the new process");
+    return false;
+  }
+
+  char ack = 0;
+  return ::recv(channelHandle, &ack, sizeof(ack), 0) == (ssize_t) sizeof(ack) && ack == HANDOFF_ACK;
+
+}
+
+bool ListenerHandoff::isHandedOff() const {
+  return m_handedOff;
+}
+
+std::shared_ptr<ListenerConnectionProvider> ListenerHandoff::takeOver(const oatpp::String& path) {
+
+  sockaddr_un address;
+  if(!makeUnixAddress(path, address)) {
+    throw std::runtime_error("[ListenerHandoff::takeOver()]: Error. Unix domain socket path is too long.");
+  }
+
+  int channelHandle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if(channelHandle < 0) {
+    throw std::runtime_error("[ListenerHandoff::takeOver()]: Error. Can't create Unix domain socket.");
+  }
+
+  if(::connect(channelHandle, (sockaddr*) &address, sizeof(address)) != 0) {
+    /* Nobody serves a listener - this is the first process */
+    ::close(channelHandle);
+    return nullptr;
+  }
+
+  char payload = 0;
+  iovec iov;
+  iov.iov_base = &payload;
+  iov.iov_len = sizeof(payload);
+
+  char control[CMSG_SPACE(sizeof(int))];
+  std::memset(control, 0, sizeof(control));
+
+  msghdr message;
+  std::memset(&message, 0, sizeof(message));
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  ssize_t res;
+  do {
+    res = ::recvmsg(channelHandle, &message, 0);
+  } while(res < 0 && errno == EINTR);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+  if(res != (ssize_t) sizeof(payload) || payload != HANDOFF_MESSAGE || cmsg == nullptr ||
+     cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+  {
+    OATPP_LOGE("[ListenerHandoff::takeOver()]", "Error. Invalid handoff message from '%s'", path->c_str());
+    ::close(channelHandle);
+    return nullptr;
+  }
+
+  int listenerHandle;
+  std::memcpy(&listenerHandle, CMSG_DATA(cmsg), sizeof(int));
+
+  auto connectionProvider = ListenerConnectionProvider::createShared(listenerHandle);
+
+  char ack = HANDOFF_ACK;
+  ::send(channelHandle, &ack, sizeof(ack), MSG_NOSIGNAL);
+  ::close(channelHandle);
+
+  OATPP_LOGI("ListenerHandoff", "Took listener over on port %d", connectionProvider->getPort());
+
+  return connectionProvider;
+
+}
@@ -0,0 +1,65 @@
+#ifndef ListenerHandoff_hpp
+#define ListenerHandoff_hpp
+
+#include "ListenerConnectionProvider.hpp"
+
+#include "lifecycle/StopSignal.hpp"
+
+#include <atomic>
+#include <thread>
+
+/**
+ * Hands a listening socket over to a new process for zero-downtime restarts.
+ * The running process serves its listener on a Unix domain socket. A new process calls &l:ListenerHandoff::takeOver ();,
+ * receives the listener handle with `SCM_RIGHTS` and starts accepting on the very same socket, so the port is never
+ * closed and no connection is refused. The old process then stops accepting without closing the shared socket and
+ * drains with its usual stop sequence.
+ */
+class ListenerHandoff {
+private:
+  oatpp::String m_path;
+  std::shared_ptr<ListenerConnectionProvider> m_connectionProvider;
+  std::shared_ptr<StopSignal> m_stopSignal;
+  StopSignal m_closeSignal;
+  int m_serverHandle;
+  std::atomic<bool> m_handedOff;
+  std::thread m_thread;
+private:
+  void serve();
+  bool handOff(int channelHandle);
+public:
+
+  /**
+   * Constructor. Starts serving the listener of the connection provider on the Unix domain socket `path`.
+   * Once a new process took the listener over, the connection provider is detached and `stopSignal` is signaled.
+   * @param path - path of the Unix domain socket.
+   * @param connectionProvider - connection provider which listener is handed over.
+   * @param stopSignal - signaled after the handoff.
+   */
+  ListenerHandoff(const oatpp::String& path,
+                  const std::shared_ptr<ListenerConnectionProvider>& connectionProvider,
+                  const std::shared_ptr<StopSignal>& stopSignal);
+
+  /**
+   * Destructor. Stops serving and removes the Unix domain socket.
+   */
+  ~ListenerHandoff();
+
+  /**
+   * Check if the listener was handed over to another process.
+   * @return - `true` if handed over.
+   */
+  bool isHandedOff() const;
+
+  /**
+   * Take the listener over from a running process.
+   * When this method returns, the new connection provider already owns the listener and the old process stops accepting.
+   * Connections arriving in between wait in the listen backlog.
+   * @param path - path of the Unix domain socket.
+   * @return - connection provider on the received listener or `nullptr` if no process serves its listener on `path`.
+   */
+  static std::shared_ptr<ListenerConnectionProvider> takeOver(const oatpp::String& path);
+
+};
+
+#endif /* ListenerHandoff_hpp */
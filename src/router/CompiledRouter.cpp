@@ -0,0 +1,494 @@
+#include "CompiledRouter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+constexpr v_int32 CompiledRouter::MAX_PARAMS;
+
+namespace {
+
+/* Displacements tried per bucket before the table is doubled */
+constexpr v_uint32 DISPLACEMENTS_PER_BUCKET = 1 << 16;
+
+/* Table may grow up to this many slots per key */
+constexpr v_uint32 MAX_SLOTS_PER_KEY = 8;
+
+/* Average number of keys per bucket of the first level */
+constexpr v_uint32 KEYS_PER_BUCKET = 4;
+
+/* FNV-1a of the segment - computed once per lookup, both levels of the perfect hash are derived from it */
+v_uint32 hashSegment(const char* data, v_buff_size size) {
+  v_uint32 hash = 2166136261u;
+  for(v_buff_size i = 0; i < size; i ++) {
+    hash ^= (v_uint8) data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/* murmur3 finalizer of the hash and a seed - FNV alone leaves the low bits badly mixed for short keys */
+v_uint32 mix(v_uint32 hash, v_uint32 seed) {
+  hash ^= seed * 0x9e3779b9u;
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6bu;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35u;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+v_uint32 nextPowerOfTwo(v_uint32 value) {
+  v_uint32 result = 1;
+  while(result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+enum class SegmentType {
+  LITERAL,
+  PARAM,
+  WILDCARD
+};
+
+struct Segment {
+  SegmentType type;
+  std::string text;
+};
+
+/**
+ * Split a pattern into whole segments.
+ * @return - `false` if the pattern can't be compiled.
+ */
+bool parsePattern(const oatpp::String& pattern, std::vector<Segment>& segments) {
+
+  if(!pattern || pattern->empty() || (*pattern)[0] != '/') {
+    return false;
+  }
+
+  /* "/" is a path without segments */
+  if(pattern->size() == 1) {
+    return true;
+  }
+
+  size_t begin = 1;
+  while(true) {
+
+    auto end = pattern->find('/', begin);
+    auto text = pattern->substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+
+    if(text.size() > 2 && text.front() == '{' && text.back() == '}' && text.find_first_of("{}*", 1) == text.size() - 1) {
+      segments.push_back({SegmentType::PARAM, text.substr(1, text.size() - 2)});
+    } else if(text == "*" && end == std::string::npos) {
+      segments.push_back({SegmentType::WILDCARD, text});
+    } else if(text.find_first_of("{}*") == std::string::npos) {
+      segments.push_back({SegmentType::LITERAL, text});
+    } else {
+      return false;
+    }
+
+    if(end == std::string::npos) {
+      return true;
+    }
+    begin = end + 1;
+
+  }
+
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CompiledRouter::RequestInterceptor
+
+CompiledRouter::RequestInterceptor::RequestInterceptor(const std::shared_ptr<CompiledRouter>& router)
+  : m_router(router)
+{}
+
+std::shared_ptr<CompiledRouter::RequestInterceptor::OutgoingResponse>
+CompiledRouter::RequestInterceptor::intercept(const std::shared_ptr<IncomingRequest>& request) {
+
+  auto route = m_router->findRoute(request->getStartingLine().method, request->getStartingLine().path);
+  if(!route) {
+    return nullptr; // stock router decides - its own patterns or 404
+  }
+
+  request->setPathVariables(route.getMatchMap());
+  return route.getEndpoint()->handle(request);
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// CompiledRouter
+
+CompiledRouter::CompiledRouter()
+  : m_frozen(false)
+{}
+
+std::shared_ptr<CompiledRouter> CompiledRouter::createShared() {
+  return std::make_shared<CompiledRouter>();
+}
+
+void CompiledRouter::route(const oatpp::String& method, const oatpp::String& pathPattern, const Handler& handler) {
+  HttpRouter::route(method, pathPattern, handler);
+  if(!isFrozen()) {
+    m_registrations.push_back({method, pathPattern, handler});
+  }
+}
+
+void CompiledRouter::route(const std::shared_ptr<oatpp::web::server::api::Endpoint>& endpoint) {
+  route(endpoint->info()->method, endpoint->info()->path, endpoint->handler);
+}
+
+void CompiledRouter::route(const oatpp::web::server::api::Endpoints& endpoints) {
+  for(auto& endpoint : endpoints.list) {
+    route(endpoint);
+  }
+}
+
+std::shared_ptr<oatpp::web::server::api::ApiController>
+CompiledRouter::addController(const std::shared_ptr<oatpp::web::server::api::ApiController>& controller) {
+  /* The stock router keeps the controller alive - its endpoint handlers don't */
+  auto result = HttpRouter::addController(controller);
+  if(!isFrozen()) {
+    for(auto& endpoint : controller->getEndpoints().list) {
+      m_registrations.push_back({endpoint->info()->method, endpoint->info()->path, endpoint->handler});
+    }
+  }
+  return result;
+}
+
+void CompiledRouter::compile(const oatpp::String& method, const oatpp::String& pathPattern, const Handler& handler) {
+
+  std::vector<Segment> segments;
+  if(!parsePattern(pathPattern, segments)) {
+    OATPP_LOGW("CompiledRouter", "'%s %s' is not made of whole segments - left to the stock router",
+               method->c_str(), pathPattern->c_str());
+    return;
+  }
+
+  Route route;
+  route.handler = handler;
+  route.pattern = pathPattern;
+  for(auto& segment : segments) {
+    if(segment.type == SegmentType::PARAM) {
+      route.paramNames.push_back(StringKeyLabel(oatpp::String(segment.text)));
+    }
+  }
+
+  if(route.paramNames.size() > (size_t) MAX_PARAMS) {
+    OATPP_LOGW("CompiledRouter", "'%s %s' has more than %d parameters - left to the stock router",
+               method->c_str(), pathPattern->c_str(), MAX_PARAMS);
+    return;
+  }
+
+  m_routes.push_back(route);
+  insert(method, (v_int32) m_routes.size() - 1);
+
+}
+
+void CompiledRouter::insert(const oatpp::String& method, v_int32 routeIndex) {
+
+  v_int32 node = -1;
+  for(auto& tree : m_trees) {
+    if(tree.method == *method) {
+      node = tree.root;
+    }
+  }
+  if(node < 0) {
+    m_nodes.push_back(Node());
+    node = (v_int32) m_nodes.size() - 1;
+    m_trees.push_back({*method, node});
+  }
+
+  std::vector<Segment> segments;
+  parsePattern(m_routes[routeIndex].pattern, segments);
+
+  for(auto& segment : segments) {
+
+    v_int32 next = -1;
+
+    switch(segment.type) {
+
+      case SegmentType::LITERAL: {
+        auto& literals = m_nodes[node].literals;
+        for(size_t i = 0; i < literals.size(); i ++) {
+          if(literals[i] == segment.text) {
+            next = m_nodes[node].literalChildren[i];
+          }
+        }
+        if(next < 0) {
+          m_nodes.push_back(Node());
+          next = (v_int32) m_nodes.size() - 1;
+          m_nodes[node].literals.push_back(segment.text);
+          m_nodes[node].literalChildren.push_back(next);
+        }
+        break;
+      }
+
+      case SegmentType::PARAM: {
+        if(m_nodes[node].paramChild < 0) {
+          m_nodes.push_back(Node());
+          m_nodes[node].paramChild = (v_int32) m_nodes.size() - 1;
+        }
+        next = m_nodes[node].paramChild;
+        break;
+      }
+
+      case SegmentType::WILDCARD: {
+        if(m_nodes[node].wildcardRoute < 0) {
+          m_nodes[node].wildcardRoute = routeIndex;
+        } else {
+          OATPP_LOGW("CompiledRouter", "'%s %s' is shadowed by '%s'", method->c_str(),
+                     m_routes[routeIndex].pattern->c_str(), m_routes[m_nodes[node].wildcardRoute].pattern->c_str());
+        }
+        return;
+      }
+
+    }
+
+    node = next;
+
+  }
+
+  /* First registered wins - same as the stock router */
+  if(m_nodes[node].route < 0) {
+    m_nodes[node].route = routeIndex;
+  } else {
+    OATPP_LOGW("CompiledRouter", "'%s %s' is shadowed by '%s'", method->c_str(),
+               m_routes[routeIndex].pattern->c_str(), m_routes[m_nodes[node].route].pattern->c_str());
+  }
+
+}
+
+void CompiledRouter::hashLiterals(Node& node) {
+
+  /*
+   * Hash and displace: keys are split into buckets by the first-level hash; each bucket, biggest first, gets
+   * the first displacement which puts all of its keys into free slots of the second level.
+   */
+
+  auto count = (v_uint32) node.literals.size();
+  if(count == 0) {
+    return;
+  }
+
+  std::vector<v_uint32> hashes;
+  for(auto& literal : node.literals) {
+    hashes.push_back(hashSegment(literal.data(), (v_buff_size) literal.size()));
+  }
+
+  auto bucketsCount = nextPowerOfTwo((count + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET);
+  std::vector<std::vector<v_uint32>> buckets(bucketsCount);
+  for(v_uint32 i = 0; i < count; i ++) {
+    buckets[mix(hashes[i], 0) & (bucketsCount - 1)].push_back(i);
+  }
+
+  std::vector<v_uint32> order;
+  for(v_uint32 b = 0; b < bucketsCount; b ++) {
+    order.push_back(b);
+  }
+  std::stable_sort(order.begin(), order.end(), [&buckets](v_uint32 a, v_uint32 b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+
+  for(auto size = nextPowerOfTwo(count); size <= nextPowerOfTwo(count) * MAX_SLOTS_PER_KEY; size <<= 1) {
+
+    node.slots.assign(size, -1);
+    node.displacements.assign(bucketsCount, 0);
+    bool placed = true;
+
+    for(auto b : order) {
+
+      auto& bucket = buckets[b];
+      if(bucket.empty()) {
+        break;
+      }
+
+      placed = false;
+      std::vector<v_uint32> taken;
+      for(v_uint32 d = 1; d <= DISPLACEMENTS_PER_BUCKET && !placed; d ++) {
+        placed = true;
+        taken.clear();
+        for(size_t k = 0; k < bucket.size() && placed; k ++) {
+          auto slot = mix(hashes[bucket[k]], d) & (size - 1);
+          if(node.slots[slot] >= 0) {
+            placed = false;
+          } else {
+            node.slots[slot] = (v_int32) bucket[k];
+            taken.push_back(slot);
+          }
+        }
+        if(placed) {
+          node.displacements[b] = d;
+        } else {
+          for(auto slot : taken) {
+            node.slots[slot] = -1;
+          }
+        }
+      }
+
+      if(!placed) {
+        break;
+      }
+
+    }
+
+    if(placed) {
+      node.mask = size - 1;
+      node.bucketMask = bucketsCount - 1;
+      return;
+    }
+
+  }
+
+  throw std::runtime_error("[CompiledRouter::hashLiterals()]: Error. Can't build a perfect hash of the path segments.");
+
+}
+
+void CompiledRouter::freeze() {
+
+  if(isFrozen()) {
+    return;
+  }
+
+  for(auto& registration : m_registrations) {
+    compile(registration.method, registration.pathPattern, registration.handler);
+  }
+  m_registrations.clear();
+
+  /* Endpoints added through a HttpRouter pointer can't be listed - a method without compiled routes gives them away */
+  for(auto& branch : m_branchMap) {
+    auto method = branch.first.toString();
+    bool compiled = false;
+    for(auto& tree : m_trees) {
+      compiled = compiled || tree.method == *method;
+    }
+    if(!compiled) {
+      OATPP_LOGW("CompiledRouter", "%s endpoints were not added through CompiledRouter - left to the stock router",
+                 method->c_str());
+    }
+  }
+
+  for(auto& node : m_nodes) {
+    hashLiterals(node);
+  }
+
+  m_frozen.store(true, std::memory_order_release);
+
+}
+
+bool CompiledRouter::isFrozen() const {
+  return m_frozen.load(std::memory_order_acquire);
+}
+
+v_int32 CompiledRouter::findLiteral(const Node& node, const char* data, v_buff_size size) const {
+  if(node.slots.empty()) {
+    return -1;
+  }
+  auto hash = hashSegment(data, size);
+  auto index = node.slots[mix(hash, node.displacements[mix(hash, 0) & node.bucketMask]) & node.mask];
+  if(index < 0) {
+    return -1;
+  }
+  auto& literal = node.literals[index];
+  if((v_buff_size) literal.size() != size || std::memcmp(literal.data(), data, (size_t) size) != 0) {
+    return -1;
+  }
+  return node.literalChildren[index];
+}
+
+const CompiledRouter::Route* CompiledRouter::match(v_int32 nodeIndex, const char* segment, const char* end, Captures& captures) const {
+
+  auto& node = m_nodes[nodeIndex];
+
+  /* No segments left */
+  if(segment == nullptr) {
+    return node.route >= 0 ? &m_routes[node.route] : nullptr;
+  }
+
+  auto slash = (const char*) std::memchr(segment, '/', (size_t) (end - segment));
+  auto segmentEnd = slash != nullptr ? slash : end;
+  auto next = slash != nullptr ? slash + 1 : nullptr;
+
+  auto literalChild = findLiteral(node, segment, segmentEnd - segment);
+  if(literalChild >= 0) {
+    if(auto route = match(literalChild, next, end, captures)) {
+      return route;
+    }
+  }
+
+  if(node.paramChild >= 0 && segmentEnd > segment && captures.count < MAX_PARAMS) {
+    captures.values[captures.count ++] = {segment, segmentEnd - segment};
+    if(auto route = match(node.paramChild, next, end, captures)) {
+      return route;
+    }
+    captures.count --;
+  }
+
+  if(node.wildcardRoute >= 0) {
+    captures.tail = {segment, end - segment};
+    return &m_routes[node.wildcardRoute];
+  }
+
+  return nullptr;
+
+}
+
+const CompiledRouter::Route* CompiledRouter::lookup(const StringKeyLabel& method, const StringKeyLabel& path, Captures& captures) const {
+
+  captures.count = 0;
+  captures.tail = {nullptr, 0};
+
+  if(!isFrozen()) {
+    return nullptr;
+  }
+
+  auto data = (const char*) path.getData();
+  auto size = path.getSize();
+  if(data == nullptr || size == 0 || data[0] != '/') {
+    return nullptr;
+  }
+
+  auto query = (const char*) std::memchr(data, '?', (size_t) size);
+  auto end = query != nullptr ? query : data + size;
+
+  for(auto& tree : m_trees) {
+    if((v_buff_size) tree.method.size() == method.getSize() &&
+       std::memcmp(tree.method.data(), method.getData(), tree.method.size()) == 0)
+    {
+      /* "/" has no segments */
+      return match(tree.root, end - data > 1 ? data + 1 : nullptr, end, captures);
+    }
+  }
+
+  return nullptr;
+
+}
+
+CompiledRouter::BranchRouter::Route CompiledRouter::findRoute(const StringKeyLabel& method, const StringKeyLabel& path) const {
+
+  Captures captures;
+  auto route = lookup(method, path, captures);
+  if(route == nullptr) {
+    return BranchRouter::Route();
+  }
+
+  oatpp::web::url::mapping::Pattern::MatchMap::Variables variables;
+  for(v_int32 i = 0; i < captures.count; i ++) {
+    variables[route->paramNames[i]] = StringKeyLabel(path.getMemoryHandle(), captures.values[i].data, captures.values[i].size);
+  }
+
+  StringKeyLabel tail;
+  if(captures.tail.data != nullptr) {
+    tail = StringKeyLabel(path.getMemoryHandle(), captures.tail.data, captures.tail.size);
+  }
+
+  return BranchRouter::Route(route->handler, oatpp::web::url::mapping::Pattern::MatchMap(variables, tail));
+
+}
+
+v_int32 CompiledRouter::getCompiledRoutesCount() const {
+  return (v_int32) m_routes.size();
+}
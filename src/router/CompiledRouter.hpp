@@ -0,0 +1,226 @@
+#ifndef CompiledRouter_hpp
+#define CompiledRouter_hpp
+
+#include "oatpp/web/server/HttpRouter.hpp"
+#include "oatpp/web/server/interceptor/RequestInterceptor.hpp"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * `HttpRouter` which, once &l:CompiledRouter::freeze (); is called, resolves routes in a radix trie of path segments
+ * instead of matching the patterns of a method one by one.
+ * Literal segments of a trie node are found with a perfect hash (hash and displace - one pass over the segment, one
+ * compare), then a `{param}` child and then a trailing `*` are tried. A literal segment takes precedence over a parameter, whatever the order of registration.
+ * Parameters are captured as pointers into the request path (&l:CompiledRouter::Captures;) - the lookup doesn't allocate.
+ *
+ * Endpoints are added through this class (&l:CompiledRouter::route (); / &l:CompiledRouter::addController ();) - they
+ * go to the stock router and are recorded, and `freeze()` compiles the recorded ones in the order of registration.
+ * `HttpRouter` methods are not virtual, so endpoints added through a `HttpRouter` pointer reach the stock router only
+ * (`freeze()` warns about methods it has seen no endpoints of). Patterns which can't be compiled are left to the stock
+ * router with a warning, as are all requests before `freeze()` and endpoints added after it.
+ * The compiled table is used by connection handlers via &l:CompiledRouter::RequestInterceptor;, which must be their last
+ * request interceptor.
+ */
+class CompiledRouter : public oatpp::web::server::HttpRouter {
+public:
+  typedef oatpp::data::share::StringKeyLabel StringKeyLabel;
+  typedef std::shared_ptr<oatpp::web::server::HttpRequestHandler> Handler;
+public:
+
+  /**
+   * Max number of parameters in a compiled pattern. Patterns with more are left to the stock router.
+   */
+  static constexpr v_int32 MAX_PARAMS = 16;
+
+public:
+
+  /**
+   * Compiled route.
+   */
+  struct Route {
+
+    /**
+     * Endpoint handler.
+     */
+    Handler handler;
+
+    /**
+     * Path pattern as registered.
+     */
+    oatpp::String pattern;
+
+    /**
+     * Names of the parameters in the order of the pattern.
+     */
+    std::vector<StringKeyLabel> paramNames;
+
+  };
+
+  /**
+   * Values captured by a lookup. They point into the looked up path.
+   */
+  struct Captures {
+
+    struct Value {
+      const char* data;
+      v_buff_size size;
+    };
+
+    /**
+     * Number of captured parameters.
+     */
+    v_int32 count;
+
+    /**
+     * Parameter values, in the order of &l:CompiledRouter::Route::paramNames;.
+     */
+    Value values[MAX_PARAMS];
+
+    /**
+     * Rest of the path matched by a trailing `*`. `nullptr` if the route has none.
+     */
+    Value tail;
+
+  };
+
+  /**
+   * Resolves the request with the compiled table and calls the endpoint. Passes the request on to the stock router
+   * when the router is not frozen or no compiled route matches.
+   */
+  class RequestInterceptor : public oatpp::web::server::interceptor::RequestInterceptor {
+  private:
+    std::shared_ptr<CompiledRouter> m_router;
+  public:
+    RequestInterceptor(const std::shared_ptr<CompiledRouter>& router);
+    std::shared_ptr<OutgoingResponse> intercept(const std::shared_ptr<IncomingRequest>& request) override;
+  };
+
+private:
+
+  /**
+   * Trie node. Children are indexes into `m_nodes`.
+   */
+  struct Node {
+
+    std::vector<std::string> literals;
+    std::vector<v_int32> literalChildren;
+
+    /* Perfect hash of `literals` - displacement per first-level bucket, slot -> index in `literals` or -1 */
+    std::vector<v_uint32> displacements;
+    v_uint32 bucketMask = 0;
+    std::vector<v_int32> slots;
+    v_uint32 mask = 0;
+
+    v_int32 paramChild = -1;
+    v_int32 route = -1;
+    v_int32 wildcardRoute = -1;
+
+  };
+
+  struct Tree {
+    std::string method;
+    v_int32 root;
+  };
+
+  /**
+   * Endpoint added through this class, compiled by `freeze()`.
+   */
+  struct Registration {
+    oatpp::String method;
+    oatpp::String pathPattern;
+    Handler handler;
+  };
+
+private:
+  std::vector<Registration> m_registrations;
+  std::vector<Route> m_routes;
+  std::vector<Node> m_nodes;
+  std::vector<Tree> m_trees;
+  std::atomic<bool> m_frozen;
+private:
+  void compile(const oatpp::String& method, const oatpp::String& pathPattern, const Handler& handler);
+  void insert(const oatpp::String& method, v_int32 routeIndex);
+  void hashLiterals(Node& node);
+  v_int32 findLiteral(const Node& node, const char* data, v_buff_size size) const;
+  const Route* match(v_int32 nodeIndex, const char* segment, const char* end, Captures& captures) const;
+public:
+
+  /**
+   * Constructor.
+   */
+  CompiledRouter();
+
+  /**
+   * Create shared CompiledRouter.
+   * @return - `std::shared_ptr` to CompiledRouter.
+   */
+  static std::shared_ptr<CompiledRouter> createShared();
+
+  /**
+   * Add endpoint to the stock router and, if not frozen yet, record it for `freeze()`.
+   * @param method - HTTP method.
+   * @param pathPattern - path pattern, segments are literals, `{name}` or a trailing `*`.
+   * @param handler - endpoint handler.
+   */
+  void route(const oatpp::String& method, const oatpp::String& pathPattern, const Handler& handler);
+
+  /**
+   * Add endpoint to the stock router and record it for `freeze()`.
+   * @param endpoint
+   */
+  void route(const std::shared_ptr<oatpp::web::server::api::Endpoint>& endpoint);
+
+  /**
+   * Add endpoints to the stock router and record them for `freeze()`.
+   * @param endpoints
+   */
+  void route(const oatpp::web::server::api::Endpoints& endpoints);
+
+  /**
+   * Add all endpoints of the controller to the stock router and record them for `freeze()`.
+   * @param controller
+   * @return - the controller.
+   */
+  std::shared_ptr<oatpp::web::server::api::ApiController> addController(const std::shared_ptr<oatpp::web::server::api::ApiController>& controller);
+
+  /**
+   * Compile the recorded endpoints. Call once all controllers are added, before the server is started -
+   * &l:AppComponent::warmUp (); does. Repeated calls do nothing.
+   */
+  void freeze();
+
+  /**
+   * Check if the router is frozen.
+   * @return
+   */
+  bool isFrozen() const;
+
+  /**
+   * Find the route of a request. Doesn't allocate. Returns `nullptr` if the router is not frozen.
+   * @param method - HTTP method.
+   * @param path - request path, a query is ignored.
+   * @param captures - filled with the parameters of the route found.
+   * @return - route or `nullptr`.
+   */
+  const Route* lookup(const StringKeyLabel& method, const StringKeyLabel& path, Captures& captures) const;
+
+  /**
+   * Find the route of a request as the stock `getRoute()` returns it - parameters in a MatchMap which refers to the
+   * memory of `path`.
+   * @param method - HTTP method.
+   * @param path - request path, a query is ignored.
+   * @return - route, invalid if not found in the compiled table.
+   */
+  BranchRouter::Route findRoute(const StringKeyLabel& method, const StringKeyLabel& path) const;
+
+  /**
+   * Get number of compiled routes.
+   * @return
+   */
+  v_int32 getCompiledRoutesCount() const;
+
+};
+
+#endif /* CompiledRouter_hpp */
@@ -0,0 +1,265 @@
+#include "FileBody.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace {
+
+/* Max bytes passed to one sendfile/splice call */
+constexpr v_int64 MAX_SEND_SIZE = 1024 * 1024 * 1024;
+
+/**
+ * Parse a single range of `Range: bytes=...` against the size of the file.
+ * @return - `1` if satisfiable (first/last filled), `0` if unsatisfiable, `-1` if the header is to be ignored.
+ */
+v_int32 parseRange(const oatpp::String& header, v_int64 fileSize, v_int64& first, v_int64& last) {
+
+  static const char prefix[] = "bytes=";
+  if(!header || header->compare(0, sizeof(prefix) - 1, prefix) != 0 || header->find(',') != std::string::npos) {
+    return -1;
+  }
+
+  const char* spec = header->c_str() + sizeof(prefix) - 1;
+  const char* dash = std::strchr(spec, '-');
+  if(dash == nullptr) {
+    return -1;
+  }
+
+  char* end;
+  if(dash == spec) {
+    /* bytes=-suffix */
+    auto suffix = std::strtoll(dash + 1, &end, 10);
+    if(end == dash + 1 || *end != 0 || suffix < 0) {
+      return -1;
+    }
+    if(suffix == 0 || fileSize == 0) {
+      return 0;
+    }
+    first = std::max<v_int64>(fileSize - suffix, 0);
+    last = fileSize - 1;
+    return 1;
+  }
+
+  first = std::strtoll(spec, &end, 10);
+  if(end != dash || first < 0) {
+    return -1;
+  }
+
+  if(*(dash + 1) == 0) {
+    last = fileSize - 1;
+  } else {
+    last = std::strtoll(dash + 1, &end, 10);
+    if(*end != 0 || last < first) {
+      return -1;
+    }
+    last = std::min(last, fileSize - 1);
+  }
+
+  return first < fileSize ? 1 : 0;
+
+}
+
+bool waitWritable(oatpp::v_io_handle socketHandle) {
+  /* A blocking socket reports EAGAIN only when its SO_SNDTIMEO expired - the client stopped reading */
+  if((::fcntl(socketHandle, F_GETFL) & O_NONBLOCK) == 0) {
+    return false;
+  }
+  pollfd handle = {socketHandle, POLLOUT, 0};
+  return ::poll(&handle, 1, -1) > 0;
+}
+
+}
+
+FileBody::FileBody(int handle, bool seekable, v_int64 offset, v_int64 size, const oatpp::String& contentType)
+  : m_handle(handle)
+  , m_seekable(seekable)
+  , m_offset(offset)
+  , m_size(size)
+  , m_position(0)
+  , m_contentType(contentType)
+{}
+
+FileBody::~FileBody() {
+  if(m_handle >= 0) {
+    ::close(m_handle);
+  }
+}
+
+std::shared_ptr<FileBody> FileBody::openFile(const oatpp::String& path, v_int64 offset, v_int64 size, const oatpp::String& contentType) {
+
+  int handle = ::open(path->c_str(), O_RDONLY | O_CLOEXEC);
+  if(handle < 0) {
+    return nullptr;
+  }
+
+  struct stat info;
+  if(::fstat(handle, &info) != 0 || !S_ISREG(info.st_mode) || offset < 0 || offset > (v_int64) info.st_size) {
+    ::close(handle);
+    return nullptr;
+  }
+
+  v_int64 available = (v_int64) info.st_size - offset;
+  if(size < 0 || size > available) {
+    size = available;
+  }
+
+  return std::make_shared<FileBody>(handle, true, offset, size, contentType);
+
+}
+
+std::shared_ptr<FileBody> FileBody::fromPipe(int handle, v_int64 size, const oatpp::String& contentType) {
+  return std::make_shared<FileBody>(handle, false, 0, size, contentType);
+}
+
+std::shared_ptr<FileBody::OutgoingResponse> FileBody::createResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                                     const oatpp::String& path,
+                                                                     const oatpp::String& contentType)
+{
+
+  auto body = openFile(path, 0, -1, contentType);
+  if(!body) {
+    return OutgoingResponse::createShared(Status::CODE_404, nullptr);
+  }
+
+  auto fileSize = body->m_size;
+  v_int64 first;
+  v_int64 last;
+
+  switch(parseRange(request->getHeader("Range"), fileSize, first, last)) {
+
+    case 1: {
+      body->m_offset = first;
+      body->m_size = last - first + 1;
+      auto response = OutgoingResponse::createShared(Status::CODE_206, body);
+      response->putHeader("Content-Range", "bytes " + std::to_string(first) + "-" + std::to_string(last) + "/" + std::to_string(fileSize));
+      response->putHeader("Accept-Ranges", "bytes");
+      return response;
+    }
+
+    case 0: {
+      auto response = OutgoingResponse::createShared(Status::CODE_416, nullptr);
+      response->putHeader("Content-Range", "bytes */" + std::to_string(fileSize));
+      return response;
+    }
+
+    default: {
+      auto response = OutgoingResponse::createShared(Status::CODE_200, body);
+      response->putHeader("Accept-Ranges", "bytes");
+      return response;
+    }
+
+  }
+
+}
+
+oatpp::v_io_size FileBody::read(void *buffer, v_buff_size count, oatpp::async::Action& action) {
+
+  (void) action;
+
+  auto left = m_size - m_position;
+  if(left <= 0) {
+    return 0;
+  }
+  if(count > left) {
+    count = (v_buff_size) left;
+  }
+
+  ssize_t res;
+  do {
+    res = m_seekable ? ::pread(m_handle, buffer, (size_t) count, (off_t) (m_offset + m_position))
+                     : ::read(m_handle, buffer, (size_t) count);
+  } while(res < 0 && errno == EINTR);
+
+  /* Shorter than promised in Content-Length - the connection has to be closed */
+  if(res <= 0) {
+    return oatpp::IOError::BROKEN_PIPE;
+  }
+
+  m_position += res;
+  return res;
+
+}
+
+bool FileBody::sendTo(oatpp::v_io_handle socketHandle) {
+
+  while(m_position < m_size) {
+
+    auto count = std::min(m_size - m_position, MAX_SEND_SIZE);
+    ssize_t res;
+
+#if defined(__linux__)
+    if(m_seekable) {
+      off_t offset = (off_t) (m_offset + m_position);
+      res = ::sendfile(socketHandle, m_handle, &offset, (size_t) count);
+    } else {
+      res = ::splice(m_handle, nullptr, socketHandle, nullptr, (size_t) count, SPLICE_F_MOVE | SPLICE_F_MORE);
+    }
+#else
+    /* No zero-copy primitive - read a chunk at the current position and send what the socket takes */
+    char buffer[64 * 1024];
+    count = std::min<v_int64>(count, sizeof(buffer));
+    res = m_seekable ? ::pread(m_handle, buffer, (size_t) count, (off_t) (m_offset + m_position))
+                     : ::read(m_handle, buffer, (size_t) count);
+    for(ssize_t sent = 0; res > 0 && sent < res;) {
+      auto chunk = ::send(socketHandle, buffer + sent, (size_t) (res - sent), MSG_NOSIGNAL);
+      if(chunk > 0) {
+        sent += chunk;
+      } else if(chunk < 0 && (errno == EINTR || ((errno == EAGAIN || errno == EWOULDBLOCK) && waitWritable(socketHandle)))) {
+        continue;
+      } else {
+        return false;
+      }
+    }
+#endif
+
+    if(res > 0) {
+      m_position += res;
+      continue;
+    }
+
+    if(res < 0 && errno == EINTR) {
+      continue;
+    }
+
+    if(res < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && waitWritable(socketHandle)) {
+      continue;
+    }
+
+    /* Error, or end of file/pipe before the promised size */
+    return false;
+
+  }
+
+  return true;
+
+}
+
+void FileBody::declareHeaders(Headers& headers) {
+  if(m_contentType) {
+    headers.putIfNotExists(oatpp::web::protocol::http::Header::CONTENT_TYPE, m_contentType);
+  }
+}
+
+p_char8 FileBody::getKnownData() {
+  return nullptr;
+}
+
+v_int64 FileBody::getKnownSize() {
+  return m_size;
+}
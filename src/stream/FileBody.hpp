@@ -0,0 +1,107 @@
+#ifndef FileBody_hpp
+#define FileBody_hpp
+
+#include "oatpp/web/protocol/http/incoming/Request.hpp"
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/web/protocol/http/outgoing/Body.hpp"
+
+/**
+ * Body of a known size read from a file descriptor - a range of a file or a pipe.
+ * Connection handlers which write to a socket themselves (&l:ParkingConnectionHandler;) send it with
+ * &l:FileBody::sendTo (); - `sendfile` for files and `splice` for pipes on Linux, so the bytes go from the page cache
+ * (or the pipe) to the socket without being copied to user space.
+ * Everywhere else - `HttpConnectionHandler`, the virtual transport, content encoding - the body is read through
+ * &l:FileBody::read (); like any other body (`pread`/`read` into the transfer buffer).
+ * The body owns the descriptor and closes it.
+ */
+class FileBody : public oatpp::web::protocol::http::outgoing::Body {
+public:
+  typedef oatpp::web::protocol::http::Status Status;
+  typedef oatpp::web::protocol::http::incoming::Request IncomingRequest;
+  typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+private:
+  int m_handle;
+  bool m_seekable;
+  v_int64 m_offset;
+  v_int64 m_size;
+  v_int64 m_position;
+  oatpp::String m_contentType;
+public:
+
+  /**
+   * Constructor. Takes ownership of the descriptor.
+   * @param handle - file or pipe descriptor.
+   * @param seekable - `true` for a file (read with `pread` from `offset`), `false` for a pipe (read sequentially).
+   * @param offset - first byte of a file. Ignored for pipes.
+   * @param size - number of bytes to send.
+   * @param contentType - `Content-Type`, may be `nullptr`.
+   */
+  FileBody(int handle, bool seekable, v_int64 offset, v_int64 size, const oatpp::String& contentType);
+
+  /**
+   * Non-virtual Destructor. Closes the descriptor.
+   */
+  ~FileBody() override;
+
+  /**
+   * Open a range of a file.
+   * @param path - file path.
+   * @param offset - first byte.
+   * @param size - number of bytes, `-1` - up to the end of the file.
+   * @param contentType - `Content-Type`, may be `nullptr`.
+   * @return - body, `nullptr` if the file can't be opened or the range is outside of it.
+   */
+  static std::shared_ptr<FileBody> openFile(const oatpp::String& path, v_int64 offset, v_int64 size, const oatpp::String& contentType);
+
+  /**
+   * Body read from a pipe. The writer must write exactly `size` bytes - the length is sent in `Content-Length`.
+   * @param handle - read end of the pipe. Ownership is taken.
+   * @param size - number of bytes.
+   * @param contentType - `Content-Type`, may be `nullptr`.
+   * @return - body.
+   */
+  static std::shared_ptr<FileBody> fromPipe(int handle, v_int64 size, const oatpp::String& contentType);
+
+  /**
+   * Controller helper - respond with a file, honoring a single-range `Range` header.
+   * Gives `200` with the whole file, `206` with `Content-Range` for a satisfiable range (`bytes=first-last`,
+   * `bytes=first-`, `bytes=-suffix`), `416` for an unsatisfiable one and `404` if the file can't be opened.
+   * Other `Range` forms (several ranges, other units) are ignored and the whole file is sent.
+   * @param request - incoming request.
+   * @param path - file path.
+   * @param contentType - `Content-Type` of the file.
+   * @return - response.
+   */
+  static std::shared_ptr<OutgoingResponse> createResponse(const std::shared_ptr<IncomingRequest>& request,
+                                                          const oatpp::String& path,
+                                                          const oatpp::String& contentType);
+
+  /**
+   * Read the next part of the body - buffered path.
+   * @param buffer
+   * @param count
+   * @param action
+   * @return - bytes read, `0` at the end of the body, `oatpp::IOError::BROKEN_PIPE` on error.
+   */
+  oatpp::v_io_size read(void *buffer, v_buff_size count, oatpp::async::Action& action) override;
+
+  /**
+   * Send the rest of the body to a socket - zero-copy path. Blocks until everything is sent.
+   * @param socketHandle - connected socket.
+   * @return - `true` if the whole body was sent.
+   */
+  bool sendTo(oatpp::v_io_handle socketHandle);
+
+  void declareHeaders(Headers& headers) override;
+
+  /**
+   * Data is not in memory.
+   * @return - `nullptr`.
+   */
+  p_char8 getKnownData() override;
+
+  v_int64 getKnownSize() override;
+
+};
+
+#endif /* FileBody_hpp */
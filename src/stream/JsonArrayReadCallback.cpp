@@ -0,0 +1,95 @@
+#include "JsonArrayReadCallback.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/StreamingBody.hpp"
+
+#include <cstring>
+
+constexpr v_buff_size JsonArrayReadCallback::BATCH_SIZE;
+
+JsonArrayReadCallback::JsonArrayReadCallback(const Generator& generator,
+                                             const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper)
+  : m_generator(generator)
+  , m_objectMapper(objectMapper)
+  , m_buffer(BATCH_SIZE * 2)
+  , m_readPosition(0)
+  , m_started(false)
+  , m_empty(true)
+  , m_finished(false)
+{}
+
+std::shared_ptr<JsonArrayReadCallback> JsonArrayReadCallback::createShared(const Generator& generator,
+                                                                           const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper)
+{
+  return std::make_shared<JsonArrayReadCallback>(generator, objectMapper);
+}
+
+std::shared_ptr<JsonArrayReadCallback::OutgoingResponse> JsonArrayReadCallback::createResponse(const Status& status,
+                                                                                               const Generator& generator,
+                                                                                               const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper)
+{
+  /* StreamingBody has no known size - the response is written with chunked transfer encoding */
+  auto body = std::make_shared<oatpp::web::protocol::http::outgoing::StreamingBody>(createShared(generator, objectMapper));
+  auto response = OutgoingResponse::createShared(status, body);
+  response->putHeader(oatpp::web::protocol::http::Header::CONTENT_TYPE, objectMapper->getInfo().http_content_type);
+  return response;
+}
+
+void JsonArrayReadCallback::fill() {
+
+  /* An element bigger than the batch grows the buffer - don't keep that for the rest of the array */
+  if(m_buffer.getCapacity() > BATCH_SIZE * 4) {
+    m_buffer.reset(BATCH_SIZE * 2);
+  }
+
+  m_buffer.setCurrentPosition(0);
+  m_readPosition = 0;
+
+  if(!m_started) {
+    m_buffer.writeSimple("[", 1);
+    m_started = true;
+  }
+
+  while(m_buffer.getCurrentPosition() < BATCH_SIZE) {
+
+    oatpp::Void element;
+
+    if(!m_generator(element)) {
+      m_buffer.writeSimple("]", 1);
+      m_finished = true;
+      m_generator = nullptr;
+      break;
+    }
+
+    if(!m_empty) {
+      m_buffer.writeSimple(",", 1);
+    }
+    m_empty = false;
+
+    m_objectMapper->write(&m_buffer, element);
+
+  }
+
+}
+
+oatpp::v_io_size JsonArrayReadCallback::read(void *buffer, v_buff_size count, oatpp::async::Action& action) {
+
+  (void) action;
+
+  if(m_readPosition == m_buffer.getCurrentPosition()) {
+    if(m_finished) {
+      return 0;
+    }
+    fill();
+  }
+
+  v_buff_size pending = m_buffer.getCurrentPosition() - m_readPosition;
+  if(count > pending) {
+    count = pending;
+  }
+
+  std::memcpy(buffer, m_buffer.getData() + m_readPosition, count);
+  m_readPosition += count;
+
+  return count;
+
+}
@@ -0,0 +1,106 @@
+#ifndef JsonArrayReadCallback_hpp
+#define JsonArrayReadCallback_hpp
+
+#include "oatpp/web/protocol/http/outgoing/Response.hpp"
+#include "oatpp/core/data/mapping/ObjectMapper.hpp"
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+#include <functional>
+
+/**
+ * Body of a JSON array which is serialized element by element while the connection reads it.
+ * The response is sent with `Transfer-Encoding: chunked`; at most &l:JsonArrayReadCallback::BATCH_SIZE; bytes
+ * (plus one element) are serialized ahead, so memory doesn't grow with the length of the array and the first
+ * bytes go out before the last element is serialized.
+ * Elements come from a &l:JsonArrayReadCallback::Generator; - they can be created lazily, or taken from an existing
+ * collection with &l:JsonArrayReadCallback::iterate;.
+ * Headers are sent before the first element is serialized - if serialization fails, the connection is closed
+ * with an incomplete body.
+ */
+class JsonArrayReadCallback : public oatpp::data::stream::ReadCallback {
+public:
+  typedef oatpp::web::protocol::http::Status Status;
+  typedef oatpp::web::protocol::http::outgoing::Response OutgoingResponse;
+
+  /**
+   * Puts the next element to its argument and returns `true`, or returns `false` after the last one.
+   * A `nullptr` element is an element - it is serialized as `null`.
+   */
+  typedef std::function<bool(oatpp::Void& element)> Generator;
+
+public:
+
+  /**
+   * Elements are serialized until this many bytes are pending.
+   */
+  static constexpr v_buff_size BATCH_SIZE = 4096;
+
+private:
+  Generator m_generator;
+  std::shared_ptr<oatpp::data::mapping::ObjectMapper> m_objectMapper;
+  oatpp::data::stream::BufferOutputStream m_buffer;
+  v_buff_size m_readPosition;
+  bool m_started;
+  bool m_empty;
+  bool m_finished;
+private:
+  void fill();
+public:
+
+  /**
+   * Constructor.
+   * @param generator - &l:JsonArrayReadCallback::Generator;.
+   * @param objectMapper - mapper to serialize elements with.
+   */
+  JsonArrayReadCallback(const Generator& generator, const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper);
+
+  /**
+   * Create shared JsonArrayReadCallback.
+   * @param generator - &l:JsonArrayReadCallback::Generator;.
+   * @param objectMapper - mapper to serialize elements with.
+   * @return - `std::shared_ptr` to JsonArrayReadCallback.
+   */
+  static std::shared_ptr<JsonArrayReadCallback> createShared(const Generator& generator,
+                                                             const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper);
+
+  /**
+   * Create a chunked response streaming the array.
+   * @param status - response status.
+   * @param generator - &l:JsonArrayReadCallback::Generator;.
+   * @param objectMapper - mapper to serialize elements with.
+   * @return - response.
+   */
+  static std::shared_ptr<OutgoingResponse> createResponse(const Status& status,
+                                                          const Generator& generator,
+                                                          const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& objectMapper);
+
+  /**
+   * Generator over an existing collection (`oatpp::List`, `oatpp::Vector`). The collection is kept alive by the generator.
+   * @tparam Collection - collection wrapper type.
+   * @param collection - collection.
+   * @return - &l:JsonArrayReadCallback::Generator;.
+   */
+  template<class Collection>
+  static Generator iterate(const Collection& collection) {
+    auto iterator = collection->begin();
+    return [collection, iterator](oatpp::Void& element) mutable -> bool {
+      if(iterator == collection->end()) {
+        return false;
+      }
+      element = *(iterator ++);
+      return true;
+    };
+  }
+
+  /**
+   * Read the next part of the serialized array.
+   * @param buffer - buffer to read to.
+   * @param count - size of the buffer.
+   * @param action - not used, serialization never waits.
+   * @return - bytes read, `0` at the end of the array.
+   */
+  oatpp::v_io_size read(void *buffer, v_buff_size count, oatpp::async::Action& action) override;
+
+};
+
+#endif /* JsonArrayReadCallback_hpp */
@@ -0,0 +1,146 @@
+#include "ResponseBatchStream.hpp"
+
+#include "memory/BufferPool.hpp"
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+constexpr v_buff_size ResponseBatchStream::DEFAULT_CAPACITY;
+
+ResponseBatchStream::ResponseBatchStream(const std::shared_ptr<oatpp::data::stream::OutputStream>& target,
+                                         oatpp::v_io_handle handle,
+                                         v_buff_size capacity)
+  : m_target(target)
+  , m_handle(handle)
+  , m_capacity(capacity)
+  , m_writeCalls(0)
+{}
+
+bool ResponseBatchStream::send(const void* tail, v_buff_size tailSize) {
+
+  auto pending = getPendingSize();
+
+  if(m_handle < 0) {
+    if(pending > 0) {
+      m_writeCalls ++;
+      if(m_target->writeExactSizeDataSimple(m_buffer->data(), pending) != pending) {
+        return false;
+      }
+      m_buffer->clear();
+    }
+    if(tailSize > 0) {
+      m_writeCalls ++;
+      return m_target->writeExactSizeDataSimple(tail, tailSize) == tailSize;
+    }
+    return true;
+  }
+
+  iovec parts[2];
+  parts[0].iov_base = pending > 0 ? (void*) m_buffer->data() : nullptr;
+  parts[0].iov_len = (size_t) pending;
+  parts[1].iov_base = (void*) tail;
+  parts[1].iov_len = (size_t) tailSize;
+
+  msghdr message = {};
+  message.msg_iov = parts[0].iov_len > 0 ? parts : parts + 1;
+  message.msg_iovlen = parts[0].iov_len > 0 ? 2 : 1;
+
+  while(message.msg_iovlen > 0) {
+
+    m_writeCalls ++;
+    auto res = ::sendmsg(m_handle, &message, MSG_NOSIGNAL);
+
+    if(res < 0) {
+      if(errno == EINTR) {
+        continue;
+      }
+      if(errno == EAGAIN || errno == EWOULDBLOCK) {
+        /* A blocking socket reports it only when its SO_SNDTIMEO expired - the client stopped reading */
+        if((::fcntl(m_handle, F_GETFL) & O_NONBLOCK) == 0) {
+          return false;
+        }
+        /* Non-blocking socket - wait until it drains */
+        pollfd handle = {m_handle, POLLOUT, 0};
+        ::poll(&handle, 1, -1);
+        continue;
+      }
+      return false;
+    }
+
+    /* Partial write - skip what was sent */
+    auto sent = (size_t) res;
+    while(message.msg_iovlen > 0 && sent >= message.msg_iov->iov_len) {
+      sent -= message.msg_iov->iov_len;
+      message.msg_iov ++;
+      message.msg_iovlen --;
+    }
+    if(message.msg_iovlen > 0) {
+      message.msg_iov->iov_base = (v_char8*) message.msg_iov->iov_base + sent;
+      message.msg_iov->iov_len -= sent;
+    }
+
+  }
+
+  if(m_buffer) {
+    m_buffer->clear();
+  }
+  return true;
+
+}
+
+oatpp::v_io_size ResponseBatchStream::write(const void *data, v_buff_size count, oatpp::async::Action& action) {
+
+  (void) action;
+
+  if(getPendingSize() + count <= m_capacity) {
+    if(!m_buffer) {
+      m_buffer = BufferPool::acquire(count);
+      m_buffer->clear();
+    }
+    m_buffer->append((const char*) data, (size_t) count);
+    return count;
+  }
+
+  if(!send(data, count)) {
+    return oatpp::IOError::BROKEN_PIPE;
+  }
+
+  return count;
+
+}
+
+void ResponseBatchStream::setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) {
+  m_target->setOutputStreamIOMode(ioMode);
+}
+
+oatpp::data::stream::IOMode ResponseBatchStream::getOutputStreamIOMode() {
+  return m_target->getOutputStreamIOMode();
+}
+
+oatpp::data::stream::Context& ResponseBatchStream::getOutputStreamContext() {
+  return m_target->getOutputStreamContext();
+}
+
+bool ResponseBatchStream::flush() {
+  return getPendingSize() == 0 || send(nullptr, 0);
+}
+
+void ResponseBatchStream::releaseBuffer() {
+  m_buffer.reset();
+}
+
+v_buff_size ResponseBatchStream::getPendingSize() const {
+  return m_buffer ? (v_buff_size) m_buffer->size() : 0;
+}
+
+v_int64 ResponseBatchStream::getWriteCalls() const {
+  return m_writeCalls;
+}
@@ -0,0 +1,84 @@
+#ifndef ResponseBatchStream_hpp
+#define ResponseBatchStream_hpp
+
+#include "oatpp/core/data/stream/Stream.hpp"
+
+#include <memory>
+#include <string>
+
+/**
+ * Output stream which collects the responses of a connection and sends them with as few syscalls as possible.
+ * Writes are copied into a buffer until &l:ResponseBatchStream::flush (); is called or the next write doesn't fit
+ * into the capacity - then the buffer and the write go out in one `sendmsg` (gather write). Headers and body of a
+ * response, and several pipelined responses, are so sent together.
+ * Without a socket handle (virtual transport) the collected bytes are written to the target stream.
+ * The buffer is taken from &l:BufferPool; on the first write, grows on demand and can be released to the pool between
+ * requests, so idle connections don't hold it.
+ */
+class ResponseBatchStream : public oatpp::data::stream::OutputStream {
+public:
+
+  /**
+   * Default max number of bytes collected before they are sent.
+   */
+  static constexpr v_buff_size DEFAULT_CAPACITY = 64 * 1024;
+
+private:
+  std::shared_ptr<oatpp::data::stream::OutputStream> m_target;
+  oatpp::v_io_handle m_handle;
+  v_buff_size m_capacity;
+  std::shared_ptr<std::string> m_buffer;
+  v_int64 m_writeCalls;
+private:
+  bool send(const void* tail, v_buff_size tailSize);
+public:
+
+  /**
+   * Constructor.
+   * @param target - connection.
+   * @param handle - socket of the connection, `-1` to write to `target`.
+   * @param capacity - max number of bytes collected before they are sent.
+   */
+  ResponseBatchStream(const std::shared_ptr<oatpp::data::stream::OutputStream>& target,
+                      oatpp::v_io_handle handle,
+                      v_buff_size capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Collect data, or send the collected data together with it if it doesn't fit.
+   * @param data
+   * @param count
+   * @param action
+   * @return - `count` or `oatpp::IOError::BROKEN_PIPE`.
+   */
+  oatpp::v_io_size write(const void *data, v_buff_size count, oatpp::async::Action& action) override;
+
+  void setOutputStreamIOMode(oatpp::data::stream::IOMode ioMode) override;
+  oatpp::data::stream::IOMode getOutputStreamIOMode() override;
+  oatpp::data::stream::Context& getOutputStreamContext() override;
+
+  /**
+   * Send the collected data.
+   * @return - `false` if the connection is broken.
+   */
+  bool flush();
+
+  /**
+   * Return the buffer to the pool. Call only when nothing is collected, e.g. after flush().
+   */
+  void releaseBuffer();
+
+  /**
+   * Number of bytes collected and not sent yet.
+   * @return
+   */
+  v_buff_size getPendingSize() const;
+
+  /**
+   * Number of write syscalls (or writes to the target stream) made so far.
+   * @return
+   */
+  v_int64 getWriteCalls() const;
+
+};
+
+#endif /* ResponseBatchStream_hpp */
@@ -0,0 +1,267 @@
+#include "AllocationTelemetry.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+constexpr v_int32 AllocationTelemetry::MAX_TYPES;
+constexpr v_int64 AllocationTelemetry::BATCH_SIZE;
+
+namespace {
+
+/**
+ * Shared totals. Touched only when a thread publishes its batch.
+ */
+class Registry {
+public:
+
+  struct Totals {
+    std::atomic<v_int64> created;
+    std::atomic<v_int64> live;
+    std::atomic<v_int64> peak;
+  };
+
+public:
+  std::mutex mutex;
+  std::vector<std::string> names;
+  Totals totals[AllocationTelemetry::MAX_TYPES];
+public:
+
+  Registry() {
+    for(auto& typeTotals : totals) {
+      typeTotals.created.store(0, std::memory_order_relaxed);
+      typeTotals.live.store(0, std::memory_order_relaxed);
+      typeTotals.peak.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /* Never destroyed - threads may publish after static destructors ran */
+  static Registry& instance() {
+    static Registry* registry = new Registry();
+    return *registry;
+  }
+
+};
+
+/* Set when ThreadCounts of the thread is destroyed - objects destroyed by later TLS destructors are counted directly */
+thread_local bool threadCountsDestroyed = false;
+
+/**
+ * Add changes of a type to the shared totals and raise the peak.
+ */
+void publishTo(v_int32 typeId, v_int64 created, v_int64 live) {
+
+  auto& totals = Registry::instance().totals[typeId];
+
+  if(created != 0) {
+    totals.created.fetch_add(created, std::memory_order_relaxed);
+  }
+
+  if(live != 0) {
+    auto total = totals.live.fetch_add(live, std::memory_order_relaxed) + live;
+    auto peak = totals.peak.load(std::memory_order_relaxed);
+    while(total > peak && !totals.peak.compare_exchange_weak(peak, total, std::memory_order_relaxed)) {}
+  }
+
+}
+
+/**
+ * Unpublished changes of the calling thread.
+ */
+class ThreadCounts {
+private:
+  v_int64 m_created[AllocationTelemetry::MAX_TYPES];
+  v_int64 m_live[AllocationTelemetry::MAX_TYPES];
+public:
+
+  ThreadCounts()
+    : m_created()
+    , m_live()
+  {}
+
+  ~ThreadCounts() {
+    publishAll();
+    threadCountsDestroyed = true;
+  }
+
+  void publish(v_int32 typeId) {
+    publishTo(typeId, m_created[typeId], m_live[typeId]);
+    m_created[typeId] = 0;
+    m_live[typeId] = 0;
+  }
+
+  void publishAll() {
+    for(v_int32 i = 0; i < AllocationTelemetry::MAX_TYPES; i ++) {
+      publish(i);
+    }
+  }
+
+  void onCreate(v_int32 typeId) {
+
+    m_created[typeId] ++;
+    m_live[typeId] ++;
+
+    if(m_created[typeId] >= AllocationTelemetry::BATCH_SIZE || m_live[typeId] >= AllocationTelemetry::BATCH_SIZE) {
+      publish(typeId);
+      return;
+    }
+
+    /* Publish right away when this object may set a new peak - only plain loads of lines which are rarely written,
+     * and below the peak nothing is published early */
+    if(m_live[typeId] > 0) {
+      auto& totals = Registry::instance().totals[typeId];
+      if(totals.live.load(std::memory_order_relaxed) + m_live[typeId] > totals.peak.load(std::memory_order_relaxed)) {
+        publish(typeId);
+      }
+    }
+
+  }
+
+  void onDestroy(v_int32 typeId) {
+    m_live[typeId] --;
+    if(m_live[typeId] <= -AllocationTelemetry::BATCH_SIZE) {
+      publish(typeId);
+    }
+  }
+
+  static ThreadCounts& get() {
+    thread_local ThreadCounts counts;
+    return counts;
+  }
+
+};
+
+std::string demangle(const char* name) {
+#if defined(__GNUG__)
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if(status == 0 && demangled) {
+    std::string result(demangled);
+    std::free(demangled);
+    return result;
+  }
+#endif
+  return name;
+}
+
+}
+
+v_int32 AllocationTelemetry::registerType(const char* name) {
+  auto& registry = Registry::instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  if(registry.names.size() >= (size_t) MAX_TYPES) {
+    return -1;
+  }
+  registry.names.push_back(demangle(name));
+  return (v_int32) registry.names.size() - 1;
+}
+
+void AllocationTelemetry::onCreate(v_int32 typeId) {
+  if(typeId < 0) {
+    return;
+  }
+  if(threadCountsDestroyed) {
+    publishTo(typeId, 1, 1);
+    return;
+  }
+  ThreadCounts::get().onCreate(typeId);
+}
+
+void AllocationTelemetry::onDestroy(v_int32 typeId) {
+  if(typeId < 0) {
+    return;
+  }
+  if(threadCountsDestroyed) {
+    publishTo(typeId, 0, -1);
+    return;
+  }
+  ThreadCounts::get().onDestroy(typeId);
+}
+
+std::vector<AllocationTelemetry::TypeStats> AllocationTelemetry::getStats() {
+
+  if(!threadCountsDestroyed) {
+    ThreadCounts::get().publishAll();
+  }
+
+  auto& registry = Registry::instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  std::vector<TypeStats> result;
+  for(size_t i = 0; i < registry.names.size(); i ++) {
+    const auto& totals = registry.totals[i];
+    result.push_back({registry.names[i],
+                      totals.created.load(std::memory_order_relaxed),
+                      totals.live.load(std::memory_order_relaxed),
+                      totals.peak.load(std::memory_order_relaxed)});
+  }
+  return result;
+
+}
+
+AllocationTelemetry::TypeStats AllocationTelemetry::getStats(const std::string& name) {
+  for(auto& stats : getStats()) {
+    if(stats.type == name) {
+      return stats;
+    }
+  }
+  return {name, 0, 0, 0};
+}
+
+std::string AllocationTelemetry::formatReport() {
+
+#ifdef DISABLE_ALLOCATION_TELEMETRY
+  return "Allocation telemetry: disabled\n";
+#else
+
+  std::string report = "Allocation telemetry:\n";
+
+  char line[256];
+  std::snprintf(line, sizeof(line), "%-56s %12s %12s %12s\n", "type", "created", "live", "peak");
+  report += line;
+
+  for(auto& stats : getStats()) {
+    std::snprintf(line, sizeof(line), "%-56s %12lld %12lld %12lld%s\n", stats.type.c_str(),
+                  (long long) stats.created, (long long) stats.live, (long long) stats.peak,
+                  stats.live != 0 ? "  <- still alive" : "");
+    report += line;
+  }
+
+  return report;
+
+#endif
+
+}
+
+std::string AllocationTelemetry::renderPrometheus() {
+
+#ifdef DISABLE_ALLOCATION_TELEMETRY
+  return "";
+#else
+
+  auto stats = getStats();
+
+  std::string created = "# HELP app_objects_created_total Objects created, by type.\n"
+                        "# TYPE app_objects_created_total counter\n";
+  std::string live = "# HELP app_objects_live Objects alive, by type.\n"
+                     "# TYPE app_objects_live gauge\n";
+  std::string peak = "# HELP app_objects_peak Max objects alive at the same time, by type.\n"
+                     "# TYPE app_objects_peak gauge\n";
+
+  for(auto& typeStats : stats) {
+    std::string label = "{type=\"" + typeStats.type + "\"} ";
+    created += "app_objects_created_total" + label + std::to_string(typeStats.created) + "\n";
+    live += "app_objects_live" + label + std::to_string(typeStats.live) + "\n";
+    peak += "app_objects_peak" + label + std::to_string(typeStats.peak) + "\n";
+  }
+
+  return created + live + peak;
+
+#endif
+
+}
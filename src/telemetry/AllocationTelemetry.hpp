@@ -0,0 +1,144 @@
+#ifndef AllocationTelemetry_hpp
+#define AllocationTelemetry_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+/**
+ * Per-type allocation and leak telemetry of the application's own objects.
+ * Replaces the process-global `oatpp::base::Environment` object counters, which are bumped with an atomic
+ * on every construction from every connection thread.
+ * Each thread counts in thread-local memory and publishes its counts to the shared totals only every
+ * &l:AllocationTelemetry::BATCH_SIZE; changes of a type, when an object may set a new peak, and when it exits.
+ * So shared cache lines are touched rarely and the totals lag by less than `BATCH_SIZE` per live thread and type.
+ * Once all threads are done (at shutdown) they are exact.
+ *
+ * Types opt in by deriving from &l:AllocationTracked;.
+ * Compiled out with the `ALLOCATION_TELEMETRY` CMake option (`-D DISABLE_ALLOCATION_TELEMETRY`).
+ */
+class AllocationTelemetry {
+public:
+
+  /**
+   * Max number of tracked types.
+   */
+  static constexpr v_int32 MAX_TYPES = 64;
+
+  /**
+   * Thread-local changes of a type after which they are published.
+   */
+  static constexpr v_int64 BATCH_SIZE = 64;
+
+  /**
+   * Counters of one type.
+   */
+  struct TypeStats {
+
+    /**
+     * Type name.
+     */
+    std::string type;
+
+    /**
+     * Objects created since start.
+     */
+    v_int64 created;
+
+    /**
+     * Objects alive now. Non-zero at shutdown means a leak.
+     */
+    v_int64 live;
+
+    /**
+     * Max objects alive at the same time. Raised as soon as a thread sees live objects beyond it - by the thread's
+     * own objects plus the published ones.
+     */
+    v_int64 peak;
+
+  };
+
+public:
+
+  /**
+   * Register a type. Called once per type by &l:AllocationTracked;.
+   * @param name - type name.
+   * @return - type id, `-1` if there are too many types.
+   */
+  static v_int32 registerType(const char* name);
+
+  /**
+   * Count construction of an object of the type.
+   * @param typeId
+   */
+  static void onCreate(v_int32 typeId);
+
+  /**
+   * Count destruction of an object of the type.
+   * @param typeId
+   */
+  static void onDestroy(v_int32 typeId);
+
+  /**
+   * Get counters of all tracked types. Publishes counts of the calling thread first.
+   * @return - counters.
+   */
+  static std::vector<TypeStats> getStats();
+
+  /**
+   * Get counters of one type.
+   * @param name - type name as registered.
+   * @return - counters, zero if the type is not registered.
+   */
+  static TypeStats getStats(const std::string& name);
+
+  /**
+   * Format counters of all tracked types as a table for the shutdown log.
+   * @return - report text.
+   */
+  static std::string formatReport();
+
+  /**
+   * Render counters in the Prometheus text format.
+   * @return - metrics text.
+   */
+  static std::string renderPrometheus();
+
+};
+
+/**
+ * Base of the types whose objects are counted by &l:AllocationTelemetry;.
+ * Usage: `class MyType : public AllocationTracked<MyType> {...}`. Empty if telemetry is compiled out.
+ * @tparam T - tracked type.
+ */
+template<class T>
+class AllocationTracked {
+#ifndef DISABLE_ALLOCATION_TELEMETRY
+private:
+
+  static v_int32 typeId() {
+    static const v_int32 id = AllocationTelemetry::registerType(typeid(T).name());
+    return id;
+  }
+
+public:
+
+  AllocationTracked() {
+    AllocationTelemetry::onCreate(typeId());
+  }
+
+  AllocationTracked(const AllocationTracked&) {
+    AllocationTelemetry::onCreate(typeId());
+  }
+
+  AllocationTracked& operator=(const AllocationTracked&) = default;
+
+  ~AllocationTracked() {
+    AllocationTelemetry::onDestroy(typeId());
+  }
+#endif
+};
+
+#endif /* AllocationTelemetry_hpp */
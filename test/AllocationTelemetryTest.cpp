@@ -0,0 +1,87 @@
+#include "AllocationTelemetryTest.hpp"
+
+#include "telemetry/AllocationTelemetry.hpp"
+
+#include <condition_variable>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/* Registered under its demangled name */
+class AllocationTelemetryTestProbe : public AllocationTracked<AllocationTelemetryTestProbe> {};
+
+void AllocationTelemetryTest::onRun() {
+
+#ifdef DISABLE_ALLOCATION_TELEMETRY
+  OATPP_LOGI(TAG, "Allocation telemetry is compiled out - skipped");
+#else
+
+  const char* const TYPE = "AllocationTelemetryTestProbe";
+  const v_int64 THREADS = 4;
+  const v_int64 OBJECTS_PER_THREAD = 1000;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  v_int64 created = 0;
+
+  /* All threads hold their objects until every thread has created its own - peak is THREADS * OBJECTS_PER_THREAD */
+  std::list<std::thread> threads;
+  for(v_int64 i = 0; i < THREADS; i ++) {
+    threads.push_back(std::thread([&] {
+      std::list<AllocationTelemetryTestProbe> objects(OBJECTS_PER_THREAD);
+      std::unique_lock<std::mutex> lock(mutex);
+      created ++;
+      condition.notify_all();
+      condition.wait(lock, [&] { return created == THREADS; });
+    }));
+  }
+
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  /* Exited threads have published everything */
+  auto stats = AllocationTelemetry::getStats(TYPE);
+  OATPP_LOGD(TAG, "created=%lld, live=%lld, peak=%lld", (long long) stats.created, (long long) stats.live, (long long) stats.peak);
+  OATPP_ASSERT(stats.created == THREADS * OBJECTS_PER_THREAD);
+  OATPP_ASSERT(stats.live == 0);
+  /* Unpublished batches may hide a part of the peak */
+  OATPP_ASSERT(stats.peak <= THREADS * OBJECTS_PER_THREAD);
+  OATPP_ASSERT(stats.peak >= THREADS * (OBJECTS_PER_THREAD - AllocationTelemetry::BATCH_SIZE));
+
+  /* getStats() publishes the calling thread - its own objects are seen at once */
+  {
+    std::list<AllocationTelemetryTestProbe> objects(10);
+    objects.push_back(objects.front());
+    stats = AllocationTelemetry::getStats(TYPE);
+    OATPP_ASSERT(stats.created == THREADS * OBJECTS_PER_THREAD + 11);
+    OATPP_ASSERT(stats.live == 11);
+  }
+
+  stats = AllocationTelemetry::getStats(TYPE);
+  OATPP_ASSERT(stats.live == 0);
+
+  /* A thread alone raises the peak with every object beyond it - nothing of it is left in an unpublished batch */
+  auto peak = stats.peak;
+  {
+    std::list<AllocationTelemetryTestProbe> objects((size_t) peak + 100);
+  }
+  stats = AllocationTelemetry::getStats(TYPE);
+  OATPP_ASSERT(stats.peak == peak + 100);
+  OATPP_ASSERT(stats.live == 0);
+
+  /* Object held in a TLS variable which is constructed before the thread's counts, so destroyed after them */
+  std::thread([] {
+    thread_local std::unique_ptr<AllocationTelemetryTestProbe> holder;
+    holder.reset(new AllocationTelemetryTestProbe());
+  }).join();
+  stats = AllocationTelemetry::getStats(TYPE);
+  OATPP_ASSERT(stats.live == 0);
+
+  auto report = AllocationTelemetry::formatReport();
+  OATPP_ASSERT(report.find(TYPE) != std::string::npos);
+
+#endif
+
+}
@@ -0,0 +1,14 @@
+#ifndef AllocationTelemetryTest_hpp
+#define AllocationTelemetryTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class AllocationTelemetryTest : public oatpp::test::UnitTest {
+public:
+
+  AllocationTelemetryTest() : UnitTest("TEST[AllocationTelemetryTest]"){}
+  void onRun() override;
+
+};
+
+#endif // AllocationTelemetryTest_hpp
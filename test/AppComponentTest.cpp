@@ -0,0 +1,55 @@
+#include "AppComponentTest.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+namespace {
+
+std::shared_ptr<MyApiTestClient> createClient(const AppComponent& components) {
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+  return MyApiTestClient::createShared(requestExecutor, components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>());
+}
+
+}
+
+void AppComponentTest::onRun() {
+
+  /* Two independent instances in one process */
+  AppComponent first({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE);
+  AppComponent second({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE);
+
+  auto firstRouter = first.get<std::shared_ptr<oatpp::web::server::HttpRouter>>();
+  auto secondRouter = second.get<std::shared_ptr<oatpp::web::server::HttpRouter>>();
+  OATPP_ASSERT(firstRouter != secondRouter);
+
+  /* Only the first instance serves MyController */
+  firstRouter->addController(std::make_shared<MyController>(first.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>()));
+
+  ServerLifecycle firstLifecycle(first.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>(),
+                                 first.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  ServerLifecycle secondLifecycle(second.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>(),
+                                  second.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+
+  firstLifecycle.start();
+  secondLifecycle.start();
+
+  OATPP_ASSERT(createClient(first)->getRoot()->getStatusCode() == 200);
+  OATPP_ASSERT(createClient(second)->getRoot()->getStatusCode() == 404);
+
+  /* Stopping one instance doesn't affect the other */
+  secondLifecycle.stop();
+  OATPP_ASSERT(firstLifecycle.isRunning());
+  OATPP_ASSERT(createClient(first)->getRoot()->getStatusCode() == 200);
+
+  firstLifecycle.stop();
+
+}
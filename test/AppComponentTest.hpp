@@ -0,0 +1,14 @@
+#ifndef AppComponentTest_hpp
+#define AppComponentTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class AppComponentTest : public oatpp::test::UnitTest {
+public:
+
+  AppComponentTest() : UnitTest("TEST[AppComponentTest]"){}
+  void onRun() override;
+
+};
+
+#endif // AppComponentTest_hpp
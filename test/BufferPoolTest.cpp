@@ -0,0 +1,99 @@
+#include "BufferPoolTest.hpp"
+
+#include "memory/BufferPool.hpp"
+
+#include <thread>
+#include <vector>
+
+void BufferPoolTest::onRun() {
+
+  BufferPool::releaseThreadCache();
+  BufferPool::trim();
+
+  /* Released buffer is reused by the same thread, its capacity intact */
+  {
+    auto buffer = BufferPool::acquire(100);
+    OATPP_ASSERT((v_buff_size) buffer->capacity() >= 100);
+    buffer->resize(BufferPool::getClassSize(0));
+    auto memory = buffer.get();
+    buffer.reset();
+
+    auto before = BufferPool::getStats();
+    auto reused = BufferPool::acquire(BufferPool::getClassSize(0));
+    OATPP_ASSERT(reused.get() == memory);
+    OATPP_ASSERT(BufferPool::getStats().allocated == before.allocated);
+  }
+
+  /* Thread cache goes to the shared pool, where other threads take it from */
+  BufferPool::releaseThreadCache();
+  OATPP_ASSERT(BufferPool::getStats().retainedBytes >= BufferPool::getClassSize(0));
+
+  std::thread([] {
+    auto before = BufferPool::getStats();
+    auto buffer = BufferPool::acquire(10);
+    OATPP_ASSERT(BufferPool::getStats().allocated == before.allocated);
+  }).join();
+
+  OATPP_ASSERT(BufferPool::trim() >= BufferPool::getClassSize(0));
+  OATPP_ASSERT(BufferPool::getStats().retainedBytes == 0);
+
+  /* Buffers cached by threads count against the cap too */
+  BufferPool::setMaxRetainedBytes(2 * BufferPool::getClassSize(0));
+  {
+    auto before = BufferPool::getStats();
+    std::vector<std::shared_ptr<std::string>> buffers;
+    for(v_int32 i = 0; i < 4; i ++) {
+      buffers.push_back(BufferPool::acquire(BufferPool::getClassSize(0)));
+    }
+    buffers.clear();
+
+    auto stats = BufferPool::getStats();
+    OATPP_ASSERT(stats.retainedBytes <= 2 * BufferPool::getClassSize(0));
+    OATPP_ASSERT(stats.dropped - before.dropped >= 2);
+  }
+  BufferPool::releaseThreadCache();
+  BufferPool::trim();
+  OATPP_ASSERT(BufferPool::getStats().retainedBytes == 0);
+
+  /* Retained memory is capped */
+  BufferPool::setMaxRetainedBytes(4 * BufferPool::getClassSize(1));
+  {
+    auto before = BufferPool::getStats();
+    std::vector<std::shared_ptr<std::string>> buffers;
+    for(v_int32 i = 0; i < 16; i ++) {
+      buffers.push_back(BufferPool::acquire(BufferPool::getClassSize(1)));
+    }
+    buffers.clear();
+    BufferPool::releaseThreadCache();
+
+    auto stats = BufferPool::getStats();
+    OATPP_ASSERT(stats.retainedBytes <= 4 * BufferPool::getClassSize(1));
+    OATPP_ASSERT(stats.dropped - before.dropped >= 12);
+  }
+  BufferPool::setMaxRetainedBytes(BufferPool::DEFAULT_MAX_RETAINED_BYTES);
+
+  /* Idle pool is trimmed, a busy one is not */
+  OATPP_ASSERT(BufferPool::trimIfIdle(std::chrono::seconds(60)) == 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  OATPP_ASSERT(BufferPool::trimIfIdle(std::chrono::milliseconds(10)) > 0);
+  OATPP_ASSERT(BufferPool::getStats().retainedBytes == 0);
+
+  /* Concurrent acquire/release */
+  std::vector<std::thread> threads;
+  for(v_int32 t = 0; t < 8; t ++) {
+    threads.push_back(std::thread([] {
+      for(v_int32 i = 0; i < 10000; i ++) {
+        auto buffer = BufferPool::acquire(i % 4 == 0 ? BufferPool::getClassSize(2) : BufferPool::getClassSize(0));
+        buffer->assign(64, 'x');
+      }
+      BufferPool::releaseThreadCache();
+    }));
+  }
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  OATPP_ASSERT(BufferPool::getStats().retainedBytes <= BufferPool::DEFAULT_MAX_RETAINED_BYTES);
+  BufferPool::trim();
+
+}
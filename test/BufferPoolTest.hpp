@@ -0,0 +1,14 @@
+#ifndef BufferPoolTest_hpp
+#define BufferPoolTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class BufferPoolTest : public oatpp::test::UnitTest {
+public:
+
+  BufferPoolTest() : UnitTest("TEST[BufferPoolTest]"){}
+  void onRun() override;
+
+};
+
+#endif // BufferPoolTest_hpp
@@ -0,0 +1,178 @@
+#include "CompiledRouterTest.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MetricsController.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "router/CompiledRouter.hpp"
+
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/protocol/http/outgoing/ResponseFactory.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+namespace {
+
+class StubHandler : public oatpp::web::server::HttpRequestHandler {
+public:
+  std::shared_ptr<OutgoingResponse> handle(const std::shared_ptr<IncomingRequest>& request) override {
+    (void) request;
+    return oatpp::web::protocol::http::outgoing::ResponseFactory::createResponse(oatpp::web::protocol::http::Status::CODE_200, "stub");
+  }
+};
+
+void testLookup() {
+
+  auto router = CompiledRouter::createShared();
+
+  auto root = std::make_shared<StubHandler>();
+  auto user = std::make_shared<StubHandler>();
+  auto userMe = std::make_shared<StubHandler>();
+  auto userPost = std::make_shared<StubHandler>();
+  auto files = std::make_shared<StubHandler>();
+  auto createUser = std::make_shared<StubHandler>();
+  auto manyParams = std::make_shared<StubHandler>();
+  auto viaBase = std::make_shared<StubHandler>();
+
+  router->route("GET", "/", root);
+  router->route("GET", "/users/{id}", user);
+  router->route("GET", "/users/me", userMe);
+  router->route("GET", "/users/{id}/posts/{post}", userPost);
+  router->route("GET", "/files/*", files);
+  router->route("POST", "/users", createUser);
+
+  /* More parameters than a compiled route may have */
+  std::string manyParamsPattern;
+  for(v_int32 i = 0; i <= CompiledRouter::MAX_PARAMS; i ++) {
+    manyParamsPattern += "/{p" + std::to_string(i) + "}";
+  }
+  router->route("GET", manyParamsPattern, manyParams);
+
+  /* Added through a plain HttpRouter pointer - the non-virtual stock method, not recorded */
+  std::shared_ptr<oatpp::web::server::HttpRouter> stockRouter = router;
+  stockRouter->route("DELETE", "/users/{id}", viaBase);
+
+  std::vector<std::shared_ptr<StubHandler>> many;
+  for(v_int32 i = 0; i < 300; i ++) {
+    many.push_back(std::make_shared<StubHandler>());
+    router->route("GET", "/resources/r" + std::to_string(i) + "/{id}", many.back());
+  }
+
+  /* Not frozen - everything is left to the stock router */
+  CompiledRouter::Captures captures;
+  OATPP_ASSERT(router->lookup("GET", "/", captures) == nullptr);
+
+  router->freeze();
+  OATPP_ASSERT(router->isFrozen());
+
+  /* The route with too many parameters and the one added through HttpRouter are left to the stock router */
+  OATPP_ASSERT(router->getCompiledRoutesCount() == 306);
+
+  auto handlerOf = [&router](const char* method, const char* path) -> std::shared_ptr<oatpp::web::server::HttpRequestHandler> {
+    auto route = router->findRoute(method, path);
+    return route ? route.getEndpoint() : nullptr;
+  };
+
+  OATPP_ASSERT(handlerOf("GET", "/") == root);
+  OATPP_ASSERT(handlerOf("GET", "/?a=b") == root);
+  OATPP_ASSERT(handlerOf("GET", "/users/42") == user);
+  OATPP_ASSERT(handlerOf("GET", "/users/42?full=true") == user);
+  OATPP_ASSERT(handlerOf("GET", "/users/me/posts/7") == userPost);
+  OATPP_ASSERT(handlerOf("GET", "/files/css/site.css") == files);
+  OATPP_ASSERT(handlerOf("POST", "/users") == createUser);
+  OATPP_ASSERT(handlerOf("DELETE", "/users/42") == nullptr);
+  OATPP_ASSERT(router->getRoute("DELETE", "/users/42").getEndpoint() == viaBase);
+  OATPP_ASSERT(handlerOf("GET", "/resources/r299/5") == many.back());
+  OATPP_ASSERT(handlerOf("GET", "/users") == nullptr);
+  OATPP_ASSERT(handlerOf("PUT", "/users/42") == nullptr);
+  OATPP_ASSERT(handlerOf("GET", "/resources/r300/5") == nullptr);
+  OATPP_ASSERT(handlerOf("GET", "/a/b/c/d/e/f/g/h/i/j/k/l/m/n/o/p/q") == nullptr);
+
+  /* Literal segment wins over a parameter registered before it */
+  OATPP_ASSERT(handlerOf("GET", "/users/me") == userMe);
+
+  /* Same handlers as the stock router where registration order doesn't matter */
+  for(auto path : {"/", "/users/42", "/users/me/posts/7", "/files/a/b", "/resources/r17/x", "/users", "/nope"}) {
+    auto stock = router->getRoute("GET", path);
+    OATPP_ASSERT(handlerOf("GET", path) == (stock ? stock.getEndpoint() : nullptr));
+  }
+
+  /* Parameters and tail refer to the path */
+  oatpp::data::share::StringKeyLabel path("/users/me/posts/7?x=1");
+  auto route = router->lookup("GET", path, captures);
+  OATPP_ASSERT(route != nullptr && route->handler == userPost);
+  OATPP_ASSERT(captures.count == 2);
+  OATPP_ASSERT(captures.values[0].data == (const char*) path.getData() + 7 && captures.values[0].size == 2);
+  OATPP_ASSERT(std::string(captures.values[1].data, captures.values[1].size) == "7");
+
+  auto matched = router->findRoute("GET", path);
+  OATPP_ASSERT(matched.getMatchMap().getVariable("id") == "me");
+  OATPP_ASSERT(matched.getMatchMap().getVariable("post") == "7");
+  OATPP_ASSERT(router->findRoute("GET", "/files/css/site.css").getMatchMap().getTail() == "css/site.css");
+
+  /* Added after freeze() - served by the stock router only */
+  router->route("GET", "/late", root);
+  OATPP_ASSERT(handlerOf("GET", "/late") == nullptr);
+  OATPP_ASSERT(router->getRoute("GET", "/late").getEndpoint() == root);
+
+}
+
+void testServer() {
+
+  AppComponent::Options options;
+  options.routerMode = AppComponent::RouterMode::COMPILED;
+  AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE, options);
+
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  auto compiledRouter = components.get<std::shared_ptr<CompiledRouter>>();
+  OATPP_ASSERT(components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>() == compiledRouter);
+
+  /* Controllers added through the CompiledRouter component, the router is frozen by the warm-up */
+  compiledRouter->addController(std::make_shared<MyController>(objectMapper));
+  compiledRouter->addController(std::make_shared<MetricsController>(components.get<std::shared_ptr<RequestMetrics>>()));
+  components.warmUp();
+  OATPP_ASSERT(compiledRouter->isFrozen());
+  OATPP_ASSERT(compiledRouter->getCompiledRoutesCount() > 0);
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+  auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+  auto root = client->getRoot();
+  OATPP_ASSERT(root->getStatusCode() == 200);
+  root->readBodyToString();
+
+  /* Path parameter captured by the compiled router */
+  auto items = client->getItems(3);
+  OATPP_ASSERT(items->getStatusCode() == 200);
+  auto list = items->readBodyToDto<oatpp::List<oatpp::Object<MyDto>>>(objectMapper.get());
+  OATPP_ASSERT(list && list->size() == 3);
+
+  /* No compiled route - the stock router answers 404 */
+  auto missing = client->getAsset("nested/name");
+  OATPP_ASSERT(missing->getStatusCode() == 404);
+  missing->readBodyToString();
+
+  /* Requests dispatched by the interceptor are still recorded */
+  auto metrics = client->getMetrics();
+  OATPP_ASSERT(metrics->getStatusCode() == 200);
+  auto text = metrics->readBodyToString();
+  OATPP_ASSERT(text->find("http_requests_total{method=\"GET\",route=\"/\",code=\"2xx\"} 1\n") != std::string::npos);
+
+  lifecycle.stop();
+
+}
+
+}
+
+void CompiledRouterTest::onRun() {
+  testLookup();
+  testServer();
+}
@@ -0,0 +1,14 @@
+#ifndef CompiledRouterTest_hpp
+#define CompiledRouterTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class CompiledRouterTest : public oatpp::test::UnitTest {
+public:
+
+  CompiledRouterTest() : UnitTest("TEST[CompiledRouterTest]"){}
+  void onRun() override;
+
+};
+
+#endif // CompiledRouterTest_hpp
@@ -0,0 +1,166 @@
+#include "ConcurrencyLimiterTest.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MetricsController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "limit/ConcurrencyLimiter.hpp"
+
+#include "app/MyApiTestClient.hpp"
+#include "app/SlowController.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * Run `windows` full windows - the whole limit in flight, then all released with the latency.
+ */
+void runWindows(ConcurrencyLimiter& limiter, v_int32 windows, v_int64 latencyMicros) {
+  for(v_int32 w = 0; w < windows; w ++) {
+    auto limit = limiter.getLimit();
+    for(v_int32 i = 0; i < limit; i ++) {
+      OATPP_ASSERT(limiter.tryAcquire());
+    }
+    for(v_int32 i = 0; i < limit; i ++) {
+      limiter.release(latencyMicros);
+    }
+  }
+}
+
+void testAdaptation() {
+
+  ConcurrencyLimiter::Config config;
+  config.initialLimit = 10;
+  config.minLimit = 2;
+  config.windowSize = 5;
+
+  ConcurrencyLimiter limiter(config);
+
+  /* No measurement at a lower limit - traffic is admitted up to the initial limit right away */
+  OATPP_ASSERT(limiter.getLimit() == 10);
+  OATPP_ASSERT(limiter.getStats().baselineLatencyMicros == 0);
+
+  /* The first window sets the baseline */
+  runWindows(limiter, 1, 1000);
+  OATPP_ASSERT(limiter.getLimit() == 10);
+  OATPP_ASSERT(limiter.getStats().baselineLatencyMicros == 1000);
+
+  /* Over the limit - shed */
+  for(v_int32 i = 0; i < 10; i ++) {
+    OATPP_ASSERT(limiter.tryAcquire());
+  }
+  OATPP_ASSERT(!limiter.tryAcquire());
+  for(v_int32 i = 0; i < 10; i ++) {
+    limiter.release(1000);
+  }
+
+  /* Flat latency at full use - the limit grows */
+  runWindows(limiter, 10, 1000);
+  auto grown = limiter.getLimit();
+  OATPP_ASSERT(grown > 10);
+  OATPP_ASSERT(grown <= config.maxLimit);
+
+  /* Latency 5x the baseline - the limit drops */
+  runWindows(limiter, 10, 5000);
+  auto dropped = limiter.getLimit();
+  OATPP_ASSERT(dropped < grown);
+  OATPP_ASSERT(dropped >= config.minLimit);
+
+  /* The baseline follows a latency which stays, slowly */
+  auto baseline = limiter.getStats().baselineLatencyMicros;
+  OATPP_ASSERT(baseline > 1000 && baseline < 5000);
+
+  /* Mostly idle - the limit stays, the faster latency is the baseline again */
+  for(v_int32 i = 0; i < 50; i ++) {
+    OATPP_ASSERT(limiter.tryAcquire());
+    limiter.release(1000);
+  }
+  OATPP_ASSERT(limiter.getLimit() == dropped);
+  OATPP_ASSERT(limiter.getStats().baselineLatencyMicros == 1000);
+
+  auto stats = limiter.getStats();
+  OATPP_ASSERT(stats.inFlight == 0);
+  OATPP_ASSERT(stats.rejected == 1);
+
+  auto text = limiter.renderPrometheus();
+  OATPP_ASSERT(text.find("app_concurrency_limit " + std::to_string(dropped) + "\n") != std::string::npos);
+  OATPP_ASSERT(text.find("app_concurrency_rejected_total 1\n") != std::string::npos);
+
+}
+
+void testShedding() {
+
+  /* Fixed limit of 2 in front of a backend which takes 300ms */
+  AppComponent::Options options;
+  options.limiter = std::make_shared<ConcurrencyLimiter::Config>();
+  options.limiter->initialLimit = 2;
+  options.limiter->minLimit = 2;
+  options.limiter->maxLimit = 2;
+
+  AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE, options);
+
+  auto limiter = components.get<std::shared_ptr<ConcurrencyLimiter>>();
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  auto router = components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>();
+  router->addController(std::make_shared<SlowController>(2, std::chrono::milliseconds(300)));
+  router->addController(std::make_shared<MetricsController>(components.get<std::shared_ptr<RequestMetrics>>(), limiter));
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+  auto client = MyApiTestClient::createShared(oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider), objectMapper);
+
+  std::atomic<v_int32> served(0);
+  std::atomic<v_int32> shed(0);
+  std::vector<std::thread> threads;
+  for(v_int32 i = 0; i < 6; i ++) {
+    threads.push_back(std::thread([&client, &served, &shed] {
+      auto response = client->getSlow();
+      if(response->getStatusCode() == 200) {
+        served ++;
+      } else if(response->getStatusCode() == 503 && response->getHeader("Retry-After") == "1") {
+        shed ++;
+      }
+      response->readBodyToString();
+    }));
+  }
+  for(auto& thread : threads) {
+    thread.join();
+  }
+
+  /* At most 2 in the backend at a time, the rest answered right away */
+  OATPP_ASSERT(served + shed == 6);
+  OATPP_ASSERT(served >= 2);
+  OATPP_ASSERT(shed >= 1);
+
+  auto stats = limiter->getStats();
+  OATPP_ASSERT(stats.limit == 2);
+  OATPP_ASSERT(stats.inFlight == 0);
+  OATPP_ASSERT(stats.rejected == shed);
+
+  /* Shed requests are routed nowhere, but still counted by the metrics */
+  auto metrics = client->getMetrics();
+  OATPP_ASSERT(metrics->getStatusCode() == 200);
+  auto text = metrics->readBodyToString();
+  OATPP_ASSERT(text->find("app_concurrency_limit 2\n") != std::string::npos);
+  OATPP_ASSERT(text->find("code=\"5xx\"} " + std::to_string(shed.load()) + "\n") != std::string::npos);
+
+  lifecycle.stop();
+
+}
+
+}
+
+void ConcurrencyLimiterTest::onRun() {
+  testAdaptation();
+  testShedding();
+}
@@ -0,0 +1,14 @@
+#ifndef ConcurrencyLimiterTest_hpp
+#define ConcurrencyLimiterTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class ConcurrencyLimiterTest : public oatpp::test::UnitTest {
+public:
+
+  ConcurrencyLimiterTest() : UnitTest("TEST[ConcurrencyLimiterTest]"){}
+  void onRun() override;
+
+};
+
+#endif // ConcurrencyLimiterTest_hpp
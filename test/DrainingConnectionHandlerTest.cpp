@@ -0,0 +1,179 @@
+#include "DrainingConnectionHandlerTest.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/DrainingConnectionHandler.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "app/LoopbackTestClient.hpp"
+#include "app/MyApiTestClient.hpp"
+#include "app/SlowController.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <cctype>
+#include <string>
+#include <thread>
+
+namespace {
+
+/**
+ * Send keep-alive `GET /slow` to `127.0.0.1:port` and read until the server closes the connection.
+ * @return - everything received, lower case.
+ */
+std::string requestSlow(v_uint16 port) {
+
+  auto data = LoopbackTestClient::request(port, "GET /slow HTTP/1.1\r\nHost: localhost\r\n\r\n");
+
+  for(auto& c : data) {
+    c = (char) std::tolower((unsigned char) c);
+  }
+  return data;
+
+}
+
+void testIdle() {
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  auto connectionHandler = DrainingConnectionHandler::createShared(
+    oatpp::web::server::HttpConnectionHandler::createShared(router), std::chrono::seconds(10)
+  );
+
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+  auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+  /* Keep-alive connection which stays idle after its first request */
+  auto connection = client->getConnection();
+  auto response = client->getRoot(connection);
+  OATPP_ASSERT(response->getStatusCode() == 200);
+  response->readBodyToString();
+
+  OATPP_ASSERT(connectionHandler->getConnectionsCount() == 1);
+
+  /* Idle connection has nothing in flight, so it is closed without waiting for the deadline */
+  auto stopStart = std::chrono::steady_clock::now();
+  lifecycle.stop();
+  auto stopTime = std::chrono::steady_clock::now() - stopStart;
+
+  auto report = connectionHandler->getReport();
+  OATPP_LOGD("DrainingConnectionHandlerTest", "idle: drained=%lld, aborted=%lld, duration=%lldus",
+             (long long) report.drained, (long long) report.aborted, (long long) report.duration.count());
+
+  OATPP_ASSERT(stopTime < std::chrono::seconds(5));
+  OATPP_ASSERT(report.drained == 1);
+  OATPP_ASSERT(report.aborted == 0);
+  OATPP_ASSERT(connectionHandler->getConnectionsCount() == 0);
+
+}
+
+void testInFlight() {
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<SlowController>(4, std::chrono::milliseconds(500)));
+
+  auto connectionHandler = DrainingConnectionHandler::createShared(
+    oatpp::web::server::HttpConnectionHandler::createShared(router), std::chrono::seconds(10)
+  );
+
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  std::string received;
+  std::thread client([port, &received] {
+    received = requestSlow(port);
+  });
+
+  /* Stop while the request is in the endpoint */
+  while(connectionHandler->getConnectionsCount() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  lifecycle.stop();
+  client.join();
+
+  /* Answered, and told that the connection won't be reused */
+  OATPP_ASSERT(received.find("http/1.1 200") == 0);
+  OATPP_ASSERT(received.find("\r\nconnection: close\r\n") != std::string::npos);
+
+  auto report = connectionHandler->getReport();
+  OATPP_ASSERT(report.drained == 1);
+  OATPP_ASSERT(report.aborted == 0);
+
+}
+
+void testAborted() {
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<SlowController>(4, std::chrono::seconds(2)));
+
+  std::weak_ptr<oatpp::web::server::HttpConnectionHandler> wrappedHandler;
+
+  {
+
+    auto httpConnectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+    wrappedHandler = httpConnectionHandler;
+    auto connectionHandler = DrainingConnectionHandler::createShared(httpConnectionHandler, std::chrono::milliseconds(200));
+    httpConnectionHandler.reset();
+
+    auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+    auto port = connectionProvider->getPort();
+
+    ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+    lifecycle.start();
+
+    std::string received;
+    std::thread client([port, &received] {
+      received = requestSlow(port);
+    });
+
+    while(connectionHandler->getConnectionsCount() == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    /* The endpoint outlives the deadline and the force-close grace - stop() returns anyway */
+    auto stopStart = std::chrono::steady_clock::now();
+    lifecycle.stop();
+    auto stopTime = std::chrono::steady_clock::now() - stopStart;
+    client.join();
+
+    OATPP_ASSERT(stopTime < std::chrono::milliseconds(1900));
+    OATPP_ASSERT(received.empty());
+
+    auto report = connectionHandler->getReport();
+    OATPP_ASSERT(report.drained == 0);
+    OATPP_ASSERT(report.aborted == 1);
+
+  }
+
+  /* The lifecycle and the draining handler are gone, the endpoint is still blocked - its connection keeps the wrapped
+   * handler alive until the task has ended */
+  OATPP_ASSERT(!wrappedHandler.expired());
+  while(!wrappedHandler.expired()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+}
+
+}
+
+void DrainingConnectionHandlerTest::onRun() {
+  testIdle();
+  testInFlight();
+  testAborted();
+}
@@ -0,0 +1,14 @@
+#ifndef DrainingConnectionHandlerTest_hpp
+#define DrainingConnectionHandlerTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class DrainingConnectionHandlerTest : public oatpp::test::UnitTest {
+public:
+
+  DrainingConnectionHandlerTest() : UnitTest("TEST[DrainingConnectionHandlerTest]"){}
+  void onRun() override;
+
+};
+
+#endif // DrainingConnectionHandlerTest_hpp
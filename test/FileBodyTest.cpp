@@ -0,0 +1,213 @@
+#include "FileBodyTest.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "stream/FileBody.hpp"
+
+#include "app/MyApiTestClient.hpp"
+#include "app/TestComponent.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+#include "oatpp-test/web/ClientServerTestRunner.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr v_int32 ASSET_SIZE = 3 * 1024 * 1024 + 17;
+
+std::string createAsset(const std::string& directory) {
+  std::string data;
+  data.reserve(ASSET_SIZE);
+  for(v_int32 i = 0; i < ASSET_SIZE; i ++) {
+    data.push_back((char) ('a' + i % 26));
+  }
+  auto file = std::fopen((directory + "/asset.bin").c_str(), "wb");
+  OATPP_ASSERT(file != nullptr);
+  OATPP_ASSERT(std::fwrite(data.data(), 1, data.size(), file) == data.size());
+  std::fclose(file);
+  return data;
+}
+
+/**
+ * Same checks for every transport - the body must not depend on how it was sent.
+ */
+void checkAssets(const std::shared_ptr<MyApiTestClient>& client, const std::string& data) {
+
+  oatpp::String size = std::to_string(ASSET_SIZE);
+
+  auto full = client->getAsset("asset.bin");
+  OATPP_ASSERT(full->getStatusCode() == 200);
+  OATPP_ASSERT(full->getHeader("Accept-Ranges") == "bytes");
+  OATPP_ASSERT(full->getHeader("Content-Type") == "application/octet-stream");
+  OATPP_ASSERT(full->getHeader("Content-Length") == size);
+  OATPP_ASSERT(*full->readBodyToString() == data);
+
+  auto range = client->getAssetRange("asset.bin", "bytes=100-1123");
+  OATPP_ASSERT(range->getStatusCode() == 206);
+  OATPP_ASSERT(range->getHeader("Content-Range") == "bytes 100-1123/" + size);
+  OATPP_ASSERT(*range->readBodyToString() == data.substr(100, 1024));
+
+  auto tail = client->getAssetRange("asset.bin", "bytes=-17");
+  OATPP_ASSERT(tail->getStatusCode() == 206);
+  OATPP_ASSERT(*tail->readBodyToString() == data.substr(ASSET_SIZE - 17));
+
+  auto open = client->getAssetRange("asset.bin", "bytes=" + std::to_string(ASSET_SIZE - 5) + "-");
+  OATPP_ASSERT(open->getStatusCode() == 206);
+  OATPP_ASSERT(*open->readBodyToString() == data.substr(ASSET_SIZE - 5));
+
+  auto unsatisfiable = client->getAssetRange("asset.bin", "bytes=" + size + "-");
+  OATPP_ASSERT(unsatisfiable->getStatusCode() == 416);
+  OATPP_ASSERT(unsatisfiable->getHeader("Content-Range") == "bytes */" + size);
+  unsatisfiable->readBodyToString();
+
+  /* Several ranges are not supported - whole file */
+  auto multi = client->getAssetRange("asset.bin", "bytes=0-1,5-6");
+  OATPP_ASSERT(multi->getStatusCode() == 200);
+  OATPP_ASSERT(multi->readBodyToString()->size() == data.size());
+
+  auto missing = client->getAsset("missing.bin");
+  OATPP_ASSERT(missing->getStatusCode() == 404);
+  missing->readBodyToString();
+
+  auto hidden = client->getAsset(".hidden");
+  OATPP_ASSERT(hidden->getStatusCode() == 400);
+  hidden->readBodyToString();
+
+}
+
+}
+
+void FileBodyTest::onRun() {
+
+  char directoryTemplate[] = "/tmp/file-body-test-XXXXXX";
+  OATPP_ASSERT(::mkdtemp(directoryTemplate) != nullptr);
+  std::string directory = directoryTemplate;
+  auto data = createAsset(directory);
+
+  /* Virtual transport - no socket to send to, the body is read through the buffer */
+  {
+
+    TestComponent component;
+    oatpp::test::web::ClientServerTestRunner runner;
+
+    OATPP_COMPONENT(std::shared_ptr<oatpp::data::mapping::ObjectMapper>, objectMapper);
+    runner.addController(std::make_shared<MyController>(objectMapper, directory));
+
+    runner.run([&data, &objectMapper] {
+      OATPP_COMPONENT(std::shared_ptr<oatpp::network::ClientConnectionProvider>, clientConnectionProvider);
+      auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+      checkAssets(MyApiTestClient::createShared(requestExecutor, objectMapper), data);
+    }, std::chrono::minutes(10));
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  }
+
+  /* TCP with ParkingConnectionHandler - sendfile */
+  {
+
+    AppComponent::Options options;
+    options.parking = std::make_shared<ParkingConnectionHandler::Config>();
+    options.parking->workersCount = 2;
+    options.parking->idleTimeout = std::chrono::milliseconds(1000);
+
+    AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE, options);
+
+    auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+    components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(objectMapper, directory));
+
+    auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+    auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+    ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+    lifecycle.start();
+
+    auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+    auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+    auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+    checkAssets(client, data);
+
+    /* Connection stays usable after a file body */
+    auto connection = client->getConnection();
+    for(v_int32 i = 0; i < 3; i ++) {
+      auto asset = client->getAssetRange("asset.bin", "bytes=0-99", connection);
+      OATPP_ASSERT(asset->getStatusCode() == 206);
+      OATPP_ASSERT(*asset->readBodyToString() == data.substr(0, 100));
+      auto root = client->getRoot(connection);
+      OATPP_ASSERT(root->getStatusCode() == 200);
+      root->readBodyToString();
+    }
+
+    lifecycle.stop();
+
+  }
+
+  /* Pipe body - spliced to the socket, the writer keeps producing while it is sent */
+  {
+
+    int sockets[2];
+    int pipe[2];
+    OATPP_ASSERT(::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0);
+    OATPP_ASSERT(::pipe(pipe) == 0);
+
+    std::thread writer([&data, &pipe] {
+      size_t written = 0;
+      while(written < data.size()) {
+        auto res = ::write(pipe[1], data.data() + written, data.size() - written);
+        OATPP_ASSERT(res > 0);
+        written += (size_t) res;
+      }
+      ::close(pipe[1]);
+    });
+
+    std::string received;
+    std::thread reader([&received, &sockets] {
+      char buffer[64 * 1024];
+      ssize_t res;
+      while((res = ::read(sockets[1], buffer, sizeof(buffer))) > 0) {
+        received.append(buffer, (size_t) res);
+      }
+    });
+
+    auto body = FileBody::fromPipe(pipe[0], ASSET_SIZE, nullptr);
+    OATPP_ASSERT(body->getKnownSize() == ASSET_SIZE);
+    OATPP_ASSERT(body->sendTo(sockets[0]));
+
+    ::shutdown(sockets[0], SHUT_WR);
+    writer.join();
+    reader.join();
+    ::close(sockets[0]);
+    ::close(sockets[1]);
+
+    OATPP_ASSERT(received == data);
+
+  }
+
+  /* Pipe shorter than the promised size - fails, so the handler closes the connection */
+  {
+    int pipe[2];
+    OATPP_ASSERT(::pipe(pipe) == 0);
+    OATPP_ASSERT(::write(pipe[1], "abc", 3) == 3);
+    ::close(pipe[1]);
+
+    auto body = FileBody::fromPipe(pipe[0], 10, nullptr);
+    char buffer[16];
+    oatpp::async::Action action;
+    OATPP_ASSERT(body->read(buffer, sizeof(buffer), action) == 3);
+    OATPP_ASSERT(body->read(buffer, sizeof(buffer), action) < 0);
+  }
+
+  std::remove((directory + "/asset.bin").c_str());
+  ::rmdir(directory.c_str());
+
+}
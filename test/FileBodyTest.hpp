@@ -0,0 +1,14 @@
+#ifndef FileBodyTest_hpp
+#define FileBodyTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class FileBodyTest : public oatpp::test::UnitTest {
+public:
+
+  FileBodyTest() : UnitTest("TEST[FileBodyTest]"){}
+  void onRun() override;
+
+};
+
+#endif // FileBodyTest_hpp
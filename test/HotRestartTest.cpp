@@ -0,0 +1,137 @@
+#include "HotRestartTest.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/DrainingConnectionHandler.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerHandoff.hpp"
+
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+
+#include <atomic>
+#include <vector>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * Start HotRestart-exe with a pipe as its stdin. Closing the pipe stops the process.
+ */
+pid_t spawnHotRestart(v_uint16 port, const oatpp::String& handoffPath, int& stdinHandle) {
+
+  int handles[2];
+  OATPP_ASSERT(::pipe(handles) == 0);
+
+  auto portStr = oatpp::utils::conversion::int32ToStr(port);
+
+  pid_t pid = ::fork();
+  OATPP_ASSERT(pid >= 0);
+
+  if(pid == 0) {
+    ::dup2(handles[0], STDIN_FILENO);
+    ::close(handles[0]);
+    ::close(handles[1]);
+    ::execl(HOT_RESTART_EXE, HOT_RESTART_EXE, portStr->c_str(), handoffPath->c_str(), (char*) nullptr);
+    ::_exit(127);
+  }
+
+  ::close(handles[0]);
+  stdinHandle = handles[1];
+  return pid;
+
+}
+
+}
+
+void HotRestartTest::onRun() {
+
+  oatpp::String handoffPath = "/tmp/my-threaded-project-test-" + oatpp::utils::conversion::int32ToStdStr(::getpid()) + ".handoff";
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  auto connectionHandler = DrainingConnectionHandler::createShared(
+    oatpp::web::server::HttpConnectionHandler::createShared(router), std::chrono::seconds(5)
+  );
+
+  /* "Old" process */
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler);
+  lifecycle.start();
+
+  ListenerHandoff handoff(handoffPath, connectionProvider, lifecycle.getStopSignal());
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+  auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+  std::atomic<v_int64> served(0);
+  std::atomic<v_int64> failed(0);
+  std::atomic<bool> clientsShouldContinue(true);
+
+  /* New connection per request, so that every request goes through accept */
+  std::vector<std::thread> clients;
+  for(v_int32 i = 0; i < 4; i ++) {
+    clients.push_back(std::thread([client, &served, &failed, &clientsShouldContinue] {
+      while(clientsShouldContinue) {
+        try {
+          auto response = client->getRoot();
+          if(response->getStatusCode() == 200 && response->readBodyToString()) {
+            served ++;
+          } else {
+            failed ++;
+          }
+        } catch(...) {
+          failed ++;
+        }
+      }
+    }));
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  /* "New" process */
+  int childStdin;
+  auto childPid = spawnHotRestart(port, handoffPath, childStdin);
+
+  /* Handoff signals the old lifecycle to stop */
+  OATPP_ASSERT(lifecycle.getStopSignal()->waitFor(std::chrono::seconds(10)));
+  OATPP_ASSERT(handoff.isHandedOff());
+
+  lifecycle.stop();
+  OATPP_LOGD(TAG, "Old server drained: %lld, aborted: %lld",
+             (long long) connectionHandler->getReport().drained, (long long) connectionHandler->getReport().aborted);
+
+  /* Only the new process accepts now */
+  auto servedByOld = served.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  clientsShouldContinue = false;
+  for(auto& thread : clients) {
+    thread.join();
+  }
+
+  OATPP_LOGD(TAG, "served=%lld (after handoff %lld), failed=%lld",
+             (long long) served.load(), (long long) (served.load() - servedByOld), (long long) failed.load());
+
+  /* Stop the new process */
+  ::close(childStdin);
+  int status = 0;
+  ::waitpid(childPid, &status, 0);
+
+  OATPP_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  OATPP_ASSERT(failed == 0);
+  OATPP_ASSERT(served > servedByOld);
+
+}
@@ -0,0 +1,18 @@
+#ifndef HotRestartTest_hpp
+#define HotRestartTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+/**
+ * Runs a server in the test process, hands its listener over to a `HotRestart-exe` process while clients keep
+ * sending requests, and checks that no request failed during the swap.
+ */
+class HotRestartTest : public oatpp::test::UnitTest {
+public:
+
+  HotRestartTest() : UnitTest("TEST[HotRestartTest]"){}
+  void onRun() override;
+
+};
+
+#endif // HotRestartTest_hpp
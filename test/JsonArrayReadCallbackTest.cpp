@@ -0,0 +1,74 @@
+#include "JsonArrayReadCallbackTest.hpp"
+
+#include "dto/DTOs.hpp"
+#include "stream/JsonArrayReadCallback.hpp"
+
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+namespace {
+
+/* Read the whole array in small reads, as a connection would */
+std::string readAll(JsonArrayReadCallback& callback) {
+  std::string result;
+  char buffer[100];
+  oatpp::async::Action action;
+  oatpp::v_io_size res;
+  while((res = callback.read(buffer, sizeof(buffer), action)) > 0) {
+    result.append(buffer, (size_t) res);
+  }
+  return result;
+}
+
+}
+
+void JsonArrayReadCallbackTest::onRun() {
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  {
+    JsonArrayReadCallback callback([](oatpp::Void& element) {
+      (void) element;
+      return false;
+    }, objectMapper);
+    OATPP_ASSERT(readAll(callback) == "[]");
+  }
+
+  /* nullptr elements don't end the array */
+  {
+    auto first = MyDto::createShared();
+    first->statusCode = 200;
+    first->message = "first";
+
+    auto last = MyDto::createShared();
+    last->statusCode = 404;
+    last->message = "last";
+
+    auto list = oatpp::List<oatpp::Object<MyDto>>::createShared();
+    list->push_back(nullptr);
+    list->push_back(first);
+    list->push_back(nullptr);
+    list->push_back(last);
+
+    JsonArrayReadCallback callback(JsonArrayReadCallback::iterate(list), objectMapper);
+    auto json = readAll(callback);
+    OATPP_LOGD(TAG, "%s", json.c_str());
+    OATPP_ASSERT(json == "[null,{\"statusCode\":200,\"message\":\"first\"},null,{\"statusCode\":404,\"message\":\"last\"}]");
+  }
+
+  /* Many batches - still one well-formed array */
+  {
+    v_int32 index = 0;
+    JsonArrayReadCallback callback([&index](oatpp::Void& element) {
+      if(index == 10000) {
+        return false;
+      }
+      element = oatpp::Int32(index ++);
+      return true;
+    }, objectMapper);
+    auto json = readAll(callback);
+    auto list = objectMapper->readFromString<oatpp::List<oatpp::Int32>>(json.c_str());
+    OATPP_ASSERT(list->size() == 10000);
+    OATPP_ASSERT(list->back() == 9999);
+  }
+
+}
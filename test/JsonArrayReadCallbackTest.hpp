@@ -0,0 +1,14 @@
+#ifndef JsonArrayReadCallbackTest_hpp
+#define JsonArrayReadCallbackTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class JsonArrayReadCallbackTest : public oatpp::test::UnitTest {
+public:
+
+  JsonArrayReadCallbackTest() : UnitTest("TEST[JsonArrayReadCallbackTest]"){}
+  void onRun() override;
+
+};
+
+#endif // JsonArrayReadCallbackTest_hpp
@@ -0,0 +1,14 @@
+#ifndef MyAsyncControllerTest_hpp
+#define MyAsyncControllerTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class MyAsyncControllerTest : public oatpp::test::UnitTest {
+public:
+
+  MyAsyncControllerTest() : UnitTest("TEST[MyAsyncControllerTest]"){}
+  void onRun() override;
+
+};
+
+#endif // MyAsyncControllerTest_hpp
@@ -50,6 +50,43 @@ void MyControllerTest::onRun() {
     OATPP_ASSERT(message->statusCode == 200);
     OATPP_ASSERT(message->message == "Hello World!");
 
+    /* Root is served from the cache - same ETag gives 304 without a body */
+    auto etag = response->getHeader("ETag");
+    OATPP_ASSERT(etag);
+
+    auto notModified = client->getRootIfNoneMatch(etag);
+    OATPP_ASSERT(notModified->getStatusCode() == 304);
+    OATPP_ASSERT(notModified->getHeader("ETag") == etag);
+
+    auto modified = client->getRootIfNoneMatch("\"0000000000000000\"");
+    OATPP_ASSERT(modified->getStatusCode() == 200);
+    auto modifiedMessage = modified->readBodyToDto<oatpp::Object<MyDto>>(objectMapper.get());
+    OATPP_ASSERT(modifiedMessage && modifiedMessage->message == "Hello World!");
+
+    /* Items are streamed with chunked transfer encoding */
+    auto items = client->getItems(1000);
+    OATPP_ASSERT(items->getStatusCode() == 200);
+    OATPP_ASSERT(items->getHeader("Transfer-Encoding") == "chunked");
+    auto list = items->readBodyToDto<oatpp::List<oatpp::Object<MyDto>>>(objectMapper.get());
+    OATPP_ASSERT(list && list->size() == 1000);
+    OATPP_ASSERT(list->front()->message == "Item 0");
+    OATPP_ASSERT(list->back()->message == "Item 999");
+
+    auto noItems = client->getItems(0);
+    OATPP_ASSERT(noItems->getStatusCode() == 200);
+    OATPP_ASSERT(noItems->readBodyToString() == "[]");
+
+    OATPP_ASSERT(client->getItems(-1)->getStatusCode() == 400);
+
+    /* Greeting is built in a per-request arena */
+    for(v_int32 i = 0; i < 3; i ++) {
+      auto hello = client->getHello("Alice");
+      OATPP_ASSERT(hello->getStatusCode() == 200);
+      auto greeting = hello->readBodyToDto<oatpp::Object<MyDto>>(objectMapper.get());
+      OATPP_ASSERT(greeting && greeting->statusCode == 200);
+      OATPP_ASSERT(greeting->message == "Hello Alice!");
+    }
+
   }, std::chrono::minutes(10) /* test timeout */);
 
   /* wait all server threads finished */
@@ -0,0 +1,143 @@
+#include "ParkingConnectionHandlerTest.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include "app/LoopbackTestClient.hpp"
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr v_int32 CONNECTIONS = 32;
+
+/**
+ * Send `count` pipelined `GET /` in one write - the last one with `Connection: close` - and read until the server closes.
+ * @return - number of `200` responses.
+ */
+v_int32 pipeline(v_uint16 port, v_int32 count) {
+
+  std::string requests;
+  for(v_int32 i = 0; i < count; i ++) {
+    requests += i + 1 < count ? "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n"
+                              : "GET / HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n";
+  }
+  auto responses = LoopbackTestClient::request(port, requests);
+
+  v_int32 ok = 0;
+  for(auto pos = responses.find("HTTP/1.1 200"); pos != std::string::npos; pos = responses.find("HTTP/1.1 200", pos + 1)) {
+    ok ++;
+  }
+  return ok;
+
+}
+
+}
+
+void ParkingConnectionHandlerTest::onRun() {
+
+  /* Two workers for many more keep-alive connections */
+  AppComponent::Options options;
+  options.parking = std::make_shared<ParkingConnectionHandler::Config>();
+  options.parking->workersCount = 2;
+  options.parking->idleTimeout = std::chrono::milliseconds(1000);
+
+  AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE, options);
+
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(objectMapper));
+
+  auto handler = components.get<std::shared_ptr<ParkingConnectionHandler>>();
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+  auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+  auto openIdleConnections = [&client] {
+    std::vector<std::shared_ptr<oatpp::web::client::RequestExecutor::ConnectionHandle>> connections;
+    for(v_int32 i = 0; i < CONNECTIONS; i ++) {
+      auto connection = client->getConnection();
+      auto response = client->getRoot(connection);
+      OATPP_ASSERT(response->getStatusCode() == 200);
+      response->readBodyToString();
+      connections.push_back(connection);
+    }
+    return connections;
+  };
+
+  {
+
+    /* More keep-alive connections than workers - all of them served, then parked */
+    auto connections = openIdleConnections();
+    OATPP_ASSERT(LoopbackTestClient::waitFor([&handler] { return handler->getStats().parked == CONNECTIONS; }));
+    OATPP_ASSERT(handler->getStats().active == 0);
+
+    /* A parked connection is taken back by a worker when the next request arrives */
+    for(auto& connection : connections) {
+      auto response = client->getRoot(connection);
+      OATPP_ASSERT(response->getStatusCode() == 200);
+      response->readBodyToString();
+    }
+
+    /* Idle longer than the timeout - closed */
+    OATPP_ASSERT(LoopbackTestClient::waitFor([&handler] { return handler->getStats().parked == 0; }));
+    OATPP_ASSERT(handler->getStats().timedOut == CONNECTIONS);
+
+  }
+
+  /* Pipelined requests - all answered in order, responses batched into fewer writes */
+  {
+    auto before = handler->getStats();
+    OATPP_ASSERT(pipeline(port, 8) == 8);
+    auto after = handler->getStats();
+    OATPP_ASSERT(after.requests - before.requests == 8);
+    OATPP_ASSERT(after.writes - before.writes < 8);
+  }
+
+  /* Errors thrown by endpoints are answered with their own status */
+  {
+    auto response = client->getItems(-1);
+    OATPP_ASSERT(response->getStatusCode() == 400);
+    response->readBodyToString();
+  }
+
+  /* Clients stalled in the middle of their headers hold every worker - until the idle timeout fails their reads */
+  {
+    std::vector<int> stalled;
+    for(v_int32 i = 0; i < options.parking->workersCount; i ++) {
+      stalled.push_back(LoopbackTestClient::connect(port));
+      OATPP_ASSERT(LoopbackTestClient::send(stalled.back(), "GET / HTTP/1.1\r\nHost: localh"));
+    }
+    auto stallStart = std::chrono::steady_clock::now();
+    for(auto handle : stalled) {
+      OATPP_ASSERT(LoopbackTestClient::readAll(handle).empty());
+    }
+    OATPP_ASSERT(std::chrono::steady_clock::now() - stallStart < std::chrono::seconds(3));
+    auto response = client->getRoot();
+    OATPP_ASSERT(response->getStatusCode() == 200);
+    response->readBodyToString();
+  }
+
+  /* Idle connections don't hold stop() */
+  auto connections = openIdleConnections();
+  OATPP_ASSERT(LoopbackTestClient::waitFor([&handler] { return handler->getStats().parked == CONNECTIONS; }));
+
+  auto stopStart = std::chrono::steady_clock::now();
+  lifecycle.stop();
+  OATPP_ASSERT(std::chrono::steady_clock::now() - stopStart < std::chrono::milliseconds(250));
+
+  auto stats = handler->getStats();
+  OATPP_ASSERT(stats.parked == 0 && stats.active == 0);
+
+}
@@ -0,0 +1,14 @@
+#ifndef ParkingConnectionHandlerTest_hpp
+#define ParkingConnectionHandlerTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class ParkingConnectionHandlerTest : public oatpp::test::UnitTest {
+public:
+
+  ParkingConnectionHandlerTest() : UnitTest("TEST[ParkingConnectionHandlerTest]"){}
+  void onRun() override;
+
+};
+
+#endif // ParkingConnectionHandlerTest_hpp
@@ -0,0 +1,95 @@
+#include "PooledConnectionHandlerTest.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include "app/LoopbackTestClient.hpp"
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+#include <string>
+
+namespace {
+
+/**
+ * Send a request with a large body to `127.0.0.1:port` and read until the server closes the connection.
+ * @return - everything received.
+ */
+std::string postLargeBody(v_uint16 port) {
+
+  std::string body(256 * 1024, 'x');
+  std::string request = "POST / HTTP/1.1\r\nHost: localhost\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+  return LoopbackTestClient::request(port, request);
+
+}
+
+}
+
+void PooledConnectionHandlerTest::onRun() {
+
+  /* One worker, one place in the queue */
+  AppComponent::Options options;
+  options.pool = std::make_shared<PooledConnectionHandler::Config>();
+  options.pool->workersCount = 1;
+  options.pool->queueSize = 1;
+  options.pool->retryAfter = std::chrono::seconds(3);
+
+  AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE, options);
+
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(objectMapper));
+
+  auto handler = components.get<std::shared_ptr<PooledConnectionHandler>>();
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+  auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+  {
+
+    /* Keep-alive connection occupies the only worker */
+    auto busyConnection = client->getConnection();
+    auto response = client->getRoot(busyConnection);
+    OATPP_ASSERT(response->getStatusCode() == 200);
+    response->readBodyToString();
+    OATPP_ASSERT(handler->getStats().active == 1);
+
+    /* Second connection waits in the queue */
+    auto queuedConnection = client->getConnection();
+    OATPP_ASSERT(LoopbackTestClient::waitFor([&handler] { return handler->getStats().queueDepth == 1; }));
+
+    /* Third one is rejected right away */
+    auto rejected = client->getRoot();
+    OATPP_ASSERT(rejected->getStatusCode() == 503);
+    OATPP_ASSERT(rejected->getHeader("Retry-After") == "3");
+
+    /* Rejected while the request is still arriving - the 503 isn't lost to a reset */
+    auto received = postLargeBody(port);
+    OATPP_ASSERT(received.find("HTTP/1.1 503") == 0);
+
+    auto stats = handler->getStats();
+    OATPP_ASSERT(stats.rejected == 2);
+    OATPP_ASSERT(stats.queueDepth == 1);
+
+  }
+
+  /* The busy connection is closed - the worker takes the next one and serves new connections again */
+  OATPP_ASSERT(LoopbackTestClient::waitFor([&handler] { auto stats = handler->getStats(); return stats.active == 0 && stats.queueDepth == 0; }));
+
+  auto response = client->getRoot();
+  OATPP_ASSERT(response->getStatusCode() == 200);
+  response->readBodyToString();
+
+  lifecycle.stop();
+
+  OATPP_ASSERT(handler->getStats().rejected == 2);
+
+}
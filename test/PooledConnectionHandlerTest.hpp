@@ -0,0 +1,14 @@
+#ifndef PooledConnectionHandlerTest_hpp
+#define PooledConnectionHandlerTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class PooledConnectionHandlerTest : public oatpp::test::UnitTest {
+public:
+
+  PooledConnectionHandlerTest() : UnitTest("TEST[PooledConnectionHandlerTest]"){}
+  void onRun() override;
+
+};
+
+#endif // PooledConnectionHandlerTest_hpp
@@ -0,0 +1,89 @@
+#include "RequestMetricsTest.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MetricsController.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+namespace {
+
+void testBucketBoundaries() {
+
+  /* `le` is inclusive - 15us is in le="0.000015", 16us is not */
+  auto metrics = RequestMetrics::createShared();
+  metrics->record("GET", "/bounds", 200, 15);
+  metrics->record("GET", "/bounds", 200, 16);
+  metrics->record("GET", "/bounds", 200, 31);
+
+  auto text = metrics->renderPrometheus();
+  OATPP_ASSERT(text->find("http_request_duration_seconds_bucket{method=\"GET\",route=\"/bounds\",le=\"0.000015\"} 1\n") != std::string::npos);
+  OATPP_ASSERT(text->find("http_request_duration_seconds_bucket{method=\"GET\",route=\"/bounds\",le=\"0.000031\"} 3\n") != std::string::npos);
+
+}
+
+}
+
+void RequestMetricsTest::onRun() {
+
+  testBucketBoundaries();
+
+  AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE);
+
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  auto router = components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>();
+  router->addController(std::make_shared<MyController>(objectMapper));
+  router->addController(std::make_shared<MetricsController>(components.get<std::shared_ptr<RequestMetrics>>()));
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+  auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+  /* Every call is a new connection served by a new thread - shards of exited threads are retired into the totals */
+  for(v_int32 i = 0; i < 3; i ++) {
+    auto response = client->getRoot();
+    OATPP_ASSERT(response->getStatusCode() == 200);
+    response->readBodyToString();
+  }
+
+  auto connection = client->getConnection();
+  for(v_int32 i = 0; i < 2; i ++) {
+    auto response = client->getRoot(connection);
+    OATPP_ASSERT(response->getStatusCode() == 200);
+    response->readBodyToString();
+  }
+
+  /* Requests with different path variables are one route */
+  for(v_int32 i = 1; i <= 3; i ++) {
+    auto response = client->getItems(i, connection);
+    OATPP_ASSERT(response->getStatusCode() == 200);
+    response->readBodyToString();
+  }
+
+  auto response = client->getMetrics(connection);
+  OATPP_ASSERT(response->getStatusCode() == 200);
+  OATPP_ASSERT(response->getHeader("Content-Type") == "text/plain; version=0.0.4");
+
+  auto text = response->readBodyToString();
+  OATPP_LOGD(TAG, "\n%s", text->c_str());
+
+  OATPP_ASSERT(text->find("http_requests_total{method=\"GET\",route=\"/\",code=\"2xx\"} 5\n") != std::string::npos);
+  OATPP_ASSERT(text->find("http_request_duration_seconds_count{method=\"GET\",route=\"/\"} 5\n") != std::string::npos);
+  OATPP_ASSERT(text->find("http_request_duration_seconds_bucket{method=\"GET\",route=\"/\",le=\"+Inf\"} 5\n") != std::string::npos);
+  OATPP_ASSERT(text->find("http_requests_total{method=\"GET\",route=\"/items/{count}\",code=\"2xx\"} 3\n") != std::string::npos);
+  OATPP_ASSERT(text->find("route=\"/items/1\"") == std::string::npos);
+
+  connection.reset();
+  lifecycle.stop();
+
+}
@@ -0,0 +1,14 @@
+#ifndef RequestMetricsTest_hpp
+#define RequestMetricsTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class RequestMetricsTest : public oatpp::test::UnitTest {
+public:
+
+  RequestMetricsTest() : UnitTest("TEST[RequestMetricsTest]"){}
+  void onRun() override;
+
+};
+
+#endif // RequestMetricsTest_hpp
@@ -0,0 +1,297 @@
+#include "ResponseCompressionTest.hpp"
+
+#include "AppComponent.hpp"
+#include "compression/CompressedBody.hpp"
+#include "compression/ResponseCompression.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include "app/LoopbackTestClient.hpp"
+#include "app/PayloadController.hpp"
+
+#include "oatpp/web/protocol/http/outgoing/BufferBody.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <zlib.h>
+
+namespace {
+
+typedef Compressor::Encoding Encoding;
+
+struct Response {
+  v_int32 status;
+  std::string headers; // lower case
+  std::string body;    // without transfer encoding
+
+  bool hasHeader(const std::string& line) const {
+    return headers.find("\r\n" + line + "\r\n") != std::string::npos;
+  }
+
+  std::string getHeader(const std::string& name) const {
+    auto pos = headers.find("\r\n" + name + ": ");
+    if(pos == std::string::npos) {
+      return "";
+    }
+    pos += name.size() + 4;
+    return headers.substr(pos, headers.find("\r\n", pos) - pos);
+  }
+};
+
+/**
+ * Send `GET path` with `Connection: close` to `127.0.0.1:port`, read the response until the server closes.
+ */
+Response fetch(v_uint16 port, const std::string& path, const std::string& extraHeaders = "") {
+
+  std::string request = "GET " + path + " HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n" + extraHeaders + "\r\n";
+  auto data = LoopbackTestClient::request(port, request);
+
+  auto headersEnd = data.find("\r\n\r\n");
+  OATPP_ASSERT(headersEnd != std::string::npos);
+
+  Response response;
+  response.status = (v_int32) std::strtol(data.c_str() + 9, nullptr, 10);
+  response.headers = data.substr(0, headersEnd + 2);
+  for(auto& c : response.headers) {
+    c = (char) std::tolower((unsigned char) c);
+  }
+
+  auto body = data.substr(headersEnd + 4);
+  if(!response.hasHeader("transfer-encoding: chunked")) {
+    response.body = body;
+    return response;
+  }
+
+  size_t pos = 0;
+  while(true) {
+    auto lineEnd = body.find("\r\n", pos);
+    OATPP_ASSERT(lineEnd != std::string::npos);
+    auto size = (size_t) std::strtoul(body.c_str() + pos, nullptr, 16);
+    if(size == 0) {
+      break;
+    }
+    response.body.append(body, lineEnd + 2, size);
+    pos = lineEnd + 2 + size + 2;
+  }
+  return response;
+
+}
+
+std::string decompress(const std::string& data, Encoding encoding) {
+
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  OATPP_ASSERT(inflateInit2(&stream, encoding == Encoding::GZIP ? 16 + 15 : 15) == Z_OK);
+
+  stream.next_in = (Bytef*) data.data();
+  stream.avail_in = (uInt) data.size();
+
+  std::string result;
+  char buffer[4096];
+  int res;
+  do {
+    stream.next_out = (Bytef*) buffer;
+    stream.avail_out = sizeof(buffer);
+    res = inflate(&stream, Z_NO_FLUSH);
+    OATPP_ASSERT(res == Z_OK || res == Z_STREAM_END);
+    result.append(buffer, sizeof(buffer) - stream.avail_out);
+  } while(res != Z_STREAM_END);
+
+  /* Exactly one complete stream */
+  OATPP_ASSERT(stream.avail_in == 0);
+  inflateEnd(&stream);
+  return result;
+
+}
+
+void testNegotiation() {
+
+  Encoding encoding;
+
+  OATPP_ASSERT(!ResponseCompression::selectEncoding(nullptr, true, encoding));
+  OATPP_ASSERT(!ResponseCompression::selectEncoding("identity", true, encoding));
+  OATPP_ASSERT(!ResponseCompression::selectEncoding("gzip;q=0, deflate;q=0", true, encoding));
+
+  OATPP_ASSERT(ResponseCompression::selectEncoding("gzip, deflate, br", true, encoding) && encoding == Encoding::BROTLI);
+  OATPP_ASSERT(ResponseCompression::selectEncoding("gzip, deflate, br", false, encoding) && encoding == Encoding::GZIP);
+  OATPP_ASSERT(ResponseCompression::selectEncoding("deflate;q=0.9, GZIP ; q=0.5", true, encoding) && encoding == Encoding::DEFLATE);
+  OATPP_ASSERT(ResponseCompression::selectEncoding("*;q=0.1, gzip;q=0", false, encoding) && encoding == Encoding::DEFLATE);
+  OATPP_ASSERT(ResponseCompression::selectEncoding("x-gzip", false, encoding) && encoding == Encoding::GZIP);
+
+  OATPP_ASSERT(ResponseCompression::isCompressible("application/json"));
+  OATPP_ASSERT(ResponseCompression::isCompressible("Text/HTML; charset=utf-8"));
+  OATPP_ASSERT(ResponseCompression::isCompressible("application/problem+json"));
+  OATPP_ASSERT(!ResponseCompression::isCompressible("application/octet-stream"));
+  OATPP_ASSERT(!ResponseCompression::isCompressible("image/png"));
+  OATPP_ASSERT(!ResponseCompression::isCompressible(nullptr));
+
+}
+
+void testCompressedBody() {
+
+  std::string data;
+  for(v_int32 i = 0; i < 20000; i ++) {
+    data += "{\"item\":" + std::to_string(i) + "},";
+  }
+
+  for(auto encoding : {Encoding::GZIP, Encoding::DEFLATE}) {
+
+    OATPP_ASSERT(decompress(Compressor::compress(encoding, 6, data.data(), data.size()), encoding) == data);
+
+    /* Small chunks and small reads - the stream must come out the same */
+    auto source = oatpp::web::protocol::http::outgoing::BufferBody::createShared(data.c_str(), nullptr);
+    CompressedBody body(source, Compressor::create(encoding, 6), 1000);
+    OATPP_ASSERT(body.getKnownSize() == -1);
+
+    std::string compressed;
+    char buffer[333];
+    oatpp::async::Action action;
+    oatpp::v_io_size res;
+    while((res = body.read(buffer, sizeof(buffer), action)) > 0) {
+      compressed.append(buffer, (size_t) res);
+    }
+    OATPP_ASSERT(res == 0);
+    OATPP_ASSERT(compressed.size() < data.size() / 4);
+    OATPP_ASSERT(decompress(compressed, encoding) == data);
+
+  }
+
+}
+
+/**
+ * Serve `/payload/cached` gzip and deflate encoded from a cache with room for one variant.
+ * @param body - identity body of `/payload/cached`.
+ */
+void testCacheEviction(const std::string& body) {
+
+  auto gzipSize = Compressor::compress(Encoding::GZIP, 6, body.data(), body.size()).size();
+  auto deflateSize = Compressor::compress(Encoding::DEFLATE, 6, body.data(), body.size()).size();
+
+  AppComponent::Options options;
+  options.compression = std::make_shared<ResponseCompression::Config>();
+  options.compression->cacheMaxBytes = (v_int64) std::max(gzipSize, deflateSize);
+  AppComponent components(ServerConfig(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4)),
+                          AppComponent::Scope::INSTANCE, options);
+
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<PayloadController>(objectMapper));
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+  auto compression = components.get<std::shared_ptr<ResponseCompression>>();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  /* gzip, gzip (hit), deflate (evicts gzip), deflate (hit), gzip (evicts deflate) */
+  const char* encodings[] = {"gzip", "gzip", "deflate", "deflate", "gzip"};
+  for(auto encoding : encodings) {
+    auto response = fetch(port, "/payload/cached", std::string("Accept-Encoding: ") + encoding + "\r\n");
+    OATPP_ASSERT(response.getHeader("content-encoding") == encoding);
+    OATPP_ASSERT(decompress(response.body, response.getHeader("content-encoding") == "gzip" ? Encoding::GZIP : Encoding::DEFLATE) == body);
+  }
+
+  auto stats = compression->getStats();
+  OATPP_ASSERT(stats.cacheHits == 2);
+  OATPP_ASSERT(stats.cacheEvictions == 2);
+  OATPP_ASSERT(stats.cacheEntries == 1);
+  OATPP_ASSERT(stats.cacheBytes == (v_int64) gzipSize);
+
+  lifecycle.stop();
+
+}
+
+void testServer() {
+
+  AppComponent::Options options;
+  options.compression = std::make_shared<ResponseCompression::Config>();
+  AppComponent components(ServerConfig(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4)),
+                          AppComponent::Scope::INSTANCE, options);
+
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  auto router = components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>();
+  router->addController(std::make_shared<MyController>(objectMapper));
+  router->addController(std::make_shared<PayloadController>(objectMapper));
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto port = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider)->getPort();
+  auto compression = components.get<std::shared_ptr<ResponseCompression>>();
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  /* Identity - the reference bodies */
+  auto cached = fetch(port, "/payload/cached");
+  OATPP_ASSERT(cached.status == 200);
+  OATPP_ASSERT(cached.getHeader("content-encoding").empty());
+  OATPP_ASSERT(cached.hasHeader("vary: accept-encoding"));
+  OATPP_ASSERT(cached.body.size() > 1024);
+
+  auto dto = fetch(port, "/payload/dto");
+  auto items = fetch(port, "/items/2000");
+  OATPP_ASSERT(dto.status == 200 && items.status == 200);
+
+  /* Cached body - compressed once, then served from the cache */
+  for(v_int32 i = 0; i < 3; i ++) {
+    auto response = fetch(port, "/payload/cached", "Accept-Encoding: gzip, deflate\r\n");
+    OATPP_ASSERT(response.status == 200);
+    OATPP_ASSERT(response.getHeader("content-encoding") == "gzip");
+    OATPP_ASSERT(response.getHeader("content-length") == std::to_string(response.body.size()));
+    OATPP_ASSERT(response.getHeader("etag") == "w/" + cached.getHeader("etag"));
+    OATPP_ASSERT(decompress(response.body, Encoding::GZIP) == cached.body);
+  }
+
+  /* Same ETag with a query - the same cached variant */
+  auto withQuery = fetch(port, "/payload/cached?v=2", "Accept-Encoding: gzip\r\n");
+  OATPP_ASSERT(withQuery.getHeader("content-encoding") == "gzip");
+  OATPP_ASSERT(decompress(withQuery.body, Encoding::GZIP) == cached.body);
+
+  auto stats = compression->getStats();
+  OATPP_ASSERT(stats.cacheEntries == 1);
+  OATPP_ASSERT(stats.cacheHits == 3);
+  OATPP_ASSERT(stats.cacheEvictions == 0);
+
+  /* The weak ETag of the compressed variant still validates */
+  auto notModified = fetch(port, "/payload/cached", "Accept-Encoding: gzip\r\nIf-None-Match: W/" + cached.getHeader("etag") + "\r\n");
+  OATPP_ASSERT(notModified.status == 304);
+
+  /* Serialized on every request - compressed on every request */
+  auto deflated = fetch(port, "/payload/dto", "Accept-Encoding: deflate\r\n");
+  OATPP_ASSERT(deflated.getHeader("content-encoding") == "deflate");
+  OATPP_ASSERT(decompress(deflated.body, Encoding::DEFLATE) == dto.body);
+
+  /* Streamed body - compressed chunk by chunk */
+  auto streamed = fetch(port, "/items/2000", "Accept-Encoding: gzip\r\n");
+  OATPP_ASSERT(streamed.hasHeader("transfer-encoding: chunked"));
+  OATPP_ASSERT(streamed.getHeader("content-encoding") == "gzip");
+  OATPP_ASSERT(decompress(streamed.body, Encoding::GZIP) == items.body);
+  OATPP_ASSERT(streamed.body.size() < items.body.size() / 4);
+
+  /* Tiny body - sent as it is */
+  auto root = fetch(port, "/", "Accept-Encoding: gzip\r\n");
+  OATPP_ASSERT(root.status == 200);
+  OATPP_ASSERT(root.getHeader("content-encoding").empty());
+
+  if(Compressor::isSupported(Encoding::BROTLI)) {
+    auto brotli = fetch(port, "/payload/dto", "Accept-Encoding: gzip, br\r\n");
+    OATPP_ASSERT(brotli.getHeader("content-encoding") == "br");
+    OATPP_ASSERT(brotli.body.size() < dto.body.size() / 4);
+  }
+
+  lifecycle.stop();
+
+  testCacheEviction(cached.body);
+
+}
+
+}
+
+void ResponseCompressionTest::onRun() {
+  testNegotiation();
+  testCompressedBody();
+  testServer();
+}
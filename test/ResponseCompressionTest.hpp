@@ -0,0 +1,14 @@
+#ifndef ResponseCompressionTest_hpp
+#define ResponseCompressionTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class ResponseCompressionTest : public oatpp::test::UnitTest {
+public:
+
+  ResponseCompressionTest() : UnitTest("TEST[ResponseCompressionTest]"){}
+  void onRun() override;
+
+};
+
+#endif // ResponseCompressionTest_hpp
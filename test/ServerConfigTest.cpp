@@ -0,0 +1,242 @@
+#include "ServerConfigTest.hpp"
+
+#include "AppComponent.hpp"
+#include "config/ServerConfig.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+
+#include "app/LoopbackTestClient.hpp"
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/Connection.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+int getOption(oatpp::v_io_handle handle, int level, int name) {
+  int value = -1;
+  socklen_t size = sizeof(value);
+  OATPP_ASSERT(::getsockopt(handle, level, name, &value, &size) == 0);
+  return value;
+}
+
+/**
+ * Connect to `127.0.0.1:port` and send a few bytes, so that a deferred accept completes.
+ */
+int connectAndSend(v_uint16 port) {
+  int handle = LoopbackTestClient::connect(port);
+  OATPP_ASSERT(LoopbackTestClient::send(handle, "GET"));
+  return handle;
+}
+
+void testParsing() {
+
+  char path[] = "/tmp/server-config-test-XXXXXX";
+  int handle = ::mkstemp(path);
+  OATPP_ASSERT(handle >= 0);
+  ::close(handle);
+
+  auto file = std::fopen(path, "w");
+  std::fputs("# listener\n"
+             "host = 127.0.0.1\n"
+             "port=0\n"
+             "\n"
+             "  backlog = 128  \n"
+             "so_rcvbuf = 65536\n"
+             "TCP_NODELAY = off\n"
+             "tcp_fastopen = 16\n"
+             "warm_up_paths = /, /items/10\n"
+             "handler = parking\n"
+             "workers = 4\n"
+             "no_such_key = 1\n", file);
+  std::fclose(file);
+
+  ServerConfig config;
+  OATPP_ASSERT(config.address.port == 8000);
+  OATPP_ASSERT(config.socketOptions.backlog == 10000);
+  OATPP_ASSERT(config.socketOptions.noDelay);
+  OATPP_ASSERT(config.warmUp.enabled);
+  OATPP_ASSERT(!config.parkingHandler);
+
+  config.readFile(path);
+  OATPP_ASSERT(config.address.host == "127.0.0.1");
+  OATPP_ASSERT(config.address.port == 0);
+  OATPP_ASSERT(config.address.family == oatpp::network::Address::IP_4);
+  OATPP_ASSERT(config.socketOptions.backlog == 128);
+  OATPP_ASSERT(config.socketOptions.receiveBufferSize == 65536);
+  OATPP_ASSERT(config.socketOptions.sendBufferSize == 0);
+  OATPP_ASSERT(!config.socketOptions.noDelay);
+  OATPP_ASSERT(config.socketOptions.fastOpenQueue == 16);
+  OATPP_ASSERT(!config.socketOptions.dualStack);
+  OATPP_ASSERT(config.warmUp.paths == std::vector<std::string>({"/", "/items/10"}));
+  OATPP_ASSERT(config.parkingHandler);
+  OATPP_ASSERT(config.parking.workersCount == 4);
+  OATPP_ASSERT(config.parking.idleTimeout == std::chrono::milliseconds(5000));
+
+  std::remove(path);
+
+  /* Environment overrides the file */
+  ::setenv("SERVER_CONFIG_TEST_TCP_NODELAY", "true", 1);
+  ::setenv("SERVER_CONFIG_TEST_FAMILY", "ipv6", 1);
+  ::setenv("SERVER_CONFIG_TEST_IPV6_DUALSTACK", "yes", 1);
+  ::setenv("SERVER_CONFIG_TEST_WARM_UP", "off", 1);
+  config.readEnvironment("SERVER_CONFIG_TEST_");
+  ::unsetenv("SERVER_CONFIG_TEST_WARM_UP");
+  ::unsetenv("SERVER_CONFIG_TEST_TCP_NODELAY");
+  ::unsetenv("SERVER_CONFIG_TEST_FAMILY");
+  ::unsetenv("SERVER_CONFIG_TEST_IPV6_DUALSTACK");
+
+  OATPP_ASSERT(config.socketOptions.noDelay);
+  OATPP_ASSERT(config.address.family == oatpp::network::Address::IP_6);
+  OATPP_ASSERT(config.socketOptions.dualStack);
+  OATPP_ASSERT(config.socketOptions.backlog == 128);
+  OATPP_ASSERT(!config.warmUp.enabled);
+
+  /* Invalid values */
+  for(auto& invalid : std::vector<std::pair<std::string, std::string>>{
+    {"port", "65536"}, {"port", "80x"}, {"backlog", "0"}, {"so_sndbuf", "-1"}, {"tcp_nodelay", "maybe"}, {"family", "ipx"},
+    {"warm_up_paths", "/,items"}, {"warm_up_requests", "-1"}, {"handler", "epoll"}, {"workers", "0"}
+  }) {
+    bool thrown = false;
+    try {
+      config.set(invalid.first, invalid.second);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+  OATPP_ASSERT(!config.set("no_such_key", "1"));
+
+  bool thrown = false;
+  try {
+    config.readFile("/nonexistent/server.conf");
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  OATPP_ASSERT(thrown);
+
+}
+
+void testSocketOptions() {
+
+  ServerConfig config(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4));
+  config.socketOptions.backlog = 64;
+  config.socketOptions.receiveBufferSize = 128 * 1024;
+  config.socketOptions.sendBufferSize = 128 * 1024;
+  config.socketOptions.noDelay = true;
+  config.socketOptions.deferAcceptSeconds = 1;
+  config.socketOptions.fastOpenQueue = 16;
+
+  auto provider = config.createConnectionProvider();
+  auto serverHandle = provider->getHandle();
+
+  /* Linux doubles the requested size for bookkeeping, other systems keep it */
+  OATPP_ASSERT(getOption(serverHandle, SOL_SOCKET, SO_RCVBUF) >= 128 * 1024);
+  OATPP_ASSERT(getOption(serverHandle, SOL_SOCKET, SO_SNDBUF) >= 128 * 1024);
+#if defined(__linux__)
+  OATPP_ASSERT(getOption(serverHandle, IPPROTO_TCP, TCP_DEFER_ACCEPT) > 0);
+  OATPP_ASSERT(getOption(serverHandle, IPPROTO_TCP, TCP_FASTOPEN) == 16);
+#endif
+
+  /* Accepted sockets */
+  int client = connectAndSend(provider->getPort());
+  auto connection = provider->get();
+  OATPP_ASSERT(connection.object);
+
+  auto acceptedHandle = std::static_pointer_cast<oatpp::network::tcp::Connection>(connection.object)->getHandle();
+  OATPP_ASSERT(getOption(acceptedHandle, IPPROTO_TCP, TCP_NODELAY) != 0);
+  OATPP_ASSERT(getOption(acceptedHandle, SOL_SOCKET, SO_RCVBUF) >= 128 * 1024);
+  OATPP_ASSERT(getOption(acceptedHandle, SOL_SOCKET, SO_SNDBUF) >= 128 * 1024);
+
+  ::close(client);
+
+  /* Default options turn Nagle off */
+  auto defaultProvider = ServerConfig(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4)).createConnectionProvider();
+  client = connectAndSend(defaultProvider->getPort());
+  auto defaultConnection = defaultProvider->get();
+  OATPP_ASSERT(defaultConnection.object);
+  auto defaultHandle = std::static_pointer_cast<oatpp::network::tcp::Connection>(defaultConnection.object)->getHandle();
+  OATPP_ASSERT(getOption(defaultHandle, IPPROTO_TCP, TCP_NODELAY) != 0);
+  ::close(client);
+
+}
+
+void testDualStack() {
+
+  ServerConfig config(oatpp::network::Address("::", 0, oatpp::network::Address::IP_6));
+  config.socketOptions.dualStack = true;
+
+  std::shared_ptr<ListenerConnectionProvider> provider;
+  try {
+    provider = config.createConnectionProvider();
+  } catch (const std::runtime_error&) {
+    OATPP_LOGW("ServerConfigTest", "IPv6 is not available - dual-stack check skipped");
+    return;
+  }
+
+  OATPP_ASSERT(getOption(provider->getHandle(), IPPROTO_IPV6, IPV6_V6ONLY) == 0);
+
+  /* IPv4 client on the IPv6 listener */
+  int client = connectAndSend(provider->getPort());
+  auto connection = provider->get();
+  OATPP_ASSERT(connection.object);
+  ::close(client);
+
+  config.socketOptions.dualStack = false;
+  auto v6OnlyProvider = config.createConnectionProvider();
+  OATPP_ASSERT(getOption(v6OnlyProvider->getHandle(), IPPROTO_IPV6, IPV6_V6ONLY) == 1);
+
+}
+
+void testAppComponent() {
+
+  ServerConfig config(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4));
+  config.socketOptions.noDelay = false;
+  config.socketOptions.deferAcceptSeconds = 1;
+  config.parkingHandler = true;
+  config.parking.workersCount = 2;
+
+  AppComponent components(config, AppComponent::Scope::INSTANCE);
+  OATPP_ASSERT(components.get<std::shared_ptr<ParkingConnectionHandler>>());
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto listener = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider);
+  OATPP_ASSERT(!listener->getOptions().noDelay);
+
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(objectMapper));
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", listener->getPort()});
+  auto client = MyApiTestClient::createShared(oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider), objectMapper);
+  for(v_int32 i = 0; i < 10; i ++) {
+    OATPP_ASSERT(client->getRoot()->getStatusCode() == 200);
+  }
+
+  lifecycle.stop();
+
+}
+
+}
+
+void ServerConfigTest::onRun() {
+  testParsing();
+  testSocketOptions();
+  testDualStack();
+  testAppComponent();
+}
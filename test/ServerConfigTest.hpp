@@ -0,0 +1,14 @@
+#ifndef ServerConfigTest_hpp
+#define ServerConfigTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class ServerConfigTest : public oatpp::test::UnitTest {
+public:
+
+  ServerConfigTest() : UnitTest("TEST[ServerConfigTest]"){}
+  void onRun() override;
+
+};
+
+#endif // ServerConfigTest_hpp
@@ -0,0 +1,60 @@
+#include "ServerGroupTest.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerGroup.hpp"
+
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+#include <atomic>
+
+void ServerGroupTest::onRun() {
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  std::atomic<v_int32> handlersCount(0);
+
+  ServerGroup group({"127.0.0.1", 0, oatpp::network::Address::IP_4}, 4, [router, &handlersCount](v_int32) {
+    handlersCount ++;
+    return oatpp::web::server::HttpConnectionHandler::createShared(router);
+  });
+
+  OATPP_ASSERT(group.getAcceptorsCount() == 4);
+  OATPP_ASSERT(handlersCount == 4);
+
+  group.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", group.getPort()});
+  auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+  auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+  /* New connection per request, so that the requests are spread over the members */
+  for(v_int32 i = 0; i < 20; i ++) {
+    auto response = client->getRoot();
+    OATPP_ASSERT(response->getStatusCode() == 200);
+    auto message = response->readBodyToDto<oatpp::Object<MyDto>>(objectMapper.get());
+    OATPP_ASSERT(message->message == "Hello World!");
+  }
+
+  auto stopStart = std::chrono::steady_clock::now();
+  group.stop();
+  OATPP_ASSERT(std::chrono::steady_clock::now() - stopStart < std::chrono::milliseconds(500));
+
+
+  /* Stop right after start - before the members' accept threads got to run their servers - must not hang */
+  for(v_int32 i = 0; i < 20; i ++) {
+    ServerGroup quickGroup({"127.0.0.1", 0, oatpp::network::Address::IP_4}, 4, [router](v_int32) {
+      return oatpp::web::server::HttpConnectionHandler::createShared(router);
+    }, i % 2 == 0);
+    quickGroup.start();
+    quickGroup.stop();
+  }
+
+}
@@ -0,0 +1,14 @@
+#ifndef ServerGroupTest_hpp
+#define ServerGroupTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class ServerGroupTest : public oatpp::test::UnitTest {
+public:
+
+  ServerGroupTest() : UnitTest("TEST[ServerGroupTest]"){}
+  void onRun() override;
+
+};
+
+#endif // ServerGroupTest_hpp
@@ -0,0 +1,74 @@
+#include "ServerLifecycleTest.hpp"
+
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "network/ListenerConnectionProvider.hpp"
+
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/web/server/HttpConnectionHandler.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+
+void ServerLifecycleTest::onRun() {
+
+  auto objectMapper = oatpp::parser::json::mapping::ObjectMapper::createShared();
+
+  auto router = oatpp::web::server::HttpRouter::createShared();
+  router->addController(std::make_shared<MyController>(objectMapper));
+
+  auto connectionHandler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+
+  /* Listen on an ephemeral port */
+  auto connectionProvider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+  auto port = connectionProvider->getPort();
+
+  auto stopSignal = std::make_shared<StopSignal>();
+
+  ServerLifecycle lifecycle(connectionProvider, connectionHandler, stopSignal);
+
+  std::thread serverThread([&lifecycle] {
+    lifecycle.run();
+  });
+
+  {
+    auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", port});
+    auto requestExecutor = oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider);
+    auto client = MyApiTestClient::createShared(requestExecutor, objectMapper);
+
+    auto response = client->getRoot();
+    OATPP_ASSERT(response->getStatusCode() == 200);
+
+    auto message = response->readBodyToDto<oatpp::Object<MyDto>>(objectMapper.get());
+    OATPP_ASSERT(message);
+    OATPP_ASSERT(message->message == "Hello World!");
+  }
+
+  OATPP_ASSERT(lifecycle.isRunning());
+
+  /* Accept loop must be woken right away, not after a poll timeout */
+  auto stopStart = std::chrono::steady_clock::now();
+  stopSignal->signal();
+  serverThread.join();
+  auto stopTime = std::chrono::steady_clock::now() - stopStart;
+
+  OATPP_LOGD(TAG, "Stopped in %lld us", (long long) std::chrono::duration_cast<std::chrono::microseconds>(stopTime).count());
+  OATPP_ASSERT(stopTime < std::chrono::milliseconds(500));
+  OATPP_ASSERT(!lifecycle.isRunning());
+
+  /* Stopping again is a no-op */
+  lifecycle.stop();
+
+  /* Stop right after start - before the accept thread got to run the server - must not hang */
+  for(v_int32 i = 0; i < 100; i ++) {
+    auto provider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4});
+    auto handler = oatpp::web::server::HttpConnectionHandler::createShared(router);
+    ServerLifecycle quickLifecycle(provider, handler);
+    quickLifecycle.start();
+    if(i % 2 == 0) {
+      quickLifecycle.stop();
+    } // else stopped by the destructor
+  }
+
+}
@@ -0,0 +1,14 @@
+#ifndef ServerLifecycleTest_hpp
+#define ServerLifecycleTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class ServerLifecycleTest : public oatpp::test::UnitTest {
+public:
+
+  ServerLifecycleTest() : UnitTest("TEST[ServerLifecycleTest]"){}
+  void onRun() override;
+
+};
+
+#endif // ServerLifecycleTest_hpp
@@ -0,0 +1,156 @@
+#include "SimdObjectMapperTest.hpp"
+
+#include "AppComponent.hpp"
+#include "dto/DTOs.hpp"
+#include "mapping/SimdObjectMapper.hpp"
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+const char* const ESCAPES[] = {"\\\"", "\\\\", "\\/", "\\b", "\\f", "\\n", "\\r", "\\t", "\\u00e9", "\\u20AC", "\\ud83d\\ude00", "\\x"};
+const char* const MULTIBYTE[] = {"\xc3\xa9", "\xe2\x82\xac", "\xe6\x97\xa5", "\xf0\x9f\x98\x80"};
+
+v_int32 pick(std::mt19937& random, v_int32 count) {
+  return (v_int32) (random() % count);
+}
+
+std::string whitespace(std::mt19937& random) {
+  static const char* const SPACES[] = {"", "", "", " ", "\n  ", "\t", "\r\n"};
+  return SPACES[pick(random, 7)];
+}
+
+/* Mostly valid string literal - lengths cross the 16 and 32 byte blocks, sometimes escapes, raw control characters or quotes */
+std::string stringLiteral(std::mt19937& random) {
+  std::string result = "\"";
+  auto length = pick(random, 100);
+  for(v_int32 i = 0; i < length; i ++) {
+    auto kind = pick(random, 100);
+    if(kind < 80) {
+      char c = (char) (0x20 + pick(random, 0x5F));
+      result += (c == '"' || c == '\\') ? 'a' : c;
+    } else if(kind < 90) {
+      result += MULTIBYTE[pick(random, 4)];
+    } else if(kind < 97) {
+      result += ESCAPES[pick(random, 12)];
+    } else if(kind < 99) {
+      result += (char) pick(random, 0x20);
+    } else {
+      result += '"';
+    }
+  }
+  return result + "\"";
+}
+
+std::string dtoJson(std::mt19937& random) {
+
+  std::vector<std::string> fields;
+  fields.push_back("\"statusCode\"" + whitespace(random) + ":" + whitespace(random) +
+                   (pick(random, 10) == 0 ? std::string("null") : std::to_string((v_int32) random())));
+  fields.push_back("\"message\"" + whitespace(random) + ":" + whitespace(random) +
+                   (pick(random, 10) == 0 ? std::string("null") : stringLiteral(random)));
+  if(pick(random, 4) == 0) {
+    fields.push_back("\"unknown\":" + stringLiteral(random));
+  }
+  std::shuffle(fields.begin(), fields.end(), random);
+
+  std::string result = "{" + whitespace(random);
+  for(size_t i = 0; i < fields.size(); i ++) {
+    if(i > 0) {
+      result += "," + whitespace(random);
+    }
+    result += fields[i] + whitespace(random);
+  }
+  return result + "}";
+
+}
+
+std::string documentJson(std::mt19937& random) {
+  std::string result = "[" + whitespace(random);
+  auto count = pick(random, 5);
+  for(v_int32 i = 0; i < count; i ++) {
+    if(i > 0) {
+      result += "," + whitespace(random);
+    }
+    result += dtoJson(random);
+  }
+  result += whitespace(random) + "]";
+  /* Truncated documents */
+  if(pick(random, 10) == 0) {
+    result.resize(pick(random, (v_int32) result.size() + 1));
+  }
+  return result;
+}
+
+/* Parse result re-serialized with the stock mapper, "error" if parsing failed */
+std::string parse(const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& mapper,
+                  const std::shared_ptr<oatpp::data::mapping::ObjectMapper>& writer,
+                  const std::string& json)
+{
+  try {
+    auto list = mapper->readFromString<oatpp::List<oatpp::Object<MyDto>>>(json);
+    return *writer->writeToString(list);
+  } catch (const std::exception&) {
+    return "error";
+  }
+}
+
+}
+
+void SimdObjectMapperTest::onRun() {
+
+  auto level = SimdObjectMapper::getLevel();
+  OATPP_LOGI(TAG, "level=%s", SimdObjectMapper::getLevelName(level));
+
+  std::mt19937 random(20240601);
+
+  /* Every supported kernel finds the same stop as the scalar one */
+  {
+    char buffer[256];
+    for(v_int32 i = 0; i < 100000; i ++) {
+      auto size = pick(random, (v_int32) sizeof(buffer));
+      for(v_int32 j = 0; j < size; j ++) {
+        buffer[j] = (char) (0x20 + pick(random, 0xE0));
+        if(buffer[j] == '"' || buffer[j] == '\\') {
+          buffer[j] = 'a';
+        }
+      }
+      if(size > 0 && pick(random, 2) == 0) {
+        static const char STOPS[] = {'"', '\\', '\x00', '\x1f'};
+        buffer[pick(random, size)] = STOPS[pick(random, 4)];
+      }
+      auto expected = SimdObjectMapper::findStringStop(buffer, size, SimdObjectMapper::Level::SCALAR);
+      for(v_int32 l = 1; l <= (v_int32) level; l ++) {
+        OATPP_ASSERT(SimdObjectMapper::findStringStop(buffer, size, (SimdObjectMapper::Level) l) == expected);
+      }
+    }
+  }
+
+  /* Differential fuzz against the stock mapper - same DTOs, same failures */
+  auto stock = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  auto simd = SimdObjectMapper::createShared();
+
+  v_int32 failed = 0;
+  v_int32 errors = 0;
+  for(v_int32 i = 0; i < 20000; i ++) {
+    auto json = documentJson(random);
+    auto expected = parse(stock, stock, json);
+    auto actual = parse(simd, stock, json);
+    if(expected != actual) {
+      OATPP_LOGE(TAG, "Mismatch on '%s': expected '%s', got '%s'", json.c_str(), expected.c_str(), actual.c_str());
+      failed ++;
+    } else if(expected == "error") {
+      errors ++;
+    }
+  }
+  OATPP_LOGD(TAG, "documents=20000, rejected by both=%d", errors);
+  OATPP_ASSERT(failed == 0);
+
+  /* Selected in AppComponent */
+  AppComponent::Options options;
+  options.jsonMapper = AppComponent::JsonMapper::SIMD;
+  AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE, options);
+  OATPP_ASSERT(std::dynamic_pointer_cast<SimdObjectMapper>(components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>()));
+
+}
@@ -0,0 +1,14 @@
+#ifndef SimdObjectMapperTest_hpp
+#define SimdObjectMapperTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class SimdObjectMapperTest : public oatpp::test::UnitTest {
+public:
+
+  SimdObjectMapperTest() : UnitTest("TEST[SimdObjectMapperTest]"){}
+  void onRun() override;
+
+};
+
+#endif // SimdObjectMapperTest_hpp
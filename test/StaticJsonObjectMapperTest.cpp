@@ -0,0 +1,139 @@
+#include "StaticJsonObjectMapperTest.hpp"
+
+#include "dto/DTOs.hpp"
+#include "mapping/StaticJsonObjectMapper.hpp"
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class StaticCheckDto : public oatpp::DTO {
+
+  DTO_INIT(StaticCheckDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name, "full-name");
+
+};
+
+class StaticCheckChildDto : public StaticCheckDto {
+
+  DTO_INIT(StaticCheckChildDto, StaticCheckDto)
+
+  DTO_FIELD(Int64, size);
+
+};
+
+class StaticCheckSwappedDto : public oatpp::DTO {
+
+  DTO_INIT(StaticCheckSwappedDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+
+};
+
+class StaticCheckMissingDto : public oatpp::DTO {
+
+  DTO_INIT(StaticCheckMissingDto, DTO)
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+STATIC_DTO(StaticCheckDto,
+  STATIC_DTO_FIELD(id)
+  STATIC_DTO_FIELD_AS(name, "full-name")
+)
+
+STATIC_DTO(StaticCheckChildDto,
+  STATIC_DTO_FIELD(id)
+  STATIC_DTO_FIELD_AS(name, "full-name")
+  STATIC_DTO_FIELD(size)
+)
+
+/* Out of the DTO_FIELD order */
+STATIC_DTO(StaticCheckSwappedDto,
+  STATIC_DTO_FIELD(name)
+  STATIC_DTO_FIELD(id)
+)
+
+/* Field added to the DTO and forgotten here */
+STATIC_DTO(StaticCheckMissingDto,
+  STATIC_DTO_FIELD(id)
+)
+
+namespace {
+
+template<class T>
+bool registers() {
+  try {
+    StaticJsonObjectMapper::createShared()->registerDto<T>();
+    return true;
+  } catch (const std::runtime_error& e) {
+    OATPP_LOGD("StaticJsonObjectMapperTest", "%s", e.what());
+    return false;
+  }
+}
+
+oatpp::Object<MyDto> createDto(const oatpp::Int32& statusCode, const oatpp::String& message) {
+  auto dto = MyDto::createShared();
+  dto->statusCode = statusCode;
+  dto->message = message;
+  return dto;
+}
+
+}
+
+void StaticJsonObjectMapperTest::onRun() {
+
+  auto runtime = oatpp::parser::json::mapping::ObjectMapper::createShared();
+  auto mapper = StaticJsonObjectMapper::createShared();
+  mapper->registerDto<MyDto>();
+
+  /* Same JSON as the runtime serializer - nulls, escapes and non-ASCII included */
+  oatpp::Object<MyDto> dtos[] = {
+    createDto(200, "Hello World!"),
+    createDto(-1, ""),
+    createDto(nullptr, nullptr),
+    createDto(0, "quote \" backslash \\ slash / tab \t"),
+    createDto(2147483647, "caf\xc3\xa9")
+  };
+
+  for(auto& dto : dtos) {
+    auto json = runtime->writeToString(dto);
+    OATPP_ASSERT(mapper->writeToString(dto) == json);
+
+    auto parsed = mapper->readFromString<oatpp::Object<MyDto>>(json);
+    OATPP_ASSERT(runtime->writeToString(parsed) == json);
+  }
+
+  /* Lists are not registered - the runtime path serializes them, the elements go the static way */
+  auto list = oatpp::List<oatpp::Object<MyDto>>::createShared();
+  list->push_back(dtos[0]);
+  list->push_back(nullptr);
+  OATPP_ASSERT(mapper->writeToString(list) == runtime->writeToString(list));
+
+  /* Input the static reader doesn't expect falls back to the runtime deserializer */
+  auto unknownField = mapper->readFromString<oatpp::Object<MyDto>>("{\"statusCode\": 1, \"extra\": [1, 2], \"message\": \"m\"}");
+  OATPP_ASSERT(unknownField && unknownField->statusCode == 1 && unknownField->message == "m");
+
+  auto escapedKey = mapper->readFromString<oatpp::Object<MyDto>>("{\"status\\u0043ode\": 5}");
+  OATPP_ASSERT(escapedKey && escapedKey->statusCode == 5);
+
+  bool failed = false;
+  try {
+    mapper->readFromString<oatpp::Object<MyDto>>("{\"statusCode\": 1,");
+  } catch (const std::exception&) {
+    failed = true;
+  }
+  OATPP_ASSERT(failed);
+
+  /* STATIC_DTO must match DTO_FIELD - custom names and base class fields included */
+  OATPP_ASSERT(registers<StaticCheckDto>());
+  OATPP_ASSERT(registers<StaticCheckChildDto>());
+  OATPP_ASSERT(!registers<StaticCheckSwappedDto>());
+  OATPP_ASSERT(!registers<StaticCheckMissingDto>());
+
+}
@@ -0,0 +1,14 @@
+#ifndef StaticJsonObjectMapperTest_hpp
+#define StaticJsonObjectMapperTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class StaticJsonObjectMapperTest : public oatpp::test::UnitTest {
+public:
+
+  StaticJsonObjectMapperTest() : UnitTest("TEST[StaticJsonObjectMapperTest]"){}
+  void onRun() override;
+
+};
+
+#endif // StaticJsonObjectMapperTest_hpp
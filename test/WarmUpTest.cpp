@@ -0,0 +1,165 @@
+#include "WarmUpTest.hpp"
+
+#include "AppComponent.hpp"
+#include "controller/MyController.hpp"
+#include "lifecycle/ServerLifecycle.hpp"
+#include "lifecycle/WarmUp.hpp"
+#include "memory/BufferPool.hpp"
+
+#include "app/LoopbackTestClient.hpp"
+#include "app/MyApiTestClient.hpp"
+
+#include "oatpp/web/client/HttpRequestExecutor.hpp"
+#include "oatpp/network/tcp/client/ConnectionProvider.hpp"
+
+namespace {
+
+void testDeferredListen() {
+
+  ListenerConnectionProvider::Options options;
+  options.deferListen = true;
+  auto provider = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4}, options);
+
+  /* Bound - the port is known and taken - but refusing */
+  OATPP_ASSERT(provider->getPort() != 0);
+  OATPP_ASSERT(!provider->isListening());
+  OATPP_ASSERT(!LoopbackTestClient::canConnect(provider->getPort()));
+
+  provider->listen();
+  provider->listen();
+  OATPP_ASSERT(provider->isListening());
+  OATPP_ASSERT(LoopbackTestClient::canConnect(provider->getPort()));
+  OATPP_ASSERT(provider->get().object);
+
+  /* Stopped before listen() - get() doesn't start listening */
+  auto stopped = ListenerConnectionProvider::createShared({"127.0.0.1", 0, oatpp::network::Address::IP_4}, options);
+  stopped->stop();
+  OATPP_ASSERT(!stopped->get().object);
+  OATPP_ASSERT(!stopped->isListening());
+
+}
+
+void testPrefault() {
+
+  BufferPool::trim();
+
+  auto prefaulted = WarmUp::prefaultBufferPool(BufferPool::CLASSES_COUNT * BufferPool::getClassSize(1));
+  OATPP_ASSERT(prefaulted >= BufferPool::CLASSES_COUNT * BufferPool::getClassSize(1));
+  OATPP_ASSERT(BufferPool::getStats().retainedBytes >= prefaulted);
+
+  /* Taken from the pool, not allocated */
+  auto before = BufferPool::getStats();
+  {
+    auto buffer = BufferPool::acquire(BufferPool::getClassSize(0));
+  }
+  OATPP_ASSERT(BufferPool::getStats().allocated == before.allocated);
+
+  OATPP_ASSERT(WarmUp::prefaultBufferPool(0) == 0);
+  BufferPool::trim();
+
+}
+
+void testAppComponent() {
+
+  ServerConfig config(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4));
+  config.warmUp.paths = {"/", "/items/10", "/no-such-path"};
+  config.warmUp.requestsPerPath = 20;
+
+  AppComponent components(config, AppComponent::Scope::INSTANCE);
+
+  auto objectMapper = components.get<std::shared_ptr<oatpp::data::mapping::ObjectMapper>>();
+  components.get<std::shared_ptr<oatpp::web::server::HttpRouter>>()->addController(std::make_shared<MyController>(objectMapper));
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto listener = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider);
+  OATPP_ASSERT(!LoopbackTestClient::canConnect(listener->getPort()));
+
+  /* Error statuses are not failures */
+  auto report = components.warmUp();
+  OATPP_ASSERT(report.requests == 60);
+  OATPP_ASSERT(report.failed == 0);
+  OATPP_ASSERT(listener->isListening());
+
+  /* HttpConnectionHandler doesn't take buffers from BufferPool - nothing to pre-fault */
+  OATPP_ASSERT(report.prefaultedBytes == 0);
+
+  /* Second call only makes sure the port is open */
+  OATPP_ASSERT(components.warmUp().requests == 0);
+
+  /* Warm-up requests are not in the metrics */
+  OATPP_ASSERT(components.get<std::shared_ptr<RequestMetrics>>()->renderPrometheus()->find("route=\"/\"") == std::string::npos);
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+
+  auto clientConnectionProvider = oatpp::network::tcp::client::ConnectionProvider::createShared({"127.0.0.1", listener->getPort()});
+  auto client = MyApiTestClient::createShared(oatpp::web::client::HttpRequestExecutor::createShared(clientConnectionProvider), objectMapper);
+  OATPP_ASSERT(client->getRoot()->getStatusCode() == 200);
+
+  lifecycle.stop();
+
+}
+
+void testParkingPrefault() {
+
+  BufferPool::trim();
+
+  /* No paths - the warm-up server is stopped right after it is started */
+  ServerConfig config(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4));
+  config.warmUp.paths = {};
+
+  AppComponent::Options options;
+  options.parking = std::make_shared<ParkingConnectionHandler::Config>();
+  options.parking->workersCount = 2;
+
+  AppComponent components(config, AppComponent::Scope::INSTANCE, options);
+
+  auto report = components.warmUp();
+  OATPP_ASSERT(report.requests == 0);
+  OATPP_ASSERT(report.prefaultedBytes > 0);
+  OATPP_ASSERT(BufferPool::getStats().retainedBytes >= report.prefaultedBytes);
+
+  BufferPool::trim();
+
+}
+
+void testDisabled() {
+
+  ServerConfig config(oatpp::network::Address("127.0.0.1", 0, oatpp::network::Address::IP_4));
+  config.warmUp.enabled = false;
+
+  AppComponent components(config, AppComponent::Scope::INSTANCE);
+
+  auto listener = std::static_pointer_cast<ListenerConnectionProvider>(components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>());
+  OATPP_ASSERT(listener->isListening());
+  OATPP_ASSERT(components.warmUp().requests == 0);
+
+}
+
+void testLifecycleOpensPort() {
+
+  /* Warm-up on, but warmUp() is never called - start() opens the port before clients connect */
+  AppComponent components({"127.0.0.1", 0, oatpp::network::Address::IP_4}, AppComponent::Scope::INSTANCE);
+
+  auto connectionProvider = components.get<std::shared_ptr<oatpp::network::ServerConnectionProvider>>();
+  auto listener = std::static_pointer_cast<ListenerConnectionProvider>(connectionProvider);
+  OATPP_ASSERT(!listener->isListening());
+
+  ServerLifecycle lifecycle(connectionProvider, components.get<std::shared_ptr<oatpp::network::ConnectionHandler>>());
+  lifecycle.start();
+  OATPP_ASSERT(listener->isListening());
+  OATPP_ASSERT(LoopbackTestClient::canConnect(listener->getPort()));
+  lifecycle.stop();
+
+}
+
+}
+
+void WarmUpTest::onRun() {
+  testDeferredListen();
+  testPrefault();
+  testAppComponent();
+  testParkingPrefault();
+  testDisabled();
+  testLifecycleOpensPort();
+}
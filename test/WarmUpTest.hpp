@@ -0,0 +1,14 @@
+#ifndef WarmUpTest_hpp
+#define WarmUpTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+class WarmUpTest : public oatpp::test::UnitTest {
+public:
+
+  WarmUpTest() : UnitTest("TEST[WarmUpTest]"){}
+  void onRun() override;
+
+};
+
+#endif // WarmUpTest_hpp
@@ -0,0 +1,132 @@
+
+#ifndef LoopbackTestClient_hpp
+#define LoopbackTestClient_hpp
+
+#include "oatpp/core/Types.hpp"
+#include "oatpp/core/base/Environment.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * Raw socket client of `127.0.0.1`.
+ * Use it where &l:MyApiTestClient; can't go - pipelined or malformed requests, connections held open, reading until
+ * the server closes.
+ */
+class LoopbackTestClient {
+public:
+
+  /**
+   * Connect to `127.0.0.1:port`. Asserts the connection was accepted by the system.
+   * @param port
+   * @return - socket handle.
+   */
+  static int connect(v_uint16 port) {
+    int handle = ::socket(AF_INET, SOCK_STREAM, 0);
+    OATPP_ASSERT(handle >= 0);
+    sockaddr_in address = makeAddress(port);
+    OATPP_ASSERT(::connect(handle, (sockaddr*) &address, sizeof(address)) == 0);
+    return handle;
+  }
+
+  /**
+   * Connect to `127.0.0.1:port` and close the connection right away.
+   * @param port
+   * @return - `true` if the connection was accepted by the system.
+   */
+  static bool canConnect(v_uint16 port) {
+    int handle = ::socket(AF_INET, SOCK_STREAM, 0);
+    OATPP_ASSERT(handle >= 0);
+    sockaddr_in address = makeAddress(port);
+    bool connected = ::connect(handle, (sockaddr*) &address, sizeof(address)) == 0;
+    ::close(handle);
+    return connected;
+  }
+
+  /**
+   * Send all of `data`. Stops at the first error - the server may close before it has read everything.
+   * @param handle
+   * @param data
+   * @return - `true` if all of `data` was sent.
+   */
+  static bool send(int handle, const std::string& data) {
+    size_t sent = 0;
+    while(sent < data.size()) {
+      auto res = ::send(handle, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+      if(res <= 0) {
+        return false;
+      }
+      sent += (size_t) res;
+    }
+    return true;
+  }
+
+  /**
+   * Read until the server closes the connection, then close the handle.
+   * @param handle
+   * @return - everything received.
+   */
+  static std::string readAll(int handle) {
+    std::string data;
+    char buffer[4096];
+    ssize_t res;
+    while((res = ::recv(handle, buffer, sizeof(buffer), 0)) > 0) {
+      data.append(buffer, (size_t) res);
+    }
+    ::close(handle);
+    return data;
+  }
+
+  /**
+   * Connect to `127.0.0.1:port`, send `data` and read until the server closes the connection.
+   * @param port
+   * @param data - raw request(s).
+   * @return - everything received.
+   */
+  static std::string request(v_uint16 port, const std::string& data) {
+    int handle = connect(port);
+    send(handle, data);
+    return readAll(handle);
+  }
+
+  /**
+   * Poll `condition` every millisecond until it holds.
+   * @param condition
+   * @param timeout
+   * @return - `false` if `timeout` passed first.
+   */
+  static bool waitFor(const std::function<bool()>& condition,
+                      const std::chrono::milliseconds& timeout = std::chrono::seconds(5))
+  {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while(!condition()) {
+      if(std::chrono::steady_clock::now() > deadline) {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+private:
+
+  static sockaddr_in makeAddress(v_uint16 port) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+  }
+
+};
+
+#endif // LoopbackTestClient_hpp
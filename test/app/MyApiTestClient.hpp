@@ -17,6 +17,13 @@ class MyApiTestClient : public oatpp::web::client::ApiClient {
   API_CLIENT_INIT(MyApiTestClient)
 
   API_CALL("GET", "/", getRoot)
+  API_CALL("GET", "/", getRootIfNoneMatch, HEADER(String, etag, "If-None-Match"))
+  API_CALL("GET", "/items/{count}", getItems, PATH(Int32, count))
+  API_CALL("GET", "/hello/{name}", getHello, PATH(String, name))
+  API_CALL("GET", "/metrics", getMetrics)
+  API_CALL("GET", "/assets/{name}", getAsset, PATH(String, name))
+  API_CALL("GET", "/assets/{name}", getAssetRange, PATH(String, name), HEADER(String, range, "Range"))
+  API_CALL("GET", "/slow", getSlow)
 
   // TODO - add more client API calls here
 
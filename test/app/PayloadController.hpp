@@ -0,0 +1,62 @@
+#ifndef PayloadController_hpp
+#define PayloadController_hpp
+
+#include "cache/CachedResponse.hpp"
+#include "dto/DTOs.hpp"
+
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+#include OATPP_CODEGEN_BEGIN(ApiController) //<-- Begin Codegen
+
+/**
+ * Test controller with JSON bodies large enough to be worth compressing - a list of `itemsCount` &l:MyDto;.
+ * `GET /payload/cached` serves it from a &l:CachedResponse; (ETag, serialized once),
+ * `GET /payload/dto` serializes it with `createDtoResponse` on every request.
+ */
+class PayloadController : public oatpp::web::server::api::ApiController {
+private:
+  oatpp::List<oatpp::Object<MyDto>> m_items;
+  std::shared_ptr<CachedResponse> m_cachedResponse;
+private:
+
+  static oatpp::List<oatpp::Object<MyDto>> createItems(v_int32 itemsCount) {
+    auto items = oatpp::List<oatpp::Object<MyDto>>::createShared();
+    for(v_int32 i = 0; i < itemsCount; i ++) {
+      auto dto = MyDto::createShared();
+      dto->statusCode = 200;
+      dto->message = "Item " + std::to_string(i);
+      items->push_back(dto);
+    }
+    return items;
+  }
+
+public:
+
+  /**
+   * Constructor.
+   * @param objectMapper - mapper to serialize the list with.
+   * @param itemsCount - number of items in the list.
+   */
+  PayloadController(const std::shared_ptr<ObjectMapper>& objectMapper, v_int32 itemsCount = 200)
+    : oatpp::web::server::api::ApiController(objectMapper)
+    , m_items(createItems(itemsCount))
+    , m_cachedResponse(CachedResponse::createDtoResponse(Status::CODE_200, m_items, objectMapper))
+  {}
+
+public:
+
+  ENDPOINT("GET", "/payload/cached", getCached,
+           REQUEST(std::shared_ptr<IncomingRequest>, request)) {
+    return m_cachedResponse->respond(request);
+  }
+
+  ENDPOINT("GET", "/payload/dto", getDto) {
+    return createDtoResponse(Status::CODE_200, m_items);
+  }
+
+};
+
+#include OATPP_CODEGEN_END(ApiController) //<-- End Codegen
+
+#endif // PayloadController_hpp
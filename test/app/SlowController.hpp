@@ -0,0 +1,69 @@
+#ifndef SlowController_hpp
+#define SlowController_hpp
+
+#include "oatpp/web/server/api/ApiController.hpp"
+#include "oatpp/core/macro/codegen.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include OATPP_CODEGEN_BEGIN(ApiController) //<-- Begin Codegen
+
+/**
+ * Test controller in front of a deliberately slow backend. `GET /slow` takes `serviceTime` in a backend which serves
+ * at most `capacity` requests at the same time, first come first served - more concurrent requests queue and their
+ * latency grows with the queue, like a saturated database pool.
+ */
+class SlowController : public oatpp::web::server::api::ApiController {
+private:
+  v_int64 m_capacity;
+  std::chrono::milliseconds m_serviceTime;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  v_int64 m_nextTicket;
+  v_int64 m_finished;
+private:
+
+  void serve() {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      auto ticket = m_nextTicket ++;
+      m_condition.wait(lock, [this, ticket] { return ticket < m_finished + m_capacity; });
+    }
+    std::this_thread::sleep_for(m_serviceTime);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_finished ++;
+    }
+    m_condition.notify_all();
+  }
+
+public:
+
+  /**
+   * Constructor.
+   * @param capacity - requests served at the same time.
+   * @param serviceTime - time to serve one request.
+   */
+  SlowController(v_int64 capacity, const std::chrono::milliseconds& serviceTime)
+    : oatpp::web::server::api::ApiController(nullptr)
+    , m_capacity(capacity)
+    , m_serviceTime(serviceTime)
+    , m_nextTicket(0)
+    , m_finished(0)
+  {}
+
+public:
+
+  ENDPOINT("GET", "/slow", slow) {
+    serve();
+    return createResponse(Status::CODE_200, "done");
+  }
+
+};
+
+#include OATPP_CODEGEN_END(ApiController) //<-- End Codegen
+
+#endif // SlowController_hpp
@@ -1,10 +1,53 @@
 
+#include "AllocationTelemetryTest.hpp"
+#include "AppComponentTest.hpp"
+#include "BufferPoolTest.hpp"
+#include "CompiledRouterTest.hpp"
+#include "ConcurrencyLimiterTest.hpp"
+#include "DrainingConnectionHandlerTest.hpp"
+#include "FileBodyTest.hpp"
+#include "HotRestartTest.hpp"
+#include "JsonArrayReadCallbackTest.hpp"
+#include "MyAsyncControllerTest.hpp"
 #include "MyControllerTest.hpp"
+#include "ParkingConnectionHandlerTest.hpp"
+#include "PooledConnectionHandlerTest.hpp"
+#include "RequestMetricsTest.hpp"
+#include "ResponseCompressionTest.hpp"
+#include "ServerConfigTest.hpp"
+#include "ServerGroupTest.hpp"
+#include "ServerLifecycleTest.hpp"
+#include "SimdObjectMapperTest.hpp"
+#include "StaticJsonObjectMapperTest.hpp"
+#include "WarmUpTest.hpp"
+
+#include "memory/BufferPool.hpp"
+#include "telemetry/AllocationTelemetry.hpp"
 
 #include <iostream>
 
 void runTests() {
   OATPP_RUN_TEST(MyControllerTest);
+  OATPP_RUN_TEST(MyAsyncControllerTest);
+  OATPP_RUN_TEST(ServerLifecycleTest);
+  OATPP_RUN_TEST(DrainingConnectionHandlerTest);
+  OATPP_RUN_TEST(ServerGroupTest);
+  OATPP_RUN_TEST(HotRestartTest);
+  OATPP_RUN_TEST(AppComponentTest);
+  OATPP_RUN_TEST(PooledConnectionHandlerTest);
+  OATPP_RUN_TEST(ParkingConnectionHandlerTest);
+  OATPP_RUN_TEST(RequestMetricsTest);
+  OATPP_RUN_TEST(AllocationTelemetryTest);
+  OATPP_RUN_TEST(SimdObjectMapperTest);
+  OATPP_RUN_TEST(StaticJsonObjectMapperTest);
+  OATPP_RUN_TEST(BufferPoolTest);
+  OATPP_RUN_TEST(FileBodyTest);
+  OATPP_RUN_TEST(JsonArrayReadCallbackTest);
+  OATPP_RUN_TEST(CompiledRouterTest);
+  OATPP_RUN_TEST(ServerConfigTest);
+  OATPP_RUN_TEST(ConcurrencyLimiterTest);
+  OATPP_RUN_TEST(ResponseCompressionTest);
+  OATPP_RUN_TEST(WarmUpTest);
 }
 
 int main() {
@@ -19,6 +62,9 @@ int main() {
   std::cout << "objectsCount = " << oatpp::base::Environment::getObjectsCount() << "\n";
   std::cout << "objectsCreated = " << oatpp::base::Environment::getObjectsCreated() << "\n\n";
 
+  std::cout << AllocationTelemetry::formatReport() << "\n";
+  std::cout << BufferPool::formatReport() << "\n";
+
   OATPP_ASSERT(oatpp::base::Environment::getObjectsCount() == 0);
 
   oatpp::base::Environment::destroy();